@@ -49,6 +49,7 @@ enum GatewayMessageType : uint16_t
     RouterTableResponse = 0xb,
     RouterTableRequest = 0xc,
     ForwardMessage = 0xd,
+    FrameBatch = 0xe,  // the small frames coalesced by a session, see libnetwork/FrameBatch.h
     All = 0xff
 };
 /**
@@ -100,6 +100,7 @@ public:
         feature_raw_address,
         feature_rpbft_vrf_type_secp256k1,
         feature_balance_policy2,  // 转账白名单 Transfer whitelist
+        feature_state_tree,       // 稀疏默克尔状态树 Sparse Merkle state tree as the state root
     };
 
 private:
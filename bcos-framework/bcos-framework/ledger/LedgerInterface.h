@@ -27,6 +27,7 @@
 #include "../storage/StorageInterface.h"
 #include "Features.h"
 #include "LedgerTypeDef.h"
+#include "StateTree.h"
 #include "SystemConfigs.h"
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
 #include <bcos-task/Task.h>
@@ -122,6 +123,21 @@ public:
         std::function<void(Error::Ptr, protocol::TransactionReceipt::Ptr, MerkleProofPtr)>
             _onGetTx) = 0;
 
+    /**
+     * @brief async get the receipts of a batch of transactions with one read of the storage
+     * @param _txHashList transaction hash list
+     * @param _onGetReceipts return <error, receipts in the order of _txHashList>, error if any of
+     *                       the receipts is missing or the ledger can't read them at once
+     */
+    virtual void asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+        std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::Ptr>)>
+            _onGetReceipts)
+    {
+        _onGetReceipts(BCOS_ERROR_PTR(LedgerError::UnknownError,
+                           "asyncGetBatchReceiptsByHashList is not supported"),
+            {});
+    }
+
     /**
      * @brief async get total transaction count and latest block number
      * @param _callback callback totalTxCount, totalFailedTxCount, and latest block number
@@ -197,6 +213,37 @@ public:
         co_return std::nullopt;
     }
 
+    /**
+     * @brief get the sparse Merkle proof of a state key against the latest state root, only
+     * available when feature_state_tree is enabled since the genesis block, otherwise the tree
+     * misses the keys written before it and an exclusion proof can not be trusted
+     * @param _table the table name of the state key
+     * @param _key the key in the table
+     * @param _blockNumber the block number to get the proof, must be the latest block
+     * @return the proof, verify it with state_tree::verifyStateProof, std::nullopt when the
+     * feature is not enabled; throws when _blockNumber is not the latest block or the feature
+     * was enabled after the genesis block
+     */
+    virtual task::Task<std::optional<state_tree::StateProof>> getStateProof(
+        std::string_view _table, std::string_view _key, protocol::BlockNumber _blockNumber)
+    {
+        co_return std::nullopt;
+    }
+
+    /**
+     * @brief get the blocks in [_fromBlock, _toBlock] that may contain a log matching the filter
+     * from the log index, blocks not covered by the index are always returned
+     * @param _addresses the log addresses to match any of, empty matches all addresses
+     * @param _topics the topics to match any of at each position, empty matches all topics
+     * @return the candidate blocks in ascending order, std::nullopt if there is no log index
+     */
+    virtual task::Task<std::optional<std::vector<protocol::BlockNumber>>> getLogIndexCandidates(
+        protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock,
+        std::vector<std::string> const& _addresses, std::vector<h256s> const& _topics)
+    {
+        co_return std::nullopt;
+    }
+
     virtual task::Task<std::optional<ledger::StorageState>> getStorageState(
         std::string_view _address, protocol::BlockNumber _blockNumber)
     {
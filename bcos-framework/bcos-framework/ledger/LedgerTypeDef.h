@@ -105,6 +105,10 @@ constexpr static std::string_view SMALLBANK_TRANSFER{"/tables/smallbank_transfer
 constexpr static std::string_view SYS_CODE_BINARY{"s_code_binary"};
 constexpr static std::string_view SYS_CONTRACT_ABI{"s_contract_abi"};
 constexpr static std::string_view SYS_BALANCE_CALLER{"s_balance_caller"};
+constexpr static std::string_view SYS_STATE_TREE{"s_state_tree"};
+constexpr static std::string_view SYS_LOG_INDEX{"s_log_index"};
+constexpr static std::string_view SYS_NUMBER_2_TX_MERKLE{"s_number_2_tx_merkle"};
+constexpr static std::string_view SYS_NUMBER_2_RECEIPT_MERKLE{"s_number_2_receipt_merkle"};
 
 struct SYS_DIRECTORY
 {
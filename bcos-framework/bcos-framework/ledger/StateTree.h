@@ -0,0 +1,438 @@
+/**
+ *  Copyright (C) 2024 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file StateTree.h
+ */
+
+#pragma once
+#include "LedgerTypeDef.h"
+#include "bcos-crypto/interfaces/crypto/Hash.h"
+#include "bcos-framework/storage/Entry.h"
+#include "bcos-framework/storage2/Storage.h"
+#include "bcos-framework/transaction-executor/StateKey.h"
+#include "bcos-task/TBBWait.h"
+#include "bcos-task/Task.h"
+#include <bcos-utilities/DataConvertUtility.h>
+#include <oneapi/tbb/parallel_invoke.h>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+// 稀疏默克尔状态树：key的路径为hash(table, key)的256位，只含一个叶子的子树直接把叶子存放在子树根的位置，
+// 空子树的哈希为0。节点按(深度, 路径前缀)存放在SYS_STATE_TREE表中，每个区块只重写被修改的key所在的路径。
+// Sparse Merkle state tree: the path of a key is the 256 bits of hash(table, key), a subtree holding a
+// single leaf stores that leaf at the subtree root and an empty subtree hashes to zero. Nodes are
+// stored in SYS_STATE_TREE keyed by (depth, path prefix), so a block only rewrites the paths of the
+// keys it modified.
+namespace bcos::ledger::state_tree
+{
+
+constexpr static uint32_t MAX_DEPTH = 256;
+
+enum class NodeType : uint8_t
+{
+    EMPTY = 0,
+    LEAF = 1,
+    INTERNAL = 2,
+};
+
+struct Node
+{
+    NodeType type = NodeType::EMPTY;
+    h256 first;   // 叶子: key路径, 中间节点: 左子树哈希 | leaf: key path, internal: left child hash
+    h256 second;  // 叶子: value哈希, 中间节点: 右子树哈希 | leaf: value hash, internal: right hash
+
+    bool operator==(Node const& rhs) const = default;
+};
+
+struct Update
+{
+    h256 path;
+    std::optional<h256> valueHash;  // nullopt表示删除 | nullopt removes the key
+};
+
+struct StateProof
+{
+    h256 path;
+    Node terminal;
+    std::vector<h256> siblings;  // 从根向下 | from the root downwards
+};
+
+inline bool pathBit(h256 const& path, uint32_t depth)
+{
+    return ((path[depth / 8] >> (7 - depth % 8)) & 1U) != 0;
+}
+
+inline h256 withPathBit(h256 path, uint32_t depth, bool bit)
+{
+    auto mask = static_cast<bcos::byte>(1U << (7 - depth % 8));
+    path[depth / 8] = bit ? (path[depth / 8] | mask) : (path[depth / 8] & ~mask);
+    return path;
+}
+
+inline h256 keyPath(std::string_view table, std::string_view key, crypto::Hash const& hashImpl)
+{
+    // 表名加长度前缀，避免("a", "bc")与("ab", "c")落到同一路径
+    // Length-prefix the table so ("a", "bc") and ("ab", "c") never share a path
+    std::string buffer;
+    buffer.reserve(sizeof(uint32_t) + table.size() + key.size());
+    auto tableSize = boost::endian::native_to_big(static_cast<uint32_t>(table.size()));
+    buffer.append(reinterpret_cast<const char*>(&tableSize), sizeof(tableSize));
+    buffer.append(table);
+    buffer.append(key);
+    return hashImpl.hash(buffer);
+}
+
+inline h256 nodeHash(Node const& node, crypto::Hash const& hashImpl)
+{
+    if (node.type == NodeType::EMPTY)
+    {
+        return {};
+    }
+    std::array<bcos::byte, 1 + h256::SIZE * 2> buffer{};
+    buffer[0] = static_cast<bcos::byte>(node.type);
+    std::copy_n(node.first.data(), h256::SIZE, buffer.data() + 1);
+    std::copy_n(node.second.data(), h256::SIZE, buffer.data() + 1 + h256::SIZE);
+    return hashImpl.hash(bytesConstRef(buffer.data(), buffer.size()));
+}
+
+inline std::string encodeNode(Node const& node)
+{
+    std::string buffer;
+    buffer.reserve(1 + h256::SIZE * 2);
+    buffer.push_back(static_cast<char>(node.type));
+    buffer.append(reinterpret_cast<const char*>(node.first.data()), h256::SIZE);
+    buffer.append(reinterpret_cast<const char*>(node.second.data()), h256::SIZE);
+    return buffer;
+}
+
+inline Node decodeNode(std::string_view buffer)
+{
+    if (buffer.size() != 1 + h256::SIZE * 2)
+    {
+        return {};
+    }
+    Node node{.type = static_cast<NodeType>(buffer[0])};
+    std::copy_n(buffer.data() + 1, h256::SIZE, reinterpret_cast<char*>(node.first.data()));
+    std::copy_n(
+        buffer.data() + 1 + h256::SIZE, h256::SIZE, reinterpret_cast<char*>(node.second.data()));
+    return node;
+}
+
+// 节点位置: 深度(1字节) + 路径前缀，前缀末尾多余的位清零，以十六进制存储
+// Node position: depth (1 byte) followed by the path prefix with the trailing bits cleared, in hex
+inline std::string nodePosition(uint32_t depth, h256 const& path)
+{
+    std::array<bcos::byte, 1 + h256::SIZE> buffer{};
+    buffer[0] = static_cast<bcos::byte>(depth);
+    auto prefixSize = (depth + 7) / 8;
+    std::copy_n(path.data(), prefixSize, buffer.data() + 1);
+    if (depth % 8 != 0)
+    {
+        buffer[prefixSize] &= static_cast<bcos::byte>(0xFFU << (8 - depth % 8));
+    }
+    return toHex(bytesConstRef(buffer.data(), 1 + prefixSize));
+}
+
+inline storage::Entry encodeEntry(Node const& node)
+{
+    storage::Entry entry;
+    entry.set(encodeNode(node));
+    return entry;
+}
+
+inline h256 stateRootFromProof(StateProof const& proof, crypto::Hash const& hashImpl)
+{
+    auto hash = nodeHash(proof.terminal, hashImpl);
+    for (auto depth = proof.siblings.size(); depth > 0; --depth)
+    {
+        auto const& sibling = proof.siblings[depth - 1];
+        Node parent{.type = NodeType::INTERNAL};
+        if (pathBit(proof.path, depth - 1))
+        {
+            parent.first = sibling;
+            parent.second = hash;
+        }
+        else
+        {
+            parent.first = hash;
+            parent.second = sibling;
+        }
+        hash = nodeHash(parent, hashImpl);
+    }
+    return hash;
+}
+
+/**
+ * @brief 校验状态证明，valueHash为空时校验key不存在
+ * Verify a state proof, an empty valueHash verifies that the key is absent
+ */
+inline bool verifyStateProof(h256 const& stateRoot, h256 const& path,
+    std::optional<h256> const& valueHash, StateProof const& proof, crypto::Hash const& hashImpl)
+{
+    if (proof.path != path || proof.siblings.size() >= MAX_DEPTH ||
+        proof.terminal.type == NodeType::INTERNAL)
+    {
+        return false;
+    }
+    auto isLeafOfKey = proof.terminal.type == NodeType::LEAF && proof.terminal.first == path;
+    if (valueHash ? !isLeafOfKey || proof.terminal.second != *valueHash : isLeafOfKey)
+    {
+        return false;
+    }
+    return stateRootFromProof(proof, hashImpl) == stateRoot;
+}
+
+task::Task<Node> readNode(auto& storage, uint32_t depth, h256 path)
+{
+    auto entry = co_await storage2::readOne(
+        storage, executor_v1::StateKey{SYS_STATE_TREE, nodePosition(depth, path)});
+    co_return entry ? decodeNode(entry->get()) : Node{};
+}
+
+task::Task<StateProof> getStateProof(auto& storage, h256 path)
+{
+    StateProof proof{.path = path};
+    for (uint32_t depth = 0; depth < MAX_DEPTH; ++depth)
+    {
+        auto node = co_await readNode(storage, depth, path);
+        if (node.type != NodeType::INTERNAL)
+        {
+            proof.terminal = node;
+            break;
+        }
+        proof.siblings.emplace_back(pathBit(path, depth) ? node.first : node.second);
+    }
+    co_return proof;
+}
+
+/**
+ * @brief 把一个区块的修改应用到状态树并返回新的根哈希，节点的读取在较浅的子树间并行，
+ * 所有节点的写入在计算完成后统一写回storage
+ * Apply the modifications of a block to the state tree and return the new root hash. Node reads
+ * run in parallel across the upper subtrees, all node writes are flushed to the storage once the
+ * new root is known.
+ */
+template <class Storage>
+class StateTreeUpdater
+{
+private:
+    constexpr static uint32_t PARALLEL_DEPTH = 8;
+    constexpr static size_t PARALLEL_GRAIN = 64;
+
+    // EMPTY节点表示删除该位置 | An EMPTY node removes the position
+    using Changes = std::vector<std::tuple<std::string, Node>>;
+
+    std::reference_wrapper<Storage> m_storage;
+    std::reference_wrapper<crypto::Hash const> m_hashImpl;
+
+    Node readNodeSync(uint32_t depth, h256 const& path) const
+    {
+        return task::tbb::syncWait(readNode(m_storage.get(), depth, path));
+    }
+
+    static size_t splitPoint(std::span<Update const> updates, uint32_t depth)
+    {
+        return std::partition_point(updates.begin(), updates.end(),
+                   [depth](Update const& update) { return !pathBit(update.path, depth); }) -
+               updates.begin();
+    }
+
+    void invoke(uint32_t depth, size_t size, auto&& left, auto&& right) const
+    {
+        if (depth < PARALLEL_DEPTH && size >= PARALLEL_GRAIN)
+        {
+            tbb::parallel_invoke(left, right);
+        }
+        else
+        {
+            left();
+            right();
+        }
+    }
+
+    // 该位置以下没有已存储的节点 | No stored node exists below this position
+    Node buildSubtree(uint32_t depth, std::span<Update const> items, Changes& changes) const
+    {
+        if (items.empty())
+        {
+            return {};
+        }
+        if (items.size() == 1)
+        {
+            return Node{
+                .type = NodeType::LEAF, .first = items[0].path, .second = *items[0].valueHash};
+        }
+
+        auto middle = splitPoint(items, depth);
+        Node left;
+        Node right;
+        Changes rightChanges;
+        invoke(
+            depth, items.size(),
+            [&]() { left = buildSubtree(depth + 1, items.first(middle), changes); },
+            [&]() { right = buildSubtree(depth + 1, items.subspan(middle), rightChanges); });
+        changes.insert(changes.end(), std::make_move_iterator(rightChanges.begin()),
+            std::make_move_iterator(rightChanges.end()));
+
+        for (auto const* child : {&left, &right})
+        {
+            if (child->type != NodeType::EMPTY)
+            {
+                auto const& anchor = child == &left ? items.front().path : items.back().path;
+                changes.emplace_back(nodePosition(depth + 1, anchor), *child);
+            }
+        }
+        return Node{.type = NodeType::INTERNAL,
+            .first = nodeHash(left, m_hashImpl.get()),
+            .second = nodeHash(right, m_hashImpl.get())};
+    }
+
+    Node updateInternal(uint32_t depth, std::span<Update const> updates, Node const& existing,
+        Changes& changes) const
+    {
+        auto middle = splitPoint(updates, depth);
+        auto leftUpdates = updates.first(middle);
+        auto rightUpdates = updates.subspan(middle);
+
+        std::optional<Node> left;
+        std::optional<Node> right;
+        Changes rightChanges;
+        invoke(
+            depth, updates.size(),
+            [&]() {
+                if (!leftUpdates.empty())
+                {
+                    left = updateSubtree(depth + 1, leftUpdates, existing.first != h256{}, changes);
+                }
+            },
+            [&]() {
+                if (!rightUpdates.empty())
+                {
+                    right = updateSubtree(
+                        depth + 1, rightUpdates, existing.second != h256{}, rightChanges);
+                }
+            });
+        changes.insert(changes.end(), std::make_move_iterator(rightChanges.begin()),
+            std::make_move_iterator(rightChanges.end()));
+
+        auto leftHash = left ? nodeHash(*left, m_hashImpl.get()) : existing.first;
+        auto rightHash = right ? nodeHash(*right, m_hashImpl.get()) : existing.second;
+        if (leftHash == h256{} && rightHash == h256{})
+        {
+            return {};
+        }
+
+        // 只剩一个叶子时上移到当前位置 | A lone remaining leaf moves up to this position
+        if (leftHash == h256{} || rightHash == h256{})
+        {
+            auto isRight = leftHash == h256{};
+            auto const& updated = isRight ? right : left;
+            auto child = updated ? *updated :
+                                   readNodeSync(depth + 1,
+                                       withPathBit(updates.front().path, depth, isRight));
+            if (child.type == NodeType::LEAF)
+            {
+                changes.emplace_back(nodePosition(depth + 1, child.first), Node{});
+                return child;
+            }
+        }
+        return Node{.type = NodeType::INTERNAL, .first = leftHash, .second = rightHash};
+    }
+
+    Node updateSubtree(
+        uint32_t depth, std::span<Update const> updates, bool exists, Changes& changes) const
+    {
+        auto const& anchor = updates.front().path;
+        auto existing = exists ? readNodeSync(depth, anchor) : Node{};
+
+        Node result;
+        if (existing.type == NodeType::INTERNAL)
+        {
+            result = updateInternal(depth, updates, existing, changes);
+        }
+        else
+        {
+            std::vector<Update> items;
+            items.reserve(updates.size() + 1);
+            auto existingUpdated = false;
+            for (auto const& update : updates)
+            {
+                if (existing.type == NodeType::LEAF && update.path == existing.first)
+                {
+                    existingUpdated = true;
+                }
+                if (update.valueHash)
+                {
+                    items.emplace_back(update);
+                }
+            }
+            if (existing.type == NodeType::LEAF && !existingUpdated)
+            {
+                auto it = std::lower_bound(items.begin(), items.end(), existing.first,
+                    [](Update const& lhs, h256 const& rhs) { return lhs.path < rhs; });
+                items.insert(it, Update{.path = existing.first, .valueHash = existing.second});
+            }
+            result = buildSubtree(depth, items, changes);
+        }
+
+        if (result != existing)
+        {
+            changes.emplace_back(nodePosition(depth, anchor), result);
+        }
+        return result;
+    }
+
+public:
+    StateTreeUpdater(Storage& storage, crypto::Hash const& hashImpl)
+      : m_storage(storage), m_hashImpl(hashImpl)
+    {}
+
+    // updates中的key不能重复 | Keys in updates must be unique
+    task::Task<h256> apply(std::vector<Update> updates)
+    {
+        if (updates.empty())
+        {
+            co_return nodeHash(co_await readNode(m_storage.get(), 0, h256{}), m_hashImpl.get());
+        }
+
+        std::sort(updates.begin(), updates.end(),
+            [](Update const& lhs, Update const& rhs) { return lhs.path < rhs.path; });
+        Changes changes;
+        auto root = updateSubtree(0, updates, true, changes);
+
+        for (auto& [position, node] : changes)
+        {
+            if (node.type == NodeType::EMPTY)
+            {
+                co_await storage2::removeOne(
+                    m_storage.get(), executor_v1::StateKey{SYS_STATE_TREE, position});
+            }
+            else
+            {
+                co_await storage2::writeOne(m_storage.get(),
+                    executor_v1::StateKey{SYS_STATE_TREE, position}, encodeEntry(node));
+            }
+        }
+        co_return nodeHash(root, m_hashImpl.get());
+    }
+};
+
+}  // namespace bcos::ledger::state_tree
@@ -0,0 +1,75 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bcos::storage2
+{
+
+// 按key的哈希值构建的布隆过滤器，mayContain返回false时key一定不存在
+// Bloom filter built over key hashes, a false mayContain means the key is definitely absent
+class BloomFilter
+{
+private:
+    // 每个key 10位、7个哈希函数，误判率约为1%
+    // 10 bits per key and 7 probes give a false positive rate around 1%
+    constexpr static size_t BITS_PER_KEY = 10;
+    constexpr static size_t HASH_COUNT = 7;
+    constexpr static size_t WORD_BITS = 64;
+
+    std::vector<uint64_t> m_words;
+    uint64_t m_mask = 0;
+
+    static uint64_t mix(uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    void forEachBit(size_t hash, auto&& func) const
+    {
+        auto first = mix(hash);
+        auto step = std::rotl(first, 32) | 1;
+        for (size_t i = 0; i < HASH_COUNT; ++i)
+        {
+            if (!func((first + i * step) & m_mask))
+            {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit BloomFilter(size_t keyCount)
+    {
+        auto bits = std::bit_ceil(std::max(WORD_BITS, keyCount * BITS_PER_KEY));
+        m_words.resize(bits / WORD_BITS);
+        m_mask = bits - 1;
+    }
+
+    void insert(size_t hash)
+    {
+        forEachBit(hash, [this](uint64_t bit) {
+            m_words[bit / WORD_BITS] |= (uint64_t(1) << (bit % WORD_BITS));
+            return true;
+        });
+    }
+
+    bool mayContain(size_t hash) const
+    {
+        bool contains = true;
+        forEachBit(hash, [&](uint64_t bit) {
+            contains = (m_words[bit / WORD_BITS] & (uint64_t(1) << (bit % WORD_BITS))) != 0;
+            return contains;
+        });
+        return contains;
+    }
+};
+
+}  // namespace bcos::storage2
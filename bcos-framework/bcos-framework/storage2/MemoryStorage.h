@@ -4,6 +4,7 @@
 #include "bcos-task/AwaitableValue.h"
 #include "bcos-utilities/Overloaded.h"
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_sort.h>
 #include <oneapi/tbb/rw_mutex.h>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/identity.hpp>
@@ -13,7 +14,11 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <atomic>
 #include <concepts>
+#include <iterator>
+#include <memory>
 #include <optional>
 #include <range/v3/view/chunk_by.hpp>
 #include <range/v3/view/transform.hpp>
@@ -51,13 +56,65 @@ struct Empty
 {
 };
 
+// The access frequency of a CLOCK entry, a hit only bumps it under the reader lock
+struct ClockFrequency
+{
+    constexpr static uint8_t MAX_FREQUENCY = 3;
+    mutable std::atomic_uint8_t m_frequency{0};
+
+    ClockFrequency() = default;
+    ClockFrequency(const ClockFrequency& other)
+      : m_frequency(other.m_frequency.load(std::memory_order_relaxed))
+    {}
+    ClockFrequency(ClockFrequency&& other) noexcept : ClockFrequency(std::as_const(other)) {}
+    ClockFrequency& operator=(const ClockFrequency& other)
+    {
+        m_frequency.store(
+            other.m_frequency.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+    ClockFrequency& operator=(ClockFrequency&& other) noexcept
+    {
+        return *this = std::as_const(other);
+    }
+    ~ClockFrequency() noexcept = default;
+
+    void touch() const
+    {
+        // a lost update between racing readers only costs one level, don't write hot entries
+        // which already saturated so they don't bounce their cache line between the readers
+        if (auto frequency = m_frequency.load(std::memory_order_relaxed);
+            frequency < MAX_FREQUENCY)
+        {
+            m_frequency.store(frequency + 1, std::memory_order_relaxed);
+        }
+    }
+    // called under the writer lock, false if the entry wasn't accessed since the last pass
+    bool decrease() const
+    {
+        auto frequency = m_frequency.load(std::memory_order_relaxed);
+        if (frequency == 0)
+        {
+            return false;
+        }
+        m_frequency.store(frequency - 1, std::memory_order_relaxed);
+        return true;
+    }
+};
+
 enum Attribute : uint8_t
 {
     UNORDERED = 0,
     ORDERED = 1,
     CONCURRENT = 1 << 1,
     LRU = 1 << 2,
-    LOGICAL_DELETION = 1 << 3
+    LOGICAL_DELETION = 1 << 3,
+    // CLOCK eviction: a hit only bumps the access frequency under the reader lock, a write
+    // evicts the entries not accessed again first so one-off scans don't flush the hot entries
+    CLOCK = 1 << 4,
+    // Hash indexed while written, freeze() sorts the entries once so range() still iterates in
+    // key order, for a layer written by many transactions and only iterated once it is frozen
+    SORT_ON_FREEZE = 1 << 5
 };
 
 template <class KeyType, class ValueType = Empty, uint8_t attribute = Attribute::UNORDERED,
@@ -70,6 +127,9 @@ public:
     constexpr static bool withConcurrent = (attribute & Attribute::CONCURRENT) != 0;
     constexpr static bool withLRU = (attribute & Attribute::LRU) != 0;
     constexpr static bool withLogicalDeletion = (attribute & Attribute::LOGICAL_DELETION) != 0;
+    constexpr static bool withClock = (attribute & Attribute::CLOCK) != 0;
+    constexpr static bool withCapacity = withLRU || withClock;
+    constexpr static bool withSortOnFreeze = (attribute & Attribute::SORT_ON_FREEZE) != 0;
 
     using Key = KeyType;
     using Value = ValueType;
@@ -81,7 +141,7 @@ public:
         {
             m_buckets = decltype(m_buckets)(buckets == 0 ? getBucketSize() : buckets);
         }
-        if constexpr (withLRU)
+        if constexpr (withCapacity)
         {
             m_maxCapacity = capacity;
         }
@@ -99,6 +159,8 @@ public:
 
     static_assert(withOrdered || !std::is_void_v<HasherType>);
     static_assert(!withConcurrent || !std::is_void_v<BucketHasherType>);
+    static_assert(!(withLRU && withClock));
+    static_assert(!withSortOnFreeze || (!withOrdered && !withConcurrent && !withCapacity));
 
     constexpr static unsigned DEFAULT_CAPACITY = 32 * 1024 * 1024;  // For mru
     using Mutex = std::conditional_t<withConcurrent, tbb::rw_mutex, Empty>;
@@ -124,6 +186,7 @@ public:
     {
         KeyType key;
         DataValue value;
+        [[no_unique_address]] std::conditional_t<withClock, ClockFrequency, Empty> frequency{};
     };
 
     using IndexType = std::conditional_t<withOrdered,
@@ -131,7 +194,7 @@ public:
             std::less<>>,
         boost::multi_index::hashed_unique<boost::multi_index::member<Data, KeyType, &Data::key>,
             HasherType, Equal>>;
-    using Container = std::conditional_t<withLRU,
+    using Container = std::conditional_t<withCapacity,
         boost::multi_index_container<Data,
             boost::multi_index::indexed_by<IndexType, boost::multi_index::sequenced<>>>,
         boost::multi_index_container<Data, boost::multi_index::indexed_by<IndexType>>>;
@@ -139,19 +202,112 @@ public:
     {
         Container container;
         [[no_unique_address]] Mutex mutex;  // For concurrent
-        [[no_unique_address]] std::conditional_t<withLRU, int64_t, Empty> capacity = {};  // LRU
+        [[no_unique_address]] std::conditional_t<withCapacity, int64_t, Empty> capacity =
+            {};  // LRU or CLOCK
     };
     using Buckets = std::conditional_t<withConcurrent, std::vector<Bucket>, std::array<Bucket, 1>>;
 
+    using SortedEntries = std::vector<const Data*>;
+    // The entries sorted by freeze(), they point into the nodes of this storage so a copy doesn't
+    // keep them
+    struct FrozenEntries
+    {
+        std::shared_ptr<const SortedEntries> entries;
+        // the keys inserted after freeze(), merged into entries instead of sorting them all again
+        SortedEntries inserted;
+        // the times all the entries were sorted
+        mutable std::atomic_size_t sorts{0};
+
+        FrozenEntries() = default;
+        FrozenEntries(const FrozenEntries& /*unused*/) {}
+        FrozenEntries(FrozenEntries&& frozen) noexcept
+          : entries(std::move(frozen.entries)),
+            inserted(std::move(frozen.inserted)),
+            sorts(frozen.sorts.load())
+        {}
+        FrozenEntries& operator=(const FrozenEntries& /*unused*/)
+        {
+            reset();
+            return *this;
+        }
+        FrozenEntries& operator=(FrozenEntries&& frozen) noexcept
+        {
+            entries = std::move(frozen.entries);
+            inserted = std::move(frozen.inserted);
+            sorts = frozen.sorts.load();
+            return *this;
+        }
+        ~FrozenEntries() noexcept = default;
+
+        void reset()
+        {
+            entries.reset();
+            inserted.clear();
+        }
+    };
+
     Buckets m_buckets;
-    [[no_unique_address]] std::conditional_t<withLRU, int64_t, Empty> m_maxCapacity;
+    [[no_unique_address]] std::conditional_t<withCapacity, int64_t, Empty> m_maxCapacity;
+    [[no_unique_address]] std::conditional_t<withSortOnFreeze, FrozenEntries, Empty> m_frozen;
 
     void setMaxCapacity(int64_t capacity)
-        requires withLRU
+        requires withCapacity
     {
         m_maxCapacity = capacity;
     }
 
+    std::shared_ptr<const SortedEntries> sortedEntries() const
+        requires withSortOnFreeze
+    {
+        auto less = [](const Data* lhs, const Data* rhs) {
+            return std::less<>{}(lhs->key, rhs->key);
+        };
+        if (m_frozen.entries && m_frozen.inserted.empty())
+        {
+            return m_frozen.entries;
+        }
+        auto entries = std::make_shared<SortedEntries>();
+        if (m_frozen.entries)
+        {  // only the keys inserted since are sorted, then merged with the frozen ones
+            auto inserted = m_frozen.inserted;
+            std::sort(inserted.begin(), inserted.end(), less);
+            entries->reserve(m_frozen.entries->size() + inserted.size());
+            std::merge(m_frozen.entries->begin(), m_frozen.entries->end(), inserted.begin(),
+                inserted.end(), std::back_inserter(*entries), less);
+            return entries;
+        }
+        auto const& container = m_buckets[0].container;
+        entries->reserve(container.size());
+        for (auto const& data : container)
+        {
+            entries->emplace_back(std::addressof(data));
+        }
+        tbb::parallel_sort(entries->begin(), entries->end(), less);
+        ++m_frozen.sorts;
+        return entries;
+    }
+
+    // Sort the entries once the storage stops taking writes, every range() then shares them. The
+    // keys inserted afterwards are merged in by range() and the next freeze(), an erase drops
+    // the sorted entries and range() sorts all of them again.
+    void freeze()
+        requires withSortOnFreeze
+    {
+        m_frozen.entries = sortedEntries();
+        m_frozen.inserted.clear();
+    }
+    bool frozen() const
+        requires withSortOnFreeze
+    {
+        return m_frozen.entries != nullptr && m_frozen.inserted.empty();
+    }
+    // the times all the entries of the storage were sorted
+    size_t sortCount() const
+        requires withSortOnFreeze
+    {
+        return m_frozen.sorts.load();
+    }
+
     size_t getBucketIndex(auto const& key)
     {
         if constexpr (!withConcurrent)
@@ -194,6 +350,25 @@ public:
         }
     }
 
+    // New entries queue at the back, the front entry moves to the back with a lower frequency if
+    // it was accessed, otherwise it is evicted
+    void evictClock(Bucket& bucket)
+        requires withClock
+    {
+        auto& index = bucket.container.template get<1>();
+        while (bucket.capacity > m_maxCapacity && !bucket.container.empty())
+        {
+            auto const& item = index.front();
+            if (item.frequency.decrease())
+            {
+                index.relocate(index.end(), index.begin());
+                continue;
+            }
+            bucket.capacity -= (getSize(item.key) + getSize(item.value));
+            index.pop_front();
+        }
+    }
+
     auto readOneRaw(const auto& key, auto&&... /*args*/) -> task::Task<DataValue>
     {
         auto& bucket = this->getBucket(key);
@@ -209,6 +384,10 @@ public:
                     updateLRUAndCheck(bucket, it);
                 }
             }
+            if constexpr (withClock)
+            {
+                it->frequency.touch();
+            }
             co_return it->value;
         }
         co_return DataValue{};
@@ -272,24 +451,32 @@ public:
             if (!deleteOP || (withLogicalDeletion && !ignoreLogicalDeletion))
             {
                 bucket.container.modify(it, [&](Data& data) mutable {
-                    if constexpr (withLRU)
+                    if constexpr (withCapacity)
                     {
                         updatedCapacity = getSize(data.value);
                     }
                     data.value.template emplace<decltype(value)>(std::move(value));
-                    if constexpr (withLRU)
+                    if constexpr (withCapacity)
                     {
                         updatedCapacity = getSize(data.value) - updatedCapacity;
                     }
                 });
+                if constexpr (withClock)
+                {
+                    it->frequency.touch();
+                }
             }
             else
             {
-                if constexpr (withLRU)
+                if constexpr (withCapacity)
                 {
                     updatedCapacity = -(getSize(it->key) + getSize(it->value));
                 }
                 it = bucket.container.erase(it);
+                if constexpr (withSortOnFreeze)
+                {
+                    m_frozen.reset();
+                }
             }
         }
         else
@@ -298,10 +485,17 @@ public:
             {
                 it = bucket.container.emplace_hint(
                     it, Data{.key = Key{std::move(key)}, .value = {std::move(value)}});
-                if constexpr (withLRU)
+                if constexpr (withCapacity)
                 {
                     updatedCapacity = getSize(it->key) + getSize(it->value);
                 }
+                if constexpr (withSortOnFreeze)
+                {
+                    if (m_frozen.entries)
+                    {
+                        m_frozen.inserted.emplace_back(std::addressof(*it));
+                    }
+                }
             }
         }
 
@@ -310,6 +504,11 @@ public:
             bucket.capacity += updatedCapacity;
             updateLRUAndCheck(bucket, it);
         }
+        if constexpr (withClock)
+        {
+            bucket.capacity += updatedCapacity;
+            evictClock(bucket);
+        }
         return !found;
     }
 
@@ -462,6 +661,11 @@ public:
     task::AwaitableValue<void> merge(MemoryStorage& fromStorage)
         requires(!std::is_const_v<decltype(fromStorage)>)
     {
+        if constexpr (withSortOnFreeze)
+        {
+            m_frozen.reset();
+            fromStorage.m_frozen.reset();
+        }
         for (auto&& [bucket, fromBucket] : ::ranges::views::zip(m_buckets, fromStorage.m_buckets))
         {
             Lock toLock(bucket.mutex, true);
@@ -540,16 +744,67 @@ public:
         }
     };
 
-    auto range() { return task::AwaitableValue(Iterator(m_buckets)); }
+    class SortedIterator
+    {
+    private:
+        std::shared_ptr<const SortedEntries> m_entries;
+        typename SortedEntries::const_iterator m_it;
+
+    public:
+        explicit SortedIterator(std::shared_ptr<const SortedEntries> entries)
+          : m_entries(std::move(entries)), m_it(m_entries->begin())
+        {}
+
+        auto next()
+        {
+            std::optional<std::tuple<Key const&, DataValue const&>> result;
+            if (m_it != m_entries->end())
+            {
+                auto const& data = **m_it;
+                result.emplace(std::make_tuple(std::cref(data.key), std::cref(data.value)));
+                ++m_it;
+            }
+            return task::AwaitableValue(std::move(result));
+        }
+
+        void seek(const auto& key)
+        {
+            m_it = std::lower_bound(m_entries->begin(), m_entries->end(), key,
+                [](const Data* data, auto const& target) {
+                    return std::less<>{}(data->key, target);
+                });
+        }
+    };
+
+    auto range()
+    {
+        if constexpr (withSortOnFreeze)
+        {
+            return task::AwaitableValue(SortedIterator(sortedEntries()));
+        }
+        else
+        {
+            return task::AwaitableValue(Iterator(m_buckets));
+        }
+    }
 
     auto range(RANGE_SEEK_TYPE /*unused*/, const auto& key)
         // TODO: need !withConcurrent, fix benchmarkScheduler
         // requires(!withConcurrent && withOrdered)
-        requires withOrdered
+        requires(withOrdered || withSortOnFreeze)
     {
-        auto iterator = Iterator(m_buckets);
-        iterator.seek(key);
-        return task::AwaitableValue(std::move(iterator));
+        if constexpr (withSortOnFreeze)
+        {
+            auto iterator = SortedIterator(sortedEntries());
+            iterator.seek(key);
+            return task::AwaitableValue(std::move(iterator));
+        }
+        else
+        {
+            auto iterator = Iterator(m_buckets);
+            iterator.seek(key);
+            return task::AwaitableValue(std::move(iterator));
+        }
     }
 
     void mergeConcurrent(MemoryStorage& toStorage)
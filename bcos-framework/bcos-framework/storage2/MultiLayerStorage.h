@@ -1,4 +1,5 @@
 #pragma once
+#include "BloomFilter.h"
 #include "Storage.h"
 #include "bcos-task/TBBWait.h"
 #include "bcos-task/Trait.h"
@@ -7,8 +8,13 @@
 #include "bcos-utilities/Overloaded.h"
 #include <oneapi/tbb/parallel_invoke.h>
 #include <boost/throw_exception.hpp>
+#include <atomic>
+#include <chrono>
 #include <concepts>
 #include <functional>
+#include <memory>
+#include <range/v3/algorithm/none_of.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/map.hpp>
 #include <range/v3/view/zip.hpp>
@@ -84,6 +90,36 @@ task::Task<bool> fillMissingValues(
     co_return count == gotSize;
 }
 
+template <class MutableStorageType>
+struct ImmutableLayer
+{
+    std::shared_ptr<MutableStorageType> storage;
+    // 冻结时构建的key过滤器，为空时不过滤 | Key filter built when frozen, null disables filtering
+    std::shared_ptr<const BloomFilter> filter;
+    // 该层覆盖的区块数，合并后的层大于1 | Number of blocks the layer covers, above 1 once compacted
+    size_t blocks = 1;
+
+    bool mayContain(size_t hash) const { return !filter || filter->mayContain(hash); }
+};
+
+// 不可变层的读取统计，用于调整过滤器和待提交区块的层数
+// Read statistics of the immutable layers, for tuning the filters and the number of pending layers
+struct LayerReadStatistics
+{
+    std::atomic_uint64_t reads;           // 到达不可变层的单key读取 | Single key reads
+    std::atomic_uint64_t layerProbes;     // 实际读取的层数 | Layers actually read
+    std::atomic_uint64_t filterSkips;     // 被过滤器跳过的层数 | Layers skipped by the filter
+    std::atomic_uint64_t falsePositives;  // 过滤器误判的层数 | Layers read without the key
+};
+
+struct LayerCompactionStatistics
+{
+    std::atomic_uint64_t compactions;             // 完成的合并 | Installed compactions
+    std::atomic_uint64_t abortedCompactions;      // 被放弃的合并 | Compactions lost to races
+    std::atomic_uint64_t compactedLayers;         // 被合并的层数 | Layers folded together
+    std::atomic_uint64_t compactionMicroseconds;  // 合并耗时 | Time spent compacting
+};
+
 template <class MutableStorageType, class CachedStorage, class BackendStorageType>
     requires((std::is_void_v<CachedStorage> || (!std::is_void_v<CachedStorage>)))
 class View
@@ -96,7 +132,8 @@ public:
     using BackendStorage = BackendStorageType;
 
     std::shared_ptr<MutableStorageType> m_mutableStorage;
-    std::deque<std::shared_ptr<MutableStorageType>> m_immutableStorages;
+    std::deque<ImmutableLayer<MutableStorageType>> m_immutableStorages;
+    LayerReadStatistics* m_statistics = nullptr;
     std::reference_wrapper<std::remove_reference_t<BackendStorage>> m_backendStorage;
     [[no_unique_address]] std::conditional_t<withCacheStorage,
         std::reference_wrapper<std::remove_reference_t<CachedStorage>>, std::monostate>
@@ -120,6 +157,21 @@ public:
     View& operator=(View&&) noexcept = default;
     ~View() noexcept = default;
 
+    void recordRead(uint64_t probes, uint64_t skips, uint64_t falsePositives, bool singleKey)
+    {
+        if (m_statistics == nullptr)
+        {
+            return;
+        }
+        if (singleKey)
+        {
+            m_statistics->reads.fetch_add(1, std::memory_order_relaxed);
+            m_statistics->falsePositives.fetch_add(falsePositives, std::memory_order_relaxed);
+        }
+        m_statistics->layerProbes.fetch_add(probes, std::memory_order_relaxed);
+        m_statistics->filterSkips.fetch_add(skips, std::memory_order_relaxed);
+    }
+
     friend MutableStorage& mutableStorage(View& storage)
     {
         if (!storage.m_mutableStorage)
@@ -142,13 +194,36 @@ public:
             co_return values;
         }
 
-        for (auto& immutableStorage : m_immutableStorages)
+        if (!m_immutableStorages.empty())
         {
-            if (co_await fillMissingValues<typename View::Key, typename View::Value>(
-                    *immutableStorage, keys, values))
+            auto hashes = ::ranges::views::transform(keys,
+                              [](auto const& key) { return std::hash<Key>{}(key); }) |
+                          ::ranges::to<std::vector>();
+            uint64_t probes = 0;
+            uint64_t skips = 0;
+            for (auto& layer : m_immutableStorages)
             {
-                co_return values;
+                // 所有未找到的key都被过滤器排除时跳过该层
+                // Skip the layer when its filter rules out every key still missing
+                if (::ranges::none_of(::ranges::views::zip(hashes, values), [&](auto const& item) {
+                        auto const& [hash, value] = item;
+                        return std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value) &&
+                               layer.mayContain(hash);
+                    }))
+                {
+                    ++skips;
+                    continue;
+                }
+
+                ++probes;
+                if (co_await fillMissingValues<typename View::Key, typename View::Value>(
+                        *layer.storage, keys, values))
+                {
+                    recordRead(probes, skips, 0, false);
+                    co_return values;
+                }
             }
+            recordRead(probes, skips, 0, false);
         }
 
         if constexpr (withCacheStorage)
@@ -177,7 +252,7 @@ public:
 
         for (auto& immutableStorage : m_immutableStorages)
         {
-            co_return co_await immutableStorage->readSomeRaw(std::move(keys));
+            co_return co_await immutableStorage.storage->readSomeRaw(std::move(keys));
         }
 
         if constexpr (withCacheStorage)
@@ -199,13 +274,27 @@ public:
             }
         }
 
-        for (auto& immutableStorage : m_immutableStorages)
+        if (!m_immutableStorages.empty())
         {
-            if (auto value = co_await immutableStorage->readOneRaw(key);
-                !std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value))
+            auto hash = std::hash<Key>{}(key);
+            uint64_t probes = 0;
+            uint64_t skips = 0;
+            for (auto& layer : m_immutableStorages)
             {
-                co_return value;
+                if (!layer.mayContain(hash))
+                {
+                    ++skips;
+                    continue;
+                }
+                ++probes;
+                if (auto value = co_await layer.storage->readOneRaw(key);
+                    !std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value))
+                {
+                    recordRead(probes, skips, probes - 1, true);
+                    co_return value;
+                }
             }
+            recordRead(probes, skips, probes, true);
         }
 
         if constexpr (withCacheStorage)
@@ -230,7 +319,7 @@ public:
 
         for (auto& immutableStorage : m_immutableStorages)
         {
-            co_return co_await immutableStorage->readOneRaw(key);
+            co_return co_await immutableStorage.storage->readOneRaw(key);
         }
 
         if constexpr (withCacheStorage)
@@ -266,13 +355,27 @@ public:
             }
         }
 
-        for (auto& immutableStorage : m_immutableStorages)
+        if (!m_immutableStorages.empty())
         {
-            if (auto value = co_await immutableStorage->readOneRaw(key);
-                !std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value))
+            auto hash = std::hash<Key>{}(key);
+            uint64_t probes = 0;
+            uint64_t skips = 0;
+            for (auto& layer : m_immutableStorages)
             {
-                co_return getValue<Value>(value);
+                if (!layer.mayContain(hash))
+                {
+                    ++skips;
+                    continue;
+                }
+                ++probes;
+                if (auto value = co_await layer.storage->readOneRaw(key);
+                    !std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value))
+                {
+                    recordRead(probes, skips, probes - 1, true);
+                    co_return getValue<Value>(value);
+                }
             }
+            recordRead(probes, skips, probes, true);
         }
 
         if constexpr (withCacheStorage)
@@ -351,10 +454,10 @@ public:
                                              std::forward<decltype(args)>(args)...),
                     RangeValue{});
             }
-            for (auto& storage : view.m_immutableStorages)
+            for (auto& layer : view.m_immutableStorages)
             {
-                m_iterators.emplace_back(
-                    co_await storage2::range(*storage, std::forward<decltype(args)>(args)...),
+                m_iterators.emplace_back(co_await storage2::range(*layer.storage,
+                                             std::forward<decltype(args)>(args)...),
                     RangeValue{});
             }
             m_iterators.emplace_back(co_await storage2::range(view.m_backendStorage.get(),
@@ -437,9 +540,17 @@ public:
     using ValueType = std::remove_cvref_t<typename MutableStorageType::Value>;
     using ViewType = View<MutableStorageType, CachedStorage, BackendStorage>;
 
-    std::deque<std::shared_ptr<MutableStorageType>> m_storages;
+    // m_storages每个区块一层，用于提交和回滚；m_readLayers是fork看到的层，相邻的旧层可被合并成一层
+    // m_storages keeps one layer per block for commit and rollback, m_readLayers is what fork()
+    // hands out, where adjacent old layers may be compacted into one
+    std::deque<ImmutableLayer<MutableStorageType>> m_storages;
+    std::deque<ImmutableLayer<MutableStorageType>> m_readLayers;
+    std::unique_ptr<LayerReadStatistics> m_statistics = std::make_unique<LayerReadStatistics>();
+    std::unique_ptr<LayerCompactionStatistics> m_compactionStatistics =
+        std::make_unique<LayerCompactionStatistics>();
     std::mutex m_listMutex;
     std::mutex m_mergeMutex;
+    std::mutex m_compactMutex;
 
     std::reference_wrapper<std::remove_reference_t<BackendStorage>> m_backendStorage;
     [[no_unique_address]] std::conditional_t<withCacheStorage,
@@ -476,19 +587,48 @@ public:
     MultiLayerStorage& operator=(MultiLayerStorage&&) noexcept = default;
     ~MultiLayerStorage() noexcept = default;
 
+    static std::shared_ptr<const BloomFilter> buildFilter(MutableStorage& storage)
+    {
+        std::vector<size_t> hashes;
+        auto range = task::tbb::syncWait(storage2::range(storage));
+        while (auto keyValue = task::tbb::syncWait(range.next()))
+        {
+            hashes.emplace_back(std::hash<Key>{}(std::get<0>(*keyValue)));
+        }
+
+        auto filter = std::make_shared<BloomFilter>(hashes.size());
+        for (auto hash : hashes)
+        {
+            filter->insert(hash);
+        }
+        return filter;
+    }
+
+    // 层变为只读时排序一次，之后的range()共享排好序的条目
+    // Sort a layer once it turns read only, every range() afterwards shares the sorted entries
+    static void freeze(MutableStorage& storage)
+    {
+        if constexpr (MutableStorage::withSortOnFreeze)
+        {
+            storage.freeze();
+        }
+    }
+
     ViewType fork()
     {
         std::unique_lock lock(m_listMutex);
         if constexpr (withCacheStorage)
         {
             ViewType view(m_backendStorage, m_cacheStorage);
-            view.m_immutableStorages = m_storages;
+            view.m_immutableStorages = m_readLayers;
+            view.m_statistics = m_statistics.get();
             return view;
         }
         else
         {
             ViewType view(m_backendStorage);
-            view.m_immutableStorages = m_storages;
+            view.m_immutableStorages = m_readLayers;
+            view.m_statistics = m_statistics.get();
             return view;
         }
     }
@@ -499,8 +639,15 @@ public:
         {
             return;
         }
+        // 在加锁前冻结并构建过滤器，被删除的key同样加入，因为删除标记会遮盖更旧的层
+        // Freeze and build the filter before locking, deleted keys are included as well since
+        // their deletion marks shadow the older layers
+        freeze(*view.m_mutableStorage);
+        auto filter = buildFilter(*view.m_mutableStorage);
         std::unique_lock lock(m_listMutex);
-        m_storages.push_front(std::move(view.m_mutableStorage));
+        m_storages.push_front({.storage = std::move(view.m_mutableStorage),
+            .filter = std::move(filter)});
+        m_readLayers.push_front(m_storages.front());
     }
 
     void popFrontStorage()
@@ -509,7 +656,122 @@ public:
         if (!m_storages.empty())
         {
             m_storages.pop_front();
+
+            // 被回滚的区块在合并层中时，把合并层拆回剩余区块各自的层
+            // When the rolled back block lives in a compacted layer, split it back into the
+            // layers of its remaining blocks
+            auto blocks = m_readLayers.front().blocks;
+            m_readLayers.pop_front();
+            for (auto i = blocks - 1; i > 0; --i)
+            {
+                m_readLayers.push_front(m_storages[i - 1]);
+            }
+        }
+    }
+
+    /**
+     * @brief 把最旧的若干相邻读取层合并为一层，使读取深度不超过maxDepth；每个区块的层仍保留用于
+     * mergeBackStorage和popFrontStorage，合并期间层发生变化时放弃本次合并
+     * Compact the oldest adjacent read layers into one so the read depth stays within maxDepth.
+     * The per block layers are kept for mergeBackStorage and popFrontStorage, and the compaction
+     * is dropped if the layers change while it runs.
+     *
+     * @return whether a compacted layer was installed
+     */
+    task::Task<bool> compactLayers(size_t maxDepth)
+    {
+        std::unique_lock compactLock(m_compactMutex, std::try_to_lock);
+        if (!compactLock.owns_lock() || maxDepth == 0)
+        {
+            co_return false;
+        }
+
+        std::unique_lock listLock(m_listMutex);
+        if (m_readLayers.size() <= maxDepth)
+        {
+            co_return false;
+        }
+        auto count = m_readLayers.size() - maxDepth + 1;
+        std::vector<ImmutableLayer<MutableStorageType>> layers(
+            m_readLayers.end() - static_cast<int64_t>(count), m_readLayers.end());
+        listLock.unlock();
+
+        ittapi::Report report(ittapi::ITT_DOMAINS::instance().STORAGE2,
+            ittapi::ITT_DOMAINS::instance().COMPACT_LAYERS);
+        auto startTime = std::chrono::steady_clock::now();
+
+        // 从新到旧复制，已复制的key不再被更旧的层覆盖；删除标记同样保留
+        // Copy from newest to oldest so older layers never overwrite a copied key, deletion marks
+        // are kept as well
+        auto compacted = std::make_shared<MutableStorage>();
+        for (auto& layer : layers)
+        {
+            auto range = co_await storage2::range(*layer.storage);
+            while (auto keyValue = co_await range.next())
+            {
+                auto&& [key, value] = *keyValue;
+                if (!std::holds_alternative<storage2::NOT_EXISTS_TYPE>(
+                        co_await compacted->readOneRaw(key)))
+                {
+                    continue;
+                }
+                if (auto* entry = std::get_if<Value>(std::addressof(value)))
+                {
+                    co_await storage2::writeOne(*compacted, Key(key), *entry);
+                }
+                else
+                {
+                    co_await storage2::removeOne(*compacted, Key(key));
+                }
+            }
+        }
+        freeze(*compacted);
+        auto filter = buildFilter(*compacted);
+
+        listLock.lock();
+        // mergeBackStorage可能已减少最旧层覆盖的区块数，只要各层仍在原位即可安装
+        // mergeBackStorage may have shrunk the block count of the oldest layer meanwhile, the
+        // result is still valid as long as every layer is in place
+        auto installed = m_readLayers.size() >= count &&
+                         std::equal(layers.begin(), layers.end(),
+                             m_readLayers.end() - static_cast<int64_t>(count),
+                             [](auto const& lhs, auto const& rhs) {
+                                 return lhs.storage == rhs.storage;
+                             });
+        if (installed)
+        {
+            size_t blocks = 0;
+            for (auto i = 0U; i < count; ++i)
+            {
+                blocks += m_readLayers.back().blocks;
+                m_readLayers.pop_back();
+            }
+            m_readLayers.push_back(
+                {.storage = std::move(compacted), .filter = std::move(filter), .blocks = blocks});
+        }
+        listLock.unlock();
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        auto& statistics = *m_compactionStatistics;
+        if (installed)
+        {
+            statistics.compactions.fetch_add(1, std::memory_order_relaxed);
+            statistics.compactedLayers.fetch_add(count, std::memory_order_relaxed);
+        }
+        else
+        {
+            statistics.abortedCompactions.fetch_add(1, std::memory_order_relaxed);
         }
+        statistics.compactionMicroseconds.fetch_add(
+            elapsed.count(), std::memory_order_relaxed);
+        co_return installed;
+    }
+
+    size_t layerDepth()
+    {
+        std::unique_lock lock(m_listMutex);
+        return m_readLayers.size();
     }
 
     task::Task<std::shared_ptr<MutableStorage>> mergeBackStorage(auto&... extraStorages)
@@ -520,7 +782,7 @@ public:
         {
             BOOST_THROW_EXCEPTION(NotExistsImmutableStorageError{});
         }
-        auto backStoragePtr = m_storages.back();
+        auto backStoragePtr = m_storages.back().storage;
         auto& backStorage = *backStoragePtr;
         listLock.unlock();
 
@@ -549,11 +811,27 @@ public:
 
         listLock.lock();
         m_storages.pop_back();
+        if (auto& backLayer = m_readLayers.back(); backLayer.blocks > 1)
+        {
+            // 合并层中已提交区块的数据与后端一致，继续保留到该层的区块全部提交
+            // The committed block's data in a compacted layer matches the backend, keep the
+            // layer until all its blocks are committed
+            --backLayer.blocks;
+        }
+        else
+        {
+            m_readLayers.pop_back();
+        }
 
         co_return backStoragePtr;
     }
 
     BackendStorage& backendStorage() { return m_backendStorage; }
+    LayerReadStatistics const& readStatistics() const { return *m_statistics; }
+    LayerCompactionStatistics const& compactionStatistics() const
+    {
+        return *m_compactionStatistics;
+    }
 };
 
 }  // namespace bcos::storage2
@@ -2,10 +2,19 @@
 #include "../storage/Entry.h"
 #include "bcos-utilities/Exceptions.h"
 #include "bcos-utilities/ThreeWay4Apple.h"
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <compare>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace bcos::executor_v1
 {
@@ -14,44 +23,213 @@ DERIVE_BCOS_EXCEPTION(NoTableSpliterError);
 using StateValue = storage::Entry;
 class StateKeyView;
 
-class StateKey
+// A table name with its hash, shared by the keys of the table. The contract tables a node touches
+// are few compared to the keys read and written in them, so the names are interned while keys of
+// them are alive
+class InternedTable
 {
 public:
-    std::string m_tableAndKey;
-    size_t m_split{};
+    InternedTable(std::string_view name, bool interned, bool immortal = false)
+      : m_name(name),
+        m_hash(std::hash<std::string_view>{}(m_name)),
+        m_interned(interned),
+        m_immortal(immortal)
+    {}
+    InternedTable(const InternedTable&) = delete;
+    InternedTable(InternedTable&&) = delete;
+    InternedTable& operator=(const InternedTable&) = delete;
+    InternedTable& operator=(InternedTable&&) = delete;
+    ~InternedTable() noexcept = default;
+
+    std::string_view name() const noexcept { return m_name; }
+    size_t hash() const noexcept { return m_hash; }
+    // an interned table is the only InternedTable of its name, others are kept by their keys only
+    bool interned() const noexcept { return m_interned; }
+    uint32_t references() const noexcept { return m_references.load(std::memory_order_acquire); }
 
-    StateKey() = default;
-    StateKey(std::string_view table, std::string_view key) : m_split(table.size())
+    // an immortal table is not counted, keys of it are moved and copied from every thread
+    friend void intrusive_ptr_add_ref(InternedTable const* table) noexcept
     {
-        m_tableAndKey.reserve(table.size() + 1 + key.size());
-        m_tableAndKey.append(table);
-        m_tableAndKey.push_back(':');
-        m_tableAndKey.append(key);
+        if (!table->m_immortal)
+        {
+            table->m_references.fetch_add(1, std::memory_order_relaxed);
+        }
     }
-    explicit StateKey(std::string tableAndKey)
-      : m_tableAndKey(std::move(tableAndKey)), m_split(m_tableAndKey.find_first_of(':'))
+    friend void intrusive_ptr_release(InternedTable const* table) noexcept
     {
-        if (m_split == std::string::npos)
+        if (!table->m_immortal && table->m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
         {
-            throwTrace(NoTableSpliterError());
+            delete table;
+        }
+    }
+
+private:
+    std::string m_name;
+    size_t m_hash;
+    bool m_interned;
+    bool m_immortal;
+    mutable std::atomic_uint32_t m_references{0};
+};
+using InternedTablePtr = boost::intrusive_ptr<const InternedTable>;
+
+// about 10MB of names at most
+constexpr static size_t MAX_INTERNED_TABLES = 1 << 16;
+
+// The interned tables by name. The table holds a reference to each of them, a full table evicts
+// the ones no key references any more, and names that still don't fit get a table of their own
+class InternedTables
+{
+public:
+    static InternedTables& instance()
+    {
+        static InternedTables tables;
+        return tables;
+    }
+
+    InternedTablePtr intern(std::string_view name)
+    {
+        {
+            std::shared_lock lock(m_mutex);
+            if (auto it = m_tables.find(name); it != m_tables.end())
+            {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(m_mutex);
+        if (auto it = m_tables.find(name); it != m_tables.end())
+        {
+            return it->second;
         }
+        if (m_tables.size() >= MAX_INTERNED_TABLES)
+        {
+            evictNoLock();
+        }
+        if (m_tables.size() >= MAX_INTERNED_TABLES)
+        {
+            return InternedTablePtr(new InternedTable(name, false));
+        }
+        InternedTablePtr table(new InternedTable(name, true));
+        m_tables.emplace(table->name(), table);
+        return table;
+    }
+
+    size_t size() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_tables.size();
+    }
+
+private:
+    // A reference is only taken from the table under its lock or copied from a key, so a table
+    // referenced by the table alone stays unreferenced while the lock is held
+    void evictNoLock()
+    {
+        // a table full of live tables is only scanned again after a quarter of it is created
+        if (m_skippedEvictions > 0)
+        {
+            --m_skippedEvictions;
+            return;
+        }
+        std::erase_if(m_tables, [](auto const& entry) { return entry.second->references() == 1; });
+        if (m_tables.size() > MAX_INTERNED_TABLES / 4 * 3)
+        {
+            m_skippedEvictions = MAX_INTERNED_TABLES / 4;
+        }
+    }
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<std::string_view, InternedTablePtr> m_tables;
+    size_t m_skippedEvictions = 0;
+};
+
+inline InternedTablePtr internTable(std::string_view table)
+{
+    // consecutive keys usually belong to the same contract
+    thread_local InternedTablePtr lastTable;
+    if (lastTable && lastTable->name() == table)
+    {
+        return lastTable;
     }
+    lastTable = InternedTables::instance().intern(table);
+    return lastTable;
+}
+
+class StateKey
+{
+public:
+    // storage slots are 32 bytes, keys up to that size are kept inline
+    constexpr static size_t INLINE_KEY_SIZE = 32;
+    using KeyBuffer = boost::container::small_vector<char, INLINE_KEY_SIZE>;
+
+    // never null, a moved from key is left with the empty table
+    InternedTablePtr m_table;
+    KeyBuffer m_key;
+
+    StateKey() : m_table(emptyTable()) {}
+    StateKey(std::string_view table, std::string_view key)
+      : m_table(internTable(table)), m_key(key.begin(), key.end())
+    {}
+    // "<table>:<key>", the encoding of the key in the backend storage
+    explicit StateKey(std::string_view tableAndKey)
+      : StateKey(tableOf(tableAndKey), tableAndKey.substr(tableOf(tableAndKey).size() + 1))
+    {}
     explicit StateKey(StateKeyView const& view);
 
     StateKey(const StateKey&) = default;
-    StateKey(StateKey&&) noexcept = default;
+    StateKey(StateKey&& stateKey) noexcept
+      : m_table(emptyTable()), m_key(std::move(stateKey.m_key))
+    {
+        m_table.swap(stateKey.m_table);
+    }
     StateKey& operator=(const StateKey&) = default;
-    StateKey& operator=(StateKey&&) noexcept = default;
+    StateKey& operator=(StateKey&& stateKey) noexcept
+    {
+        m_table.swap(stateKey.m_table);
+        m_key = std::move(stateKey.m_key);
+        return *this;
+    }
     ~StateKey() noexcept = default;
 
+    static std::string_view tableOf(std::string_view tableAndKey)
+    {
+        auto split = tableAndKey.find_first_of(':');
+        if (split == std::string_view::npos)
+        {
+            throwTrace(NoTableSpliterError());
+        }
+        return tableAndKey.substr(0, split);
+    }
+    static InternedTablePtr const& emptyTable()
+    {
+        static const InternedTablePtr table(new InternedTable({}, false, true));
+        return table;
+    }
+
+    std::string_view table() const noexcept { return m_table->name(); }
+    std::string_view key() const noexcept { return {m_key.data(), m_key.size()}; }
+    std::string encode() const
+    {
+        std::string tableAndKey;
+        tableAndKey.reserve(table().size() + 1 + m_key.size());
+        tableAndKey.append(table());
+        tableAndKey.push_back(':');
+        tableAndKey.append(key());
+        return tableAndKey;
+    }
+
+    size_t hash() const noexcept
+    {
+        auto result = m_table->hash();
+        boost::hash_combine(result, std::hash<std::string_view>{}(key()));
+        return result;
+    }
+
     friend ::std::ostream& operator<<(
         ::std::ostream& stream, const bcos::executor_v1::StateKey& stateKey)
     {
-        stream << stateKey.m_tableAndKey;
+        stream << stateKey.table() << ":" << stateKey.key();
         return stream;
     }
-    const char* data() const& noexcept { return m_tableAndKey.data(); }
-    size_t size() const noexcept { return m_tableAndKey.size(); }
 };
 
 class StateKeyView
@@ -66,8 +244,7 @@ public:
     StateKeyView& operator=(StateKeyView&&) noexcept = default;
     StateKeyView(const StateKeyView& stateKeyView) noexcept = default;
     explicit StateKeyView(const StateKey& stateKey) noexcept
-      : m_table(stateKey.data(), stateKey.m_split),
-        m_key(stateKey.data() + stateKey.m_split + 1, stateKey.size() - stateKey.m_split - 1)
+      : m_table(stateKey.table()), m_key(stateKey.key())
     {}
     StateKeyView(std::string_view table, std::string_view key) noexcept : m_table(table), m_key(key)
     {}
@@ -80,6 +257,7 @@ public:
         return stream;
     }
 
+    // the same as StateKey::hash() for the same table and key
     size_t hash() const noexcept
     {
         auto result = std::hash<std::string_view>{}(m_table);
@@ -94,13 +272,26 @@ inline StateKey::StateKey(StateKeyView const& view) : StateKey(view.m_table, vie
 
 inline std::strong_ordering operator<=>(const StateKey& lhs, const StateKey& rhs) noexcept
 {
+    if (lhs.m_table == rhs.m_table)
+    {
+        return lhs.key() <=> rhs.key();
+    }
     auto lhsView = bcos::executor_v1::StateKeyView{lhs};
     auto rhsView = bcos::executor_v1::StateKeyView{rhs};
     return lhsView <=> rhsView;
 }
 inline bool operator==(const StateKey& lhs, const StateKey& rhs) noexcept
 {
-    return std::is_eq(lhs <=> rhs);
+    if (lhs.m_table == rhs.m_table)
+    {
+        return lhs.key() == rhs.key();
+    }
+    // different interned tables have different names
+    if (lhs.m_table->interned() && rhs.m_table->interned())
+    {
+        return false;
+    }
+    return lhs.table() == rhs.table() && lhs.key() == rhs.key();
 }
 
 inline std::strong_ordering operator<=>(
@@ -143,8 +334,16 @@ struct std::hash<bcos::executor_v1::StateKey>
 {
     size_t operator()(const auto& stateKey) const noexcept
     {
-        bcos::executor_v1::StateKeyView view(stateKey);
-        return std::hash<bcos::executor_v1::StateKeyView>{}(view);
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(stateKey)>,
+                          bcos::executor_v1::StateKey>)
+        {
+            return stateKey.hash();
+        }
+        else
+        {
+            bcos::executor_v1::StateKeyView view(stateKey);
+            return std::hash<bcos::executor_v1::StateKeyView>{}(view);
+        }
     }
 };
 
@@ -0,0 +1,126 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief salted short transaction ids for the compact proposal and missed-txs relay
+ *
+ * A short id is the 48 low bits of a salted mix of the whole transaction hash. The salt is taken
+ * from the hash of the proposal the transactions are missed for, so the transactions colliding on
+ * a short id can't be prepared before the proposal exists, and the leader indexes its sealed
+ * transactions once per proposal for all the followers. A collision only costs a fallback: the
+ * requester always checks the full hash of what it receives.
+ *
+ * @file ShortTxID.h
+ */
+
+#pragma once
+
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace bcos::txpool
+{
+using ShortTxID = uint64_t;
+static constexpr const size_t SHORT_TXID_SIZE = 6;
+static constexpr const size_t SHORT_TXID_SALT_SIZE = 8;
+
+inline ShortTxID shortTxID(uint64_t _salt, bcos::crypto::HashType const& _txHash)
+{
+    // murmur3 fmix64 over the salted words of the hash
+    auto mix = [](uint64_t _value) {
+        _value ^= _value >> 33;
+        _value *= 0xff51afd7ed558ccdULL;
+        _value ^= _value >> 33;
+        _value *= 0xc4ceb9fe1a85ec53ULL;
+        _value ^= _value >> 33;
+        return _value;
+    };
+    uint64_t id = _salt;
+    for (size_t offset = 0; offset < bcos::crypto::HashType::SIZE; offset += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, _txHash.data() + offset, sizeof(word));
+        id = mix(id ^ word);
+    }
+    return id & ((ShortTxID(1) << (SHORT_TXID_SIZE * 8)) - 1);
+}
+
+// the salt of the short ids of the txs of a proposal
+inline uint64_t shortTxIDSalt(bcos::crypto::HashType const& _proposalHash)
+{
+    uint64_t salt = 0;
+    std::memcpy(&salt, _proposalHash.data(), sizeof(salt));
+    return salt;
+}
+
+// encode the salt and the short ids, little-endian
+inline bytes encodeShortTxIDs(uint64_t _salt, std::span<const ShortTxID> _shortIDs)
+{
+    bytes encoded;
+    encoded.reserve(SHORT_TXID_SALT_SIZE + _shortIDs.size() * SHORT_TXID_SIZE);
+    for (size_t i = 0; i < SHORT_TXID_SALT_SIZE; ++i)
+    {
+        encoded.emplace_back(static_cast<byte>(_salt >> (i * 8)));
+    }
+    for (auto id : _shortIDs)
+    {
+        for (size_t i = 0; i < SHORT_TXID_SIZE; ++i)
+        {
+            encoded.emplace_back(static_cast<byte>(id >> (i * 8)));
+        }
+    }
+    return encoded;
+}
+
+// encode the salt and the short ids of _txsHash
+inline bytes encodeShortTxIDs(uint64_t _salt, bcos::crypto::HashList const& _txsHash)
+{
+    std::vector<ShortTxID> shortIDs;
+    shortIDs.reserve(_txsHash.size());
+    for (auto const& txHash : _txsHash)
+    {
+        shortIDs.emplace_back(shortTxID(_salt, txHash));
+    }
+    return encodeShortTxIDs(_salt, shortIDs);
+}
+
+// return false if _data is not a salt followed by whole short ids
+inline bool decodeShortTxIDs(
+    bytesConstRef _data, uint64_t& _salt, std::vector<ShortTxID>& _shortIDs)
+{
+    if (_data.size() < SHORT_TXID_SALT_SIZE ||
+        (_data.size() - SHORT_TXID_SALT_SIZE) % SHORT_TXID_SIZE != 0)
+    {
+        return false;
+    }
+    auto readLE = [&_data](size_t _offset, size_t _size) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < _size; ++i)
+        {
+            value |= uint64_t(_data[_offset + i]) << (i * 8);
+        }
+        return value;
+    };
+    _salt = readLE(0, SHORT_TXID_SALT_SIZE);
+    _shortIDs.clear();
+    _shortIDs.reserve((_data.size() - SHORT_TXID_SALT_SIZE) / SHORT_TXID_SIZE);
+    for (size_t offset = SHORT_TXID_SALT_SIZE; offset < _data.size(); offset += SHORT_TXID_SIZE)
+    {
+        _shortIDs.emplace_back(readLE(offset, SHORT_TXID_SIZE));
+    }
+    return true;
+}
+}  // namespace bcos::txpool
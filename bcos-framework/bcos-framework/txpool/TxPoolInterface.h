@@ -22,6 +22,7 @@
 #include "../protocol/Block.h"
 #include "../protocol/Transaction.h"
 #include "../protocol/TransactionSubmitResult.h"
+#include "ShortTxID.h"
 #include "bcos-task/Task.h"
 #include "bcos-utilities/Error.h"
 #include <boost/throw_exception.hpp>
@@ -113,6 +114,27 @@ public:
         protocol::Block::ConstPtr _block,
         std::function<void(Error::Ptr, bool)> _onVerifyFinished) = 0;
 
+    // whether the peer rebuilds the proposals relayed by the short ids of their txs. Defaults keep
+    // the TARS txpool clients on the full proposal relay
+    virtual bool compactRelayPeer(bcos::crypto::NodeIDPtr const& /*_peer*/) { return false; }
+
+    /**
+     * @brief rebuild the txs of a proposal relayed by the short ids of their txs
+     *
+     * @param _generatedNodeID the NodeID of the leader, the txs missing in the pool are fetched
+     * from it
+     * @param _proposal the proposal with the signed header only
+     * @param _shortIDs the short ids of the txs of the proposal in order
+     * @param _onRebuilt called with the proposal carrying the tx metadata, its txsRoot checked
+     * against the header
+     */
+    virtual void asyncRebuildCompactProposal(bcos::crypto::PublicPtr /*_generatedNodeID*/,
+        protocol::Block::Ptr /*_proposal*/, std::vector<ShortTxID> /*_shortIDs*/,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _onRebuilt)
+    {
+        _onRebuilt(BCOS_ERROR_PTR(-1, "compact proposal relay not supported"), nullptr);
+    }
+
     /**
      * @brief The dispatcher obtains the transaction list corresponding to the block from the
      * transaction pool
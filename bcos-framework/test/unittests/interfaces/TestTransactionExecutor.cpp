@@ -1,5 +1,7 @@
 #include "bcos-framework/transaction-executor/StateKey.h"
 #include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
 
 using namespace bcos::executor_v1;
 using namespace std::string_view_literals;
@@ -24,6 +26,91 @@ BOOST_AUTO_TEST_CASE(stateKey)
     BOOST_CHECK_EQUAL(ss.str(), "table:key");
 }
 
+BOOST_AUTO_TEST_CASE(internedStateKey)
+{
+    std::string table = "/apps/" + std::string(40, 'a');
+    std::string slot(32, '\x01');
+    StateKey key1(table, slot);
+    StateKey key2{std::string(table), std::string(slot)};
+
+    // the tables are interned, the slot is kept inline
+    BOOST_CHECK(key1.m_table == key2.m_table);
+    BOOST_CHECK_EQUAL(key1.table(), table);
+    BOOST_CHECK_EQUAL(key1.key(), slot);
+    BOOST_CHECK_EQUAL(key1.m_key.capacity(), StateKey::INLINE_KEY_SIZE);
+    BOOST_CHECK_EQUAL(key1, key2);
+
+    // the hash and the order match the view of the same table and key
+    StateKeyView view(table, slot);
+    BOOST_CHECK_EQUAL(std::hash<StateKey>{}(key1), std::hash<StateKeyView>{}(view));
+    BOOST_CHECK(key1 == view);
+    BOOST_CHECK(StateKey("a"sv, "b"sv) < StateKey("a"sv, "c"sv));
+    BOOST_CHECK(StateKey("a"sv, "c"sv) < StateKey("b"sv, "a"sv));
+    BOOST_CHECK(StateKey("a"sv, "b"sv) < StateKeyView("ab"sv, ""sv));
+
+    // round trip through the "<table>:<key>" encoding
+    auto encoded = key1.encode();
+    BOOST_CHECK_EQUAL(encoded, table + ":" + slot);
+    BOOST_CHECK_EQUAL(StateKey(encoded), key1);
+    BOOST_CHECK_EQUAL(StateKey("table:key:with:colons"sv).key(), "key:with:colons");
+    BOOST_CHECK_THROW(StateKey("no splitter"sv), NoTableSpliterError);
+    BOOST_CHECK_EQUAL(StateKey().table(), "");
+}
+
+BOOST_AUTO_TEST_CASE(boundedInternTable)
+{
+    // fill the intern table with tables referenced by keys
+    std::vector<StateKey> keys;
+    for (size_t i = 0; InternedTables::instance().size() < MAX_INTERNED_TABLES; ++i)
+    {
+        keys.emplace_back("/apps/interned" + std::to_string(i), "key"sv);
+    }
+    BOOST_CHECK(keys.front().m_table->interned());
+
+    // the unreferenced tables are evicted, then the tables beyond it are kept by their keys
+    StateKey key1;
+    for (size_t i = 0; i < MAX_INTERNED_TABLES; ++i)
+    {
+        if (!key1.table().empty() && !key1.m_table->interned())
+        {
+            break;
+        }
+        key1 = StateKey("/apps/not interned" + std::to_string(i), "key"sv);
+    }
+    BOOST_REQUIRE(!key1.m_table->interned());
+    auto table = std::string(key1.table());
+    StateKey interned0("/apps/interned0"sv, "key"sv);
+    StateKey key2{std::string(table), std::string("key")};
+    BOOST_CHECK(key1.m_table != key2.m_table);
+    BOOST_CHECK_EQUAL(key1.table(), table);
+    BOOST_CHECK_EQUAL(key1, key2);
+    BOOST_CHECK_NE(key1, StateKey(table, "other"sv));
+    BOOST_CHECK_NE(key1, interned0);
+    BOOST_CHECK(interned0 < key1);
+
+    StateKeyView view(table, "key");
+    BOOST_CHECK_EQUAL(std::hash<StateKey>{}(key1), std::hash<StateKeyView>{}(view));
+    BOOST_CHECK(key1 == view);
+    BOOST_CHECK_EQUAL(StateKey(key1.encode()), key1);
+
+    // once the keys are gone their tables are evicted, a key still alive keeps its table
+    auto kept = keys.front();
+    keys.clear();
+    InternedTablePtr evicted;
+    for (size_t i = 0; i <= MAX_INTERNED_TABLES / 4 && !(evicted && evicted->interned()); ++i)
+    {
+        evicted = internTable("/apps/evicted" + std::to_string(i));
+    }
+    BOOST_CHECK(evicted->interned());
+    BOOST_CHECK_LT(InternedTables::instance().size(), MAX_INTERNED_TABLES / 4);
+    BOOST_CHECK(internTable(kept.table()) == kept.m_table);
+
+    // a moved from key is left with the empty table
+    auto moved = std::move(kept);
+    BOOST_CHECK_EQUAL(kept.table(), "");
+    BOOST_CHECK_EQUAL(moved.table(), "/apps/interned0");
+}
+
 BOOST_AUTO_TEST_CASE(single_view)
 {
     int i = 100;
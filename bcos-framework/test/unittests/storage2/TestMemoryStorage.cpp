@@ -186,6 +186,52 @@ BOOST_AUTO_TEST_CASE(lru)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(clock)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, storage::Entry, Attribute(ORDERED | CLOCK)> storage(1);
+        storage.setMaxCapacity(1040);
+
+        // write 10 100byte value
+        storage::Entry entry;
+        entry.set(std::string(100, 'a'));
+        co_await storage2::writeSome(storage,
+            ::ranges::views::zip(::ranges::views::iota(0, 10), ::ranges::views::repeat(entry)));
+
+        // 0~4 are hot
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto values = co_await storage2::readSome(storage, ::ranges::views::iota(0, 5));
+            for (auto&& value : values)
+            {
+                BOOST_REQUIRE(value);
+            }
+        }
+
+        // a scan of 10 new keys evicts the cold keys and itself, not the hot keys
+        co_await storage2::writeSome(storage,
+            ::ranges::views::zip(::ranges::views::iota(10, 20), ::ranges::views::repeat(entry)));
+        auto hotValues = co_await storage2::readSome(storage, ::ranges::views::iota(0, 5));
+        for (auto&& value : hotValues)
+        {
+            BOOST_CHECK(value);
+        }
+        auto coldValues = co_await storage2::readSome(storage, ::ranges::views::iota(5, 15));
+        for (auto&& value : coldValues)
+        {
+            BOOST_CHECK(!value);
+        }
+
+        auto range = co_await storage2::range(storage);
+        size_t count = 0;
+        while (co_await range.next())
+        {
+            ++count;
+        }
+        BOOST_CHECK_EQUAL(count, 10);
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(logicalDeletion)
 {
     task::syncWait([]() -> task::Task<void> {
@@ -283,6 +329,66 @@ BOOST_AUTO_TEST_CASE(range)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(sortOnFreeze)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, int, Attribute(SORT_ON_FREEZE | LOGICAL_DELETION)> storage;
+        for (auto key : {7, 3, 9, 1, 5})
+        {
+            co_await storage2::writeOne(storage, key, key * 10);
+        }
+        co_await storage2::removeOne(storage, 9);
+
+        auto keysOf = [](auto& range) -> task::Task<std::vector<int>> {
+            std::vector<int> keys;
+            while (auto keyValue = co_await range.next())
+            {
+                keys.emplace_back(std::get<0>(*keyValue));
+            }
+            co_return keys;
+        };
+
+        // sorted even before freeze, with the deletion mark
+        auto unfrozenRange = co_await storage2::range(storage);
+        BOOST_CHECK(!storage.frozen());
+        BOOST_CHECK((co_await keysOf(unfrozenRange) == std::vector<int>{1, 3, 5, 7, 9}));
+        BOOST_CHECK_EQUAL(storage.sortCount(), 1U);
+
+        storage.freeze();
+        BOOST_CHECK(storage.frozen());
+        BOOST_CHECK_EQUAL(storage.sortCount(), 2U);
+        auto seekRange = co_await storage2::range(storage, storage2::RANGE_SEEK, 4);
+        BOOST_CHECK((co_await keysOf(seekRange) == std::vector<int>{5, 7, 9}));
+        BOOST_CHECK_EQUAL((co_await storage2::readOne(storage, 3)).value(), 30);
+
+        // updating a value keeps the sorted entries, a new key is merged into them
+        co_await storage2::writeOne(storage, 3, 31);
+        BOOST_CHECK(storage.frozen());
+        auto copied = storage;
+        BOOST_CHECK(!copied.frozen());
+        co_await storage2::writeOne(storage, 4, 40);
+        co_await storage2::writeOne(storage, 0, 0);
+        BOOST_CHECK(!storage.frozen());
+
+        auto range = co_await storage2::range(storage);
+        BOOST_CHECK((co_await keysOf(range) == std::vector<int>{0, 1, 3, 4, 5, 7, 9}));
+        storage.freeze();
+        BOOST_CHECK(storage.frozen());
+        auto frozenRange = co_await storage2::range(storage);
+        BOOST_CHECK((co_await keysOf(frozenRange) == std::vector<int>{0, 1, 3, 4, 5, 7, 9}));
+        BOOST_CHECK_EQUAL(storage.sortCount(), 2U);
+        auto copiedRange = co_await storage2::range(copied);
+        BOOST_CHECK((co_await keysOf(copiedRange) == std::vector<int>{1, 3, 5, 7, 9}));
+
+        // an erase drops them
+        co_await storage2::removeOne(storage, 4, storage2::DIRECT);
+        BOOST_CHECK(!storage.frozen());
+        auto erasedRange = co_await storage2::range(storage);
+        BOOST_CHECK((co_await keysOf(erasedRange) == std::vector<int>{0, 1, 3, 5, 7, 9}));
+        BOOST_CHECK_EQUAL(storage.sortCount(), 3U);
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(merge)
 {
     task::syncWait([]() -> task::Task<void> {
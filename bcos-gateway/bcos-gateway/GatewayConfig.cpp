@@ -227,6 +227,16 @@ bool GatewayConfig::enableCompress() const
     return m_enableCompress;
 }
 
+void GatewayConfig::setEnableFrameCoalescing(bool _enableFrameCoalescing)
+{
+    m_enableFrameCoalescing = _enableFrameCoalescing;
+}
+
+bool GatewayConfig::enableFrameCoalescing() const
+{
+    return m_enableFrameCoalescing;
+}
+
 uint32_t GatewayConfig::allowMaxMsgSize() const
 {
     return m_allowMaxMsgSize;
@@ -576,6 +586,8 @@ void GatewayConfig::initP2PConfig(const boost::property_tree::ptree& _pt, bool _
     m_enableRIPProtocol = _pt.get<bool>("p2p.enable_rip_protocol", true);
 
     m_enableCompress = _pt.get<bool>("p2p.enable_compression", true);
+    // the peers must be able to unpack frame batches, enable it once all the gateways are upgraded
+    m_enableFrameCoalescing = _pt.get<bool>("p2p.enable_frame_coalescing", false);
 
     constexpr static uint32_t defaultAllowMaxMsgSize = MAX_MESSAGE_LENGTH;
     m_allowMaxMsgSize = _pt.get<uint32_t>("p2p.allow_max_msg_size", defaultAllowMaxMsgSize);
@@ -641,6 +653,7 @@ void GatewayConfig::initP2PConfig(const boost::property_tree::ptree& _pt, bool _
                              << LOG_KV("p2p.listen_port", listenPort) << LOG_KV("p2p.sm_ssl", smSSL)
                              << LOG_KV("p2p.enable_rip_protocol", m_enableRIPProtocol)
                              << LOG_KV("p2p.enable_compression", m_enableCompress)
+                             << LOG_KV("p2p.enable_frame_coalescing", m_enableFrameCoalescing)
                              << LOG_KV("p2p.allow_max_msg_size", m_allowMaxMsgSize)
                              << LOG_KV("p2p.session_recv_buffer_size", m_sessionRecvBufferSize)
                              << LOG_KV("p2p.session_max_read_data_size", m_maxReadDataSize)
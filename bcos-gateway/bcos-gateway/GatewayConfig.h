@@ -210,6 +210,9 @@ public:
     void setEnableCompress(bool _enableCompress);
     bool enableCompress() const;
 
+    void setEnableFrameCoalescing(bool _enableFrameCoalescing);
+    bool enableFrameCoalescing() const;
+
     uint32_t allowMaxMsgSize() const;
     void setAllowMaxMsgSize(uint32_t _allowMaxMsgSize);
 
@@ -338,6 +341,8 @@ private:
     bool m_enableRIPProtocol{true};
     // enable compress
     bool m_enableCompress{true};
+    // coalesce the small frames sent to a peer into frame batches
+    bool m_enableFrameCoalescing{false};
     std::set<std::string> m_certWhitelist;
     // cert config for ssl connection
     CertConfig m_certConfig;
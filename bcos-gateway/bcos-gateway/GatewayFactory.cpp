@@ -646,7 +646,8 @@ std::shared_ptr<Service> GatewayFactory::buildService(const GatewayConfig::Ptr&
     // Session Factory
     auto sessionFactory = std::make_shared<SessionFactory>(selfInfo,
         _config->sessionRecvBufferSize(), _config->allowMaxMsgSize(), _config->maxReadDataSize(),
-        _config->maxSendDataSize(), _config->maxMsgCountSendOneTime(), _config->enableCompress());
+        _config->maxSendDataSize(), _config->maxMsgCountSendOneTime(), _config->enableCompress(),
+        _config->enableFrameCoalescing());
     // KeyFactory
     auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
     // Session Callback manager
@@ -702,6 +703,7 @@ std::shared_ptr<Service> GatewayFactory::buildService(const GatewayConfig::Ptr&
     GATEWAY_FACTORY_LOG(INFO) << LOG_BADGE("buildService") << LOG_DESC("build service end")
                               << LOG_KV("enable rip protocol", _config->enableRIPProtocol())
                               << LOG_KV("enable compress", _config->enableCompress())
+                              << LOG_KV("enable frame coalescing", _config->enableFrameCoalescing())
                               << LOG_KV("myself pub id", printShortP2pID(pubHex))
                               << LOG_KV("myself_pub_id_hash", printShortP2pID(nodeIDHash));
     service->setMessageFactory(messageFactory);
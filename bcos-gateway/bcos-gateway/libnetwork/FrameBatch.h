@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pack the small frames queued for a peer into one frame
+ *
+ * A frame batch is laid out as a frame of its own
+ *   length(4) | version(2) = 0 | packet type(2) = FrameBatch | seq(4) = 0 | ext(2) | frames
+ * where frames are complete frames, each starting with its own length. frames is compressed once
+ * for the whole batch when ext has the COMPRESS flag. All the integers are big-endian.
+ *
+ * @file FrameBatch.h
+ */
+#pragma once
+
+#include "bcos-framework/gateway/GatewayTypeDef.h"
+#include "bcos-framework/protocol/Protocol.h"
+#include "bcos-gateway/Common.h"
+#include "bcos-gateway/libnetwork/Common.h"
+#include "bcos-gateway/libnetwork/Message.h"
+#include "bcos-utilities/ZstdCompress.h"
+#include <vector>
+
+namespace bcos::gateway
+{
+/// length(4) + version(2) + packetType(2) + seq(4) + ext(2)
+constexpr static size_t FRAME_HEADER_LENGTH = 14;
+constexpr static size_t FRAME_PACKET_TYPE_OFFSET = 6;
+constexpr static size_t FRAME_EXT_OFFSET = 12;
+// frame batches smaller than this are not worth compressing
+constexpr static size_t FRAME_BATCH_COMPRESS_THRESHOLD = 1024;
+constexpr static int FRAME_BATCH_COMPRESS_LEVEL = 1;
+
+inline uint32_t readFrameField(bytesConstRef _buffer, size_t _offset, size_t _size)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < _size; ++i)
+    {
+        value = (value << 8) | _buffer[_offset + i];
+    }
+    return value;
+}
+
+inline void appendFrameField(bytes& _buffer, uint32_t _value, size_t _size)
+{
+    for (size_t i = _size; i > 0; --i)
+    {
+        _buffer.emplace_back(static_cast<byte>(_value >> ((i - 1) * 8)));
+    }
+}
+
+// the length of the frame at the head of _buffer, 0 if its length isn't received yet
+inline uint32_t frameLength(bytesConstRef _buffer)
+{
+    return _buffer.size() < sizeof(uint32_t) ? 0 : readFrameField(_buffer, 0, sizeof(uint32_t));
+}
+
+inline bool isFrameBatch(bytesConstRef _buffer)
+{
+    return _buffer.size() >= FRAME_PACKET_TYPE_OFFSET + sizeof(uint16_t) &&
+           readFrameField(_buffer, FRAME_PACKET_TYPE_OFFSET, sizeof(uint16_t)) ==
+               GatewayMessageType::FrameBatch;
+}
+
+// pack _frames, the concatenated complete frames, into a frame batch
+inline EncodedMessage encodeFrameBatch(bytes _frames, bool _compress)
+{
+    EncodedMessage batch;
+    uint16_t ext = 0;
+    if (_compress && _frames.size() > FRAME_BATCH_COMPRESS_THRESHOLD)
+    {
+        bytes compressed;
+        if (ZstdCompress::compress(ref(_frames), compressed, FRAME_BATCH_COMPRESS_LEVEL) &&
+            compressed.size() < _frames.size())
+        {
+            ext |= bcos::protocol::MessageExtFieldFlag::COMPRESS;
+            batch.payload = std::move(compressed);
+        }
+    }
+    if ((ext & bcos::protocol::MessageExtFieldFlag::COMPRESS) == 0)
+    {
+        batch.payload = std::move(_frames);
+    }
+    batch.header.reserve(FRAME_HEADER_LENGTH);
+    appendFrameField(batch.header, FRAME_HEADER_LENGTH + batch.payload.size(), sizeof(uint32_t));
+    appendFrameField(batch.header, bcos::protocol::ProtocolVersion::V0, sizeof(uint16_t));
+    appendFrameField(batch.header, GatewayMessageType::FrameBatch, sizeof(uint16_t));
+    appendFrameField(batch.header, 0, sizeof(uint32_t));
+    appendFrameField(batch.header, ext, sizeof(uint16_t));
+    return batch;
+}
+
+// unpack the frame batch at the head of _buffer into _frames, _frameRefs point into _frames
+// return the length of the batch, MESSAGE_INCOMPLETE if it isn't fully received or MESSAGE_ERROR
+inline int32_t decodeFrameBatch(
+    bytesConstRef _buffer, bytes& _frames, std::vector<bytesConstRef>& _frameRefs)
+{
+    if (_buffer.size() < FRAME_HEADER_LENGTH)
+    {
+        return MessageDecodeStatus::MESSAGE_INCOMPLETE;
+    }
+    auto length = frameLength(_buffer);
+    if (length <= FRAME_HEADER_LENGTH || length > MAX_MESSAGE_LENGTH)
+    {
+        return MessageDecodeStatus::MESSAGE_ERROR;
+    }
+    if (_buffer.size() < length)
+    {
+        return MessageDecodeStatus::MESSAGE_INCOMPLETE;
+    }
+    auto body = _buffer.getCroppedData(FRAME_HEADER_LENGTH, length - FRAME_HEADER_LENGTH);
+    auto ext = readFrameField(_buffer, FRAME_EXT_OFFSET, sizeof(uint16_t));
+    if ((ext & bcos::protocol::MessageExtFieldFlag::COMPRESS) != 0)
+    {
+        if (!ZstdCompress::uncompress(body, _frames))
+        {
+            return MessageDecodeStatus::MESSAGE_ERROR;
+        }
+    }
+    else
+    {
+        _frames.assign(body.begin(), body.end());
+    }
+
+    _frameRefs.clear();
+    auto frames = ref(_frames);
+    size_t offset = 0;
+    while (offset < frames.size())
+    {
+        auto frame = frames.getCroppedData(offset);
+        auto frameSize = frameLength(frame);
+        // the frames of a batch are complete and never batches themselves
+        if (frameSize < FRAME_HEADER_LENGTH || frameSize > frame.size() || isFrameBatch(frame))
+        {
+            return MessageDecodeStatus::MESSAGE_ERROR;
+        }
+        _frameRefs.emplace_back(frame.getCroppedData(0, frameSize));
+        offset += frameSize;
+    }
+    return static_cast<int32_t>(length);
+}
+}  // namespace bcos::gateway
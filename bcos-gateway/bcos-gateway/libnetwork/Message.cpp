@@ -10,7 +10,11 @@ std::size_t bcos::gateway::EncodedMessage::headerSize() const
 }
 std::size_t bcos::gateway::EncodedMessage::payloadSize() const
 {
-    return payload.size();
+    return payloadRef().size();
+}
+bcos::bytesConstRef bcos::gateway::EncodedMessage::payloadRef() const
+{
+    return sharedPayload ? bcos::ref(*sharedPayload) : bcos::ref(payload);
 }
 uint32_t bcos::gateway::MessageFactory::newSeq()
 {
@@ -32,11 +32,15 @@ struct EncodedMessage
 {
     bcos::bytes header;
     bcos::bytes payload;
+    // the immutable encoded payload shared by all the sessions of a broadcast, sent instead of
+    // payload when it is set
+    std::shared_ptr<const bcos::bytes> sharedPayload;
     bool compress = true;
 
     std::size_t dataSize() const;
     std::size_t headerSize() const;
     std::size_t payloadSize() const;
+    bytesConstRef payloadRef() const;
 };
 
 class Message
@@ -10,6 +10,7 @@
 #include "bcos-gateway/libnetwork/Session.h"
 #include "bcos-gateway/libnetwork/ASIOInterface.h"
 #include "bcos-gateway/libnetwork/Common.h"
+#include "bcos-gateway/libnetwork/FrameBatch.h"
 #include "bcos-gateway/libnetwork/Host.h"
 #include "bcos-gateway/libnetwork/Message.h"
 #include "bcos-gateway/libnetwork/SessionFace.h"
@@ -208,7 +209,9 @@ void Session::asyncSendMessage(Message::Ptr message, Options options, SessionCal
     }
 
     EncodedMessage encodedMessage;
-    encodedMessage.compress = m_enableCompress;
+    // the small messages are compressed with the frame batch they are coalesced into
+    encodedMessage.compress =
+        m_enableCompress && (!m_coalesceFrames || message->length() > FRAME_BATCH_MAX_FRAME_SIZE);
     message->encode(encodedMessage);
 
     if (c_fileLogLevel <= LogLevel::TRACE)
@@ -276,6 +279,44 @@ bool Session::tryPopSomeEncodedMsgs(
     return totalDataSize > 0;
 }
 
+// pack the runs of small payloads into frame batches and collect the buffers to write, return the
+// count of the frames written
+static size_t coalescePayloads(Session::Writings& writings, bool compress)
+{
+    auto outputIt = std::back_inserter(writings.buffers);
+    auto isSmall = [](const Payload& payload) {
+        return payload.size() <= Session::FRAME_BATCH_MAX_FRAME_SIZE;
+    };
+    auto& payloads = writings.payloads;
+    for (auto it = payloads.begin(); it != payloads.end();)
+    {
+        auto runEnd = std::find_if_not(it, payloads.end(), isSmall);
+        if (std::distance(it, runEnd) < 2)
+        {  // a single frame is not worth a batch header
+            it->toConstBuffer(outputIt);
+            ++it;
+            continue;
+        }
+        bytes frames;
+        std::vector<boost::asio::const_buffer> frameBuffers;
+        for (; it != runEnd; ++it)
+        {
+            it->toConstBuffer(std::back_inserter(frameBuffers));
+        }
+        frames.reserve(boost::asio::buffer_size(frameBuffers));
+        for (const auto& buffer : frameBuffers)
+        {
+            const auto* data = static_cast<const byte*>(buffer.data());
+            frames.insert(frames.end(), data, data + buffer.size());
+        }
+        auto& batch =
+            writings.frameBatches.emplace_back(encodeFrameBatch(std::move(frames), compress));
+        *outputIt = {batch.header.data(), batch.header.size()};
+        *outputIt = {batch.payload.data(), batch.payload.size()};
+    }
+    return payloads.size();
+}
+
 void Session::write()
 {
     std::unique_lock lock(m_writingQueueMutex, std::try_to_lock);
@@ -304,11 +345,20 @@ void Session::write()
             return;
         }
 
-        auto outputIt = std::back_inserter(m_writings->buffers);
-        for (auto& payload : m_writings->payloads)
+        if (m_coalesceFrames)
         {
-            payload.toConstBuffer(outputIt);
+            m_writtenFrameCount += coalescePayloads(*m_writings, m_enableCompress);
         }
+        else
+        {
+            auto outputIt = std::back_inserter(m_writings->buffers);
+            for (auto& payload : m_writings->payloads)
+            {
+                payload.toConstBuffer(outputIt);
+            }
+            m_writtenFrameCount += m_writings->payloads.size();
+        }
+        ++m_writeCount;
         m_server.get().asioInterface()->asyncWrite(m_socket, m_writings->buffers,
             // FIB-184: hold a strong reference to the session for the duration of the async write.
             // async_write operates on this->m_socket and reads from buffers owned via m_writings;
@@ -330,6 +380,7 @@ void Session::write()
                         }
                     }
                     session->m_writings->payloads.clear();
+                    session->m_writings->frameBatches.clear();
                     session->onWrite(_error, _size);
                 }
             });
@@ -590,17 +641,23 @@ void Session::doRead()
                     {
                         auto writeBuffer = recvBuffer.asWriteBuffer();
                         auto readBuffer = recvBuffer.asReadBuffer();
+                        auto frameBatch = isFrameBatch(readBuffer);
                         // Note: the decode function may throw exception
-                        ssize_t result = message->decode(readBuffer);
+                        ssize_t result = frameBatch ? session->onFrameBatch(readBuffer) :
+                                                      message->decode(readBuffer);
                         if (result > 0)
                         {
-                            NetworkException e(P2PExceptionType::Success, "Success");
-                            session->onMessage(e, message);
+                            if (!frameBatch)
+                            {
+                                NetworkException e(P2PExceptionType::Success, "Success");
+                                session->onMessage(e, message);
+                            }
                             recvBuffer.onRead(result);
                         }
                         else if (result == 0)
                         {
-                            auto length = message->lengthDirect();
+                            auto length =
+                                frameBatch ? frameLength(readBuffer) : message->lengthDirect();
                             if (length > session->allowMaxMsgSize())
                             {
                                 SESSION_LOG(ERROR)
@@ -773,6 +830,30 @@ void Session::onMessage(NetworkException const& e, Message::Ptr message)
     });
 }
 
+int32_t Session::onFrameBatch(bytesConstRef _buffer)
+{
+    bytes frames;
+    std::vector<bytesConstRef> frameRefs;
+    auto result = decodeFrameBatch(_buffer, frames, frameRefs);
+    if (result <= 0)
+    {
+        return result;
+    }
+    for (auto frame : frameRefs)
+    {
+        auto message = m_messageFactory->buildMessage();
+        if (std::cmp_not_equal(message->decode(frame), frame.size()))
+        {
+            SESSION_LOG(WARNING) << LOG_BADGE("onFrameBatch") << LOG_DESC("invalid frame in batch")
+                                 << LOG_KV("frameSize", frame.size())
+                                 << LOG_KV("endpoint", nodeIPEndpoint());
+            return MessageDecodeStatus::MESSAGE_ERROR;
+        }
+        onMessage(NetworkException(P2PExceptionType::Success, "Success"), std::move(message));
+    }
+    return result;
+}
+
 void Session::onTimeout(const boost::system::error_code& error, uint32_t seq)
 {
     if (error)
@@ -818,6 +899,14 @@ void Session::checkNetworkStatus()
             drop(IdleWaitTimeout);
             return;
         }
+        if (c_fileLogLevel <= LogLevel::DEBUG)
+        {
+            SESSION_LOG(DEBUG) << LOG_DESC("checkNetworkStatus")
+                               << LOG_KV("endpoint", m_socket->nodeIPEndpoint())
+                               << LOG_KV("writes", m_writeCount.load())
+                               << LOG_KV("framesPerWrite", framesPerWrite())
+                               << LOG_KV("coalesceFrames", m_coalesceFrames);
+        }
     }
     catch (std::exception const& e)
     {
@@ -979,7 +1068,7 @@ size_t bcos::gateway::Payload::size() const
     return std::visit(
         bcos::overloaded(
             [](const EncodedMessage& encodedMessage) -> size_t {
-                return encodedMessage.header.size() + encodedMessage.payload.size();
+                return encodedMessage.dataSize();
             },
             [](const boost::container::small_vector<bytesConstRef, 3>& refs) {
                 return ::ranges::accumulate(refs, size_t(0),
@@ -1145,6 +1234,19 @@ bool bcos::gateway::Session::enableCompress() const
 {
     return m_enableCompress;
 }
+void bcos::gateway::Session::setCoalesceFrames(bool _coalesceFrames)
+{
+    m_coalesceFrames = _coalesceFrames;
+}
+bool bcos::gateway::Session::coalesceFrames() const
+{
+    return m_coalesceFrames;
+}
+double bcos::gateway::Session::framesPerWrite() const
+{
+    auto writeCount = m_writeCount.load();
+    return writeCount == 0 ? 0 : (double)m_writtenFrameCount.load() / (double)writeCount;
+}
 bcos::gateway::SessionRecvBuffer& bcos::gateway::Session::recvBuffer()
 {
     return m_recvBuffer;
@@ -1167,12 +1269,14 @@ std::shared_ptr<SessionFace> bcos::gateway::SessionFactory::createSession(Host&
     session->setMaxSendDataSize(m_maxSendDataSize);
     session->setMaxSendMsgCountS(m_maxSendMsgCountS);
     session->setEnableCompress(m_enableCompress);
+    session->setCoalesceFrames(m_coalesceFrames);
     BCOS_LOG(INFO) << LOG_BADGE("SessionFactory") << LOG_DESC("create new session")
                    << LOG_KV("sessionRecvBufferSize", m_sessionRecvBufferSize)
                    << LOG_KV("allowMaxMsgSize", m_allowMaxMsgSize)
                    << LOG_KV("maxReadDataSize", m_maxReadDataSize)
                    << LOG_KV("maxSendDataSize", m_maxSendDataSize)
                    << LOG_KV("maxSendMsgCountS", m_maxSendMsgCountS)
-                   << LOG_KV("enableCompress", m_enableCompress);
+                   << LOG_KV("enableCompress", m_enableCompress)
+                   << LOG_KV("coalesceFrames", m_coalesceFrames);
     return session;
 }
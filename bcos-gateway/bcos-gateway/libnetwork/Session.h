@@ -20,6 +20,7 @@
 #include <boost/heap/priority_queue.hpp>
 #include <atomic>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -83,7 +84,8 @@ struct Payload
         std::visit(bcos::overloaded(
                        [&](const EncodedMessage& encodedMessage) {
                            *output = {encodedMessage.header.data(), encodedMessage.header.size()};
-                           *output = {encodedMessage.payload.data(), encodedMessage.payload.size()};
+                           auto payload = encodedMessage.payloadRef();
+                           *output = {payload.data(), payload.size()};
                        },
                        [&](const MessageList& refs) {
                            for (const auto& ref : refs)
@@ -107,6 +109,8 @@ public:
     // for sessions that actually carry large messages. Must stay well above the message
     // header length so the first read can always make forward progress.
     constexpr static const std::size_t INITIAL_SESSION_RECV_BUFFER_SIZE = 16 * 1024UL;
+    // the frames not larger than this are coalesced into frame batches when m_coalesceFrames is on
+    constexpr static const std::size_t FRAME_BATCH_MAX_FRAME_SIZE = 4 * 1024UL;
 
     Session(std::shared_ptr<SocketFace> socket, Host& server,
         size_t _recvBufferSize = INITIAL_SESSION_RECV_BUFFER_SIZE, bool _forceSize = false);
@@ -185,6 +189,11 @@ public:
     void setEnableCompress(bool _enableCompress);
     bool enableCompress() const;
 
+    void setCoalesceFrames(bool _coalesceFrames);
+    bool coalesceFrames() const;
+    // the average count of the frames sent by one write, the frames of a batch count one by one
+    double framesPerWrite() const;
+
     SessionRecvBuffer& recvBuffer();
     const SessionRecvBuffer& recvBuffer() const;
 
@@ -227,6 +236,9 @@ public:
     uint32_t m_allowMaxMsgSize = 32 * 1024 * 1024;
     //
     bool m_enableCompress = true;
+    // pack the small frames queued while a write is in flight into one frame batch, the batch is
+    // compressed once instead of every frame, see FrameBatch.h
+    bool m_coalesceFrames = false;
     // ------ for optimize send message parameters  end ---------------
 
     /// Drop the connection for the reason @a _reason.
@@ -254,6 +266,9 @@ public:
 
     /// call by doRead() to deal with message
     void onMessage(NetworkException const& e, Message::Ptr message);
+    /// call by doRead() to unpack a frame batch and deal with its messages, return the length of
+    /// the batch or the MessageDecodeStatus
+    int32_t onFrameBatch(bytesConstRef _buffer);
 
     std::reference_wrapper<Host> m_server;  ///< The host that owns us. Never null.
     std::shared_ptr<SocketFace> m_socket;   ///< Socket of peer's connection.
@@ -278,6 +293,9 @@ public:
     // timer to check the connection
     std::atomic<uint64_t> m_lastReadTime;
     std::atomic<uint64_t> m_lastWriteTime;
+    // for framesPerWrite
+    std::atomic<uint64_t> m_writeCount{0};
+    std::atomic<uint64_t> m_writtenFrameCount{0};
     std::shared_ptr<bcos::Timer> m_idleCheckTimer;
 
     // FIB-97-new: idempotency guard. drop() may be invoked concurrently from the
@@ -295,6 +313,8 @@ public:
     {
         std::vector<Payload> payloads;
         std::vector<boost::asio::const_buffer> buffers;
+        // the frame batches the buffers point to
+        std::deque<EncodedMessage> frameBatches;
     };
     std::shared_ptr<Writings> m_writings;
 };
@@ -304,14 +324,15 @@ class SessionFactory
 public:
     SessionFactory(P2PInfo _hostInfo, uint32_t _sessionRecvBufferSize,  // NOLINT
         uint32_t _allowMaxMsgSize, uint32_t _maxReadDataSize, uint32_t _maxSendDataSize,
-        uint32_t _maxSendMsgCountS, bool _enableCompress)
+        uint32_t _maxSendMsgCountS, bool _enableCompress, bool _coalesceFrames = false)
       : m_hostInfo(std::move(_hostInfo)),
         m_sessionRecvBufferSize(_sessionRecvBufferSize),
         m_allowMaxMsgSize(_allowMaxMsgSize),
         m_maxReadDataSize(_maxReadDataSize),
         m_maxSendDataSize(_maxSendDataSize),
         m_maxSendMsgCountS(_maxSendMsgCountS),
-        m_enableCompress(_enableCompress)
+        m_enableCompress(_enableCompress),
+        m_coalesceFrames(_coalesceFrames)
     {}
     SessionFactory(const SessionFactory&) = delete;
     SessionFactory(SessionFactory&&) = delete;
@@ -331,6 +352,7 @@ private:
     uint32_t m_maxSendDataSize{0};
     uint32_t m_maxSendMsgCountS{0};
     bool m_enableCompress = true;
+    bool m_coalesceFrames = false;
 };
 
 }  // namespace bcos::gateway
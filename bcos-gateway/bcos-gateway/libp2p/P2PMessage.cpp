@@ -230,7 +230,20 @@ bool bcos::gateway::P2PMessage::encodeHeaderImpl(bytes& _buffer) const
 bool P2PMessage::encode(EncodedMessage& _buffer) const
 {
     bool isCompressSuccess = false;
-    if (_buffer.compress)
+    if (m_sharePayload)
+    {
+        isCompressSuccess = encodeSharedPayload(_buffer);
+        // the compress flag follows the session the header is encoded for
+        if (isCompressSuccess)
+        {
+            m_ext |= bcos::protocol::MessageExtFieldFlag::COMPRESS;
+        }
+        else
+        {
+            m_ext &= (~bcos::protocol::MessageExtFieldFlag::COMPRESS);
+        }
+    }
+    else if (_buffer.compress)
     {
         bcos::bytes compressData;
         if (tryToCompressPayload(compressData))
@@ -243,7 +256,7 @@ bool P2PMessage::encode(EncodedMessage& _buffer) const
     }
 
     // No data compression is performed
-    if (!isCompressSuccess)
+    if (!isCompressSuccess && !m_sharePayload)
     {
         _buffer.payload = m_payload;
     }
@@ -256,7 +269,7 @@ bool P2PMessage::encode(EncodedMessage& _buffer) const
     }
 
     *(uint32_t*)headerBuffer.data() = boost::asio::detail::socket_ops::host_to_network_long(
-        headerBuffer.size() + _buffer.payload.size());
+        headerBuffer.size() + _buffer.payloadSize());
 
     _buffer.header = std::move(headerBuffer);
     return true;
@@ -320,6 +333,34 @@ bool P2PMessage::tryToCompressPayload(bytes& compressData) const
     return isCompressSuccess;
 }
 
+bool P2PMessage::encodeSharedPayload(EncodedMessage& _buffer) const
+{
+    // only version >= V2 support p2p network compress
+    if (_buffer.compress && m_version >= (uint16_t)(bcos::protocol::ProtocolVersion::V2))
+    {
+        if (!m_compressTried)
+        {
+            m_compressTried = true;
+            bcos::bytes compressData;
+            if (tryToCompressPayload(compressData))
+            {
+                m_compressedPayload = std::make_shared<const bytes>(std::move(compressData));
+            }
+        }
+        if (m_compressedPayload)
+        {
+            _buffer.sharedPayload = m_compressedPayload;
+            return true;
+        }
+    }
+    if (!m_sharedPayload)
+    {
+        m_sharedPayload = std::make_shared<const bytes>(m_payload);
+    }
+    _buffer.sharedPayload = m_sharedPayload;
+    return false;
+}
+
 int32_t P2PMessage::decodeHeader(const bytesConstRef& _buffer)
 {
     int32_t offset = 0;
@@ -551,6 +592,17 @@ bcos::bytesConstRef bcos::gateway::P2PMessage::payload() const
 void bcos::gateway::P2PMessage::setPayload(bytes _payload)
 {
     m_payload = std::move(_payload);
+    m_sharedPayload.reset();
+    m_compressedPayload.reset();
+    m_compressTried = false;
+}
+void bcos::gateway::P2PMessage::setSharePayload(bool _sharePayload)
+{
+    m_sharePayload = _sharePayload;
+}
+bool bcos::gateway::P2PMessage::sharePayload() const
+{
+    return m_sharePayload;
 }
 void bcos::gateway::P2PMessage::setRespPacket()
 {
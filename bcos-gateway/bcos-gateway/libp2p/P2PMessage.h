@@ -158,6 +158,11 @@ public:
     // compress payload if payload need to be compressed
     bool tryToCompressPayload(bytes& compressData) const;
 
+    // encode and compress the payload only once, and share the encoded payload between all the
+    // sessions the message is sent to, used by broadcast
+    void setSharePayload(bool _sharePayload);
+    bool sharePayload() const;
+
     bool hasOptions() const;
 
     virtual void setSrcP2PNodeID(std::string const& _srcP2PNodeID);
@@ -179,6 +184,8 @@ public:
 protected:
     virtual bool encodeHeaderImpl(bytes& _buffer) const;
     virtual int32_t decodeHeader(const bytesConstRef& _buffer);
+    // return true if the shared payload is compressed
+    bool encodeSharedPayload(EncodedMessage& _buffer) const;
 
     mutable uint32_t m_length = 0;
     uint16_t m_version = (uint16_t)(bcos::protocol::ProtocolVersion::V0);
@@ -194,6 +201,13 @@ protected:
     P2PMessageOptions m_options;  ///< options fields
     bytes m_payload;              ///< payload data
 
+    bool m_sharePayload = false;
+    // the encoded payload caches for the shared payload, m_compressTried records whether the
+    // compression has been tried, since a failed compression leaves m_compressedPayload empty
+    mutable std::shared_ptr<const bytes> m_sharedPayload;
+    mutable std::shared_ptr<const bytes> m_compressedPayload;
+    mutable bool m_compressTried = false;
+
     std::any m_extAttr = nullptr;  ///< message additional attributes
 };
 
@@ -549,6 +549,9 @@ void Service::asyncBroadcastMessage(P2PMessage::Ptr message, Options options)
                 nodeIDs.push_back(session.first);
             }
         }
+        // encode and compress the payload once for all the sessions, only the header is encoded
+        // per session
+        message->setSharePayload(true);
         for (auto const& nodeID : nodeIDs)
         {
             asyncSendMessageByNodeID(nodeID, message, {}, options);
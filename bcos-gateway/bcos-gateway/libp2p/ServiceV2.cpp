@@ -423,6 +423,9 @@ void ServiceV2::asyncBroadcastMessage(std::shared_ptr<P2PMessage> message, Optio
     auto reachableNodes = m_routerTable->getAllReachableNode();
     try
     {
+        // the payload is encoded once for all the reachable nodes, only the header carrying the
+        // dst nodeID is encoded per node
+        message->setSharePayload(true);
         for (auto const& node : reachableNodes)
         {
             message->setSrcP2PNodeID(m_nodeID);
@@ -0,0 +1,149 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Tests for the frame batches the sessions coalesce the small frames into
+ * @file FrameBatchTest.cpp
+ */
+#include "bcos-gateway/libnetwork/FrameBatch.h"
+#include "bcos-gateway/libp2p/P2PMessageV2.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::test;
+
+namespace
+{
+bytes encodeFrame(uint32_t seq, size_t payloadSize)
+{
+    auto message = std::make_shared<P2PMessageV2>();
+    message->setVersion(bcos::protocol::ProtocolVersion::V3);
+    message->setPacketType(GatewayMessageType::Heartbeat);
+    message->setSeq(seq);
+    message->setSrcP2PNodeID("src");
+    message->setDstP2PNodeID("dst");
+    message->setPayload(bytes(payloadSize, static_cast<byte>('a' + seq % 26)));
+    EncodedMessage encoded;
+    encoded.compress = false;
+    BOOST_REQUIRE(message->encode(encoded));
+    bytes frame = encoded.header;
+    auto payload = encoded.payloadRef();
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+bytes encodeFrames(size_t count, size_t payloadSize)
+{
+    bytes frames;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto frame = encodeFrame(i, payloadSize);
+        frames.insert(frames.end(), frame.begin(), frame.end());
+    }
+    return frames;
+}
+
+bytes toBytes(const EncodedMessage& batch)
+{
+    bytes buffer = batch.header;
+    buffer.insert(buffer.end(), batch.payload.begin(), batch.payload.end());
+    return buffer;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FrameBatchTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(codec)
+{
+    for (auto compress : {false, true})
+    {
+        auto frames = encodeFrames(20, 100);
+        auto buffer = toBytes(encodeFrameBatch(frames, compress));
+        BOOST_CHECK(isFrameBatch(ref(buffer)));
+        BOOST_CHECK_EQUAL(frameLength(ref(buffer)), buffer.size());
+        // the batch is compressed once as a whole
+        BOOST_CHECK_EQUAL(buffer.size() < frames.size(), compress);
+
+        bytes decoded;
+        std::vector<bytesConstRef> frameRefs;
+        BOOST_CHECK_EQUAL(
+            decodeFrameBatch(ref(buffer), decoded, frameRefs), static_cast<int32_t>(buffer.size()));
+        BOOST_CHECK(decoded == frames);
+        BOOST_REQUIRE_EQUAL(frameRefs.size(), 20U);
+        for (uint32_t i = 0; i < frameRefs.size(); ++i)
+        {
+            BOOST_CHECK(!isFrameBatch(frameRefs[i]));
+            P2PMessageV2 message;
+            BOOST_CHECK_EQUAL(
+                message.decode(frameRefs[i]), static_cast<int32_t>(frameRefs[i].size()));
+            BOOST_CHECK_EQUAL(message.seq(), i);
+            BOOST_CHECK_EQUAL(message.srcP2PNodeID(), "src");
+            BOOST_CHECK(message.payload().toBytes() == bytes(100, 'a' + i % 26));
+        }
+
+        // the batch is followed by the next frame in the recv buffer
+        auto next = encodeFrame(100, 10);
+        buffer.insert(buffer.end(), next.begin(), next.end());
+        BOOST_CHECK_EQUAL(decodeFrameBatch(ref(buffer), decoded, frameRefs),
+            static_cast<int32_t>(buffer.size() - next.size()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incompleteBatch)
+{
+    auto buffer = toBytes(encodeFrameBatch(encodeFrames(4, 10), false));
+    bytes decoded;
+    std::vector<bytesConstRef> frameRefs;
+    for (auto size : {size_t(0), size_t(4), FRAME_HEADER_LENGTH, buffer.size() - 1})
+    {
+        BOOST_CHECK_EQUAL(decodeFrameBatch(bytesConstRef(buffer.data(), size), decoded, frameRefs),
+            MessageDecodeStatus::MESSAGE_INCOMPLETE);
+    }
+    BOOST_CHECK_EQUAL(frameLength(bytesConstRef(buffer.data(), 3)), 0U);
+    BOOST_CHECK_EQUAL(frameLength(bytesConstRef(buffer.data(), 4)), buffer.size());
+}
+
+BOOST_AUTO_TEST_CASE(invalidBatch)
+{
+    bytes decoded;
+    std::vector<bytesConstRef> frameRefs;
+
+    // a truncated frame
+    auto frames = encodeFrames(4, 10);
+    frames.pop_back();
+    auto buffer = toBytes(encodeFrameBatch(frames, false));
+    BOOST_CHECK_EQUAL(decodeFrameBatch(ref(buffer), decoded, frameRefs),
+        MessageDecodeStatus::MESSAGE_ERROR);
+
+    // a batch in a batch
+    auto inner = toBytes(encodeFrameBatch(encodeFrames(2, 10), false));
+    buffer = toBytes(encodeFrameBatch(inner, false));
+    BOOST_CHECK_EQUAL(decodeFrameBatch(ref(buffer), decoded, frameRefs),
+        MessageDecodeStatus::MESSAGE_ERROR);
+
+    // a compressed batch that can't be uncompressed
+    buffer = toBytes(encodeFrameBatch(encodeFrames(20, 100), true));
+    buffer[FRAME_HEADER_LENGTH + 1] ^= 0xff;
+    BOOST_CHECK_EQUAL(decodeFrameBatch(ref(buffer), decoded, frameRefs),
+        MessageDecodeStatus::MESSAGE_ERROR);
+
+    // an empty batch
+    buffer = toBytes(encodeFrameBatch({}, false));
+    BOOST_CHECK_EQUAL(decodeFrameBatch(ref(buffer), decoded, frameRefs),
+        MessageDecodeStatus::MESSAGE_ERROR);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -461,6 +461,57 @@ BOOST_AUTO_TEST_CASE(test_P2PMessage_compress)
     */
 }
 
+BOOST_AUTO_TEST_CASE(test_P2PMessage_sharedPayload)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto msg = std::static_pointer_cast<P2PMessageV2>(factory->buildMessage());
+    msg->setPacketType(GatewayMessageType::PeerToPeerMessage);
+    msg->setSeq(0x12345678);
+    msg->setPayload(bytes(10000, 'a'));
+    msg->setSrcP2PNodeID("srcNode");
+    msg->setSharePayload(true);
+
+    auto encodeAndDecode = [&](uint16_t version, std::string const& dstNodeID,
+                               EncodedMessage& encoded) {
+        msg->setVersion(version);
+        msg->setDstP2PNodeID(dstNodeID);
+        BOOST_CHECK(msg->encode(encoded));
+        BOOST_CHECK(encoded.payload.empty());
+        BOOST_REQUIRE(encoded.sharedPayload);
+
+        bytes buffer = encoded.header;
+        auto payload = encoded.payloadRef();
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
+        BOOST_CHECK_EQUAL(encoded.dataSize(), buffer.size());
+        auto decodeMsg = std::static_pointer_cast<P2PMessageV2>(factory->buildMessage());
+        BOOST_CHECK_GT(decodeMsg->decode(bytesConstRef(buffer.data(), buffer.size())), 0);
+        BOOST_CHECK(decodeMsg->payload().toBytes() == bytes(10000, 'a'));
+        BOOST_CHECK_EQUAL(decodeMsg->dstP2PNodeID(), dstNodeID);
+    };
+
+    // the compressed payload is encoded once and shared, the header follows every destination
+    EncodedMessage encoded1;
+    EncodedMessage encoded2;
+    encodeAndDecode(2, "dstNode1", encoded1);
+    encodeAndDecode(2, "dstNode2", encoded2);
+    BOOST_CHECK_EQUAL(encoded1.sharedPayload.get(), encoded2.sharedPayload.get());
+    BOOST_CHECK_LT(encoded1.payloadSize(), 10000);
+    BOOST_CHECK(encoded1.header != encoded2.header);
+
+    // the old protocol version does not support compression
+    EncodedMessage encoded3;
+    encodeAndDecode(1, "dstNode3", encoded3);
+    BOOST_CHECK_EQUAL(encoded3.payloadSize(), 10000);
+    BOOST_CHECK_EQUAL(msg->ext() & bcos::protocol::MessageExtFieldFlag::COMPRESS, 0);
+
+    // a new payload drops the encoded caches
+    msg->setPayload(bytes(10000, 'b'));
+    EncodedMessage encoded4;
+    msg->setVersion(2);
+    BOOST_CHECK(msg->encode(encoded4));
+    BOOST_CHECK_NE(encoded4.sharedPayload.get(), encoded1.sharedPayload.get());
+}
+
 BOOST_AUTO_TEST_CASE(test_P2PMessage_attr)
 {
     auto attr = std::make_shared<GatewayMessageExtAttributes>();
@@ -0,0 +1,96 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BlockMerkle.cpp
+ */
+
+#include "BlockMerkle.h"
+#include <bcos-crypto/merkle/Merkle.h>
+#include <boost/endian/conversion.hpp>
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+constexpr static size_t HASH_SIZE = crypto::HashType::SIZE;
+
+std::string block_merkle::encodeMerkle(
+    crypto::hasher::AnyHasher hasher, std::vector<crypto::HashType> const& leaves)
+{
+    crypto::merkle::Merkle merkle(std::move(hasher));
+    std::vector<crypto::HashType> nodes;
+    merkle.generateMerkle(::ranges::views::all(leaves), nodes);
+
+    std::string row;
+    row.reserve(sizeof(uint32_t) + (leaves.size() + nodes.size()) * HASH_SIZE);
+    auto count = boost::endian::native_to_big(static_cast<uint32_t>(leaves.size()));
+    row.append((const char*)&count, sizeof(count));
+    for (auto const& leaf : leaves)
+    {
+        row.append((const char*)leaf.data(), HASH_SIZE);
+    }
+    for (auto const& node : nodes)
+    {
+        row.append((const char*)node.data(), HASH_SIZE);
+    }
+    return row;
+}
+
+std::optional<MerkleProof> block_merkle::getMerkleProof(
+    crypto::hasher::AnyHasher hasher, std::string_view row, crypto::HashType const& hash)
+{
+    if (row.size() < sizeof(uint32_t) || (row.size() - sizeof(uint32_t)) % HASH_SIZE != 0)
+    {
+        return std::nullopt;
+    }
+    uint32_t count = 0;
+    std::memcpy(&count, row.data(), sizeof(count));
+    count = boost::endian::big_to_native(count);
+    auto total = (row.size() - sizeof(uint32_t)) / HASH_SIZE;
+    if (count == 0 || count >= total)
+    {
+        return std::nullopt;
+    }
+
+    // read the hashes in place, a proof only touches the sibling path
+    auto data = (const byte*)row.data() + sizeof(uint32_t);
+    auto hashAt = [data](size_t index) {
+        return crypto::HashType(data + index * HASH_SIZE, crypto::HashType::FromPointer);
+    };
+    auto leaves = ::ranges::views::iota(size_t(0), size_t(count)) |
+                  ::ranges::views::transform(hashAt);
+    auto nodes = ::ranges::views::iota(size_t(count), total) | ::ranges::views::transform(hashAt);
+
+    auto it = ::ranges::find(leaves, hash);
+    if (it == ::ranges::end(leaves))
+    {
+        return std::nullopt;
+    }
+    crypto::merkle::Merkle merkle(std::move(hasher));
+    MerkleProof proof;
+    try
+    {
+        merkle.generateMerkleProof(
+            leaves, nodes, ::ranges::distance(::ranges::begin(leaves), it), proof);
+    }
+    catch (std::invalid_argument const&)
+    {
+        // the number of the merkle nodes does not match the leaves
+        return std::nullopt;
+    }
+    return proof;
+}
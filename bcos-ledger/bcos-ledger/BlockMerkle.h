@@ -0,0 +1,43 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BlockMerkle.h
+ * @brief the persisted merkle trees of the transactions and receipts of a block
+ */
+
+#pragma once
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include <bcos-crypto/hasher/AnyHasher.h>
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos::ledger::block_merkle
+{
+/**
+ * The merkle trees of the transactions and the receipts of a block are written to
+ * SYS_NUMBER_2_TX_MERKLE and SYS_NUMBER_2_RECEIPT_MERKLE with the block, keyed by the block
+ * number. A row is the big endian leaf count followed by the leaves and the merkle nodes, so a
+ * proof is read from one row instead of loading and hashing every transaction of the block.
+ */
+std::string encodeMerkle(
+    crypto::hasher::AnyHasher hasher, std::vector<crypto::HashType> const& leaves);
+
+// the proof of the hash, std::nullopt if the row is malformed or the hash is not one of its leaves
+std::optional<MerkleProof> getMerkleProof(
+    crypto::hasher::AnyHasher hasher, std::string_view row, crypto::HashType const& hash);
+}  // namespace bcos::ledger::block_merkle
@@ -23,6 +23,7 @@
 
 #include "Ledger.h"
 #include "LedgerMethods.h"
+#include "NonceIndex.h"
 #include "bcos-framework/ledger/EVMAccount.h"
 #include "bcos-framework/ledger/Features.h"
 #include "bcos-framework/ledger/FeaturesStorage.h"
@@ -142,6 +143,46 @@ task::Task<std::optional<storage::Entry>> Ledger::getStorageAt(
         *stateStorage, executor_v1::StateKeyView{contractTableName, _key});
 }
 
+task::Task<std::optional<state_tree::StateProof>> Ledger::getStateProof(
+    std::string_view _table, std::string_view _key, protocol::BlockNumber _blockNumber)
+{
+    auto const stateStorage = getStateStorage();
+    // the tree only holds the latest state, there is no proof against the root of an older block
+    auto numberEntry = co_await storage2::readOne(
+        *stateStorage, executor_v1::StateKeyView(SYS_CURRENT_STATE, SYS_KEY_CURRENT_NUMBER));
+    auto currentNumber =
+        numberEntry ? boost::lexical_cast<protocol::BlockNumber>(numberEntry->get()) : 0;
+    if (_blockNumber != currentNumber)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(LedgerError::ErrorArgument,
+            "getStateProof only supports the latest block " + std::to_string(currentNumber)));
+    }
+
+    auto featureEntry = co_await storage2::readOne(*stateStorage,
+        executor_v1::StateKeyView(
+            SYS_CONFIG, magic_enum::enum_name(Features::Flag::feature_state_tree)));
+    if (!featureEntry)
+    {
+        co_return std::nullopt;
+    }
+    auto [value, enableNumber] = featureEntry->getObject<SystemConfigEntry>();
+    if (enableNumber > currentNumber)
+    {
+        co_return std::nullopt;
+    }
+    // the keys written before the feature was enabled are not in the tree, an exclusion proof
+    // would claim them absent
+    if (enableNumber > 0)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(LedgerError::ErrorArgument,
+            "getStateProof is not available, feature_state_tree was enabled at block " +
+                std::to_string(enableNumber) + " instead of the genesis block"));
+    }
+    auto const& hashImpl = *m_blockFactory->cryptoSuite()->hashImpl();
+    co_return co_await state_tree::getStateProof(
+        *stateStorage, state_tree::keyPath(_table, _key, hashImpl));
+}
+
 void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     bcos::protocol::ConstTransactionsPtr _blockTxs, bcos::protocol::Block::ConstPtr block,
     std::function<void(std::string, Error::Ptr&&)> callback, bool writeTxsAndReceipts,
@@ -175,12 +216,15 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     auto header = block->blockHeader();
 
     auto blockNumberStr = boost::lexical_cast<std::string>(header->number());
+    auto logIndexRows = buildLogIndexRows(*block);
+    auto merkleRows = buildMerkleRows(*block);
 
     size_t TOTAL_CALLBACK = 8;
     if (writeTxsAndReceipts)
     {  // 9 storage callbacks and write hash=>tx
         TOTAL_CALLBACK = 9;
     }
+    TOTAL_CALLBACK += logIndexRows.size() + merkleRows.size();
     auto primiaryKey = bcos::storage::toDBKey(
         SYS_HASH_2_NUMBER, bcos::concepts::bytebuffer::toView(header->hash()));
     auto setRowCallback = [total = std::make_shared<std::atomic<size_t>>(TOTAL_CALLBACK),
@@ -232,7 +276,6 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
 
     // number 2 nonce
-    auto nonceBlock = m_blockFactory->createBlock();
     protocol::NonceList nonceList;
     // get nonce from _blockTxs
     if (_blockTxs)
@@ -251,12 +294,8 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
         }
     }
 
-    nonceBlock->setNonceList(nonceList);
-    bytes nonceBuffer;
-    nonceBlock->encode(nonceBuffer);
-
     Entry number2NonceEntry;
-    number2NonceEntry.importFields({std::move(nonceBuffer)});
+    number2NonceEntry.importFields({nonce_index::encodeNonces(nonceList)});
     storage->asyncSetRow(SYS_BLOCK_NUMBER_2_NONCES, blockNumberStr, std::move(number2NonceEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
 
@@ -299,6 +338,28 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     storage->asyncSetRow(SYS_NUMBER_2_TXS, blockNumberStr, std::move(number2TransactionHashesEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
 
+    // log index, written with the block so that it is committed together with the block
+    for (auto& [key, value] : logIndexRows)
+    {
+        Entry logIndexEntry;
+        logIndexEntry.set(std::move(value));
+        storage->asyncSetRow(
+            SYS_LOG_INDEX, key, std::move(logIndexEntry), [setRowCallback](auto&& error) {
+                setRowCallback(std::forward<decltype(error)>(error));
+            });
+    }
+
+    // merkle trees of the transactions and receipts, the proofs are read from them
+    for (auto& [table, value] : merkleRows)
+    {
+        Entry merkleEntry;
+        merkleEntry.set(std::move(value));
+        storage->asyncSetRow(
+            table, blockNumberStr, std::move(merkleEntry), [setRowCallback](auto&& error) {
+                setRowCallback(std::forward<decltype(error)>(error));
+            });
+    }
+
     std::atomic_int64_t totalCount = 0;
     std::atomic_int64_t failedCount = 0;
     if (writeTxsAndReceipts)
@@ -396,6 +457,188 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
         });
 }
 
+std::vector<log_index::Row> Ledger::buildLogIndexRows(protocol::Block const& block)
+{
+    auto number = block.blockHeader()->number();
+    auto bloom = log_index::blockBloom(block);
+    std::vector<log_index::Row> rows;
+    rows.emplace_back(log_index::blockKey(number), log_index::encodeBloom(bloom));
+    if ((number + 1) % log_index::LOG_INDEX_SECTION_SIZE != 0)
+    {
+        return rows;
+    }
+
+    // the last block of a section, build the section from the blooms of the committed blocks
+    auto section = number / log_index::LOG_INDEX_SECTION_SIZE;
+    auto sectionBegin = section * log_index::LOG_INDEX_SECTION_SIZE;
+    try
+    {
+        // the genesis block has no logs and is not prewritten
+        auto blooms = log_index::getBlockBlooms(
+            *getStateStorage(), std::max<protocol::BlockNumber>(sectionBegin, 1), number - 1);
+        if (blooms && sectionBegin == 0)
+        {
+            blooms->insert(blooms->begin(), Bloom{});
+        }
+        if (!blooms)
+        {
+            LEDGER_LOG(INFO) << LOG_DESC("skip building log index section with unindexed blocks")
+                             << LOG_KV("section", section) << LOG_KV("number", number);
+            return rows;
+        }
+        blooms->push_back(bloom);
+        auto sectionRows = log_index::buildSectionRows(section, *blooms);
+        rows.insert(rows.end(), std::make_move_iterator(sectionRows.begin()),
+            std::make_move_iterator(sectionRows.end()));
+    }
+    catch (std::exception& e)
+    {
+        LEDGER_LOG(WARNING) << LOG_DESC("build log index section failed")
+                            << LOG_KV("section", section) << LOG_KV("number", number)
+                            << LOG_KV("message", boost::diagnostic_information(e));
+    }
+    return rows;
+}
+
+std::vector<std::pair<std::string_view, std::string>> Ledger::buildMerkleRows(
+    protocol::Block const& block)
+{
+    auto hashImpl = m_blockFactory->cryptoSuite()->hashImpl();
+    std::vector<std::pair<std::string_view, std::string>> rows;
+    std::vector<crypto::HashType> leaves;
+    if (block.transactionsMetaDataSize() > 0)
+    {
+        for (auto hash : block.transactionHashes())
+        {
+            leaves.push_back(hash);
+        }
+    }
+    else
+    {
+        for (auto transaction : block.transactions())
+        {
+            leaves.push_back(transaction->hash());
+        }
+    }
+    if (!leaves.empty())
+    {
+        rows.emplace_back(
+            SYS_NUMBER_2_TX_MERKLE, block_merkle::encodeMerkle(hashImpl->hasher(), leaves));
+    }
+
+    leaves.clear();
+    for (auto receipt : block.receipts())
+    {
+        leaves.push_back(receipt->hash());
+    }
+    if (!leaves.empty())
+    {
+        rows.emplace_back(
+            SYS_NUMBER_2_RECEIPT_MERKLE, block_merkle::encodeMerkle(hashImpl->hasher(), leaves));
+    }
+    return rows;
+}
+
+task::Task<std::optional<std::vector<protocol::BlockNumber>>> Ledger::getLogIndexCandidates(
+    protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock,
+    std::vector<std::string> const& _addresses, std::vector<h256s> const& _topics)
+{
+    auto query = log_index::makeQuery(_addresses, _topics);
+    if (!query)
+    {
+        co_return std::nullopt;
+    }
+    co_return log_index::queryBlocks(*getStateStorage(), _fromBlock, _toBlock, *query);
+}
+
+void Ledger::asyncBuildLogIndex(protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock)
+{
+    if (_fromBlock > _toBlock)
+    {
+        LEDGER_LOG(INFO) << LOG_DESC("asyncBuildLogIndex finished") << LOG_KV("to", _toBlock);
+        return;
+    }
+    // the pending sections are dropped when the thread pool stops
+    m_threadPool->enqueue([this, _fromBlock, _toBlock]() {
+        auto sectionEnd = (_fromBlock / log_index::LOG_INDEX_SECTION_SIZE + 1) *
+                          log_index::LOG_INDEX_SECTION_SIZE;
+        auto end = std::min(_toBlock, sectionEnd - 1);
+        try
+        {
+            buildLogIndex(_fromBlock, end);
+        }
+        catch (std::exception& e)
+        {
+            LEDGER_LOG(WARNING) << LOG_DESC("asyncBuildLogIndex failed")
+                                << LOG_KV("from", _fromBlock) << LOG_KV("to", end)
+                                << LOG_KV("message", boost::diagnostic_information(e));
+            return;
+        }
+        asyncBuildLogIndex(end + 1, _toBlock);
+    });
+}
+
+void Ledger::buildLogIndex(protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock)
+{
+    auto storage = getStateStorage();
+    auto firstSection = _fromBlock / log_index::LOG_INDEX_SECTION_SIZE;
+    auto lastSection = _toBlock / log_index::LOG_INDEX_SECTION_SIZE;
+    for (auto section = firstSection; section <= lastSection; ++section)
+    {
+        auto sectionBegin = section * log_index::LOG_INDEX_SECTION_SIZE;
+        auto sectionEnd = sectionBegin + log_index::LOG_INDEX_SECTION_SIZE - 1;
+        auto begin = std::max(_fromBlock, sectionBegin);
+        auto end = std::min(_toBlock, sectionEnd);
+
+        std::vector<log_index::Row> rows;
+        std::vector<Bloom> blooms;
+        auto indexedBlooms = log_index::readBlockBlooms(*storage, begin, end);
+        for (auto number = begin; number <= end; ++number)
+        {
+            if (auto const& indexed = indexedBlooms[number - begin])
+            {
+                blooms.push_back(*indexed);
+                continue;
+            }
+            std::promise<std::pair<Error::Ptr, protocol::Block::Ptr>> blockPromise;
+            asyncGetBlockDataByNumber(
+                number, RECEIPTS, [&blockPromise](Error::Ptr error, protocol::Block::Ptr block) {
+                    blockPromise.set_value({std::move(error), std::move(block)});
+                });
+            auto [error, block] = blockPromise.get_future().get();
+            if (error)
+            {
+                BOOST_THROW_EXCEPTION(*error);
+            }
+            auto bloom = log_index::blockBloom(*block);
+            rows.emplace_back(log_index::blockKey(number), log_index::encodeBloom(bloom));
+            blooms.push_back(bloom);
+        }
+        if (begin == sectionBegin && end == sectionEnd)
+        {
+            auto sectionRows = log_index::buildSectionRows(section, blooms);
+            rows.insert(rows.end(), std::make_move_iterator(sectionRows.begin()),
+                std::make_move_iterator(sectionRows.end()));
+        }
+
+        for (auto& [key, value] : rows)
+        {
+            Entry entry;
+            entry.set(std::move(value));
+            std::promise<Error::UniquePtr> setPromise;
+            storage->asyncSetRow(SYS_LOG_INDEX, key, std::move(entry),
+                [&setPromise](Error::UniquePtr error) { setPromise.set_value(std::move(error)); });
+            if (auto error = setPromise.get_future().get())
+            {
+                BOOST_THROW_EXCEPTION(*error);
+            }
+        }
+        LEDGER_LOG(INFO) << LOG_DESC("buildLogIndex") << LOG_KV("section", section)
+                         << LOG_KV("begin", begin) << LOG_KV("end", end)
+                         << LOG_KV("rows", rows.size());
+    }
+}
+
 task::Task<std::optional<ledger::StorageState>> Ledger::getStorageState(
     std::string_view _address, protocol::BlockNumber _blockNumber)
 {
@@ -992,6 +1235,30 @@ void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txH
         });
 }
 
+void Ledger::asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+    std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::Ptr>)> _onGetReceipts)
+{
+    if (!_txHashList)
+    {
+        LEDGER_LOG(ERROR) << "GetBatchReceiptsByHashList error, wrong argument";
+        _onGetReceipts(BCOS_ERROR_PTR(LedgerError::ErrorArgument, "Wrong argument"), {});
+        return;
+    }
+
+    LEDGER_LOG(TRACE) << "GetBatchReceiptsByHashList request"
+                      << LOG_KV("hashes", _txHashList->size());
+    auto keys = std::make_shared<std::vector<std::string>>();
+    keys->reserve(_txHashList->size());
+    for (auto const& hash : *_txHashList)
+    {
+        keys->emplace_back(hash.begin(), hash.end());
+    }
+    asyncBatchGetReceipts(keys, [callback = std::move(_onGetReceipts)](Error::Ptr&& error,
+                                    std::vector<protocol::TransactionReceipt::Ptr>&& receipts) {
+        callback(std::move(error), std::move(receipts));
+    });
+}
+
 void Ledger::asyncGetTotalTransactionCount(
     std::function<void(Error::Ptr, int64_t, int64_t, bcos::protocol::BlockNumber)> _callback)
 {
@@ -1155,68 +1422,58 @@ void Ledger::asyncGetNonceList(bcos::protocol::BlockNumber _startNumber, int64_t
         return;
     }
 
-    m_stateStorage->asyncOpenTable(
-        SYS_BLOCK_NUMBER_2_NONCES, [this, callback = std::move(_onGetList), _startNumber, _offset](
-                                       auto&& error, std::optional<Table>&& table) mutable {
-            auto tableError = checkTableValid(
-                std::forward<decltype(error)>(error), table, SYS_BLOCK_NUMBER_2_NONCES);
-            if (tableError)
+    // the nonces of the whole window in one read of the rows, without decoding any block
+    auto numberRange = ::ranges::views::iota(_startNumber, _startNumber + _offset + 1);
+    auto numberList = numberRange | ::ranges::views::transform([](BlockNumber blockNumber) {
+        return boost::lexical_cast<std::string>(blockNumber);
+    }) | ::ranges::to<std::vector<std::string>>();
+
+    m_stateStorage->asyncGetRows(SYS_BLOCK_NUMBER_2_NONCES, numberList,
+        [this, numberRange, callback = std::move(_onGetList)](
+            auto&& error, std::vector<std::optional<Entry>>&& entries) {
+            if (error)
             {
-                callback(std::move(tableError), nullptr);
+                LEDGER_LOG(INFO) << "GetNonceList failed" << boost::diagnostic_information(*error);
+                callback(
+                    BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError, "GetNonceList", *error),
+                    nullptr);
                 return;
             }
 
-            auto numberRange = ::ranges::views::iota(_startNumber, _startNumber + _offset + 1);
-            auto numberList = numberRange | ::ranges::views::transform([](BlockNumber blockNumber) {
-                return boost::lexical_cast<std::string>(blockNumber);
-            }) | ::ranges::to<std::vector<std::string>>();
+            auto retMap =
+                std::make_shared<std::map<protocol::BlockNumber, protocol::NonceListPtr>>();
 
-            table->asyncGetRows(
-                numberList, [this, numberRange, callback = std::move(callback)](
-                                auto&& error, std::vector<std::optional<Entry>>&& entries) {
-                    if (error)
+            for (auto const& [number, entry] : ::ranges::views::zip(numberRange, entries))
+            {
+                try
+                {
+                    if (!entry)
                     {
-                        LEDGER_LOG(INFO)
-                            << "GetNonceList failed" << boost::diagnostic_information(*error);
-                        callback(BCOS_ERROR_WITH_PREV_PTR(
-                                     LedgerError::GetStorageError, "GetNonceList", *error),
-                            nullptr);
-                        return;
+                        continue;
                     }
 
-                    auto retMap =
-                        std::make_shared<std::map<protocol::BlockNumber, protocol::NonceListPtr>>();
-
-                    for (auto const& [number, entry] : ::ranges::views::zip(numberRange, entries))
+                    auto value = entry->getField(0);
+                    if (auto nonces = nonce_index::decodeNonces(value))
                     {
-                        try
-                        {
-                            if (!entry)
-                            {
-                                continue;
-                            }
-
-                            auto value = entry->getField(0);
-                            auto block = m_blockFactory->createBlock(
-                                bcos::bytesConstRef((bcos::byte*)value.data(), value.size()), false,
-                                false);
-
-                            retMap->emplace(std::make_pair(
-                                number, std::make_shared<NonceList>(
-                                            block->nonceList() | ::ranges::to<NonceList>())));
-                        }
-                        catch (std::exception const& e)
-                        {
-                            LEDGER_LOG(WARNING)
-                                << "Parse nonce list failed" << boost::diagnostic_information(e);
-                            continue;
-                        }
+                        retMap->emplace(number, std::make_shared<NonceList>(std::move(*nonces)));
+                        continue;
                     }
+                    // the rows written as a tars Block before the nonce index format
+                    auto block = m_blockFactory->createBlock(
+                        bcos::bytesConstRef((bcos::byte*)value.data(), value.size()), false, false);
+                    retMap->emplace(number, std::make_shared<NonceList>(
+                                                block->nonceList() | ::ranges::to<NonceList>()));
+                }
+                catch (std::exception const& e)
+                {
+                    LEDGER_LOG(WARNING)
+                        << "Parse nonce list failed" << boost::diagnostic_information(e);
+                    continue;
+                }
+            }
 
-                    LEDGER_LOG(TRACE)
-                        << "GetNonceList success" << LOG_KV("retMap size", retMap->size());
-                    callback(nullptr, std::move(retMap));
-                });
+            LEDGER_LOG(TRACE) << "GetNonceList success" << LOG_KV("retMap size", retMap->size());
+            callback(nullptr, std::move(retMap));
         });
 }
 
@@ -1651,10 +1908,33 @@ static std::shared_ptr<std::vector<h256>> getMerkleTreeFromCache(int64_t blockNu
     return merkleTree;
 }
 
+void Ledger::asyncGetStoredMerkleProof(std::string_view _table,
+    protocol::BlockNumber _blockNumber, const crypto::HashType& _hash,
+    std::function<void(std::optional<MerkleProof>&&)> _onGetProof)
+{
+    m_stateStorage->asyncGetRow(_table, boost::lexical_cast<std::string>(_blockNumber),
+        [this, table = std::string(_table), _blockNumber, _hash,
+            _onGetProof = std::move(_onGetProof)](
+            Error::UniquePtr error, std::optional<Entry> entry) {
+            if (error || !entry)
+            {
+                // blocks written before the merkle trees were persisted have no row
+                LEDGER_LOG(TRACE) << LOG_BADGE("asyncGetStoredMerkleProof")
+                                  << LOG_DESC("no stored merkle tree") << LOG_KV("table", table)
+                                  << LOG_KV("blockNumber", _blockNumber)
+                                  << LOG_KV("error", error ? error->errorMessage() : "");
+                _onGetProof(std::nullopt);
+                return;
+            }
+            _onGetProof(block_merkle::getMerkleProof(
+                m_blockFactory->cryptoSuite()->hashImpl()->hasher(), entry->get(), _hash));
+        });
+}
+
 void Ledger::getTxProof(
     const HashType& _txHash, std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
-    // txHash->receipt receipt->number number->txHash
+    // txHash->receipt receipt->number number->merkle
     asyncGetTransactionReceiptByHash(_txHash, false,
         [this, _txHash, _onGetProof = std::move(_onGetProof)](
             Error::Ptr _error, TransactionReceipt::ConstPtr _receipt, const MerkleProofPtr&) {
@@ -1667,51 +1947,66 @@ void Ledger::getTxProof(
                 return;
             }
             auto blockNumber = _receipt->blockNumber();
-            asyncGetBlockTransactionHashes(
-                blockNumber, [this, _onGetProof, _txHash = std::move(_txHash), blockNumber](
-                                 Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
-                    if (_error || _hashList.empty())
+            asyncGetStoredMerkleProof(SYS_NUMBER_2_TX_MERKLE, blockNumber, _txHash,
+                [this, _txHash, blockNumber, _onGetProof](std::optional<MerkleProof>&& _proof) {
+                    if (_proof)
+                    {
+                        LEDGER_LOG(TRACE) << LOG_BADGE("getTxProof")
+                                          << LOG_DESC("get stored merkle proof success")
+                                          << LOG_KV("txHash", _txHash.hex());
+                        _onGetProof(nullptr, std::make_shared<MerkleProof>(std::move(*_proof)));
+                        return;
+                    }
+                    buildTxProof(blockNumber, _txHash, _onGetProof);
+                });
+        });
+}
+
+void Ledger::buildTxProof(protocol::BlockNumber blockNumber, const HashType& _txHash,
+    std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
+{
+    // number->txHash, rebuild the merkle tree from the transactions of the block
+    asyncGetBlockTransactionHashes(
+        blockNumber, [this, _onGetProof = std::move(_onGetProof), _txHash, blockNumber](
+                         Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
+            if (_error || _hashList.empty())
+            {
+                LEDGER_LOG(DEBUG) << LOG_BADGE("getTxProof")
+                                  << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
+                                  << LOG_KV("txHash", _txHash.hex());
+                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
+                return;
+            }
+            asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
+                [this, cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
+                    _txHash = std::move(_txHash), blockNumber](
+                    Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
+                    if (_error || _txList.empty())
                     {
                         LEDGER_LOG(DEBUG)
-                            << LOG_BADGE("getTxProof")
-                            << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
-                            << LOG_KV("txHash", _txHash.hex());
+                            << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback failed")
+                            << LOG_KV("code", _error->errorCode())
+                            << LOG_KV("msg", _error->errorMessage());
                         _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                         return;
                     }
-                    asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
-                        [this, cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
-                            _txHash = std::move(_txHash), blockNumber](
-                            Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
-                            if (_error || _txList.empty())
-                            {
-                                LEDGER_LOG(DEBUG)
-                                    << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback failed")
-                                    << LOG_KV("code", _error->errorCode())
-                                    << LOG_KV("msg", _error->errorMessage());
-                                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
-                                return;
-                            }
-                            auto merkleProofPtr = std::make_shared<MerkleProof>();
-                            bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
-                            auto hashesRange =
-                                _txList |
-                                ::ranges::views::transform([](const Transaction::Ptr& transaction) {
-                                    return transaction->hash();
-                                });
+                    auto merkleProofPtr = std::make_shared<MerkleProof>();
+                    bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
+                    auto hashesRange =
+                        _txList |
+                        ::ranges::views::transform([](const Transaction::Ptr& transaction) {
+                            return transaction->hash();
+                        });
 
-                            auto merkleTree =
-                                getMerkleTreeFromCache(blockNumber, m_txProofMerkleCache,
-                                    m_txMerkleMtx, "getTxProof", merkle, hashesRange);
-                            merkle.generateMerkleProof(
-                                hashesRange, *merkleTree, _txHash, *merkleProofPtr);
+                    auto merkleTree = getMerkleTreeFromCache(blockNumber, m_txProofMerkleCache,
+                        m_txMerkleMtx, "getTxProof", merkle, hashesRange);
+                    merkle.generateMerkleProof(hashesRange, *merkleTree, _txHash, *merkleProofPtr);
 
-                            LEDGER_LOG(TRACE)
-                                << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
-                                << LOG_KV("txHash", _txHash.hex());
+                    LEDGER_LOG(TRACE) << LOG_BADGE("getTxProof")
+                                      << LOG_DESC("get merkle proof success")
+                                      << LOG_KV("txHash", _txHash.hex());
 
-                            _onGetProof(nullptr, std::move(merkleProofPtr));
-                        });
+                    _onGetProof(nullptr, std::move(merkleProofPtr));
                 });
         });
 }
@@ -1719,10 +2014,30 @@ void Ledger::getTxProof(
 void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
     std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
-    // receipt->number number->txs txs->receipts
+    // receipt->number number->merkle
     auto blockNumber = _receipt->blockNumber();
+    auto receiptHash = _receipt->hash();
+    asyncGetStoredMerkleProof(SYS_NUMBER_2_RECEIPT_MERKLE, blockNumber, receiptHash,
+        [this, receiptHash, blockNumber, _onGetProof = std::move(_onGetProof)](
+            std::optional<MerkleProof>&& _proof) {
+            if (_proof)
+            {
+                LEDGER_LOG(TRACE) << LOG_BADGE("getReceiptProof")
+                                  << LOG_DESC("get stored merkle proof success")
+                                  << LOG_KV("receiptHash", receiptHash.hex());
+                _onGetProof(nullptr, std::make_shared<MerkleProof>(std::move(*_proof)));
+                return;
+            }
+            buildReceiptProof(blockNumber, receiptHash, _onGetProof);
+        });
+}
+
+void Ledger::buildReceiptProof(protocol::BlockNumber blockNumber, const HashType& receiptHash,
+    std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
+{
+    // number->txs txs->receipts, rebuild the merkle tree from the receipts of the block
     asyncGetBlockTransactionHashes(blockNumber,
-        [this, _onGetProof = std::move(_onGetProof), receiptHash = _receipt->hash(), blockNumber](
+        [this, _onGetProof = std::move(_onGetProof), receiptHash, blockNumber](
             Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
             if (_error)
             {
@@ -18,6 +18,8 @@
  * @date 2021-04-13
  */
 #pragma once
+#include "BlockMerkle.h"
+#include "LogIndex.h"
 #include "bcos-framework/ledger/GenesisConfig.h"
 #include "bcos-framework/ledger/LedgerInterface.h"
 #include "bcos-framework/ledger/LedgerTypeDef.h"
@@ -90,6 +92,10 @@ public:
         std::function<void(Error::Ptr, bcos::protocol::TransactionReceipt::Ptr, MerkleProofPtr)>
             _onGetTx) override;
 
+    void asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+        std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::Ptr>)>
+            _onGetReceipts) override;
+
     void asyncGetTotalTransactionCount(
         std::function<void(Error::Ptr, int64_t, int64_t, bcos::protocol::BlockNumber)> _callback)
         override;
@@ -116,6 +122,19 @@ public:
     task::Task<std::optional<storage::Entry>> getStorageAt(std::string_view _address,
         std::string_view _key, protocol::BlockNumber _blockNumber) override;
 
+    task::Task<std::optional<state_tree::StateProof>> getStateProof(std::string_view _table,
+        std::string_view _key, protocol::BlockNumber _blockNumber) override;
+
+    task::Task<std::optional<std::vector<protocol::BlockNumber>>> getLogIndexCandidates(
+        protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock,
+        std::vector<std::string> const& _addresses, std::vector<h256s> const& _topics) override;
+
+    // build the log index of the blocks in [_fromBlock, _toBlock] committed before the log index
+    // was introduced, the blocks already indexed are skipped
+    void buildLogIndex(protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock);
+    // build the log index in the background, one section at a time
+    void asyncBuildLogIndex(protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock);
+
     bool buildGenesisBlock(GenesisConfig const& genesis, ledger::LedgerConfig const& ledgerConfig);
 
     void asyncGetBlockTransactionHashes(bcos::protocol::BlockNumber blockNumber,
@@ -149,12 +168,30 @@ private:
     void getTxProof(const crypto::HashType& _txHash,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
+    void buildTxProof(protocol::BlockNumber blockNumber, const crypto::HashType& _txHash,
+        std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
+
     void getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
+    void buildReceiptProof(protocol::BlockNumber blockNumber, const crypto::HashType& receiptHash,
+        std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
+
+    // the proof from the merkle tree persisted with the block, std::nullopt if there is none
+    void asyncGetStoredMerkleProof(std::string_view _table, protocol::BlockNumber _blockNumber,
+        const crypto::HashType& _hash,
+        std::function<void(std::optional<MerkleProof>&&)> _onGetProof);
+
     void asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
         std::function<void(Error::Ptr&&, std::optional<bcos::storage::Entry>&&)> callback);
 
+    // the log index rows of the block, and the rows of its section if it is the last block
+    std::vector<log_index::Row> buildLogIndexRows(protocol::Block const& block);
+
+    // the merkle tree rows of the transactions and receipts of the block, keyed by table
+    std::vector<std::pair<std::string_view, std::string>> buildMerkleRows(
+        protocol::Block const& block);
+
     void createFileSystemTables(uint32_t blockVersion);
 
     bcos::storage::StorageInterface::Ptr getBlockStorage()
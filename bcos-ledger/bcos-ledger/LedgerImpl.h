@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Ledger.h"
+#include "NonceIndex.h"
 #include "bcos-framework/ledger/Ledger.h"
 #include "bcos-task/Task.h"
 #include <bcos-concepts/Basic.h>
@@ -466,8 +467,14 @@ private:
             co_return;
         }
 
-        std::remove_reference_t<decltype(block)> nonceBlock;
         auto field = entry->getField(0);
+        if (auto nonces = nonce_index::decodeNonces(field))
+        {
+            block.nonceList = std::move(*nonces);
+            co_return;
+        }
+        // the rows written as a tars Block before the nonce index format
+        std::remove_reference_t<decltype(block)> nonceBlock;
         bcos::concepts::serialize::decode(field, nonceBlock);
         block.nonceList = std::move(nonceBlock.nonceList);
     }
@@ -533,12 +540,8 @@ private:
     {
         LEDGER_LOG(DEBUG) << "setBlockData nonce " << blockNumberKey;
 
-        std::remove_cvref_t<decltype(block)> blockNonceList;
-        blockNonceList.nonceList = std::move(block.nonceList);
         bcos::storage::Entry number2NonceEntry;
-        std::vector<bcos::byte> number2NonceBuffer;
-        bcos::concepts::serialize::encode(blockNonceList, number2NonceBuffer);
-        number2NonceEntry.importFields({std::move(number2NonceBuffer)});
+        number2NonceEntry.importFields({nonce_index::encodeNonces(block.nonceList)});
         storage().setRow(SYS_BLOCK_NUMBER_2_NONCES, blockNumberKey, std::move(number2NonceEntry));
 
         co_return;
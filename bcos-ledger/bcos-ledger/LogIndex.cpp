@@ -0,0 +1,317 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LogIndex.cpp
+ */
+
+#include "LogIndex.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <boost/throw_exception.hpp>
+#include <cstring>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::ledger::log_index;
+
+static std::vector<std::optional<storage::Entry>> getIndexRows(
+    storage::StorageInterface& storage, std::vector<std::string> const& keys)
+{
+    std::promise<std::pair<Error::UniquePtr, std::vector<std::optional<storage::Entry>>>> promise;
+    storage.asyncGetRows(SYS_LOG_INDEX, keys,
+        [&promise](Error::UniquePtr error, std::vector<std::optional<storage::Entry>> entries) {
+            promise.set_value({std::move(error), std::move(entries)});
+        });
+    auto [error, entries] = promise.get_future().get();
+    if (error)
+    {
+        BOOST_THROW_EXCEPTION(*error);
+    }
+    return std::move(entries);
+}
+
+static bool hasBitmapBit(std::string_view bitmap, size_t offset)
+{
+    // an absent bitmap has no bit set
+    return !bitmap.empty() && (bitmap[offset / 8] & (1 << (offset % 8))) != 0;
+}
+
+std::string log_index::blockKey(protocol::BlockNumber number)
+{
+    return "block_" + std::to_string(number);
+}
+
+std::string log_index::sectionKey(int64_t section)
+{
+    return "section_" + std::to_string(section);
+}
+
+std::string log_index::sectionBitKey(int64_t section, size_t bit)
+{
+    return sectionKey(section) + "_" + std::to_string(bit);
+}
+
+BloomBits log_index::bloomBits(bytesConstRef value)
+{
+    auto hash = crypto::keccak256Hash(value);
+    BloomBits bits{};
+    for (size_t i = 0; i < BLOOM_BITS_PER_VALUE; ++i)
+    {
+        bits[i] = static_cast<uint16_t>(((hash[i * 2] & LOWER_3_BITS) << 8) + hash[i * 2 + 1]);
+    }
+    return bits;
+}
+
+bool log_index::hasBloomBit(Bloom const& bloom, size_t bit)
+{
+    return (bloom[BloomBytesSize - 1 - bit / 8] & (1 << (bit % 8))) != 0;
+}
+
+Bloom log_index::blockBloom(protocol::Block const& block)
+{
+    Bloom bloom{};
+    for (auto receipt : block.receipts())
+    {
+        for (auto const& log : receipt->logEntries())
+        {
+            auto address = log.address();
+            bytesToBloom(bytesConstRef((const byte*)address.data(), address.size()), bloom);
+            for (auto const& topic : log.topics())
+            {
+                bytesToBloom(topic, bloom);
+            }
+        }
+    }
+    return bloom;
+}
+
+std::string log_index::encodeBloom(Bloom const& bloom)
+{
+    // most blocks have no logs, keep their rows small
+    if (std::ranges::all_of(bloom, [](auto byte) { return byte == 0; }))
+    {
+        return std::string(1, '\0');
+    }
+    return {(const char*)bloom.data(), bloom.size()};
+}
+
+Bloom log_index::decodeBloom(std::string_view value)
+{
+    Bloom bloom{};
+    if (value.size() == BloomBytesSize)
+    {
+        std::memcpy(bloom.data(), value.data(), BloomBytesSize);
+    }
+    return bloom;
+}
+
+bool LogIndexQuery::matches(Bloom const& bloom) const
+{
+    return matchesBits([&bloom](size_t bit) { return hasBloomBit(bloom, bit); });
+}
+
+std::optional<LogIndexQuery> log_index::makeQuery(
+    std::vector<std::string> const& addresses, std::vector<h256s> const& topics)
+{
+    LogIndexQuery query;
+    if (!addresses.empty())
+    {
+        auto& group = query.groups.emplace_back();
+        for (auto const& address : addresses)
+        {
+            group.push_back(bloomBits(bytesConstRef((const byte*)address.data(), address.size())));
+        }
+    }
+    for (auto const& position : topics)
+    {
+        if (position.empty())
+        {
+            continue;
+        }
+        auto& group = query.groups.emplace_back();
+        for (auto const& topic : position)
+        {
+            group.push_back(bloomBits(topic.ref()));
+        }
+    }
+    if (query.groups.empty())
+    {
+        return std::nullopt;
+    }
+    return query;
+}
+
+std::vector<std::optional<Bloom>> log_index::readBlockBlooms(
+    storage::StorageInterface& storage, protocol::BlockNumber from, protocol::BlockNumber to)
+{
+    std::vector<std::optional<Bloom>> blooms;
+    if (from > to)
+    {
+        return blooms;
+    }
+    std::vector<std::string> keys;
+    keys.reserve(to - from + 1);
+    for (auto number = from; number <= to; ++number)
+    {
+        keys.push_back(blockKey(number));
+    }
+    auto entries = getIndexRows(storage, keys);
+    blooms.reserve(entries.size());
+    for (auto const& entry : entries)
+    {
+        blooms.push_back(entry ? std::make_optional(decodeBloom(entry->get())) : std::nullopt);
+    }
+    return blooms;
+}
+
+std::optional<std::vector<Bloom>> log_index::getBlockBlooms(
+    storage::StorageInterface& storage, protocol::BlockNumber from, protocol::BlockNumber to)
+{
+    std::vector<Bloom> blooms;
+    for (auto& bloom : readBlockBlooms(storage, from, to))
+    {
+        if (!bloom)
+        {
+            return std::nullopt;
+        }
+        blooms.push_back(*bloom);
+    }
+    return blooms;
+}
+
+std::vector<Row> log_index::buildSectionRows(int64_t section, std::span<const Bloom> blooms)
+{
+    std::vector<std::string> bitmaps(BLOOM_BITS);
+    Bloom sectionBloom{};
+    for (size_t offset = 0; offset < blooms.size(); ++offset)
+    {
+        auto const& bloom = blooms[offset];
+        orBloom(sectionBloom, bloom);
+        for (size_t index = 0; index < BloomBytesSize; ++index)
+        {
+            if (bloom[index] == 0)
+            {
+                continue;
+            }
+            for (size_t bitInByte = 0; bitInByte < 8; ++bitInByte)
+            {
+                if ((bloom[index] & (1 << bitInByte)) == 0)
+                {
+                    continue;
+                }
+                auto& bitmap = bitmaps[(BloomBytesSize - 1 - index) * 8 + bitInByte];
+                if (bitmap.empty())
+                {
+                    bitmap.assign(SECTION_BITMAP_BYTES, '\0');
+                }
+                bitmap[offset / 8] = (char)(bitmap[offset / 8] | (1 << (offset % 8)));
+            }
+        }
+    }
+
+    std::vector<Row> rows;
+    for (size_t bit = 0; bit < BLOOM_BITS; ++bit)
+    {
+        if (!bitmaps[bit].empty())
+        {
+            rows.emplace_back(sectionBitKey(section, bit), std::move(bitmaps[bit]));
+        }
+    }
+    // the section row marks the section as built, keep it last
+    rows.emplace_back(sectionKey(section), encodeBloom(sectionBloom));
+    return rows;
+}
+
+std::vector<protocol::BlockNumber> log_index::queryBlocks(storage::StorageInterface& storage,
+    protocol::BlockNumber from, protocol::BlockNumber to, LogIndexQuery const& query)
+{
+    std::vector<protocol::BlockNumber> blocks;
+    if (from > to)
+    {
+        return blocks;
+    }
+    auto firstSection = from / LOG_INDEX_SECTION_SIZE;
+    auto lastSection = to / LOG_INDEX_SECTION_SIZE;
+    std::vector<std::string> sectionKeys;
+    for (auto section = firstSection; section <= lastSection; ++section)
+    {
+        sectionKeys.push_back(sectionKey(section));
+    }
+    auto sectionEntries = getIndexRows(storage, sectionKeys);
+
+    std::vector<uint16_t> queryBits;
+    for (auto const& group : query.groups)
+    {
+        for (auto const& bits : group)
+        {
+            queryBits.insert(queryBits.end(), bits.begin(), bits.end());
+        }
+    }
+    std::ranges::sort(queryBits);
+    queryBits.erase(std::unique(queryBits.begin(), queryBits.end()), queryBits.end());
+
+    for (auto section = firstSection; section <= lastSection; ++section)
+    {
+        auto sectionBegin = section * LOG_INDEX_SECTION_SIZE;
+        auto begin = std::max(from, sectionBegin);
+        auto end = std::min(to, sectionBegin + LOG_INDEX_SECTION_SIZE - 1);
+        auto const& sectionEntry = sectionEntries[section - firstSection];
+        if (!sectionEntry)
+        {
+            // the section is not built yet, check the blooms of its blocks one by one
+            auto blooms = readBlockBlooms(storage, begin, end);
+            for (auto number = begin; number <= end; ++number)
+            {
+                auto const& bloom = blooms[number - begin];
+                if (!bloom || query.matches(*bloom))
+                {
+                    blocks.push_back(number);
+                }
+            }
+            continue;
+        }
+        if (!query.matches(decodeBloom(sectionEntry->get())))
+        {
+            continue;
+        }
+
+        std::vector<std::string> keys;
+        keys.reserve(queryBits.size());
+        for (auto bit : queryBits)
+        {
+            keys.push_back(sectionBitKey(section, bit));
+        }
+        auto entries = getIndexRows(storage, keys);
+        std::vector<std::string_view> bitmaps(BLOOM_BITS);
+        for (size_t i = 0; i < queryBits.size(); ++i)
+        {
+            if (entries[i] && entries[i]->get().size() == SECTION_BITMAP_BYTES)
+            {
+                bitmaps[queryBits[i]] = entries[i]->get();
+            }
+        }
+        for (auto number = begin; number <= end; ++number)
+        {
+            auto offset = static_cast<size_t>(number - sectionBegin);
+            if (query.matchesBits(
+                    [&](size_t bit) { return hasBitmapBit(bitmaps[bit], offset); }))
+            {
+                blocks.push_back(number);
+            }
+        }
+    }
+    return blocks;
+}
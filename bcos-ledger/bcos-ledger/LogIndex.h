@@ -0,0 +1,100 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LogIndex.h
+ * @brief the log index used to skip the blocks without matching logs in getLogs
+ */
+
+#pragma once
+#include "bcos-framework/protocol/Block.h"
+#include "bcos-framework/protocol/ProtocolTypeDef.h"
+#include "bcos-framework/storage/StorageInterface.h"
+#include <bcos-utilities/Bloom.h>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bcos::ledger::log_index
+{
+/**
+ * The log index is stored in SYS_LOG_INDEX with three kinds of rows:
+ *  - block_<number>: the logs bloom of the block, written when the block is prewritten. A block
+ *    without this row is not indexed and always matches.
+ *  - section_<section>: the OR of the blooms of the LOG_INDEX_SECTION_SIZE blocks of the section,
+ *    written when the last block of the section is prewritten.
+ *  - section_<section>_<bit>: the posting bitmap of a bloom bit, one bit per block of the section.
+ *    An address or topic sets BLOOM_BITS_PER_VALUE bloom bits, so the blocks it may appear in are
+ *    the AND of its bitmaps, and a query reads a few bitmaps per section instead of every block.
+ */
+constexpr static protocol::BlockNumber LOG_INDEX_SECTION_SIZE = 4096;
+constexpr static size_t BLOOM_BITS = BloomBytesSize * 8;
+constexpr static size_t BLOOM_BITS_PER_VALUE = 3;
+constexpr static size_t SECTION_BITMAP_BYTES = LOG_INDEX_SECTION_SIZE / 8;
+
+using BloomBits = std::array<uint16_t, BLOOM_BITS_PER_VALUE>;
+using Row = std::pair<std::string, std::string>;
+
+std::string blockKey(protocol::BlockNumber number);
+std::string sectionKey(int64_t section);
+std::string sectionBitKey(int64_t section, size_t bit);
+
+// the bloom bits of an address or a topic, the same bits bytesToBloom sets
+BloomBits bloomBits(bytesConstRef value);
+bool hasBloomBit(Bloom const& bloom, size_t bit);
+
+// the bloom of all the logs in the receipts of the block
+Bloom blockBloom(protocol::Block const& block);
+
+std::string encodeBloom(Bloom const& bloom);
+Bloom decodeBloom(std::string_view value);
+
+// A query matches a block when every group matches, a group matches when any of its values does
+struct LogIndexQuery
+{
+    std::vector<std::vector<BloomBits>> groups;
+
+    bool matchesBits(auto&& hasBit) const
+    {
+        return std::ranges::all_of(groups, [&](auto const& group) {
+            return std::ranges::any_of(
+                group, [&](BloomBits const& bits) { return std::ranges::all_of(bits, hasBit); });
+        });
+    }
+    bool matches(Bloom const& bloom) const;
+};
+
+// std::nullopt when the filter matches every log, the index can not skip any block then
+std::optional<LogIndexQuery> makeQuery(
+    std::vector<std::string> const& addresses, std::vector<h256s> const& topics);
+
+// the blooms of the blocks in [from, to], std::nullopt for the blocks not indexed
+std::vector<std::optional<Bloom>> readBlockBlooms(
+    storage::StorageInterface& storage, protocol::BlockNumber from, protocol::BlockNumber to);
+
+// the blooms of the blocks in [from, to], std::nullopt if any of the blocks is not indexed
+std::optional<std::vector<Bloom>> getBlockBlooms(
+    storage::StorageInterface& storage, protocol::BlockNumber from, protocol::BlockNumber to);
+
+// the section rows built from the blooms of all the blocks of the section in block order
+std::vector<Row> buildSectionRows(int64_t section, std::span<const Bloom> blooms);
+
+// the blocks in [from, to] that may contain a log matching the query in ascending order
+std::vector<protocol::BlockNumber> queryBlocks(storage::StorageInterface& storage,
+    protocol::BlockNumber from, protocol::BlockNumber to, LogIndexQuery const& query);
+}  // namespace bcos::ledger::log_index
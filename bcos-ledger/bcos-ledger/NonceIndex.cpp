@@ -0,0 +1,119 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file NonceIndex.cpp
+ */
+
+#include "NonceIndex.h"
+#include <boost/throw_exception.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::ledger::nonce_index;
+
+constexpr static size_t HEADER_SIZE = 2 + 4 + 4;
+
+static void appendUint32(std::string& buffer, size_t value)
+{
+    if (value > UINT32_MAX)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("nonce index value too large"));
+    }
+    for (auto shift : {24, 16, 8, 0})
+    {
+        buffer.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+static size_t readUint32(std::string_view value, size_t offset)
+{
+    size_t number = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        number = (number << 8) | static_cast<uint8_t>(value[offset + i]);
+    }
+    return number;
+}
+
+std::string nonce_index::encodeNonces(protocol::NonceList const& nonces)
+{
+    size_t width = nonces.empty() ? 0 : nonces.front().size();
+    size_t dataSize = 0;
+    for (auto const& nonce : nonces)
+    {
+        if (nonce.size() != width)
+        {
+            width = 0;
+        }
+        dataSize += nonce.size();
+    }
+    // an empty nonce has no width, all of them are stored with their lengths
+    auto fixedWidth = width > 0;
+
+    std::string buffer;
+    buffer.reserve(HEADER_SIZE + dataSize + (fixedWidth ? 0 : nonces.size() * 4));
+    buffer.push_back(static_cast<char>(NONCE_INDEX_MARKER));
+    buffer.push_back(static_cast<char>(NONCE_INDEX_VERSION));
+    appendUint32(buffer, nonces.size());
+    appendUint32(buffer, width);
+    if (!fixedWidth)
+    {
+        for (auto const& nonce : nonces)
+        {
+            appendUint32(buffer, nonce.size());
+        }
+    }
+    for (auto const& nonce : nonces)
+    {
+        buffer.append(nonce);
+    }
+    return buffer;
+}
+
+std::optional<protocol::NonceList> nonce_index::decodeNonces(std::string_view value)
+{
+    if (value.empty() || static_cast<uint8_t>(value[0]) != NONCE_INDEX_MARKER)
+    {
+        return std::nullopt;
+    }
+    if (value.size() < HEADER_SIZE || static_cast<uint8_t>(value[1]) != NONCE_INDEX_VERSION)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("invalid nonce index row"));
+    }
+    auto count = readUint32(value, 2);
+    auto width = readUint32(value, 6);
+    size_t offset = HEADER_SIZE;
+    auto dataOffset = width > 0 ? offset : offset + count * 4;
+    if (dataOffset > value.size() || (width > 0 && count * width != value.size() - offset))
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("truncated nonce index row"));
+    }
+
+    protocol::NonceList nonces;
+    nonces.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto size = width > 0 ? width : readUint32(value, offset + i * 4);
+        if (size > value.size() - dataOffset)
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("truncated nonce index row"));
+        }
+        nonces.emplace_back(value.substr(dataOffset, size));
+        dataOffset += size;
+    }
+    return nonces;
+}
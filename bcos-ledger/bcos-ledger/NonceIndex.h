@@ -0,0 +1,44 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file NonceIndex.h
+ * @brief the format of the nonces of a block in SYS_BLOCK_NUMBER_2_NONCES
+ */
+
+#pragma once
+#include "bcos-framework/protocol/ProtocolTypeDef.h"
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bcos::ledger::nonce_index
+{
+/**
+ * The nonces of a block are stored as:
+ *  - the marker byte 0x00 and the format version. A row written as a tars Block with only the
+ *    nonce list never starts with 0x00, since the fields of Block start at tag 1.
+ *  - the number of nonces and the width of them, as 4 bytes big endian integers. The width is 0
+ *    when the nonces are not of the same length.
+ *  - with a width, the nonces one after another in block order.
+ *  - without a width, the 4 bytes big endian length of each nonce, then the nonces in block order.
+ */
+constexpr static uint8_t NONCE_INDEX_MARKER = 0x00;
+constexpr static uint8_t NONCE_INDEX_VERSION = 1;
+
+std::string encodeNonces(protocol::NonceList const& nonces);
+
+// std::nullopt when the row is not in this format, a row written as a tars Block before it
+std::optional<protocol::NonceList> decodeNonces(std::string_view value);
+}  // namespace bcos::ledger::nonce_index
@@ -35,6 +35,7 @@
 #include "bcos-framework/storage/LegacyStorageMethods.h"
 #include "bcos-framework/transaction-executor/StateKey.h"
 #include "bcos-ledger/LedgerMethods.h"
+#include "bcos-ledger/NonceIndex.h"
 #include "bcos-task/Wait.h"
 #include "bcos-tool/BfsFileFactory.h"
 #include "bcos-tool/NodeConfig.h"
@@ -1216,6 +1217,114 @@ BOOST_AUTO_TEST_CASE(getTransactionReceiptByHash)
     BOOST_CHECK_EQUAL(f4.get(), true);
 }
 
+BOOST_AUTO_TEST_CASE(getBatchReceiptsByHashList)
+{
+    initFixture();
+    initChain(5);
+
+    auto hashList = std::make_shared<protocol::HashList>();
+    for (auto blockNumber : {3, 1, 4})
+    {
+        hashList->emplace_back(m_fakeBlocks->at(blockNumber)->transactionHash(0));
+    }
+    std::promise<bool> p1;
+    auto f1 = p1.get_future();
+    m_ledger->asyncGetBatchReceiptsByHashList(
+        hashList, [&](Error::Ptr _error, std::vector<TransactionReceipt::Ptr> _receipts) {
+            BOOST_CHECK_EQUAL(_error, nullptr);
+            BOOST_REQUIRE_EQUAL(_receipts.size(), hashList->size());
+            // in the order of the hashes
+            BOOST_CHECK_EQUAL(
+                _receipts[0]->hash().hex(), m_fakeBlocks->at(3)->receipts()[0]->hash().hex());
+            BOOST_CHECK_EQUAL(
+                _receipts[1]->hash().hex(), m_fakeBlocks->at(1)->receipts()[0]->hash().hex());
+            BOOST_CHECK_EQUAL(
+                _receipts[2]->hash().hex(), m_fakeBlocks->at(4)->receipts()[0]->hash().hex());
+            p1.set_value(true);
+        });
+
+    // a missing receipt fails the batch
+    hashList->emplace_back(HashType("123"));
+    std::promise<bool> p2;
+    auto f2 = p2.get_future();
+    m_ledger->asyncGetBatchReceiptsByHashList(
+        hashList, [&](Error::Ptr _error, std::vector<TransactionReceipt::Ptr> _receipts) {
+            BOOST_CHECK(_error != nullptr);
+            BOOST_CHECK(_receipts.empty());
+            p2.set_value(true);
+        });
+
+    std::promise<bool> p3;
+    auto f3 = p3.get_future();
+    m_ledger->asyncGetBatchReceiptsByHashList(
+        nullptr, [&](Error::Ptr _error, std::vector<TransactionReceipt::Ptr> _receipts) {
+            BOOST_CHECK_EQUAL(_error->errorCode(), LedgerError::ErrorArgument);
+            p3.set_value(true);
+        });
+    BOOST_CHECK_EQUAL(f1.get(), true);
+    BOOST_CHECK_EQUAL(f2.get(), true);
+    BOOST_CHECK_EQUAL(f3.get(), true);
+}
+
+BOOST_AUTO_TEST_CASE(storedMerkleProof)
+{
+    initFixture();
+    initChain(5);
+
+    auto checkProofs = [this](int blockNumber) {
+        auto block = m_fakeBlocks->at(blockNumber);
+        std::promise<bool> receiptPromise;
+        m_ledger->asyncGetTransactionReceiptByHash(block->transactionHash(0), true,
+            [&](Error::Ptr _error, TransactionReceipt::Ptr _receipt, MerkleProofPtr _proof) {
+                BOOST_CHECK_EQUAL(_error, nullptr);
+                BOOST_REQUIRE(_proof != nullptr);
+                BOOST_CHECK(merkleUtility.verifyMerkleProof(
+                    *_proof, _receipt->hash(), block->blockHeader()->receiptsRoot()));
+                receiptPromise.set_value(true);
+            });
+        BOOST_CHECK(receiptPromise.get_future().get());
+
+        auto hashList = std::make_shared<protocol::HashList>();
+        hashList->emplace_back(block->transactionHash(1));
+        std::promise<bool> txPromise;
+        m_ledger->asyncGetBatchTxsByHashList(hashList, true,
+            [&](Error::Ptr _error, protocol::TransactionsPtr,
+                std::shared_ptr<std::map<std::string, MerkleProofPtr>> _proof) {
+                BOOST_CHECK_EQUAL(_error, nullptr);
+                auto hash = block->transactionHash(1);
+                BOOST_REQUIRE(_proof->at(hash.hex()) != nullptr);
+                BOOST_CHECK(merkleUtility.verifyMerkleProof(
+                    *_proof->at(hash.hex()), hash, block->blockHeader()->txsRoot()));
+                txPromise.set_value(true);
+            });
+        BOOST_CHECK(txPromise.get_future().get());
+    };
+
+    // the merkle trees are written with the block
+    auto blockNumber = m_fakeBlocks->at(3)->blockHeader()->number();
+    auto numberKey = boost::lexical_cast<std::string>(blockNumber);
+    for (auto table : {SYS_NUMBER_2_TX_MERKLE, SYS_NUMBER_2_RECEIPT_MERKLE})
+    {
+        auto [error, entry] = m_storage->getRow(table, numberKey);
+        BOOST_CHECK(!error);
+        BOOST_REQUIRE(entry);
+        auto unknownProof = block_merkle::getMerkleProof(
+            m_blockFactory->cryptoSuite()->hashImpl()->hasher(), entry->get(), HashType("123"));
+        BOOST_CHECK(!unknownProof);
+    }
+    checkProofs(3);
+
+    // a block without a valid stored tree falls back to rebuilding it from the block data
+    for (auto table : {SYS_NUMBER_2_TX_MERKLE, SYS_NUMBER_2_RECEIPT_MERKLE})
+    {
+        Entry entry;
+        entry.set(std::string("invalid"));
+        m_storage->asyncSetRow(table, numberKey, std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    checkProofs(3);
+}
+
 BOOST_AUTO_TEST_CASE(getNonceList)
 {
     initFixture();
@@ -1630,6 +1739,36 @@ BOOST_AUTO_TEST_CASE(replaceBinary)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(stateProof)
+{
+    auto memoryStorage = std::make_shared<StateStorage>(nullptr, false);
+    auto storage = std::make_shared<MockStorage>(memoryStorage);
+    auto ledger = std::make_shared<Ledger>(m_blockFactory, storage, 1);
+    auto setFeature = [&](protocol::BlockNumber enableNumber) {
+        storage::Entry entry;
+        entry.setObject(SystemConfigEntry{"1", enableNumber});
+        task::syncWait(storage2::writeOne(*storage,
+            executor_v1::StateKey(SYS_CONFIG, "feature_state_tree"), std::move(entry)));
+    };
+    task::syncWait(storage2::writeOne(*storage,
+        executor_v1::StateKey(SYS_CURRENT_STATE, SYS_KEY_CURRENT_NUMBER),
+        storage::Entry{std::string_view{"5"}}));
+
+    // without the feature
+    BOOST_CHECK(!task::syncWait(ledger->getStateProof("/apps/t", "key", 5)));
+
+    setFeature(0);
+    auto proof = task::syncWait(ledger->getStateProof("/apps/t", "key", 5));
+    BOOST_REQUIRE(proof);
+    BOOST_CHECK(proof->terminal.type == state_tree::NodeType::EMPTY);
+    // only against the latest root
+    BOOST_CHECK_THROW(task::syncWait(ledger->getStateProof("/apps/t", "key", 4)), std::exception);
+
+    // enabled after genesis, the keys written before are not in the tree
+    setFeature(3);
+    BOOST_CHECK_THROW(task::syncWait(ledger->getStateProof("/apps/t", "key", 5)), std::exception);
+}
+
 BOOST_AUTO_TEST_CASE(nonceList)
 {
     task::syncWait([this]() -> task::Task<void> {
@@ -1672,5 +1811,124 @@ BOOST_AUTO_TEST_CASE(nonceList)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(nonceIndex)
+{
+    for (auto const& nonces : std::vector<NonceList>{
+             {}, {"0x01", "0x02", "0x03"}, {"1", "22", "", "333"}, {std::string("\0\1", 2)}})
+    {
+        auto value = nonce_index::encodeNonces(nonces);
+        auto decoded = nonce_index::decodeNonces(value);
+        BOOST_REQUIRE(decoded);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            decoded->begin(), decoded->end(), nonces.begin(), nonces.end());
+        BOOST_CHECK_THROW(
+            nonce_index::decodeNonces(value.substr(0, value.size() - 1)), std::exception);
+    }
+    // the nonces of the same width are stored without their lengths
+    BOOST_CHECK_EQUAL(nonce_index::encodeNonces({"0x01", "0x02", "0x03"}).size(), 10 + 3 * 4);
+
+    task::syncWait([this]() -> task::Task<void> {
+        auto memoryStorage = std::make_shared<StateStorage>(nullptr, false);
+        auto storage = std::make_shared<MockStorage>(memoryStorage);
+        auto ledger = std::make_shared<Ledger>(m_blockFactory, storage, 1);
+        co_await storage2::writeOne(*storage,
+            executor_v1::StateKey(SYS_TABLES, SYS_BLOCK_NUMBER_2_NONCES),
+            storage::Entry{std::string_view{"value"}});
+
+        // a window of the rows in the nonce index format and the ones written as a tars Block
+        auto nonceList = std::vector<std::string>{"a", "b", "c"};
+        co_await storage2::writeOne(*storage,
+            executor_v1::StateKey(SYS_BLOCK_NUMBER_2_NONCES, "1"),
+            Entry{nonce_index::encodeNonces(nonceList)});
+        auto block = m_blockFactory->createBlock();
+        block->setNonceList(std::vector<std::string>{"d"});
+        bytes buffer;
+        block->encode(buffer);
+        BOOST_CHECK(!nonce_index::decodeNonces({(const char*)buffer.data(), buffer.size()}));
+        co_await storage2::writeOne(
+            *storage, executor_v1::StateKey(SYS_BLOCK_NUMBER_2_NONCES, "2"), Entry{buffer});
+
+        auto gotNonceList = co_await ledger::getNonceList(*ledger, 1, 1);
+        BOOST_REQUIRE(gotNonceList);
+        BOOST_REQUIRE_EQUAL(gotNonceList->size(), 2);
+        BOOST_CHECK_EQUAL_COLLECTIONS(gotNonceList->at(1)->begin(), gotNonceList->at(1)->end(),
+            nonceList.begin(), nonceList.end());
+        BOOST_CHECK_EQUAL(gotNonceList->at(2)->size(), 1);
+        BOOST_CHECK_EQUAL(gotNonceList->at(2)->front(), "d");
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(logIndex)
+{
+    initFixture();
+    constexpr auto sectionSize = log_index::LOG_INDEX_SECTION_SIZE;
+
+    // the blocks before are indexed without logs
+    for (BlockNumber number = 1; number < sectionSize - 3; ++number)
+    {
+        Entry entry;
+        entry.set(log_index::encodeBloom(Bloom{}));
+        m_storage->asyncSetRow(SYS_LOG_INDEX, log_index::blockKey(number), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    std::string address1 = "1111111111111111111111111111111111111111";
+    std::string address2 = "2222222222222222222222222222222222222222";
+    auto topic = m_blockFactory->cryptoSuite()->hash("topic"s);
+    auto prewriteBlock = [this](BlockNumber number, std::vector<LogEntry> logs) {
+        auto block = m_blockFactory->createBlock();
+        auto blockHeader = m_blockFactory->blockHeaderFactory()->createBlockHeader();
+        blockHeader->setNumber(number);
+        blockHeader->calculateHash(*m_blockFactory->cryptoSuite()->hashImpl());
+        block->setBlockHeader(blockHeader);
+        block->appendReceipt(m_blockFactory->receiptFactory()->createReceipt(
+            0, "", logs, 0, bytesConstRef(), number));
+
+        std::promise<bool> prewritePromise;
+        m_ledger->asyncPrewriteBlock(
+            m_storage, nullptr, block,
+            [&](std::string, Error::Ptr&& error) {
+                BOOST_CHECK(!error);
+                prewritePromise.set_value(true);
+            },
+            false);
+        prewritePromise.get_future().get();
+    };
+    prewriteBlock(sectionSize - 3, {LogEntry(asBytes(address1), {}, {})});
+    prewriteBlock(sectionSize - 2, {});
+    prewriteBlock(sectionSize - 1, {LogEntry(asBytes(address2), {topic}, {})});
+    prewriteBlock(sectionSize, {LogEntry(asBytes(address1), {topic}, {})});
+    prewriteBlock(sectionSize + 1, {});
+
+    // the last block of the section builds the section
+    auto [error, sectionEntry] = m_storage->getRow(SYS_LOG_INDEX, log_index::sectionKey(0));
+    BOOST_CHECK(!error);
+    BOOST_CHECK(sectionEntry);
+
+    auto candidates = [this](BlockNumber from, BlockNumber to, std::vector<std::string> addresses,
+                          std::vector<h256s> topics) {
+        auto blocks = task::syncWait(m_ledger->getLogIndexCandidates(from, to, addresses, topics));
+        BOOST_REQUIRE(blocks);
+        return *blocks;
+    };
+    using Blocks = std::vector<BlockNumber>;
+    BOOST_CHECK(candidates(0, sectionSize - 1, {address1}, {}) == Blocks{sectionSize - 3});
+    BOOST_CHECK(candidates(0, sectionSize + 1, {address1}, {}) ==
+                (Blocks{sectionSize - 3, sectionSize}));
+    BOOST_CHECK(candidates(0, sectionSize + 1, {address1}, {{topic}}) == Blocks{sectionSize});
+    BOOST_CHECK(candidates(0, sectionSize + 1, {address1, address2}, {{topic}}) ==
+                (Blocks{sectionSize - 1, sectionSize}));
+    BOOST_CHECK(candidates(0, sectionSize + 1, {"3333333333333333333333333333333333333333"}, {})
+                    .empty());
+
+    // the blocks not indexed always match
+    BOOST_CHECK(candidates(sectionSize + 1, sectionSize + 3, {address2}, {}) ==
+                (Blocks{sectionSize + 2, sectionSize + 3}));
+
+    // no criteria, every block matches
+    auto noCriteria = std::vector<h256s>{h256s{}};
+    BOOST_CHECK(!task::syncWait(m_ledger->getLogIndexCandidates(0, sectionSize, {}, noCriteria)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
@@ -103,6 +103,8 @@ void PBFTImpl::init()
     auto config = m_pbftEngine->pbftConfig();
     config->validator()->init();
     m_pbftEngine->fetchAndUpdateLedgerConfig();
+    // before the frontService dispatches the PBFT messages to the engine
+    m_pbftEngine->initMessageVerifier();
     PBFT_LOG(INFO) << LOG_DESC("init PBFT success");
 }
 
@@ -420,6 +420,12 @@ public:
     size_t pipelineLruCapacity() const noexcept { return m_pipelineLruCapacity; }
     size_t pipelineMaxPeers() const noexcept { return m_pipelineMaxPeers; }
 
+    // threads verifying the message signatures ahead of the worker, 0 verifies on the worker
+    void setVerifyThreadCount(size_t _count) noexcept { m_verifyThreadCount = _count; }
+    void setVerifyCacheCapacity(size_t _cap) noexcept { m_verifyCacheCapacity = _cap; }
+    size_t verifyThreadCount() const noexcept { return m_verifyThreadCount; }
+    size_t verifyCacheCapacity() const noexcept { return m_verifyCacheCapacity; }
+
     void registerTxsStatusSyncHandler(std::function<void()> const& _txsStatusSyncHandler)
     {
         m_txsStatusSyncHandler = _txsStatusSyncHandler;
@@ -485,6 +491,8 @@ protected:
     size_t m_pipelinePerPeerCapacity = 64;
     size_t m_pipelineLruCapacity = 256;
     size_t m_pipelineMaxPeers = 1024;
+    size_t m_verifyThreadCount = 0;
+    size_t m_verifyCacheCapacity = 4096;
     std::atomic<int64_t> m_checkPointTimeoutInterval = {3000};
     std::atomic<int64_t> m_minSealTime = {3000};
 
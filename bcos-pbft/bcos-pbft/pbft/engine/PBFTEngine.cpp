@@ -23,6 +23,7 @@
 #include "../cache/PBFTCacheProcessor.h"
 #include "bcos-framework/front/FrontServiceInterface.h"
 #include "bcos-framework/ledger/Ledger.h"
+#include "bcos-framework/txpool/ShortTxID.h"
 #include "bcos-ledger/LedgerMethods.h"
 #include "bcos-task/Wait.h"
 #include "bcos-utilities/BoostLog.h"
@@ -34,6 +35,7 @@
 #include <bcos-utilities/ITTAPI.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/bind/bind.hpp>
+#include <algorithm>
 #include <utility>
 
 using namespace bcos;
@@ -121,6 +123,16 @@ void PBFTEngine::initSendResponseHandler()
     };
 }
 
+void PBFTEngine::initMessageVerifier()
+{
+    if (m_verifier || m_config->verifyThreadCount() == 0)
+    {
+        return;
+    }
+    m_verifier = std::make_shared<PBFTMessageVerifier>(
+        m_config, m_config->verifyThreadCount(), m_config->verifyCacheCapacity());
+}
+
 void PBFTEngine::start()
 {
     ConsensusEngine::start();
@@ -225,6 +237,10 @@ void PBFTEngine::stop()
     }
     m_stopped.store(true);
     ConsensusEngine::stop();
+    if (m_verifier)
+    {
+        m_verifier->stop();
+    }
     if (m_logSync)
     {
         m_logSync->stop();
@@ -474,9 +490,7 @@ void PBFTEngine::onRecvProposal(bool _containSysTxs, const protocol::Block& prop
                    << LOG_KV("index", pbftMessage->index())
                    << LOG_KV("encode(ms)", encodeEnd - encodeStart)
                    << LOG_KV("asyncSend(ms)", utcTime() - encodeEnd);
-    // FIB-185: hand the owned payload to the front's serial send queue (off this thread); no copy.
-    m_config->frontService()->asyncBroadcastMessageByOwnedPayload(
-        bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, std::move(encodedData));
+    broadcastPrePrepare(pbftMessage, proposal, std::move(encodedData));
 
     // handle the pre-prepare packet
     RecursiveGuard lock(m_mutex);
@@ -497,6 +511,166 @@ void PBFTEngine::onRecvProposal(bool _containSysTxs, const protocol::Block& prop
     }
 }
 
+void PBFTEngine::broadcastPrePrepare(std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg,
+    const protocol::Block& _proposal, bytesPointer _encodedData)
+{
+    auto compactData = encodeCompactPrePrepare(_prePrepareMsg, _proposal);
+    if (!compactData)
+    {
+        // FIB-185: the owned payload goes to the front's serial send queue, no copy
+        m_config->frontService()->asyncBroadcastMessageByOwnedPayload(
+            bcos::protocol::NodeType::CONSENSUS_NODE, ModuleID::PBFT, std::move(_encodedData));
+        return;
+    }
+    size_t compactPeers = 0;
+    for (auto const& node : m_config->consensusNodeList())
+    {
+        if (node.nodeID->data() == m_config->nodeID()->data())
+        {
+            continue;
+        }
+        auto compact = m_config->validator()->compactRelayPeer(node.nodeID);
+        compactPeers += compact ? 1 : 0;
+        m_config->frontService()->asyncSendMessageByNodeIDByOwnedPayload(
+            ModuleID::PBFT, node.nodeID, compact ? compactData : _encodedData);
+    }
+    PBFT_LOG(INFO) << LOG_DESC("send compact pre-prepare packet")
+                   << LOG_KV("index", _prePrepareMsg->index())
+                   << LOG_KV("packetSize", _encodedData->size())
+                   << LOG_KV("compactPacketSize", compactData->size())
+                   << LOG_KV("compactPeers", compactPeers);
+}
+
+bytesPointer PBFTEngine::encodeCompactPrePrepare(
+    std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg, const protocol::Block& _proposal)
+{
+    // the txs of a sealed proposal were broadcast to the pools of the followers before
+    if (_proposal.transactionsSize() > 0 ||
+        _proposal.transactionsMetaDataSize() < MIN_COMPACT_PROPOSAL_TXS)
+    {
+        return nullptr;
+    }
+    auto consensusNodes = m_config->consensusNodeList();
+    if (std::none_of(consensusNodes.begin(), consensusNodes.end(), [this](auto const& node) {
+            return m_config->validator()->compactRelayPeer(node.nodeID);
+        }))
+    {
+        return nullptr;
+    }
+    auto salt = txpool::shortTxIDSalt(_prePrepareMsg->hash());
+    auto metaDatas = _proposal.transactionMetaDatas();
+    std::vector<txpool::ShortTxID> shortIDs;
+    shortIDs.reserve(metaDatas.size());
+    std::unordered_set<txpool::ShortTxID> uniqueIDs;
+    for (size_t i = 0; i < metaDatas.size(); ++i)
+    {
+        // the metadata of the VRF rotating tx carries its source, which the followers can't
+        // rebuild from the pool; two txs colliding on a short id can't be told apart
+        auto shortID = txpool::shortTxID(salt, metaDatas[i]->hash());
+        if (!metaDatas[i]->source().empty() || !uniqueIDs.insert(shortID).second)
+        {
+            return nullptr;
+        }
+        shortIDs.emplace_back(shortID);
+    }
+    // the same pre-prepare with the header of the proposal only
+    auto& blockFactory = m_config->blockFactory();
+    bytes headerData;
+    _proposal.blockHeader()->encode(headerData);
+    auto headerOnly = blockFactory.createBlock();
+    headerOnly->setVersion(_proposal.version());
+    headerOnly->setBlockType(_proposal.blockType());
+    headerOnly->setBlockHeader(blockFactory.blockHeaderFactory()->createBlockHeader(headerData));
+    bytes headerOnlyData;
+    headerOnly->encode(headerOnlyData);
+
+    auto consensusProposal = _prePrepareMsg->consensusProposal();
+    auto compactProposal =
+        m_config->pbftMessageFactory()->populateFrom(consensusProposal, false, false);
+    compactProposal->setData(std::move(headerOnlyData));
+    compactProposal->setSystemProposal(consensusProposal->systemProposal());
+    auto compactMessage = m_config->pbftMessageFactory()->populateFrom(
+        PacketType::PrePreparePacket, compactProposal, _prePrepareMsg->version(),
+        _prePrepareMsg->view(), _prePrepareMsg->timestamp(), _prePrepareMsg->generatedFrom());
+    auto prePrepareData = m_config->codec()->encode(compactMessage);
+    auto shortIDsData = txpool::encodeShortTxIDs(salt, shortIDs);
+    return m_config->codec()->encodeCompactPrePrepare(ref(*prePrepareData), ref(shortIDsData));
+}
+
+void PBFTEngine::pushVerifiedMsg(std::shared_ptr<PBFTBaseMessageInterface> _msg, bool _valid)
+{
+    // a compact pre-prepare with an invalid signature is handled as is, and rejected as one
+    if (_valid && _msg->packetType() == PacketType::PrePreparePacket)
+    {
+        auto prePrepareMsg = std::dynamic_pointer_cast<PBFTMessageInterface>(_msg);
+        if (prePrepareMsg && !prePrepareMsg->compactTxIDs().empty())
+        {
+            rebuildCompactPrePrepare(std::move(prePrepareMsg));
+            return;
+        }
+    }
+    m_msgQueue.push(std::move(_msg));
+    m_signalled.notify_all();
+}
+
+void PBFTEngine::rebuildCompactPrePrepare(std::shared_ptr<PBFTMessageInterface> _prePrepareMsg)
+{
+    auto proposal = _prePrepareMsg->consensusProposal();
+    auto block = m_config->blockFactory().createBlock(proposal->data(), false, false);
+    auto blockHeader = block->blockHeader();
+    uint64_t salt = 0;
+    std::vector<txpool::ShortTxID> shortIDs;
+    auto leader = m_config->getConsensusNodeByIndex(_prePrepareMsg->generatedFrom());
+    bool valid = leader && blockHeader && block->transactionsSize() == 0 &&
+                 block->transactionsMetaDataSize() == 0 &&
+                 txpool::decodeShortTxIDs(_prePrepareMsg->compactTxIDs(), salt, shortIDs) &&
+                 shortIDs.size() <= m_config->blockTxCountLimit();
+    if (valid)
+    {
+        // the txs are rebuilt for the signed hash only, handlePrePrepareMsg checks the rest
+        blockHeader->calculateHash(*m_config->cryptoSuite()->hashImpl());
+        valid = blockHeader->hash() == proposal->hash() &&
+                salt == txpool::shortTxIDSalt(proposal->hash());
+    }
+    if (!valid)
+    {
+        PBFT_LOG(WARNING) << LOG_DESC("rebuildCompactPrePrepare: invalid compact pre-prepare")
+                          << printPBFTMsgInfo(_prePrepareMsg);
+        m_pipeline.consumed(_prePrepareMsg);
+        return;
+    }
+    auto startT = utcTime();
+    auto self = weak_from_this();
+    m_config->validator()->asyncRebuildCompactProposal(leader->nodeID, std::move(block),
+        std::move(shortIDs),
+        [self, _prePrepareMsg, startT](Error::Ptr _error, protocol::Block::Ptr _proposal) {
+            auto engine = self.lock();
+            if (!engine)
+            {
+                return;
+            }
+            if (_error != nullptr)
+            {
+                PBFT_LOG(WARNING) << LOG_DESC("rebuildCompactPrePrepare failed")
+                                  << LOG_KV("code", _error->errorCode())
+                                  << LOG_KV("msg", _error->errorMessage())
+                                  << printPBFTMsgInfo(_prePrepareMsg);
+                engine->m_pipeline.consumed(_prePrepareMsg);
+                return;
+            }
+            bytes proposalData;
+            _proposal->encode(proposalData);
+            _prePrepareMsg->consensusProposal()->setData(std::move(proposalData));
+            _prePrepareMsg->setCompactTxIDs({});
+            PBFT_LOG(INFO) << LOG_DESC("rebuildCompactPrePrepare success")
+                           << LOG_KV("txs", _proposal->transactionsMetaDataSize())
+                           << LOG_KV("timecost", utcTime() - startT)
+                           << printPBFTMsgInfo(_prePrepareMsg);
+            engine->m_msgQueue.push(_prePrepareMsg);
+            engine->m_signalled.notify_all();
+        });
+}
+
 void PBFTEngine::resetSealedTxs(
     std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg, const protocol::Block& block)
 {
@@ -611,8 +785,30 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
         {
             return;
         }
-        m_msgQueue.push(pbftMsg);
-        m_signalled.notify_all();
+        if (m_verifier)
+        {
+            // the worker gets the messages once their signatures are verified and cached, in the
+            // order each sender sent them
+            auto self = weak_from_this();
+            m_verifier->asyncVerify(pbftMsg, [self, pbftMsg](bool _valid) {
+                auto engine = self.lock();
+                if (!engine)
+                {
+                    return;
+                }
+                // FIB-131: a pre-prepare with an invalid signature still goes to
+                // handlePrePrepareMsg, which notifies the sealer to reseal at a rate limited per
+                // peer
+                if (!_valid && pbftMsg->packetType() != PacketType::PrePreparePacket)
+                {
+                    engine->m_pipeline.consumed(pbftMsg);
+                    return;
+                }
+                engine->pushVerifiedMsg(pbftMsg, _valid);
+            });
+            return;
+        }
+        pushVerifiedMsg(std::move(pbftMsg), true);
     }
     catch (std::exception const& _e)
     {
@@ -879,7 +1075,10 @@ CheckResult PBFTEngine::checkSignature(PBFTBaseMessageInterface::Ptr _req)
     // exception churn and ERROR log spam in the consensus worker loop.
     try
     {
-        if (!_req->verifySignature(m_config->cryptoSuite(), publicKey))
+        auto verify = [&]() { return _req->verifySignature(m_config->cryptoSuite(), publicKey); };
+        if (!(m_verifier ? m_verifier->verify(publicKey, _req->signatureDataHash(),
+                               _req->signatureData(), verify) :
+                           verify()))
         {
             PBFT_LOG(WARNING) << LOG_DESC("checkSignature failed for invalid signature")
                               << printPBFTMsgInfo(_req);
@@ -913,8 +1112,16 @@ bool PBFTEngine::checkProposalSignature(
         return false;
     }
 
-    return m_config->cryptoSuite()->signatureImpl()->verify(
-        nodeInfo->nodeID, _proposal->hash(), _proposal->signature());
+    auto verify = [&]() {
+        return m_config->cryptoSuite()->signatureImpl()->verify(
+            nodeInfo->nodeID, _proposal->hash(), _proposal->signature());
+    };
+    if (m_verifier)
+    {
+        return m_verifier->verify(
+            nodeInfo->nodeID, _proposal->hash(), _proposal->signature(), verify);
+    }
+    return verify();
 }
 
 bool PBFTEngine::checkRotateTransactionValid(PBFTMessageInterface::Ptr const& _proposal,
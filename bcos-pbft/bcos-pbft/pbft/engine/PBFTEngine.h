@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "PBFTLogSync.h"
+#include "PBFTMessageVerifier.h"
 #include "bcos-framework/ledger/LedgerInterface.h"
 #include "bcos-pbft/core/ConsensusEngine.h"
 #include "bcos-pbft/pbft/utilities/PBFTPipeline.h"
@@ -107,6 +108,9 @@ public:
     void recoverState();
 
     void fetchAndUpdateLedgerConfig();
+    // build the signature verifier configured in m_config, it must be called before the engine
+    // is registered to the frontService as the network threads read m_verifier unsynchronized
+    void initMessageVerifier();
     bool shouldRotateSealers(protocol::BlockNumber _number) const;
     void setLedger(ledger::LedgerInterface::Ptr ledger);
 
@@ -134,6 +138,17 @@ protected:
     virtual bool handlePrePrepareMsg(std::shared_ptr<PBFTMessageInterface> _prePrepareMsg,
         bool _needVerifyProposal, bool _generatedFromNewView = false,
         bool _needCheckSignature = true);
+    // send the pre-prepare to the consensus nodes, with the proposal header and the short ids of
+    // its txs to the ones rebuilding it from their pools
+    virtual void broadcastPrePrepare(std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg,
+        const protocol::Block& _proposal, bytesPointer _encodedData);
+    // nullptr when the proposal is relayed whole
+    virtual bytesPointer encodeCompactPrePrepare(
+        std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg,
+        const protocol::Block& _proposal);
+    // hand a verified message to the worker, a compact pre-prepare once its proposal is rebuilt
+    virtual void pushVerifiedMsg(std::shared_ptr<PBFTBaseMessageInterface> _msg, bool _valid);
+    virtual void rebuildCompactPrePrepare(std::shared_ptr<PBFTMessageInterface> _prePrepareMsg);
     // When handlePrePrepareMsg return false, then reset sealed txs
     virtual void resetSealedTxs(
         std::shared_ptr<PBFTMessageInterface> const& _prePrepareMsg, const protocol::Block& block);
@@ -286,6 +301,9 @@ protected:
 
     // FIB-145 / FIB-146: 3-stage admission pipeline applied before m_msgQueue.push().
     PBFTPipeline m_pipeline;
+    // Verifies the signatures of the admitted messages in parallel before they are pushed into
+    // m_msgQueue, nullptr verifies them inline on the worker. Only set by initMessageVerifier
+    PBFTMessageVerifier::Ptr m_verifier;
     // FIB-131: per-peer consecutive invalid-pre-prepare counter used to suppress reseal storms.
     // Key: node index (IndexType). Protected by m_mutex.
     // Resets on any successful pre-prepare from the same peer.
@@ -0,0 +1,176 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief verify the signatures of the PBFT messages on a worker pool before they are queued
+ *        to the single consensus worker
+ * @file PBFTMessageVerifier.cpp
+ */
+#include "PBFTMessageVerifier.h"
+#include "../utilities/Common.h"
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::crypto;
+
+void PBFTMessageVerifier::asyncVerify(
+    std::shared_ptr<PBFTBaseMessageInterface> _msg, std::function<void(bool)> _onVerified)
+{
+    auto sender = _msg->from() ? _msg->from()->hex() : std::string();
+    auto pending = std::make_shared<PendingMessage>();
+    pending->msg = std::move(_msg);
+    pending->onVerified = std::move(_onVerified);
+    {
+        std::scoped_lock lock(x_senders);
+        m_senders[sender].pending.push_back(pending);
+    }
+    auto self = weak_from_this();
+    m_taskPool->enqueue([self, sender = std::move(sender), pending = std::move(pending)]() {
+        auto verifier = self.lock();
+        if (!verifier)
+        {
+            return;
+        }
+        verifier->onMessageVerified(sender, pending, verifier->verifyMessage(pending->msg));
+    });
+}
+
+void PBFTMessageVerifier::onMessageVerified(
+    std::string const& _sender, std::shared_ptr<PendingMessage> const& _pending, bool _valid)
+{
+    std::unique_lock lock(x_senders);
+    _pending->verified = true;
+    _pending->valid = _valid;
+    // the queue of the sender is only erased by the thread delivering it
+    auto& queue = m_senders[_sender];
+    if (queue.delivering)
+    {
+        return;
+    }
+    queue.delivering = true;
+    while (true)
+    {
+        // the verified messages at the front of the queue, the ones behind a message that is
+        // still being verified wait for it
+        std::vector<std::shared_ptr<PendingMessage>> verified;
+        while (!queue.pending.empty() && queue.pending.front()->verified)
+        {
+            verified.push_back(std::move(queue.pending.front()));
+            queue.pending.pop_front();
+        }
+        if (verified.empty())
+        {
+            queue.delivering = false;
+            if (queue.pending.empty())
+            {
+                m_senders.erase(_sender);
+            }
+            return;
+        }
+        lock.unlock();
+        for (auto const& it : verified)
+        {
+            it->onVerified(it->valid);
+        }
+        lock.lock();
+    }
+}
+
+bool PBFTMessageVerifier::verify(PublicPtr const& _publicKey, HashType const& _hash,
+    bytesConstRef _signature, std::function<bool()> const& _verify)
+{
+    auto key = cacheKey(_publicKey, _hash, _signature);
+    {
+        std::scoped_lock lock(x_verified);
+        if (m_verified.contains(key))
+        {
+            return true;
+        }
+    }
+    // verify out of the lock, the pool verifies in parallel
+    if (!_verify())
+    {
+        return false;
+    }
+    std::scoped_lock lock(x_verified);
+    m_verified.seenAndInsert(key);
+    return true;
+}
+
+bool PBFTMessageVerifier::verifyMessage(std::shared_ptr<PBFTBaseMessageInterface> const& _msg)
+{
+    // the consensus node list may not have caught up with the sender yet, leave the message to
+    // the engine which checks it against the list it handles the message with
+    auto nodeInfo = m_config->getConsensusNodeByIndex(_msg->generatedFrom());
+    if (!nodeInfo)
+    {
+        return true;
+    }
+    auto const& publicKey = nodeInfo->nodeID;
+    try
+    {
+        if (!verify(publicKey, _msg->signatureDataHash(), _msg->signatureData(),
+                [&]() { return _msg->verifySignature(m_config->cryptoSuite(), publicKey); }))
+        {
+            PBFT_LOG(WARNING) << LOG_DESC("PBFTMessageVerifier: drop msg with invalid signature")
+                              << printPBFTMsgInfo(_msg);
+            return false;
+        }
+        // the prepare and checkpoint messages carry the proposal signed by the sender
+        auto packetType = _msg->packetType();
+        if (packetType != PacketType::PreparePacket && packetType != PacketType::CheckPoint)
+        {
+            return true;
+        }
+        auto pbftMsg = std::dynamic_pointer_cast<PBFTMessageInterface>(_msg);
+        auto proposal = pbftMsg ? pbftMsg->consensusProposal() : nullptr;
+        if (!proposal || proposal->signature().size() == 0)
+        {
+            return true;
+        }
+        if (!verify(publicKey, proposal->hash(), proposal->signature(), [&]() {
+                return m_config->cryptoSuite()->signatureImpl()->verify(
+                    publicKey, proposal->hash(), proposal->signature());
+            }))
+        {
+            PBFT_LOG(WARNING) << LOG_DESC(
+                                     "PBFTMessageVerifier: drop msg with invalid proposal "
+                                     "signature")
+                              << printPBFTMsgInfo(_msg);
+            return false;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        // FIB-136: the signature backend throws on malformed input, which the engine treats as
+        // an invalid signature as well
+        PBFT_LOG(DEBUG) << LOG_DESC("PBFTMessageVerifier: verify threw, drop the msg")
+                        << printPBFTMsgInfo(_msg)
+                        << LOG_KV("what", boost::diagnostic_information(e));
+        return false;
+    }
+    return true;
+}
+
+std::string PBFTMessageVerifier::cacheKey(
+    PublicPtr const& _publicKey, HashType const& _hash, bytesConstRef _signature)
+{
+    auto const& publicKey = _publicKey->data();
+    std::string key;
+    key.reserve(publicKey.size() + _hash.size() + _signature.size());
+    key.append((const char*)publicKey.data(), publicKey.size());
+    key.append((const char*)_hash.data(), _hash.size());
+    key.append((const char*)_signature.data(), _signature.size());
+    return key;
+}
@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief verify the signatures of the PBFT messages on a worker pool before they are queued
+ *        to the single consensus worker
+ *
+ * The engine checks every signature again when it handles the message, the verifier only makes
+ * that check a cache hit: a signature verified on the pool is remembered by
+ * (public key, signed hash, signature), so the engine never pays for an ECDSA/SM2 verify that
+ * has already been done.
+ *
+ * @file PBFTMessageVerifier.h
+ */
+#pragma once
+#include "../config/PBFTConfig.h"
+#include "../interfaces/PBFTMessageInterface.h"
+#include "../utilities/PBFTPipeline.h"
+#include <bcos-utilities/ThreadPool.h>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace bcos::consensus
+{
+class PBFTMessageVerifier : public std::enable_shared_from_this<PBFTMessageVerifier>
+{
+public:
+    using Ptr = std::shared_ptr<PBFTMessageVerifier>;
+    PBFTMessageVerifier(PBFTConfig::Ptr _config, size_t _threadCount, size_t _cacheCapacity)
+      : m_config(std::move(_config)),
+        m_taskPool(std::make_shared<ThreadPool>("pbftVerifier", _threadCount)),
+        m_verified(_cacheCapacity)
+    {}
+    virtual ~PBFTMessageVerifier() = default;
+
+    // Verify the signatures carried by _msg on the pool, _onVerified(false) means a known
+    // consensus node signed it with an invalid signature and the message can be dropped.
+    // The messages of a sender are verified in parallel but _onVerified is called in the order
+    // they were received from it
+    virtual void asyncVerify(std::shared_ptr<PBFTBaseMessageInterface> _msg,
+        std::function<void(bool)> _onVerified);
+
+    // Verify with _verify unless the signature has already been verified, the exceptions of
+    // _verify are thrown to the caller
+    bool verify(bcos::crypto::PublicPtr const& _publicKey, bcos::crypto::HashType const& _hash,
+        bytesConstRef _signature, std::function<bool()> const& _verify);
+
+    virtual void stop()
+    {
+        if (m_taskPool)
+        {
+            m_taskPool->stop();
+        }
+    }
+
+private:
+    struct PendingMessage
+    {
+        std::shared_ptr<PBFTBaseMessageInterface> msg;
+        std::function<void(bool)> onVerified;
+        bool verified = false;
+        bool valid = false;
+    };
+    struct SenderQueue
+    {
+        std::deque<std::shared_ptr<PendingMessage>> pending;
+        // a single thread calls the callbacks of a sender at a time
+        bool delivering = false;
+    };
+
+    bool verifyMessage(std::shared_ptr<PBFTBaseMessageInterface> const& _msg);
+    void onMessageVerified(
+        std::string const& _sender, std::shared_ptr<PendingMessage> const& _pending, bool _valid);
+    static std::string cacheKey(bcos::crypto::PublicPtr const& _publicKey,
+        bcos::crypto::HashType const& _hash, bytesConstRef _signature);
+
+    PBFTConfig::Ptr m_config;
+    ThreadPool::Ptr m_taskPool;
+
+    std::mutex x_verified;
+    PeerLRUCache m_verified;
+
+    // the messages of every sender waiting for the ones received before them to be verified
+    std::mutex x_senders;
+    std::unordered_map<std::string, SenderQueue> m_senders;
+};
+}  // namespace bcos::consensus
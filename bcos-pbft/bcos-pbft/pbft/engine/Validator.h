@@ -38,6 +38,11 @@ public:
     virtual void verifyProposal(bcos::crypto::PublicPtr _fromNode,
         bcos::protocol::BlockNumber index, protocol::Block::ConstPtr block,
         std::function<void(Error::Ptr, bool)> _verifyFinishedHandler) = 0;
+    // whether the pre-prepare is relayed to the peer by the short ids of the txs
+    virtual bool compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer) = 0;
+    virtual void asyncRebuildCompactProposal(bcos::crypto::PublicPtr _leader,
+        protocol::Block::Ptr _proposal, std::vector<bcos::txpool::ShortTxID> _shortIDs,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _onRebuilt) = 0;
 
     virtual void asyncResetTxsFlag(
         const protocol::Block& proposal, bool _flag, bool _emptyTxBatchHash = false) = 0;
@@ -75,6 +80,17 @@ public:
     void verifyProposal(bcos::crypto::PublicPtr _fromNode, bcos::protocol::BlockNumber index,
         protocol::Block::ConstPtr block,
         std::function<void(Error::Ptr, bool)> _verifyFinishedHandler) override;
+    bool compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer) override
+    {
+        return m_txPool->compactRelayPeer(_peer);
+    }
+    void asyncRebuildCompactProposal(bcos::crypto::PublicPtr _leader,
+        protocol::Block::Ptr _proposal, std::vector<bcos::txpool::ShortTxID> _shortIDs,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _onRebuilt) override
+    {
+        m_txPool->asyncRebuildCompactProposal(
+            std::move(_leader), std::move(_proposal), std::move(_shortIDs), std::move(_onRebuilt));
+    }
 
     void asyncResetTxsFlag(
         const protocol::Block& proposal, bool _flag, bool _emptyTxBatchHash = false) override;
@@ -42,6 +42,11 @@ public:
     // Taking into account the situation of future blocks, verify the signature if and only when
     // processing the message packet
     virtual PBFTBaseMessageInterface::Ptr decode(bytesConstRef _data) const = 0;
+
+    // wrap the encoded pre-prepare of a header-only proposal with the short ids of its txs
+    virtual bytesPointer encodeCompactPrePrepare(bytesConstRef _prePrepare,
+        bytesConstRef _shortTxIDs,
+        int32_t _version = toWireVersion(c_currentPBFTMsgVersion)) const = 0;
 };
 }  // namespace consensus
 }  // namespace bcos
\ No newline at end of file
@@ -39,6 +39,11 @@ public:
     virtual PBFTProposalList const& proposals() const = 0;
 
     virtual PBFTMessageInterface::Ptr populateWithoutProposal() = 0;
+
+    // the short ids of the txs of a pre-prepare relayed with the proposal header only, never
+    // encoded with the message
+    virtual void setCompactTxIDs(bytes _compactTxIDs) = 0;
+    virtual bytesConstRef compactTxIDs() const = 0;
 };
 using PBFTMessageList = std::vector<PBFTMessageInterface::Ptr>;
 using PBFTMessageListPtr = std::shared_ptr<PBFTMessageList>;
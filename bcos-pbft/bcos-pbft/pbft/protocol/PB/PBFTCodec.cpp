@@ -61,14 +61,64 @@ bytesPointer PBFTCodec::encode(PBFTBaseMessageInterface::Ptr _pbftMessage, int32
     return bcos::protocol::encodePBObject(pbMessage);
 }
 
+bytesPointer PBFTCodec::encodeCompactPrePrepare(
+    bytesConstRef _prePrepare, bytesConstRef _shortTxIDs, int32_t _version) const
+{
+    // no signature, the pre-prepare in it is signed
+    auto compactPrePrepare = std::make_shared<CompactPrePrepare>();
+    compactPrePrepare->set_preprepare(_prePrepare.data(), _prePrepare.size());
+    compactPrePrepare->set_shorttxids(_shortTxIDs.data(), _shortTxIDs.size());
+    auto payLoad = bcos::protocol::encodePBObject(compactPrePrepare);
+
+    auto pbMessage = std::make_shared<RawMessage>();
+    pbMessage->set_type((int32_t)PacketType::CompactPrePreparePacket);
+    pbMessage->set_payload(payLoad->data(), payLoad->size());
+    pbMessage->set_version(_version);
+    return bcos::protocol::encodePBObject(pbMessage);
+}
+
 PBFTBaseMessageInterface::Ptr PBFTCodec::decode(bytesConstRef _data) const
 {
     auto pbMessage = std::make_shared<RawMessage>();
     bcos::protocol::decodePBObject(pbMessage, _data);
+    if ((PacketType)(pbMessage->type()) == PacketType::CompactPrePreparePacket)
+    {
+        return decodeCompactPrePrepare(*pbMessage);
+    }
+    return decodeRawMessage(*pbMessage);
+}
+
+PBFTBaseMessageInterface::Ptr PBFTCodec::decodeCompactPrePrepare(
+    RawMessage const& _rawMessage) const
+{
+    auto const& payLoad = _rawMessage.payload();
+    auto compactPrePrepare = std::make_shared<CompactPrePrepare>();
+    bcos::protocol::decodePBObject(
+        compactPrePrepare, bytesConstRef((byte const*)payLoad.c_str(), payLoad.size()));
+    auto const& prePrepareData = compactPrePrepare->preprepare();
+    auto prePrepare = std::make_shared<RawMessage>();
+    bcos::protocol::decodePBObject(prePrepare,
+        bytesConstRef((byte const*)prePrepareData.c_str(), prePrepareData.size()));
+    // only a pre-prepare is relayed compact, never another envelope
+    auto const& shortTxIDs = compactPrePrepare->shorttxids();
+    if ((PacketType)(prePrepare->type()) != PacketType::PrePreparePacket || shortTxIDs.empty())
+    {
+        BOOST_THROW_EXCEPTION(InvalidPBFTMessage() << errinfo_comment(
+                                  "invalid compact pre-prepare, packetType: " +
+                                  std::to_string(prePrepare->type())));
+    }
+    auto decodedMsg = decodeRawMessage(*prePrepare);
+    auto pbftMessage = std::dynamic_pointer_cast<PBFTMessageInterface>(decodedMsg);
+    pbftMessage->setCompactTxIDs(bytes(shortTxIDs.begin(), shortTxIDs.end()));
+    return decodedMsg;
+}
+
+PBFTBaseMessageInterface::Ptr PBFTCodec::decodeRawMessage(RawMessage const& _rawMessage) const
+{
     // get packetType
-    PacketType packetType = (PacketType)(pbMessage->type());
+    PacketType packetType = (PacketType)(_rawMessage.type());
     // get payLoad
-    auto const& payLoad = pbMessage->payload();
+    auto const& payLoad = _rawMessage.payload();
     auto payLoadRefData = bytesConstRef((byte const*)payLoad.c_str(), payLoad.size());
     // decode the packet according to the packetType
     PBFTBaseMessageInterface::Ptr decodedMsg = nullptr;
@@ -103,11 +153,11 @@ PBFTBaseMessageInterface::Ptr PBFTCodec::decode(bytesConstRef _data) const
         // FIB-134: dual-mode receiver — branch on the outer wrapper's wire
         // `version` (matches the `_version` argument the encoder passed). v=0 keeps
         // the legacy formula `hash(payload)`; v>=1 binds `packetType` into the digest.
-        auto hash = PacketTypeDigest::compute(pbMessage->version(),
+        auto hash = PacketTypeDigest::compute(_rawMessage.version(),
             static_cast<int32_t>(packetType), payLoadRefData, m_cryptoSuite->hashImpl());
         decodedMsg->setSignatureDataHash(hash);
 
-        auto const& signatureData = pbMessage->signaturedata();
+        auto const& signatureData = _rawMessage.signaturedata();
         bytes signatureBytes(signatureData.begin(), signatureData.end());
         decodedMsg->setSignatureData(std::move(signatureBytes));
     }
@@ -25,6 +25,7 @@
 #include <bcos-crypto/interfaces/crypto/KeyPairInterface.h>
 namespace bcos::consensus
 {
+class RawMessage;
 class PBFTCodec : public PBFTCodecInterface
 {
 public:
@@ -47,7 +48,14 @@ public:
 
     PBFTBaseMessageInterface::Ptr decode(bytesConstRef _data) const override;
 
+    bytesPointer encodeCompactPrePrepare(bytesConstRef _prePrepare, bytesConstRef _shortTxIDs,
+        int32_t _version = toWireVersion(c_currentPBFTMsgVersion)) const override;
+
 protected:
+    PBFTBaseMessageInterface::Ptr decodeRawMessage(RawMessage const& _rawMessage) const;
+    // the pre-prepare of the envelope, with the short ids of its txs
+    PBFTBaseMessageInterface::Ptr decodeCompactPrePrepare(RawMessage const& _rawMessage) const;
+
     virtual bool shouldHandleSignature(PacketType _packetType) const
     {
         return (_packetType == PacketType::ViewChangePacket ||
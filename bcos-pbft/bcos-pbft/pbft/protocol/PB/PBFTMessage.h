@@ -95,6 +95,12 @@ public:
         return pbftMessage;
     }
 
+    void setCompactTxIDs(bytes _compactTxIDs) override
+    {
+        m_compactTxIDs = std::move(_compactTxIDs);
+    }
+    bytesConstRef compactTxIDs() const override { return ref(m_compactTxIDs); }
+
     void encodeHashFields() const;
     void deserializeToObject() override;
 
@@ -133,5 +139,6 @@ private:
     PBFTProposalListPtr m_proposals;
 
     mutable bcos::crypto::HashType m_signatureDataHash;
+    bytes m_compactTxIDs;
 };
 }  // namespace bcos::consensus
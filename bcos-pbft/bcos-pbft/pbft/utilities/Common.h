@@ -44,6 +44,8 @@ enum PacketType : uint32_t
     CheckPoint = 0x9,
     RecoverRequest = 0xa,
     RecoverResponse = 0xb,
+    // a CompactPrePrepare, only sent to the peers announcing the compact relay in the txs sync
+    CompactPrePreparePacket = 0xc,
 };
 DERIVE_BCOS_EXCEPTION(UnknownPBFTMsgType);
 DERIVE_BCOS_EXCEPTION(InitPBFTException);
@@ -54,6 +56,10 @@ DERIVE_BCOS_EXCEPTION(InvalidPBFTMessage);
 /// crafted messages (CertiK FIB-120, FIB-123).
 inline constexpr std::size_t MAX_PBFT_REPEATED_FIELD_SIZE = 100000;
 
+/// A compact pre-prepare saves 26 bytes per tx of the proposal, below this many txs the saving
+/// doesn't pay for the round trip a follower missing txs makes, the proposal is relayed whole
+inline constexpr std::size_t MIN_COMPACT_PROPOSAL_TXS = 16;
+
 /// Validate that a protobuf repeated field does not exceed the given maximum.
 /// Throws InvalidPBFTMessage (a bcos::Exception subtype) on violation.
 template <class RepeatedField>
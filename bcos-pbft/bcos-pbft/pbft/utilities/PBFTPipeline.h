@@ -91,6 +91,19 @@ public:
         return false;
     }
 
+    // Returns true if the key is in the cache, marking it most recently used
+    // without inserting it.
+    bool contains(std::string const& key)
+    {
+        const auto it = m_map.find(key);
+        if (it == m_map.end())
+        {
+            return false;
+        }
+        m_list.splice(m_list.begin(), m_list, it->second);
+        return true;
+    }
+
     // Drop a key from the cache (no-op if absent). Used when a message is
     // consumed from m_msgQueue so subsequent legitimate retransmissions /
     // next-round messages with a colliding key are not blocked.
@@ -0,0 +1,172 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Tests for the signature verification stage ahead of the PBFT worker: the signatures
+ *        verified on the pool are cached for the engine, invalid ones are never cached and
+ *        their messages are dropped before m_msgQueue.
+ * @file PBFTMessageVerifierTest.cpp
+ */
+#include "bcos-pbft/pbft/engine/PBFTMessageVerifier.h"
+#include "bcos-pbft/pbft/protocol/PB/PBFTMessage.h"
+#include "bcos-pbft/pbft/protocol/PB/PBFTProposal.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <mutex>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::crypto;
+
+namespace bcos::test
+{
+class PBFTMessageVerifierFixture : public TestPromptFixture
+{
+public:
+    PBFTMessageVerifierFixture()
+      : cryptoSuite(std::make_shared<CryptoSuite>(
+            std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr)),
+        sealer(cryptoSuite->signatureImpl()->generateKeyPair()),
+        outsider(cryptoSuite->signatureImpl()->generateKeyPair())
+    {
+        config = std::make_shared<PBFTConfig>(cryptoSuite, sealer, nullptr, nullptr, nullptr,
+            nullptr, nullptr, nullptr, nullptr);
+        config->setConsensusNodeList(
+            {ConsensusNode{sealer->publicKey(), consensus::Type::consensus_sealer, 1, 0, 0}});
+        verifier = std::make_shared<PBFTMessageVerifier>(config, 2, 16);
+    }
+    ~PBFTMessageVerifierFixture() { verifier->stop(); }
+
+    PBFTBaseMessageInterface::Ptr prepare(KeyPairInterface::Ptr const& keyPair, IndexType from)
+    {
+        auto hash = cryptoSuite->hashImpl()->hash(std::string_view("proposal"));
+        auto proposal = std::make_shared<PBFTProposal>();
+        proposal->setIndex(1);
+        proposal->setHash(hash);
+        proposal->setSignature(*cryptoSuite->signatureImpl()->sign(*keyPair, hash, false));
+
+        auto message = std::make_shared<PBFTMessage>();
+        message->setPacketType(PacketType::PreparePacket);
+        message->setIndex(1);
+        message->setGeneratedFrom(from);
+        message->setHash(hash);
+        message->setConsensusProposal(proposal);
+        auto encoded = message->encode(cryptoSuite, keyPair);
+        return std::make_shared<PBFTMessage>(cryptoSuite, ref(*encoded));
+    }
+
+    bool asyncVerify(PBFTBaseMessageInterface::Ptr const& message)
+    {
+        std::promise<bool> promise;
+        verifier->asyncVerify(message, [&promise](bool valid) { promise.set_value(valid); });
+        return promise.get_future().get();
+    }
+
+    CryptoSuite::Ptr cryptoSuite;
+    KeyPairInterface::Ptr sealer;
+    KeyPairInterface::Ptr outsider;
+    PBFTConfig::Ptr config;
+    PBFTMessageVerifier::Ptr verifier;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PBFTMessageVerifierTest, PBFTMessageVerifierFixture)
+
+BOOST_AUTO_TEST_CASE(verifiedSignaturesAreCached)
+{
+    HashType hash;
+    hash[0] = 1;
+    bytes signature{1, 2, 3};
+    size_t calls = 0;
+
+    // an invalid signature is verified every time it is checked
+    auto invalid = [&]() {
+        ++calls;
+        return false;
+    };
+    BOOST_CHECK(!verifier->verify(sealer->publicKey(), hash, ref(signature), invalid));
+    BOOST_CHECK(!verifier->verify(sealer->publicKey(), hash, ref(signature), invalid));
+    BOOST_CHECK_EQUAL(calls, 2);
+
+    // a valid one only once
+    auto valid = [&]() {
+        ++calls;
+        return true;
+    };
+    BOOST_CHECK(verifier->verify(sealer->publicKey(), hash, ref(signature), valid));
+    BOOST_CHECK(verifier->verify(sealer->publicKey(), hash, ref(signature), invalid));
+    BOOST_CHECK_EQUAL(calls, 3);
+
+    // the cache is keyed by the signature too
+    bytes otherSignature{3, 2, 1};
+    BOOST_CHECK(!verifier->verify(sealer->publicKey(), hash, ref(otherSignature), invalid));
+    BOOST_CHECK_EQUAL(calls, 4);
+}
+
+BOOST_AUTO_TEST_CASE(asyncVerifyPrepare)
+{
+    auto index = config->getNodeIndexByNodeID(sealer->publicKey());
+    auto message = prepare(sealer, index);
+    BOOST_CHECK(asyncVerify(message));
+
+    // the engine's own check is now a cache hit
+    auto pbftMessage = std::dynamic_pointer_cast<PBFTMessage>(message);
+    auto proposal = pbftMessage->consensusProposal();
+    BOOST_CHECK(verifier->verify(sealer->publicKey(), message->signatureDataHash(),
+        message->signatureData(), []() { return false; }));
+    BOOST_CHECK(verifier->verify(sealer->publicKey(), proposal->hash(), proposal->signature(),
+        []() { return false; }));
+
+    // signed by a node other than the one it claims to come from
+    BOOST_CHECK(!asyncVerify(prepare(outsider, index)));
+    // from a node the consensus node list doesn't know yet, left to the engine
+    BOOST_CHECK(asyncVerify(prepare(outsider, index + 1)));
+}
+
+BOOST_AUTO_TEST_CASE(asyncVerifyKeepsSenderOrder)
+{
+    auto index = config->getNodeIndexByNodeID(sealer->publicKey());
+    constexpr static size_t MESSAGE_COUNT = 64;
+    std::vector<PBFTBaseMessageInterface::Ptr> messages;
+    for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        // the invalid ones take the same path and must not overtake the valid ones either
+        auto message = prepare(i % 3 == 0 ? outsider : sealer, index);
+        message->setFrom(sealer->publicKey());
+        messages.push_back(std::move(message));
+    }
+
+    std::mutex mutex;
+    std::vector<PBFTBaseMessageInterface::Ptr> verified;
+    std::promise<void> finished;
+    for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        verifier->asyncVerify(messages[i], [&, i](bool valid) {
+            std::scoped_lock lock(mutex);
+            BOOST_CHECK_EQUAL(valid, i % 3 != 0);
+            verified.push_back(messages[i]);
+            if (verified.size() == MESSAGE_COUNT)
+            {
+                finished.set_value();
+            }
+        });
+    }
+    finished.get_future().get();
+    BOOST_CHECK(verified == messages);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
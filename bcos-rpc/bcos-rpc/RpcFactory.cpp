@@ -375,6 +375,8 @@ bcos::rpc::JsonRpcImpl_2_0::Ptr RpcFactory::buildJsonRpc(int sendTxTimeout,
     auto jsonRpcInterface = std::make_shared<bcos::rpc::JsonRpcImpl_2_0>(
         _groupManager, m_gateway, _wsService, filterSystem, m_nodeConfig->forceSender());
     jsonRpcInterface->setSendTxTimeout(sendTxTimeout);
+    jsonRpcInterface->setBatchRequestSizeLimit(m_nodeConfig->rpcBatchRequestSizeLimit());
+    jsonRpcInterface->setStreamMethods(m_nodeConfig->rpcStreamResponseMethods());
 
     if (auto httpServer = _wsService->httpServer())
     {
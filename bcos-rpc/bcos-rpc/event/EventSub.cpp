@@ -26,7 +26,9 @@
 #include "bcos-rpc/event/EventSubRequest.h"
 #include "bcos-rpc/event/EventSubResponse.h"
 #include "bcos-rpc/event/EventSubTask.h"
+#include <algorithm>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <thread>
 
@@ -357,92 +359,7 @@ void EventSub::onTaskComplete(EventSubTask::Ptr _task)
                     << LOG_KV("currentBlock", _task->state()->currentBlockNumber());
 }
 
-int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task, int64_t _blockNumber)
-{
-    bcos::protocol::BlockNumber currentBlockNumber = _task->state()->currentBlockNumber();
-    if (currentBlockNumber < 0)
-    {
-        currentBlockNumber =
-            _task->params()->fromBlock() > 0 ? _task->params()->fromBlock() : _blockNumber;
-    }
-
-    if (_blockNumber < currentBlockNumber)
-    {
-        _task->freeWork();
-        // waiting for block to be sealed
-        return 0;
-    }
-
-    /*
-    EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTask") << LOG_DESC("running")
-                     << LOG_KV("id", _task->id())
-                     << LOG_KV("fromBlock", _task->params()->fromBlock())
-                     << LOG_KV("toBlock", _task->params()->toBlock())
-                     << LOG_KV("blockNumber", _blockNumber)
-                     << LOG_KV("currentBlockNumber", _task->state()->currentBlockNumber());
-     */
-
-    int64_t toBlockNumber = _task->params()->toBlock();
-    if (toBlockNumber > 0 && toBlockNumber < _blockNumber)
-    {
-        _blockNumber = toBlockNumber;
-    }
-
-    int64_t blockCanProcess = _blockNumber - currentBlockNumber + 1;
-    int64_t maxBlockProcessPerLoop = m_maxBlockProcessPerLoop;
-    blockCanProcess =
-        (blockCanProcess > maxBlockProcessPerLoop ? maxBlockProcessPerLoop : blockCanProcess);
-
-    class RecursiveProcess : public std::enable_shared_from_this<RecursiveProcess>
-    {
-    public:
-        void process(int64_t _blockNumber)
-        {
-            if (_blockNumber > m_endBlockNumber)
-            {  // all block has been proccessed
-                m_task->freeWork();
-                return;
-            }
-
-            EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTask:process")
-                             << LOG_KV("id", m_task->id())
-                             << LOG_KV("fromBlock", m_task->params()->fromBlock())
-                             << LOG_KV("toBlock", m_task->params()->toBlock())
-                             << LOG_KV("blockNumber", _blockNumber);
-
-            auto eventSub = m_eventSub;
-            auto task = m_task;
-            auto p = shared_from_this();
-            eventSub->processNextBlock(
-                _blockNumber, task, [task, _blockNumber, p](Error::Ptr _error) {
-                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-                    {
-                        // error occur, wait for the next loop ???
-                        task->freeWork();
-                        return;
-                    }
-                    // next block
-                    task->state()->setCurrentBlockNumber(_blockNumber + 1);
-                    p->process(_blockNumber + 1);
-                });
-        }
-
-    public:
-        bcos::protocol::BlockNumber m_endBlockNumber;
-        std::shared_ptr<EventSub> m_eventSub;
-        EventSubTask::Ptr m_task;
-    };
-
-    auto p = std::make_shared<RecursiveProcess>();
-    p->m_endBlockNumber = currentBlockNumber + blockCanProcess - 1;
-    p->m_eventSub = shared_from_this();
-    p->m_task = _task;
-    p->process(currentBlockNumber);
-
-    return blockCanProcess;
-}
-
-int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
+int64_t EventSub::prepareEventSubTask(EventSubTask::Ptr _task, int64_t& _blockNumber)
 {
     // tests whether the connection of the session is available first
     auto connAvailable = checkConnAvailable(_task);
@@ -456,92 +373,159 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
     {
         unsubscribeEventSub(_task->id());
         onTaskComplete(_task);
-        return 0;
+        return -1;
     }
 
     // task is working, waiting for done
     if (!_task->tryWork())
     {
-        EVENT_SUB(DEBUG) << LOG_BADGE("executeEventSubTask")
+        EVENT_SUB(DEBUG) << LOG_BADGE("prepareEventSubTask")
                          << LOG_DESC("tryWork false, the previous is still going on")
                          << LOG_KV("id", _task->id()) << LOG_KV("group", _task->group());
-        return 0;
+        return -1;
     }
 
     std::string group = _task->group();
-    auto blockNumber = m_groupManager->getBlockNumberByGroup(group);
-    if (blockNumber < 0)
+    _blockNumber = m_groupManager->getBlockNumberByGroup(group);
+    if (_blockNumber < 0)
     {  // group not exist ???
         EVENT_SUB(ERROR)
-            << LOG_BADGE("executeEventSubTask")
+            << LOG_BADGE("prepareEventSubTask")
             << LOG_DESC("Cannot getBlockNumber from groupManager, maybe the group has been removed")
             << LOG_KV("group", group);
         unsubscribeEventSub(_task->id());
         return -1;
     }
 
-    executeEventSubTask(_task, blockNumber);
+    bcos::protocol::BlockNumber currentBlockNumber = _task->state()->currentBlockNumber();
+    if (currentBlockNumber < 0)
+    {
+        currentBlockNumber =
+            _task->params()->fromBlock() > 0 ? _task->params()->fromBlock() : _blockNumber;
+        // a range ending before it starts completes in the next loop
+        _task->state()->setCurrentBlockNumber(currentBlockNumber);
+    }
 
-    return 0;
+    if (_blockNumber < currentBlockNumber || _task->isCompleted())
+    {
+        _task->freeWork();
+        // waiting for block to be sealed
+        return -1;
+    }
+    return currentBlockNumber;
 }
 
-void EventSub::processNextBlock(
-    int64_t _blockNumber, EventSubTask::Ptr _task, std::function<void(Error::Ptr _error)> _callback)
+void EventSub::processNextBlock(std::string _group, int64_t _blockNumber, int64_t _endBlockNumber,
+    EventSubTaskPtrs _tasks)
 {
-    auto self = std::weak_ptr<EventSub>(shared_from_this());
-    auto matcher = m_matcher;
+    if (_tasks.empty())
+    {
+        return;
+    }
+    if (_blockNumber > _endBlockNumber)
+    {  // all block has been proccessed
+        for (auto& task : _tasks)
+        {
+            task->freeWork();
+        }
+        return;
+    }
 
-    std::string group = _task->group();
-    auto nodeService = m_groupManager->getNodeService(group, "");
+    auto nodeService = m_groupManager->getNodeService(_group, "");
     if (!nodeService)
     {
         // group not exist???
         EVENT_SUB(ERROR)
             << LOG_BADGE("processNextBlock")
             << LOG_DESC("cannot get node service of the group maybe the group has been removed")
-            << LOG_KV("id", _task->id()) << LOG_KV("group", _task->group());
-        unsubscribeEventSub(_task->id());
+            << LOG_KV("group", _group) << LOG_KV("subscriptions", _tasks.size());
+        for (auto& task : _tasks)
+        {
+            unsubscribeEventSub(task->id());
+        }
         return;
     }
 
+    auto self = shared_from_this();
+    auto matcher = m_matcher;
+    auto startT = utcSteadyTime();
     auto ledger = nodeService->ledger();
     ledger->asyncGetBlockDataByNumber(_blockNumber,
         bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
-        [matcher, _task, _blockNumber, _callback, self](
-            Error::Ptr _error, protocol::Block::Ptr _block) {
+        [self, matcher, group = std::move(_group), tasks = std::move(_tasks), _blockNumber,
+            _endBlockNumber, startT](Error::Ptr _error, protocol::Block::Ptr _block) mutable {
             if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
             {
                 // Note: wait for next time
                 EVENT_SUB(ERROR) << LOG_BADGE("processNextBlock")
-                                 << LOG_DESC("asyncGetBlockDataByNumber")
-                                 << LOG_KV("id", _task->id()) << LOG_KV("blockNumber", _blockNumber)
+                                 << LOG_DESC("asyncGetBlockDataByNumber") << LOG_KV("group", group)
+                                 << LOG_KV("blockNumber", _blockNumber)
                                  << LOG_KV("code", _error->errorCode())
                                  << LOG_KV("message", _error->errorMessage());
-                _callback(_error);
+                for (auto& task : tasks)
+                {
+                    task->freeWork();
+                }
                 return;
             }
 
-            Json::Value jResp(Json::arrayValue);
-            auto count = matcher->matches(_task->params(), _block, jResp);
-            if (count)
+            EventSubIndex index;
+            for (std::size_t i = 0; i < tasks.size(); ++i)
             {
-                EVENT_SUB(TRACE) << LOG_BADGE("processNextBlock")
-                                 << LOG_DESC("asyncGetBlockDataByNumber")
-                                 << LOG_KV("blockNumber", _blockNumber) << LOG_KV("id", _task->id())
-                                 << LOG_KV("count", count);
+                index.add(i, tasks[i]->params());
+            }
+            std::vector<Json::Value> results;
+            auto count = matcher->matches(index, _block, results);
 
-                _task->callback()(_task->id(), false, jResp);
+            EventSubTaskPtrs nextTasks;
+            nextTasks.reserve(tasks.size());
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+            {
+                auto& task = tasks[i];
+                if (results[i].size() > 0)
+                {
+                    task->callback()(task->id(), false, results[i]);
+                }
+                // next block
+                task->state()->setCurrentBlockNumber(_blockNumber + 1);
+                if (task->isCompleted())
+                {
+                    task->freeWork();
+                    continue;
+                }
+                nextTasks.emplace_back(std::move(task));
             }
 
-            _callback(nullptr);
+            EVENT_SUB(DEBUG) << LOG_BADGE("processNextBlock") << LOG_KV("group", group)
+                             << LOG_KV("blockNumber", _blockNumber)
+                             << LOG_KV("subscriptions", tasks.size()) << LOG_KV("count", count)
+                             << LOG_KV("timecost", utcSteadyTime() - startT);
+            self->processNextBlock(
+                std::move(group), _blockNumber + 1, _endBlockNumber, std::move(nextTasks));
         });
 }
 
 void EventSub::executeEventSubTasks()
 {
+    // the tasks of a group following the same block fetch and match each block together
+    std::map<std::pair<std::string, int64_t>, std::pair<int64_t, EventSubTaskPtrs>> cursors;
     for (auto& task : m_tasks)
     {
-        executeEventSubTask(task.second);
+        int64_t blockNumber = -1;
+        auto currentBlockNumber = prepareEventSubTask(task.second, blockNumber);
+        if (currentBlockNumber < 0)
+        {
+            continue;
+        }
+        auto& [endBlockNumber, tasks] = cursors[{task.second->group(), currentBlockNumber}];
+        endBlockNumber = std::max(endBlockNumber,
+            std::min(blockNumber, currentBlockNumber + m_maxBlockProcessPerLoop - 1));
+        tasks.emplace_back(task.second);
+    }
+
+    for (auto& [cursor, following] : cursors)
+    {
+        processNextBlock(cursor.first, cursor.second, following.first, std::move(following.second));
     }
 
     // limiting speed
@@ -95,16 +95,29 @@ public:
     void reportEventSubTasks();
 
 public:
-    int64_t executeEventSubTask(EventSubTask::Ptr _task);
+    /**
+     * @brief: check the task and claim it for this loop
+     * @param _task: the event sub task
+     * @param _blockNumber: set to the latest block number of the task's group
+     * @return int64_t: the next block the task follows, -1 if it has nothing to do in this loop
+     */
+    int64_t prepareEventSubTask(EventSubTask::Ptr _task, int64_t& _blockNumber);
     void subscribeEventSub(EventSubTask::Ptr _task);
     void unsubscribeEventSub(const std::string& _id);
 
 public:
-    int64_t executeEventSubTask(EventSubTask::Ptr _task, int64_t _currentBlockNumber);
     void onTaskComplete(bcos::event::EventSubTask::Ptr _task);
     bool checkConnAvailable(bcos::event::EventSubTask::Ptr _task);
-    void processNextBlock(int64_t _blockNumber, bcos::event::EventSubTask::Ptr _task,
-        std::function<void(Error::Ptr _error)> _callback);
+    /**
+     * @brief: fetch the block once and dispatch its logs to all the tasks following it, then go
+     * on with the next block until _endBlockNumber
+     * @param _group: the group of the tasks
+     * @param _blockNumber: the block the tasks follow
+     * @param _endBlockNumber: the last block to process in this loop
+     * @param _tasks: the tasks following _blockNumber
+     */
+    void processNextBlock(std::string _group, int64_t _blockNumber, int64_t _endBlockNumber,
+        EventSubTaskPtrs _tasks);
 
 public:
     std::shared_ptr<EventSubMatcher> matcher() const { return m_matcher; }
@@ -52,28 +52,78 @@ uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
         if (matches(_params, logEntry))
         {
             count++;
+            _result.append(toJson(_receipt, _tx, _txIndex, logEntry, logIndex));
+        }
+
+        logIndex += 1;
+    }
+
+    return count;
+}
+
+Json::Value EventSubMatcher::toJson(const bcos::protocol::TransactionReceipt& _receipt,
+    const bcos::protocol::Transaction& _tx, std::size_t _txIndex,
+    const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex)
+{
+    Json::Value jResp;
+    jResp["blockNumber"] = _receipt.blockNumber();
+    jResp["address"] = std::string(_logEntry.address());
+    jResp["data"] = toHexStringWithPrefix(_logEntry.data());
+    jResp["logIndex"] = (uint64_t)_logIndex;
+    jResp["transactionHash"] = _tx.hash().hexPrefixed();
+    jResp["transactionIndex"] = (uint64_t)_txIndex;
+    jResp["topics"] = Json::Value(Json::arrayValue);
+    for (const auto& topic : _logEntry.topics())
+    {
+        jResp["topics"].append(topic.hexPrefixed());
+    }
+    return jResp;
+}
 
-            Json::Value jResp;
-            jResp["blockNumber"] = _receipt.blockNumber();
-            jResp["address"] = std::string(logEntry.address());
-            jResp["data"] = toHexStringWithPrefix(logEntry.data());
-            jResp["logIndex"] = (uint64_t)logIndex;
-            jResp["transactionHash"] = _tx.hash().hexPrefixed();
-            jResp["transactionIndex"] = (uint64_t)_txIndex;
-            jResp["topics"] = Json::Value(Json::arrayValue);
-            for (const auto& topic : logEntry.topics())
+uint32_t EventSubMatcher::matches(const EventSubIndex& _index,
+    bcos::protocol::Block::ConstPtr _block, std::vector<Json::Value>& _results)
+{
+    _results.assign(_index.size(), Json::Value(Json::arrayValue));
+    uint32_t count = 0;
+    std::vector<std::size_t> subscriptions;
+    auto transactions = _block->transactions();
+    auto receipts = _block->receipts();
+    for (auto [index, transaction, receipt] :
+        ::ranges::views::zip(::ranges::views::iota(0), transactions, receipts))
+    {
+        std::size_t logIndex = 0;
+        for (const auto& logEntry : receipt->logEntries())
+        {
+            matches(_index, logEntry, subscriptions);
+            if (!subscriptions.empty())
             {
-                jResp["topics"].append(topic.hexPrefixed());
+                // the log is converted once whatever the number of subscriptions selecting it
+                auto jLog = toJson(*receipt, *transaction, index, logEntry, logIndex);
+                for (auto subscription : subscriptions)
+                {
+                    _results[subscription].append(jLog);
+                }
+                count += subscriptions.size();
             }
-            _result.append(jResp);
+            logIndex += 1;
         }
-
-        logIndex += 1;
     }
 
     return count;
 }
 
+void EventSubMatcher::matches(const EventSubIndex& _index,
+    const bcos::protocol::LogEntry& _logEntry, std::vector<std::size_t>& _subscriptions)
+{
+    _subscriptions.clear();
+    _index.forEachCandidate(_logEntry, [&](std::size_t _subscription) {
+        if (matches(_index.params(_subscription), _logEntry))
+        {
+            _subscriptions.emplace_back(_subscription);
+        }
+    });
+}
+
 bool EventSubMatcher::matches(
     EventSubParams::ConstPtr _params, const bcos::protocol::LogEntry& _logEntry)
 {
@@ -103,3 +153,29 @@ bool EventSubMatcher::matches(
 
     return isMatch;
 }
+
+void EventSubIndex::add(std::size_t _subscription, EventSubParams::ConstPtr _params)
+{
+    if (_subscription >= m_params.size())
+    {
+        m_params.resize(_subscription + 1);
+    }
+    m_params[_subscription] = _params;
+    if (!_params->addresses().empty())
+    {
+        for (const auto& address : _params->addresses())
+        {
+            m_byAddress[address].emplace_back(_subscription);
+        }
+        return;
+    }
+    if (!_params->topics().empty() && !_params->topics()[0].empty())
+    {
+        for (const auto& topic : _params->topics()[0])
+        {
+            m_byTopic[topic].emplace_back(_subscription);
+        }
+        return;
+    }
+    m_wildcards.emplace_back(_subscription);
+}
@@ -24,9 +24,61 @@
 #include <bcos-framework/protocol/TransactionReceipt.h>
 #include <bcos-rpc/event/EventSubParams.h>
 #include <json/json.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace bcos::event
 {
+// An inverted index of the subscriptions following the same block. The subscriptions with
+// addresses are keyed by address, the others by their first topic when they filter on it, so a log
+// is only checked against the subscriptions that can select it.
+class EventSubIndex
+{
+public:
+    void add(std::size_t _subscription, EventSubParams::ConstPtr _params);
+    std::size_t size() const { return m_params.size(); }
+    EventSubParams::ConstPtr const& params(std::size_t _subscription) const
+    {
+        return m_params[_subscription];
+    }
+
+    // call _func with every subscription the address or first topic of _logEntry may match
+    template <class Func>
+    void forEachCandidate(const bcos::protocol::LogEntry& _logEntry, Func&& _func) const
+    {
+        auto forEach = [&_func](auto const& _subscriptions) {
+            for (auto subscription : _subscriptions)
+            {
+                _func(subscription);
+            }
+        };
+        if (!m_byAddress.empty())
+        {
+            if (auto it = m_byAddress.find(std::string(_logEntry.address()));
+                it != m_byAddress.end())
+            {
+                forEach(it->second);
+            }
+        }
+        if (!m_byTopic.empty() && !_logEntry.topics().empty())
+        {
+            if (auto it = m_byTopic.find(_logEntry.topics()[0].hex()); it != m_byTopic.end())
+            {
+                forEach(it->second);
+            }
+        }
+        forEach(m_wildcards);
+    }
+
+private:
+    std::vector<EventSubParams::ConstPtr> m_params;
+    std::unordered_map<std::string, std::vector<std::size_t>> m_byAddress;
+    std::unordered_map<std::string, std::vector<std::size_t>> m_byTopic;
+    // the subscriptions filtering neither on address nor on the first topic
+    std::vector<std::size_t> m_wildcards;
+};
+
 class EventSubMatcher
 {
 public:
@@ -43,6 +95,18 @@ public:
         std::size_t _txIndex, Json::Value& _result);
     uint32_t matches(EventSubParams::ConstPtr _params, bcos::protocol::Block::ConstPtr _block,
         Json::Value& _result);
+
+    // the subscriptions of _index selecting _logEntry
+    void matches(const EventSubIndex& _index, const bcos::protocol::LogEntry& _logEntry,
+        std::vector<std::size_t>& _subscriptions);
+    // match the block once for all the subscriptions of _index, _results[i] collects the logs
+    // selected by subscription i, return the count of the logs delivered
+    uint32_t matches(const EventSubIndex& _index, bcos::protocol::Block::ConstPtr _block,
+        std::vector<Json::Value>& _results);
+
+    static Json::Value toJson(const bcos::protocol::TransactionReceipt& _receipt,
+        const bcos::protocol::Transaction& _tx, std::size_t _txIndex,
+        const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex);
 };
 
 }  // namespace bcos::event
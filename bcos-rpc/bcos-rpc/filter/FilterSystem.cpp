@@ -1,5 +1,6 @@
 #include "bcos-rpc/filter/FilterSystem.h"
 #include "bcos-rpc/jsonrpc/Common.h"
+#include "bcos-utilities/DataConvertUtility.h"
 #include <utility>
 
 #define CPU_CORES (std::thread::hardware_concurrency() + 1)
@@ -349,6 +350,36 @@ task::Task<Json::Value> FilterSystem::getLogsImpl(
     }
 }
 
+task::Task<std::optional<std::vector<protocol::BlockNumber>>> FilterSystem::getLogIndexCandidates(
+    bcos::ledger::LedgerInterface& ledger, FilterRequest const& params)
+{
+    std::vector<std::string> addresses;
+    for (auto const& address : params.addresses())
+    {
+        addresses.push_back(address.starts_with("0x") ? address.substr(2) : address);
+    }
+    std::vector<h256s> topics;
+    for (auto const& position : params.topics())
+    {
+        auto& topicHashes = topics.emplace_back();
+        for (auto const& topic : position)
+        {
+            // the topics that are not hashes never match any log
+            auto topicBytes = safeFromHexWithPrefix(topic);
+            if (topicBytes && topicBytes->size() == h256::SIZE)
+            {
+                topicHashes.emplace_back(*topicBytes);
+            }
+        }
+        if (!position.empty() && topicHashes.empty())
+        {
+            co_return std::vector<protocol::BlockNumber>{};
+        }
+    }
+    co_return co_await ledger.getLogIndexCandidates(
+        params.fromBlock(), params.toBlock(), addresses, topics);
+}
+
 task::Task<Json::Value> FilterSystem::getLogsInternal(
     bcos::ledger::LedgerInterface& ledger, FilterRequest::Ptr params)
 {
@@ -356,11 +387,23 @@ task::Task<Json::Value> FilterSystem::getLogsInternal(
     auto toBlock = params->toBlock();
     Json::Value jArray(Json::arrayValue);
     auto matcher = m_matcher;
-    for (auto number = fromBlock; number <= toBlock; ++number)
+    // only load the blocks the log index can not rule out
+    auto candidates = co_await getLogIndexCandidates(ledger, *params);
+    if (!candidates)
+    {
+        candidates.emplace();
+        for (auto number = fromBlock; number <= toBlock; ++number)
+        {
+            candidates->push_back(number);
+        }
+    }
+    FILTER_LOG(TRACE) << LOG_BADGE("getLogsInternal") << LOG_KV("fromBlock", fromBlock)
+                      << LOG_KV("toBlock", toBlock) << LOG_KV("candidates", candidates->size());
+    for (auto number : *candidates)
     {
         auto block = co_await ledger::getBlockData(ledger, number,
             bcos::ledger::HEADER | bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS_HASH);
         matcher->matches(params, block, jArray);
     }
     co_return jArray;
-}
\ No newline at end of file
+}
@@ -144,6 +144,10 @@ protected:
         std::string_view groupId, FilterRequest::Ptr params, bool needCheckRange);
     task::Task<Json::Value> getLogsInternal(
         bcos::ledger::LedgerInterface& ledger, FilterRequest::Ptr params);
+    // the blocks that may contain the logs of params according to the log index of the ledger,
+    // std::nullopt if the ledger has no log index
+    static task::Task<std::optional<std::vector<protocol::BlockNumber>>> getLogIndexCandidates(
+        bcos::ledger::LedgerInterface& ledger, FilterRequest const& params);
 
     virtual int32_t InvalidParamsCode() = 0;
     uint64_t insertFilter(Filter::Ptr filter);
@@ -22,7 +22,9 @@
 #include "bcos-framework/multigroup/GroupInfo.h"
 #include "bcos-utilities/Error.h"
 #include <json/json.h>
+#include <array>
 #include <exception>
+#include <string_view>
 
 #define RPC_IMPL_LOG(LEVEL) BCOS_LOG(LEVEL) << "[RPC][JSONRPC]"
 #define WEB3_LOG(LEVEL) BCOS_LOG(LEVEL) << "[RPC][WEB3]"
@@ -31,6 +33,12 @@ namespace bcos
 {
 namespace rpc
 {
+// the max number of requests in a batch request
+constexpr static uint32_t DEFAULT_BATCH_REQUEST_SIZE_LIMIT = 100;
+// the methods whose large results are written straight into the response
+constexpr static std::array<std::string_view, 2> DEFAULT_STREAM_METHODS = {
+    "getBlockByHash", "getBlockByNumber"};
+
 struct NodeInfo
 {
     std::string version;
@@ -754,6 +754,142 @@ void JsonRpcImpl_2_0::getTransactionReceipt(std::string_view _groupID, std::stri
         });
 }
 
+static bcos::crypto::HashListPtr toHashList(const std::vector<std::string>& _txHashes)
+{
+    auto hashList = std::make_shared<bcos::crypto::HashList>();
+    hashList->reserve(_txHashes.size());
+    for (const auto& txHash : _txHashes)
+    {
+        hashList->emplace_back(txHash, bcos::crypto::HashType::FromHex);
+    }
+    return hashList;
+}
+
+void JsonRpcImpl_2_0::getTransactions(std::string_view _groupID, std::string_view _nodeName,
+    std::vector<std::string> _txHashes, BatchRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactions") << LOG_KV("size", _txHashes.size())
+                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+
+    auto hashList = toHashList(_txHashes);
+    auto nodeService = getNodeService(_groupID, _nodeName, "getTransactions");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    ledger->asyncGetBatchTxsByHashList(hashList, false,
+        [hashList, m_respFunc = std::move(_respFunc)](Error::Ptr _error,
+            bcos::protocol::TransactionsPtr _transactionsPtr,
+            std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>>) {
+            std::vector<Json::Value> results;
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                m_respFunc(_error, results);
+                return;
+            }
+            // the ledger skips the missing txs, leave them to the lookups one by one
+            if (!_transactionsPtr || _transactionsPtr->size() != hashList->size())
+            {
+                m_respFunc(BCOS_ERROR_PTR(JsonRpcError::InternalError, "missing transactions"),
+                    results);
+                return;
+            }
+            results.resize(hashList->size());
+            for (size_t i = 0; i < hashList->size(); ++i)
+            {
+                const auto& transaction = (*_transactionsPtr)[i];
+                if (!transaction || transaction->hash() != (*hashList)[i])
+                {
+                    results.clear();
+                    m_respFunc(BCOS_ERROR_PTR(JsonRpcError::InternalError, "missing transactions"),
+                        results);
+                    return;
+                }
+                toJsonResp(results[i], *transaction);
+            }
+            m_respFunc(nullptr, results);
+        });
+}
+
+void JsonRpcImpl_2_0::getTransactionReceipts(std::string_view _groupID,
+    std::string_view _nodeName, std::vector<std::string> _txHashes, BatchRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactionReceipts") << LOG_KV("size", _txHashes.size())
+                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+
+    auto hashList = toHashList(_txHashes);
+    auto nodeService = getNodeService(_groupID, _nodeName, "getTransactionReceipts");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto hashImpl = nodeService->blockFactory()->cryptoSuite()->hashImpl();
+
+    auto groupInfo = m_groupManager->getGroupInfo(_groupID);
+    if (!groupInfo)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::GroupNotExist,
+            "The group " + std::string(_groupID) + " does not exist!"));
+    }
+    bool isWasm = groupInfo->wasm();
+
+    ledger->asyncGetBatchReceiptsByHashList(hashList,
+        [ledger, hashList, hashImpl, isWasm, m_respFunc = std::move(_respFunc)](Error::Ptr _error,
+            std::vector<protocol::TransactionReceipt::Ptr> _receipts) mutable {
+            std::vector<Json::Value> results;
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                m_respFunc(_error, results);
+                return;
+            }
+            if (_receipts.size() != hashList->size())
+            {
+                m_respFunc(BCOS_ERROR_PTR(JsonRpcError::InternalError, "missing receipts"),
+                    results);
+                return;
+            }
+            results.resize(hashList->size());
+            for (size_t i = 0; i < hashList->size(); ++i)
+            {
+                toJsonResp(results[i], (*hashList)[i].hexPrefixed(),
+                    protocol::TransactionStatus::None, *_receipts[i], isWasm, *hashImpl);
+            }
+
+            // the fields of the txs in the receipts
+            ledger->asyncGetBatchTxsByHashList(hashList, false,
+                [hashList, m_results = std::move(results), m_respFunc = std::move(m_respFunc)](
+                    Error::Ptr _error, bcos::protocol::TransactionsPtr _transactionsPtr,
+                    std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>>) mutable {
+                    if ((_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS) ||
+                        !_transactionsPtr || _transactionsPtr->size() != hashList->size())
+                    {
+                        m_results.clear();
+                        m_respFunc(
+                            BCOS_ERROR_PTR(JsonRpcError::InternalError, "missing transactions"),
+                            m_results);
+                        return;
+                    }
+                    for (size_t i = 0; i < hashList->size(); ++i)
+                    {
+                        const auto& transaction = (*_transactionsPtr)[i];
+                        if (!transaction || transaction->hash() != (*hashList)[i])
+                        {
+                            m_results.clear();
+                            m_respFunc(
+                                BCOS_ERROR_PTR(JsonRpcError::InternalError, "missing transactions"),
+                                m_results);
+                            return;
+                        }
+                        Json::Value jTx;
+                        toJsonResp(jTx, *transaction);
+                        auto& jResp = m_results[i];
+                        jResp["input"] = jTx["input"];
+                        jResp["from"] = jTx["from"];
+                        jResp["to"] = jTx["to"];
+                        jResp["extraData"] = jTx["extraData"];
+                        jResp["transactionProof"] = jTx["transactionProof"];
+                    }
+                    m_respFunc(nullptr, m_results);
+                });
+        });
+}
+
 void JsonRpcImpl_2_0::getBlockByHash(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
 {
@@ -794,8 +930,46 @@ void JsonRpcImpl_2_0::getBlockByHash(std::string_view _groupID, std::string_view
         });
 }
 
-void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
-    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
+void JsonRpcImpl_2_0::streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("streamBlockByHash") << LOG_KV("blockHash", _blockHash)
+                        << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getBlockByHash");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
+    ledger->asyncGetBlockNumberByHash(
+        bcos::crypto::HashType(_blockHash, bcos::crypto::HashType::FromHex),
+        [m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName),
+            m_blockHash = std::string(_blockHash), _onlyHeader, _onlyTxHash,
+            m_respFunc = std::move(_respFunc),
+            self](Error::Ptr _error, protocol::BlockNumber blockNumber) {
+            if (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS)
+            {
+                auto rpc = self.lock();
+                if (rpc)
+                {
+                    return rpc->streamBlockByNumber(m_groupID, m_nodeName, blockNumber,
+                        _onlyHeader, _onlyTxHash, std::move(m_respFunc));
+                }
+            }
+            else
+            {
+                RPC_IMPL_LOG(INFO)
+                    << LOG_BADGE("streamBlockByHash failed") << LOG_KV("blockHash", m_blockHash)
+                    << LOG_KV("code", _error ? _error->errorCode() : 0)
+                    << LOG_KV("message", _error ? _error->errorMessage() : "success");
+                m_respFunc(_error, [](JsonStreamWriter& _writer) { _writer.null(); });
+            }
+        });
+}
+
+void JsonRpcImpl_2_0::fetchBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+    std::function<void(Error::Ptr, protocol::Block::Ptr)> _callback)
 {
     RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockByNumber") << LOG_KV("_blockNumber", _blockNumber)
                         << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
@@ -809,9 +983,8 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
                     (_onlyTxHash ? bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS_HASH :
                                    bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS);
     ledger->asyncGetBlockDataByNumber(_blockNumber, flag,
-        [_blockNumber, _onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+        [_blockNumber, _onlyHeader, _onlyTxHash, m_callback = std::move(_callback)](
             Error::Ptr _error, protocol::Block::Ptr _block) {
-            Json::Value jResp;
             if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
             {
                 RPC_IMPL_LOG(INFO)
@@ -820,7 +993,18 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
                     << LOG_KV("code", _error ? _error->errorCode() : 0)
                     << LOG_KV("message", _error ? _error->errorMessage() : "success");
             }
-            else
+            m_callback(std::move(_error), std::move(_block));
+        });
+}
+
+void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
+{
+    fetchBlockByNumber(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        [_onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            Json::Value jResp;
+            if (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS)
             {
                 if (_onlyHeader)
                 {
@@ -835,6 +1019,27 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
         });
 }
 
+void JsonRpcImpl_2_0::streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    fetchBlockByNumber(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        [_onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            // the block is written into the response buffer, no Json::Value of it is built
+            m_respFunc(std::move(_error),
+                [block = std::move(_block), _onlyHeader, _onlyTxHash](JsonStreamWriter& _writer) {
+                    if (_onlyHeader)
+                    {
+                        toJsonResp(_writer, block ? block->blockHeader() : nullptr);
+                    }
+                    else
+                    {
+                        toJsonResp(_writer, *block, _onlyTxHash);
+                    }
+                });
+        });
+}
+
 void JsonRpcImpl_2_0::getBlockHashByNumber(
     std::string_view _groupID, std::string_view _nodeName, int64_t _blockNumber, RespFunc _respFunc)
 {
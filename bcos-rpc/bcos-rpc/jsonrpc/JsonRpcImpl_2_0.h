@@ -59,6 +59,12 @@ public:
     void getTransactionReceipt(std::string_view _groupID, std::string_view _nodeName,
         std::string_view _txHash, bool _requireProof, RespFunc _respFunc) override;
 
+    void getTransactions(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> _txHashes, BatchRespFunc _respFunc) override;
+
+    void getTransactionReceipts(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> _txHashes, BatchRespFunc _respFunc) override;
+
     void getBlockByHash(std::string_view _groupID, std::string_view _nodeName,
         std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
         RespFunc _respFunc) override;
@@ -66,6 +72,14 @@ public:
     void getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
         int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc) override;
 
+    void streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
+    void streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
     void getBlockHashByNumber(std::string_view _groupID, std::string_view _nodeName,
         int64_t _blockNumber, RespFunc _respFunc) override;
 
@@ -177,6 +191,11 @@ protected:
     static void execCall(NodeService::Ptr nodeService, protocol::Transaction::Ptr _tx,
         bcos::rpc::RespFunc _respFunc);
 
+    // the block of getBlockByNumber, with only the header, the tx hashes or the txs
+    void fetchBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _callback);
+
     // ms
     int m_sendTxTimeout = -1;
 
@@ -1,10 +1,14 @@
 #include "JsonRpcInterface.h"
+#include <bcos-utilities/Common.h>
 #include <json/forwards.h>
 #include <boost/beast/core/ostream.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <atomic>
+#include <map>
+#include <tuple>
 
 using namespace bcos::rpc;
 
@@ -112,6 +116,14 @@ void JsonRpcInterface::initMethod()
         getLogsI(params, std::move(callback));
     };
 
+    m_methodToStreamFunc["getBlockByHash"] = [this](ParamsType params, StreamRespFunc callback) {
+        streamBlockByHashI(params, std::move(callback));
+    };
+    m_methodToStreamFunc["getBlockByNumber"] = [this](ParamsType params,
+                                                   StreamRespFunc callback) {
+        streamBlockByNumberI(params, std::move(callback));
+    };
+
     for (const auto& method : m_methodToFunc)
     {
         RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("method", method.first);
@@ -119,30 +131,152 @@ void JsonRpcInterface::initMethod()
     RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("size", m_methodToFunc.size());
 }
 
+// fill the error of _response with the exception being handled
+static void setExceptionResponse(JsonResponse& _response)
+{
+    try
+    {
+        throw;
+    }
+    catch (const JsonRpcException& e)
+    {
+        _response.error.code = e.code();
+        _response.error.message = std::string(e.what());
+    }
+    catch (const std::exception& e)
+    {
+        // server internal error or unexpected error
+        _response.error.code = JsonRpcError::InvalidRequest;
+        _response.error.message = std::string(e.what());
+    }
+    catch (...)
+    {
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest")
+                            << LOG_DESC("response with unknown exception");
+        _response.error.code = JsonRpcError::InternalError;
+        _response.error.message = boost::current_exception_diagnostic_information();
+    }
+}
+
+// the lookups without proof of a batch can be served from one read of the ledger
+static bool isSharedLookup(const JsonRequest& _request)
+{
+    if (_request.method != "getTransaction" && _request.method != "getTransactionReceipt")
+    {
+        return false;
+    }
+    const auto& params = _request.params;
+    return params.size() >= 4 && params[0U].isString() && params[1U].isString() &&
+           params[2U].isString() && params[3U].isBool() && !params[3U].asBool();
+}
+
+void JsonRpcInterface::getTransactions(std::string_view _groupID, std::string_view _nodeName,
+    std::vector<std::string> _txHashes, BatchRespFunc _respFunc)
+{
+    boost::ignore_unused(_groupID, _nodeName, _txHashes);
+    std::vector<Json::Value> results;
+    _respFunc(BCOS_ERROR_PTR(JsonRpcError::MethodNotFound, "getTransactions is not supported"),
+        results);
+}
+
+void JsonRpcInterface::getTransactionReceipts(std::string_view _groupID,
+    std::string_view _nodeName, std::vector<std::string> _txHashes, BatchRespFunc _respFunc)
+{
+    boost::ignore_unused(_groupID, _nodeName, _txHashes);
+    std::vector<Json::Value> results;
+    _respFunc(BCOS_ERROR_PTR(
+                  JsonRpcError::MethodNotFound, "getTransactionReceipts is not supported"),
+        results);
+}
+
+void JsonRpcInterface::streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    getBlockByHash(_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash,
+        [_respFunc = std::move(_respFunc)](Error::Ptr _error, Json::Value& _result) {
+            _respFunc(std::move(_error), [result = std::move(_result)](JsonStreamWriter& _writer) {
+                _writer.value(result);
+            });
+        });
+}
+
+void JsonRpcInterface::streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    getBlockByNumber(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        [_respFunc = std::move(_respFunc)](Error::Ptr _error, Json::Value& _result) {
+            _respFunc(std::move(_error), [result = std::move(_result)](JsonStreamWriter& _writer) {
+                _writer.value(result);
+            });
+        });
+}
+
 void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sender)
 {
+    auto first = _requestBody.find_first_not_of(" \t\r\n");
+    if (first != std::string_view::npos && _requestBody[first] == '[')
+    {
+        onRPCBatchRequest(_requestBody, std::move(_sender));
+        return;
+    }
+
     JsonRequest request;
-    JsonResponse response;
     try
     {
         parseRpcRequestJson(_requestBody, request);
+    }
+    catch (...)
+    {
+        JsonResponse response{};
+        setExceptionResponse(response);
+        auto strResp = toStringResponse(std::move(response));
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_DESC("response with exception")
+                            << LOG_KV("request", _requestBody)
+                            << LOG_KV("response",
+                                   std::string_view((const char*)strResp.data(), strResp.size()));
+        _sender(std::move(strResp));
+        return;
+    }
 
-        response.jsonrpc = request.jsonrpc;
-        response.id = request.id;
+    if (c_fileLogLevel == TRACE) [[unlikely]]
+    {
+        RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody);
+    }
+    if (m_streamMethods.contains(request.method) &&
+        m_methodToStreamFunc.contains(request.method))
+    {
+        dispatchStreamRequest(std::move(request), std::move(_sender));
+        return;
+    }
+    dispatchRequest(std::move(request), [_sender = std::move(_sender)](JsonResponse _response) {
+        auto strResp = toStringResponse(std::move(_response));
+        if (c_fileLogLevel == TRACE) [[unlikely]]
+        {
+            RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest")
+                                << LOG_KV("response", std::string_view(
+                                                          (const char*)strResp.data(),
+                                                          strResp.size()));
+        }
+        _sender(std::move(strResp));
+    });
+}
 
-        const auto& method = request.method;
-        auto it = m_methodToFunc.find(method);
+void JsonRpcInterface::dispatchRequest(
+    JsonRequest _request, std::function<void(JsonResponse)> _respond)
+{
+    JsonResponse response{};
+    response.jsonrpc = _request.jsonrpc;
+    response.id = _request.id;
+    try
+    {
+        auto it = m_methodToFunc.find(_request.method);
         if (it == m_methodToFunc.end())
         {
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 JsonRpcError::MethodNotFound, "The method does not exist/is not available."));
         }
-        if (c_fileLogLevel == TRACE) [[unlikely]]
-        {
-            RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody);
-        }
-        it->second(
-            request.params, [response, _sender](Error::Ptr _error, Json::Value& _result) mutable {
+        it->second(_request.params,
+            [response, _respond](Error::Ptr _error, Json::Value& _result) mutable {
                 if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
                 {
                     // error
@@ -153,52 +287,256 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
                 {
                     response.result.swap(_result);
                 }
-                auto strResp = toStringResponse(std::move(response));
-                if (c_fileLogLevel == TRACE) [[unlikely]]
-                {
-                    RPC_IMPL_LOG(TRACE)
-                        << LOG_BADGE("onRPCRequest")
-                        << LOG_KV("response",
-                               std::string_view((const char*)strResp.data(), strResp.size()));
-                }
-                _sender(std::move(strResp));
+                _respond(std::move(response));
             });
 
         // success response
         return;
     }
-    catch (const JsonRpcException& e)
+    catch (...)
     {
-        response.error.code = e.code();
-        response.error.message = std::string(e.what());
+        setExceptionResponse(response);
     }
-    catch (const std::exception& e)
+
+    RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_DESC("response with exception")
+                        << LOG_KV("method", _request.method)
+                        << LOG_KV("code", response.error.code)
+                        << LOG_KV("message", response.error.message);
+    _respond(std::move(response));
+}
+
+void JsonRpcInterface::dispatchStreamRequest(JsonRequest _request, Sender _sender)
+{
+    JsonResponse response{};
+    response.jsonrpc = _request.jsonrpc;
+    response.id = _request.id;
+    try
     {
-        // server internal error or unexpected error
-        response.error.code = JsonRpcError::InvalidRequest;
-        response.error.message = std::string(e.what());
+        auto& streamFunc = m_methodToStreamFunc.at(_request.method);
+        streamFunc(_request.params, [response, _sender](Error::Ptr _error,
+                                        StreamResult _writeResult) mutable {
+            if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+            {
+                response.error.code = _error->errorCode();
+                response.error.message = _error->errorMessage();
+                _sender(toStringResponse(std::move(response)));
+                return;
+            }
+            // the same as toStringResponse of the JsonResponse with the result
+            bcos::bytes buffer;
+            JsonStreamWriter writer(buffer);
+            writer.beginObject();
+            writer.key("id");
+            writer.value(response.id);
+            writer.key("jsonrpc");
+            writer.value(response.jsonrpc);
+            writer.key("result");
+            _writeResult(writer);
+            writer.endObject();
+            if (c_fileLogLevel == TRACE) [[unlikely]]
+            {
+                RPC_IMPL_LOG(TRACE)
+                    << LOG_BADGE("onRPCRequest") << LOG_DESC("stream response")
+                    << LOG_KV("response", std::string_view((const char*)buffer.data(),
+                                              buffer.size()));
+            }
+            _sender(std::move(buffer));
+        });
+
+        // success response
+        return;
     }
     catch (...)
     {
-        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest")
-                            << LOG_DESC("response with unknown exception");
-        response.error.code = JsonRpcError::InternalError;
-        response.error.message = boost::current_exception_diagnostic_information();
+        setExceptionResponse(response);
     }
 
-    auto strResp = toStringResponse(response);
-
     RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCRequest") << LOG_DESC("response with exception")
-                        << LOG_KV("request", _requestBody)
-                        << LOG_KV("response",
-                               std::string_view((const char*)strResp.data(), strResp.size()));
-    _sender(std::move(strResp));
+                        << LOG_KV("method", _request.method)
+                        << LOG_KV("code", response.error.code)
+                        << LOG_KV("message", response.error.message);
+    _sender(toStringResponse(std::move(response)));
+}
+
+void JsonRpcInterface::onRPCBatchRequest(std::string_view _requestBody, Sender _sender)
+{
+    Json::Value root;
+    Json::Reader jsonReader;
+    JsonResponse response{};
+    response.jsonrpc = "2.0";
+    if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root) || !root.isArray())
+    {
+        response.error.code = JsonRpcError::ParseError;
+        response.error.message = "Invalid JSON was received by the server.";
+    }
+    else if (root.empty())
+    {
+        response.error.code = JsonRpcError::InvalidRequest;
+        response.error.message = "The batch request is empty.";
+    }
+    else if (root.size() > m_batchRequestSizeLimit)
+    {
+        response.error.code = JsonRpcError::InvalidRequest;
+        response.error.message =
+            "The batch request exceeds the size limit " + std::to_string(m_batchRequestSizeLimit);
+    }
+    if (response.error.code != 0)
+    {
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCBatchRequest") << LOG_DESC("invalid batch request")
+                            << LOG_KV("request", _requestBody)
+                            << LOG_KV("message", response.error.message);
+        _sender(toStringResponse(std::move(response)));
+        return;
+    }
+
+    // the requests are dispatched at once, the responses are assembled in the order of the
+    // requests whatever order they complete in
+    struct BatchResponses
+    {
+        std::vector<Json::Value> responses;
+        std::atomic<std::size_t> remaining;
+        Sender sender;
+        uint64_t startT;
+    };
+    auto batch = std::make_shared<BatchResponses>();
+    batch->responses.resize(root.size());
+    batch->remaining = root.size();
+    batch->sender = std::move(_sender);
+    batch->startT = utcSteadyTime();
+    BatchRespond respond = [batch](std::size_t _index, JsonResponse _response) {
+        batch->responses[_index] = toJsonResponse(std::move(_response));
+        if (batch->remaining.fetch_sub(1) != 1)
+        {
+            return;
+        }
+        Json::Value jResp(Json::arrayValue);
+        for (auto& item : batch->responses)
+        {
+            jResp.append(std::move(item));
+        }
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCBatchRequest") << LOG_KV("size", jResp.size())
+                            << LOG_KV("timecost", utcSteadyTime() - batch->startT);
+        batch->sender(toStringResponse(jResp));
+    };
+
+    std::map<std::tuple<std::string, std::string, std::string>,
+        std::vector<std::pair<std::size_t, JsonRequest>>>
+        sharedLookups;
+    for (Json::ArrayIndex i = 0; i < root.size(); ++i)
+    {
+        JsonRequest request{};
+        try
+        {
+            parseRpcRequestJson(root[i], request);
+        }
+        catch (...)
+        {
+            JsonResponse errorResponse{};
+            errorResponse.jsonrpc = "2.0";
+            setExceptionResponse(errorResponse);
+            respond(i, std::move(errorResponse));
+            continue;
+        }
+        if (isSharedLookup(request))
+        {
+            auto key = std::make_tuple(
+                request.method, request.params[0U].asString(), request.params[1U].asString());
+            sharedLookups[std::move(key)].emplace_back(i, std::move(request));
+            continue;
+        }
+        dispatchRequest(std::move(request),
+            [respond, i](JsonResponse _response) { respond(i, std::move(_response)); });
+    }
+    for (auto& it : sharedLookups)
+    {
+        dispatchSharedLookups(std::move(it.second), respond);
+    }
+}
+
+void JsonRpcInterface::dispatchSharedLookups(
+    std::vector<std::pair<std::size_t, JsonRequest>> _requests, BatchRespond _respond)
+{
+    auto requests =
+        std::make_shared<std::vector<std::pair<std::size_t, JsonRequest>>>(std::move(_requests));
+    auto dispatchOneByOne = [this, requests, _respond]() {
+        for (auto& [index, request] : *requests)
+        {
+            dispatchRequest(std::move(request), [_respond, i = index](JsonResponse _response) {
+                _respond(i, std::move(_response));
+            });
+        }
+    };
+    if (requests->size() == 1)
+    {
+        dispatchOneByOne();
+        return;
+    }
+
+    const auto& first = requests->front().second;
+    std::vector<std::string> txHashes;
+    txHashes.reserve(requests->size());
+    for (const auto& it : *requests)
+    {
+        txHashes.emplace_back(it.second.params[2U].asString());
+    }
+    auto onLookup = [requests, _respond, dispatchOneByOne](
+                        Error::Ptr _error, std::vector<Json::Value>& _results) {
+        if ((_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS) ||
+            _results.size() != requests->size())
+        {
+            RPC_IMPL_LOG(DEBUG) << LOG_BADGE("dispatchSharedLookups")
+                                << LOG_DESC("dispatch the lookups one by one")
+                                << LOG_KV("size", requests->size())
+                                << LOG_KV("message", _error ? _error->errorMessage() : "");
+            dispatchOneByOne();
+            return;
+        }
+        for (std::size_t i = 0; i < _results.size(); ++i)
+        {
+            auto const& [index, request] = (*requests)[i];
+            JsonResponse response{};
+            response.jsonrpc = request.jsonrpc;
+            response.id = request.id;
+            response.result.swap(_results[i]);
+            _respond(index, std::move(response));
+        }
+    };
+    try
+    {
+        auto groupID = first.params[0U].asString();
+        auto nodeName = first.params[1U].asString();
+        if (first.method == "getTransaction")
+        {
+            getTransactions(groupID, nodeName, std::move(txHashes), std::move(onLookup));
+        }
+        else
+        {
+            getTransactionReceipts(groupID, nodeName, std::move(txHashes), std::move(onLookup));
+        }
+    }
+    catch (...)
+    {
+        // responds the error of each request, e.g. the group doesn't exist
+        dispatchOneByOne();
+    }
 }
 
 void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest)
 {
     Json::Value root;
     Json::Reader jsonReader;
+    if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root))
+    {
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+                            << LOG_KV("message", "invalid request json object");
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
+    }
+    parseRpcRequestJson(root, _jsonRequest);
+}
+
+void bcos::rpc::parseRpcRequestJson(const Json::Value& root, JsonRequest& _jsonRequest)
+{
     std::string errorMessage;
 
     try
@@ -208,7 +546,7 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
         int64_t id = 0;
         do
         {
-            if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root))
+            if (!root.isObject())
             {
                 errorMessage = "invalid request json object";
                 break;
@@ -261,14 +599,13 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
     }
     catch (const std::exception& e)
     {
-        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson")
                             << LOG_KV("message", boost::diagnostic_information(e));
         BOOST_THROW_EXCEPTION(
             JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
     }
 
-    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
-                        << LOG_KV("message", errorMessage);
+    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("message", errorMessage);
 
     BOOST_THROW_EXCEPTION(JsonRpcException(
         JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
@@ -277,7 +614,11 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
 
 bcos::bytes bcos::rpc::toStringResponse(JsonResponse _jsonResponse)
 {
-    auto jResp = toJsonResponse(std::move(_jsonResponse));
+    return toStringResponse(toJsonResponse(std::move(_jsonResponse)));
+}
+
+bcos::bytes bcos::rpc::toStringResponse(const Json::Value& jResp)
+{
     auto builder = Json::StreamWriterBuilder();
     builder["commentStyle"] = "None";
     builder["indentation"] = "";
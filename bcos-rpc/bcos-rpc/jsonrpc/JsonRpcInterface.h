@@ -24,17 +24,23 @@
 #include <bcos-framework/multigroup/GroupInfo.h>
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/JsonStreamWriter.h>
 #include <bcos-utilities/Error.h>
 #include <json/json.h>
 #include <util/tc_json.h>
 #include <functional>
+#include <set>
 
 namespace bcos::rpc
 {
 
 using Sender = std::function<void(bcos::bytes)>;
 using RespFunc = std::function<void(bcos::Error::Ptr, Json::Value&)>;
+using BatchRespFunc = std::function<void(bcos::Error::Ptr, std::vector<Json::Value>&)>;
 using MethodMap = std::unordered_map<std::string, std::function<void(Json::Value&, RespFunc)>>;
+using StreamRespFunc = std::function<void(bcos::Error::Ptr, StreamResult)>;
+using StreamMethodMap =
+    std::unordered_map<std::string, std::function<void(Json::Value&, StreamRespFunc)>>;
 
 class JsonRpcInterface
 {
@@ -134,12 +140,55 @@ public:
     virtual void getLogs(
         std::string_view _groupID, const Json::Value& params, RespFunc _respFunc) = 0;
 
+    // get the txs of _txHashes with one read of the ledger, the results are in the order of
+    // _txHashes, the default implementation responds an error
+    virtual void getTransactions(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> _txHashes, BatchRespFunc _respFunc);
+    // get the receipts of _txHashes with one read of the ledger, see getTransactions
+    virtual void getTransactionReceipts(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> _txHashes, BatchRespFunc _respFunc);
+
+    // getBlockByHash and getBlockByNumber writing the block straight into the response, the
+    // default implementations write the Json::Value of getBlockByHash and getBlockByNumber
+    virtual void streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc);
+    virtual void streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc);
+
+    // handle a request or a batch of requests, https://www.jsonrpc.org/specification#batch
     void onRPCRequest(std::string_view _requestBody, Sender _sender);
 
+    // the methods whose result is written straight into the response of a single request
+    const std::set<std::string>& streamMethods() const { return m_streamMethods; }
+    void setStreamMethods(std::set<std::string> _streamMethods)
+    {
+        m_streamMethods = std::move(_streamMethods);
+    }
+
+    uint32_t batchRequestSizeLimit() const { return m_batchRequestSizeLimit; }
+    void setBatchRequestSizeLimit(uint32_t _batchRequestSizeLimit)
+    {
+        m_batchRequestSizeLimit = _batchRequestSizeLimit;
+    }
+
 protected:
     void initMethod();
 
+    using BatchRespond = std::function<void(std::size_t, JsonResponse)>;
+    void dispatchRequest(JsonRequest _request, std::function<void(JsonResponse)> _respond);
+    void dispatchStreamRequest(JsonRequest _request, Sender _sender);
+    void onRPCBatchRequest(std::string_view _requestBody, Sender _sender);
+    // serve the getTransaction or getTransactionReceipt requests of a batch sharing the group and
+    // node with one ledger read, fall back to dispatching them one by one on error
+    void dispatchSharedLookups(
+        std::vector<std::pair<std::size_t, JsonRequest>> _requests, BatchRespond _respond);
+
     MethodMap m_methodToFunc;
+    StreamMethodMap m_methodToStreamFunc;
+    std::set<std::string> m_streamMethods{DEFAULT_STREAM_METHODS.begin(),
+        DEFAULT_STREAM_METHODS.end()};
+    uint32_t m_batchRequestSizeLimit = DEFAULT_BATCH_REQUEST_SIZE_LIMIT;
 
 
     std::string_view toView(const Json::Value& value)
@@ -200,6 +249,20 @@ protected:
             std::move(_respFunc));
     }
 
+    void streamBlockByHashI(const Json::Value& req, StreamRespFunc _respFunc)
+    {
+        streamBlockByHash(toView(req[0u]), toView(req[1u]), toView(req[2u]),
+            (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
+            std::move(_respFunc));
+    }
+
+    void streamBlockByNumberI(const Json::Value& req, StreamRespFunc _respFunc)
+    {
+        streamBlockByNumber(toView(req[0u]), toView(req[1u]), req[2u].asInt64(),
+            (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
+            std::move(_respFunc));
+    }
+
     void getBlockHashByNumberI(const Json::Value& req, RespFunc _respFunc)
     {
         getBlockHashByNumber(
@@ -332,7 +395,9 @@ protected:
     }
 };
 void parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest);
+void parseRpcRequestJson(const Json::Value& _root, JsonRequest& _jsonRequest);
 bcos::bytes toStringResponse(JsonResponse _jsonResponse);
+bcos::bytes toStringResponse(const Json::Value& _jResp);
 Json::Value toJsonResponse(JsonResponse _jsonResponse);
 
 
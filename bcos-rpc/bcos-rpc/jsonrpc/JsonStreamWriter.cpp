@@ -0,0 +1,361 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file JsonStreamWriter.cpp
+ */
+#include "bcos-rpc/jsonrpc/JsonStreamWriter.h"
+#include "bcos-crypto/ChecksumAddress.h"
+#include "bcos-rpc/web3jsonrpc/model/Web3Transaction.h"
+#include <algorithm>
+#include <optional>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+static const Json::StreamWriterBuilder& compactWriterBuilder()
+{
+    static const Json::StreamWriterBuilder builder = []() {
+        Json::StreamWriterBuilder builder;
+        builder["commentStyle"] = "None";
+        builder["indentation"] = "";
+        return builder;
+    }();
+    return builder;
+}
+
+void JsonStreamWriter::value(std::string_view _value)
+{
+    // the same chars jsoncpp escapes
+    auto needEscape = std::any_of(_value.begin(), _value.end(), [](char c) {
+        auto ch = static_cast<unsigned char>(c);
+        return ch == '"' || ch == '\\' || ch < 0x20 || ch > 0x7f;
+    });
+    if (needEscape) [[unlikely]]
+    {
+        value(Json::Value(_value.data(), _value.data() + _value.size()));
+        return;
+    }
+    separate();
+    m_buffer.reserve(m_buffer.size() + _value.size() + 2);
+    m_buffer.push_back('"');
+    m_buffer.insert(m_buffer.end(), _value.begin(), _value.end());
+    m_buffer.push_back('"');
+    m_needComma = true;
+}
+
+void JsonStreamWriter::value(const Json::Value& _value)
+{
+    append(Json::writeString(compactWriterBuilder(), _value));
+}
+
+// the fields are written in the order jsoncpp sorts the keys of toJsonResp(Json::Value&, ...)
+void bcos::rpc::toJsonResp(
+    JsonStreamWriter& _writer, bcos::protocol::Transaction const& _transaction)
+{
+    auto version = _transaction.version();
+    bool hasFeeFields = version >= int32_t(bcos::protocol::TransactionVersion::V1_VERSION);
+    std::string value;
+    std::string gasPrice;
+    std::string maxFeePerGas;
+    std::string maxPriorityFeePerGas;
+    std::optional<uint64_t> web3GasLimit;
+    if (hasFeeFields)
+    {
+        value = _transaction.value();
+        gasPrice = _transaction.gasPrice();
+        maxFeePerGas = _transaction.maxFeePerGas();
+        maxPriorityFeePerGas = _transaction.maxPriorityFeePerGas();
+    }
+    bool hasWeb3FeeFields = false;
+    if (_transaction.type() == bcos::protocol::TransactionType::Web3Transaction) [[unlikely]]
+    {
+        Web3Transaction web3Tx;
+        auto extraBytesRef =
+            bcos::bytesRef(const_cast<byte*>(_transaction.extraTransactionBytes().data()),
+                _transaction.extraTransactionBytes().size());
+        codec::rlp::decodeFromPayload(extraBytesRef, web3Tx);
+        value = web3Tx.value.str();
+        web3GasLimit = web3Tx.gasLimit;
+        if (web3Tx.type >= TransactionType::EIP1559)
+        {
+            hasWeb3FeeFields = true;
+            maxPriorityFeePerGas = web3Tx.maxPriorityFeePerGas.str();
+            maxFeePerGas = web3Tx.maxFeePerGas.str();
+            gasPrice = "0";
+        }
+        else
+        {
+            gasPrice = web3Tx.maxPriorityFeePerGas.str();
+        }
+    }
+    bool hasGasFields = hasFeeFields || web3GasLimit.has_value();
+    bool hasMaxFeeFields = hasFeeFields || hasWeb3FeeFields;
+
+    _writer.beginObject();
+    _writer.key("abi");
+    _writer.value(_transaction.abi());
+    _writer.key("blockLimit");
+    _writer.value(_transaction.blockLimit());
+    _writer.key("chainID");
+    _writer.value(_transaction.chainId());
+    if (version >= (int32_t)bcos::protocol::TransactionVersion::V2_VERSION)
+    {
+        _writer.key("extension");
+        _writer.beginArray();
+        for (const auto& ext : _transaction.extension())
+        {
+            _writer.value(static_cast<int>(ext));
+        }
+        _writer.endArray();
+    }
+    _writer.key("extraData");
+    _writer.value(_transaction.extraData());
+    _writer.key("from");
+    _writer.hexValue(_transaction.sender());
+    if (hasGasFields)
+    {
+        _writer.key("gasLimit");
+        if (web3GasLimit)
+        {
+            _writer.value(*web3GasLimit);
+        }
+        else
+        {
+            _writer.value(_transaction.gasLimit());
+        }
+        _writer.key("gasPrice");
+        _writer.value(gasPrice);
+    }
+    _writer.key("groupID");
+    _writer.value(_transaction.groupId());
+    _writer.key("hash");
+    _writer.hexValue(_transaction.hash());
+    _writer.key("importTime");
+    _writer.value(_transaction.importTime());
+    _writer.key("input");
+    _writer.hexValue(_transaction.input());
+    if (hasMaxFeeFields)
+    {
+        _writer.key("maxFeePerGas");
+        _writer.value(maxFeePerGas);
+        _writer.key("maxPriorityFeePerGas");
+        _writer.value(maxPriorityFeePerGas);
+    }
+    _writer.key("nonce");
+    _writer.hexValue(_transaction.nonce(), false);
+    _writer.key("signature");
+    _writer.hexValue(_transaction.signatureData());
+    _writer.key("to");
+    _writer.value(_transaction.to());
+    if (hasGasFields)
+    {
+        _writer.key("value");
+        _writer.value(value);
+    }
+    _writer.key("version");
+    _writer.value(version);
+    _writer.endObject();
+}
+
+void bcos::rpc::toJsonResp(JsonStreamWriter& _writer, std::string_view _txHash,
+    protocol::TransactionStatus _status,
+    bcos::protocol::TransactionReceipt const& _transactionReceipt, bool _isWasm,
+    crypto::Hash& _hashImpl)
+{
+    std::string contractAddress = std::string(_transactionReceipt.contractAddress());
+    std::string checksumContractAddr = contractAddress;
+    if (!contractAddress.empty() && !_isWasm)
+    {
+        toChecksumAddress(checksumContractAddr, _hashImpl.hash(contractAddress).hex());
+        if (!contractAddress.starts_with("0x") && !contractAddress.starts_with("0X"))
+        {
+            contractAddress = "0x" + contractAddress;
+        }
+        if (!checksumContractAddr.starts_with("0x") && !checksumContractAddr.starts_with("0X"))
+        {
+            checksumContractAddr = "0x" + checksumContractAddr;
+        }
+    }
+
+    _writer.beginObject();
+    _writer.key("checksumContractAddress");
+    _writer.value(checksumContractAddr);
+    _writer.key("contractAddress");
+    _writer.value(contractAddress);
+    if (_transactionReceipt.version() >=
+        int32_t(bcos::protocol::TransactionVersion::V1_VERSION))
+    {
+        _writer.key("effectiveGasPrice");
+        _writer.value(_transactionReceipt.effectiveGasPrice());
+    }
+    _writer.key("gasUsed");
+    _writer.value(_transactionReceipt.gasUsed().str(16));
+    _writer.key("hash");
+    if (_status == protocol::TransactionStatus::None)
+    {
+        _writer.hexValue(_transactionReceipt.hash());
+    }
+    else
+    {
+        _writer.value("0x");
+    }
+    _writer.key("logEntries");
+    _writer.beginArray();
+    for (const auto& logEntry : _transactionReceipt.logEntries())
+    {
+        _writer.beginObject();
+        _writer.key("address");
+        _writer.value(logEntry.address());
+        _writer.key("data");
+        _writer.hexValue(logEntry.data());
+        _writer.key("topics");
+        _writer.beginArray();
+        for (const auto& topic : logEntry.topics())
+        {
+            _writer.hexValue(topic);
+        }
+        _writer.endArray();
+        _writer.endObject();
+    }
+    _writer.endArray();
+    _writer.key("message");
+    _writer.value(_transactionReceipt.message());
+    _writer.key("output");
+    _writer.hexValue(_transactionReceipt.output());
+    _writer.key("status");
+    // see toJsonResp(Json::Value&, ...) for the status of sendTransaction
+    _writer.value((_status == protocol::TransactionStatus::None) ?
+                      _transactionReceipt.status() :
+                      static_cast<int32_t>(_status));
+    _writer.key("transactionHash");
+    _writer.value(_txHash);
+    _writer.key("version");
+    _writer.value(_transactionReceipt.version());
+    _writer.endObject();
+}
+
+// the fields of the header, with the txs of _block between timestamp and txsRoot if it is set
+static void writeBlockHeader(JsonStreamWriter& _writer,
+    const bcos::protocol::BlockHeader::Ptr& _blockHeaderPtr, bcos::protocol::Block* _block,
+    bool _onlyTxHash)
+{
+    if (!_blockHeaderPtr && !_block)
+    {
+        _writer.null();
+        return;
+    }
+    _writer.beginObject();
+    if (_blockHeaderPtr)
+    {
+        _writer.key("consensusWeights");
+        _writer.beginArray();
+        for (const auto& wei : _blockHeaderPtr->consensusWeights())
+        {
+            _writer.value(wei);
+        }
+        _writer.endArray();
+        _writer.key("extraData");
+        _writer.hexValue(_blockHeaderPtr->extraData());
+        _writer.key("gasUsed");
+        _writer.value(_blockHeaderPtr->gasUsed().str(16));
+        _writer.key("hash");
+        _writer.hexValue(_blockHeaderPtr->hash());
+        _writer.key("number");
+        _writer.value(_blockHeaderPtr->number());
+        _writer.key("parentInfo");
+        _writer.beginArray();
+        for (const auto& p : _blockHeaderPtr->parentInfo())
+        {
+            _writer.beginObject();
+            _writer.key("blockHash");
+            _writer.hexValue(p.blockHash);
+            _writer.key("blockNumber");
+            _writer.value(p.blockNumber);
+            _writer.endObject();
+        }
+        _writer.endArray();
+        _writer.key("receiptsRoot");
+        _writer.hexValue(_blockHeaderPtr->receiptsRoot());
+        _writer.key("sealer");
+        _writer.value(_blockHeaderPtr->sealer());
+        _writer.key("sealerList");
+        _writer.beginArray();
+        for (const auto& sealer : _blockHeaderPtr->sealerList())
+        {
+            _writer.hexValue(sealer);
+        }
+        _writer.endArray();
+        _writer.key("signatureList");
+        _writer.beginArray();
+        for (const auto& sign : _blockHeaderPtr->signatureList())
+        {
+            _writer.beginObject();
+            _writer.key("sealerIndex");
+            _writer.value(sign.index);
+            _writer.key("signature");
+            _writer.hexValue(sign.signature);
+            _writer.endObject();
+        }
+        _writer.endArray();
+        _writer.key("stateRoot");
+        _writer.hexValue(_blockHeaderPtr->stateRoot());
+        _writer.key("timestamp");
+        _writer.value(_blockHeaderPtr->timestamp());
+    }
+    if (_block)
+    {
+        _writer.key("transactions");
+        _writer.beginArray();
+        auto txSize =
+            _onlyTxHash ? _block->transactionsMetaDataSize() : _block->transactionsSize();
+        if (_onlyTxHash)
+        {
+            auto transactionMetaDatas = _block->transactionMetaDatas();
+            for (std::size_t index = 0; index < txSize; ++index)
+            {
+                _writer.hexValue(transactionMetaDatas[index]->hash());
+            }
+        }
+        else
+        {
+            auto transactions = _block->transactions();
+            for (std::size_t index = 0; index < txSize; ++index)
+            {
+                toJsonResp(_writer, *transactions[index]);
+            }
+        }
+        _writer.endArray();
+    }
+    if (_blockHeaderPtr)
+    {
+        _writer.key("txsRoot");
+        _writer.hexValue(_blockHeaderPtr->txsRoot());
+        _writer.key("version");
+        _writer.value(_blockHeaderPtr->version());
+    }
+    _writer.endObject();
+}
+
+void bcos::rpc::toJsonResp(
+    JsonStreamWriter& _writer, bcos::protocol::BlockHeader::Ptr _blockHeaderPtr)
+{
+    writeBlockHeader(_writer, _blockHeaderPtr, nullptr, false);
+}
+
+void bcos::rpc::toJsonResp(
+    JsonStreamWriter& _writer, bcos::protocol::Block& _block, bool _onlyTxHash)
+{
+    writeBlockHeader(_writer, _block.blockHeader(), &_block, _onlyTxHash);
+}
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief write the JSON of a response straight into the output buffer, without building the
+ * Json::Value tree of it first
+ *
+ * The output is the same as the one of Json::StreamWriterBuilder without indentation, as long as
+ * the keys of each object are written in the order jsoncpp sorts them.
+ *
+ * @file JsonStreamWriter.h
+ */
+#pragma once
+
+#include "bcos-framework/protocol/Block.h"
+#include "bcos-framework/protocol/ProtocolTypeDef.h"
+#include "bcos-framework/protocol/Transaction.h"
+#include "bcos-framework/protocol/TransactionReceipt.h"
+#include "bcos-protocol/TransactionStatus.h"
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Common.h>
+#include <json/json.h>
+#include <charconv>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace bcos::rpc
+{
+class JsonStreamWriter
+{
+public:
+    explicit JsonStreamWriter(bcos::bytes& _buffer) : m_buffer(_buffer) {}
+
+    void beginObject()
+    {
+        separate();
+        m_buffer.push_back('{');
+        m_needComma = false;
+    }
+    void endObject()
+    {
+        m_buffer.push_back('}');
+        m_needComma = true;
+    }
+    void beginArray()
+    {
+        separate();
+        m_buffer.push_back('[');
+        m_needComma = false;
+    }
+    void endArray()
+    {
+        m_buffer.push_back(']');
+        m_needComma = true;
+    }
+
+    // the key of the next value in the current object
+    void key(std::string_view _key)
+    {
+        value(_key);
+        m_buffer.push_back(':');
+        m_needComma = false;
+    }
+
+    void value(std::string_view _value);
+    void value(const char* _value) { value(std::string_view(_value)); }
+    void value(const std::string& _value) { value(std::string_view(_value)); }
+    void value(bool _value)
+    {
+        append(_value ? std::string_view("true") : std::string_view("false"));
+    }
+    template <class Int>
+        requires std::is_integral_v<Int>
+    void value(Int _value)
+    {
+        char number[24];
+        auto result = std::to_chars(number, number + sizeof(number), _value);
+        append(std::string_view(number, result.ptr - number));
+    }
+    // a value built as Json::Value, written by jsoncpp
+    void value(const Json::Value& _value);
+    void null() { append("null"); }
+
+    // the lowercase hex string of _data, the same as toHexStringWithPrefix or toHex
+    template <class Data>
+    void hexValue(const Data& _data, bool _withPrefix = true)
+    {
+        separate();
+        auto begin = (const byte*)_data.data();
+        auto end = begin + _data.size();
+        m_buffer.reserve(m_buffer.size() + _data.size() * 2 + 4);
+        m_buffer.push_back('"');
+        if (_withPrefix)
+        {
+            m_buffer.push_back('0');
+            m_buffer.push_back('x');
+        }
+        constexpr static std::string_view hexChars = "0123456789abcdef";
+        for (auto it = begin; it != end; ++it)
+        {
+            m_buffer.push_back(hexChars[*it >> 4]);
+            m_buffer.push_back(hexChars[*it & 0x0f]);
+        }
+        m_buffer.push_back('"');
+        m_needComma = true;
+    }
+
+private:
+    void separate()
+    {
+        if (m_needComma)
+        {
+            m_buffer.push_back(',');
+        }
+    }
+    void append(std::string_view _token)
+    {
+        separate();
+        m_buffer.insert(m_buffer.end(), _token.begin(), _token.end());
+        m_needComma = true;
+    }
+
+    bcos::bytes& m_buffer;
+    bool m_needComma = false;
+};
+
+// writes the result of a request into the response
+using StreamResult = std::function<void(JsonStreamWriter&)>;
+
+// the same JSON as the toJsonResp overloads of JsonRpcImpl_2_0.h, keep them in sync
+void toJsonResp(JsonStreamWriter& _writer, bcos::protocol::Transaction const& _transaction);
+void toJsonResp(JsonStreamWriter& _writer, std::string_view _txHash,
+    protocol::TransactionStatus _status,
+    bcos::protocol::TransactionReceipt const& _transactionReceipt, bool _isWasm,
+    crypto::Hash& _hashImpl);
+void toJsonResp(JsonStreamWriter& _writer, bcos::protocol::BlockHeader::Ptr _blockHeaderPtr);
+void toJsonResp(JsonStreamWriter& _writer, bcos::protocol::Block& _block, bool _onlyTxHash);
+}  // namespace bcos::rpc
@@ -11,6 +11,7 @@
 #include <bcos-framework/protocol/LogEntry.h>
 #include <bcos-rpc/event/EventSubMatcher.h>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 
 using namespace bcos;
 using namespace bcos::event;
@@ -68,5 +69,61 @@ BOOST_AUTO_TEST_CASE(topicFilter)
     BOOST_CHECK(!matcher.matches(params, makeLog("addr", {})));
 }
 
+BOOST_AUTO_TEST_CASE(indexMatchesLikeParams)
+{
+    TestMatcher matcher;
+    h256 topic1(0x42);
+    h256 topic2(0x43);
+    std::vector<EventSubParams::Ptr> subscriptions;
+    // anything
+    subscriptions.emplace_back(std::make_shared<EventSubParams>());
+    // by address
+    subscriptions.emplace_back(std::make_shared<EventSubParams>());
+    subscriptions.back()->addAddress("addr1");
+    subscriptions.back()->addAddress("addr2");
+    // by address and topic
+    subscriptions.emplace_back(std::make_shared<EventSubParams>());
+    subscriptions.back()->addAddress("addr1");
+    subscriptions.back()->addTopic(0, topic1.hex());
+    // by first topic
+    subscriptions.emplace_back(std::make_shared<EventSubParams>());
+    subscriptions.back()->addTopic(0, topic1.hex());
+    subscriptions.back()->addTopic(0, topic2.hex());
+    // by second topic only
+    subscriptions.emplace_back(std::make_shared<EventSubParams>());
+    subscriptions.back()->addTopic(1, topic2.hex());
+
+    EventSubIndex index;
+    for (std::size_t i = 0; i < subscriptions.size(); ++i)
+    {
+        index.add(i, subscriptions[i]);
+    }
+    BOOST_CHECK_EQUAL(index.size(), subscriptions.size());
+
+    std::vector<protocol::LogEntry> logs = {makeLog("addr1", {}), makeLog("addr1", {topic1}),
+        makeLog("addr2", {topic2, topic2}), makeLog("addr3", {topic1, topic2}),
+        makeLog("addr3", {h256(0x99)})};
+    for (const auto& log : logs)
+    {
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < subscriptions.size(); ++i)
+        {
+            if (matcher.matches(subscriptions[i], log))
+            {
+                expected.emplace_back(i);
+            }
+        }
+        std::vector<std::size_t> matched;
+        matcher.matches(index, log, matched);
+        std::sort(matched.begin(), matched.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            matched.begin(), matched.end(), expected.begin(), expected.end());
+    }
+
+    std::vector<std::size_t> matched;
+    matcher.matches(index, makeLog("addr3", {topic1, topic2}), matched);
+    BOOST_CHECK_EQUAL(matched.size(), 3U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
@@ -0,0 +1,241 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the streamed responses are the same as the ones serialized from Json::Value
+ * @file JsonStreamWriterTest.cpp
+ */
+#include "../common/RPCFixture.h"
+#include "bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h"
+#include "bcos-rpc/jsonrpc/JsonStreamWriter.h"
+#include <bcos-tars-protocol/protocol/TransactionImpl.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+namespace bcos::test
+{
+namespace
+{
+std::string toString(const Json::Value& _value)
+{
+    auto buffer = toStringResponse(_value);
+    return {buffer.begin(), buffer.end()};
+}
+
+template <class Write>
+std::string streamed(Write&& _write)
+{
+    bcos::bytes buffer;
+    JsonStreamWriter writer(buffer);
+    _write(writer);
+    return {buffer.begin(), buffer.end()};
+}
+
+protocol::Transaction::Ptr makeTransaction(int32_t _version, const crypto::Hash& _hashImpl)
+{
+    bcostars::Transaction inner;
+    inner.data.version = _version;
+    inner.data.chainID = "chain0";
+    inner.data.groupID = "group0";
+    inner.data.blockLimit = 500;
+    inner.data.nonce = std::string("\x01\xfe nonce", 8);
+    inner.data.to = "0x1234567890123456789012345678901234567890";
+    inner.data.input = {1, 2, 3, -1};
+    // the strings jsoncpp escapes
+    inner.data.abi = "[{\"name\":\"set\",\"type\":\"function\"}]\\";
+    inner.data.value = "100";
+    inner.data.gasPrice = "200";
+    inner.data.gasLimit = 3000000;
+    inner.data.maxFeePerGas = "300";
+    inner.data.maxPriorityFeePerGas = "400";
+    inner.data.extension = {7, -1, 0};
+    inner.signature = {9, 8, 7};
+    inner.importTime = 1700000000000;
+    inner.sender = {0x12, 0x34};
+    inner.extraData = "line\n\t\"quoted\" \x7f \xe4\xb8\xad\xe6\x96\x87";
+    auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>();
+    transaction->setInner(std::move(inner));
+    transaction->calculateHash(_hashImpl);
+    return transaction;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(JsonStreamWriterTest, RPCFixture)
+
+BOOST_AUTO_TEST_CASE(values)
+{
+    auto output = streamed([](JsonStreamWriter& writer) {
+        writer.beginObject();
+        writer.key("array");
+        writer.beginArray();
+        writer.value(int64_t(-1));
+        writer.value(uint64_t(18446744073709551615ULL));
+        writer.value(true);
+        writer.null();
+        writer.beginArray();
+        writer.endArray();
+        writer.beginObject();
+        writer.endObject();
+        writer.endArray();
+        writer.key("hex");
+        writer.hexValue(bytes{0x00, 0xab, 0xff});
+        writer.key("string");
+        writer.value(std::string("a\"b\\c\x01\n\xc3\xa9/", 10));
+        writer.key("value");
+        Json::Value value;
+        value["x"] = 1;
+        writer.value(value);
+        writer.endObject();
+    });
+
+    Json::Value expected;
+    expected["array"].append(Json::Int64(-1));
+    expected["array"].append(Json::UInt64(18446744073709551615ULL));
+    expected["array"].append(true);
+    expected["array"].append(Json::Value());
+    expected["array"].append(Json::Value(Json::arrayValue));
+    expected["array"].append(Json::Value(Json::objectValue));
+    expected["hex"] = "0x00abff";
+    expected["string"] = std::string("a\"b\\c\x01\n\xc3\xa9/", 10);
+    expected["value"]["x"] = 1;
+    BOOST_CHECK_EQUAL(output, toString(expected));
+}
+
+BOOST_AUTO_TEST_CASE(transaction)
+{
+    for (auto version : {0, 1, 2})
+    {
+        auto transaction = makeTransaction(version, *hashImpl);
+        Json::Value expected;
+        toJsonResp(expected, *transaction);
+        auto output = streamed([&](JsonStreamWriter& writer) { toJsonResp(writer, *transaction); });
+        BOOST_CHECK_EQUAL(output, toString(expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(receipt)
+{
+    auto receiptFactory = m_blockFactory->receiptFactory();
+    std::vector<protocol::LogEntry> logs;
+    logs.emplace_back(bytes{'a', 'b', 'c'}, h256s{h256(1), h256(2)}, bytes{1, 2, 3});
+    logs.emplace_back(bytes{}, h256s{}, bytes{});
+    bytes output{4, 5, 6};
+    std::vector<protocol::TransactionReceipt::Ptr> receipts{
+        receiptFactory->createReceipt(21000, "", logs, 0, ref(output), 10),
+        receiptFactory->createReceipt2(
+            21000, "1234567890123456789012345678901234567890", logs, 16, ref(output), 10),
+        receiptFactory->createReceipt(0, "", {}, 0, {}, 0)};
+    receipts.back()->setMessage("reverted: \"out of gas\"");
+    for (const auto& receipt : receipts)
+    {
+        for (auto status : {protocol::TransactionStatus::None,
+                 protocol::TransactionStatus::TransactionPoolTimeout})
+        {
+            for (auto isWasm : {false, true})
+            {
+                Json::Value expected;
+                toJsonResp(expected, "0xabcd", status, *receipt, isWasm, *hashImpl);
+                auto output = streamed([&](JsonStreamWriter& writer) {
+                    toJsonResp(writer, "0xabcd", status, *receipt, isWasm, *hashImpl);
+                });
+                BOOST_CHECK_EQUAL(output, toString(expected));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(block)
+{
+    auto block = m_blockFactory->createBlock();
+    auto header = block->blockHeader();
+    header->setVersion(3);
+    header->setNumber(100);
+    header->setTimestamp(1700000000000);
+    header->setSealer(1);
+    header->setGasUsed(123456);
+    header->setTxsRoot(h256(1));
+    header->setReceiptsRoot(h256(2));
+    header->setStateRoot(h256(3));
+    header->setExtraData(bytes{1, 2});
+    header->setSealerList(std::vector<bytes>{bytes(64, 1), bytes(64, 2)});
+    header->setConsensusWeights(std::vector<uint64_t>{1, 2});
+    std::vector<protocol::ParentInfo> parentInfo{{99, h256(4)}};
+    header->setParentInfo(parentInfo);
+    header->setSignatureList(protocol::SignatureList{{0, bytes(65, 3)}, {1, bytes(65, 4)}});
+    for (auto version : {0, 1, 2})
+    {
+        auto transaction = makeTransaction(version, *hashImpl);
+        block->appendTransaction(transaction);
+        block->appendTransactionMetaData(
+            m_blockFactory->createTransactionMetaData(transaction->hash(), "to"));
+    }
+
+    for (auto onlyTxHash : {false, true})
+    {
+        Json::Value expected;
+        toJsonResp(expected, *block, onlyTxHash);
+        auto output =
+            streamed([&](JsonStreamWriter& writer) { toJsonResp(writer, *block, onlyTxHash); });
+        BOOST_CHECK_EQUAL(output, toString(expected));
+    }
+
+    Json::Value expected;
+    toJsonResp(expected, header);
+    auto output = streamed([&](JsonStreamWriter& writer) { toJsonResp(writer, header); });
+    BOOST_CHECK_EQUAL(output, toString(expected));
+    output = streamed([&](JsonStreamWriter& writer) { toJsonResp(writer, nullptr); });
+    BOOST_CHECK_EQUAL(output, "null");
+}
+
+BOOST_AUTO_TEST_CASE(streamMethods)
+{
+    auto rpc = factory->buildLocalRpc(groupInfo, nodeService);
+    rpc->groupManager()->updateGroupInfo(groupInfo);
+    auto impl = rpc->jsonRpcImpl();
+    BOOST_CHECK(impl->streamMethods().contains("getBlockByNumber"));
+
+    auto onRPCRequest = [&impl](const std::string& request) {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto future = promise->get_future();
+        impl->onRPCRequest(request, [promise](bcos::bytes response) {
+            promise->set_value(std::string(response.begin(), response.end()));
+        });
+        return future.get();
+    };
+    std::vector<std::string> requests;
+    for (auto params : {"1,false,false", "1,false,true", "1,true,false", "100,false,false"})
+    {
+        requests.emplace_back(
+            "{\"jsonrpc\":\"2.0\",\"method\":\"getBlockByNumber\",\"params\":[\"" + groupId +
+            "\",\"\"," + params + "],\"id\":3}");
+    }
+    std::vector<std::string> streamedResponses;
+    for (const auto& request : requests)
+    {
+        streamedResponses.emplace_back(onRPCRequest(request));
+    }
+
+    // the same responses with the streaming of getBlockByNumber turned off
+    impl->setStreamMethods({});
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(onRPCRequest(requests[i]), streamedResponses[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -218,5 +218,71 @@ BOOST_AUTO_TEST_CASE(sendTransactionTimeoutStatusNotMaskedByEmptyReceipt)
         static_cast<int32_t>(protocol::TransactionStatus::TransactionPoolTimeout));
 }
 
+BOOST_AUTO_TEST_CASE(batchRequest)
+{
+    auto rpc = factory->buildLocalRpc(groupInfo, nodeService);
+    rpc->groupManager()->updateGroupInfo(groupInfo);
+    auto impl = rpc->jsonRpcImpl();
+
+    auto onRPCRequest = [&impl](const std::string& request) {
+        auto promise = std::make_shared<std::promise<Json::Value>>();
+        auto future = promise->get_future();
+        impl->onRPCRequest(request, [promise](bcos::bytes response) {
+            Json::Value root;
+            Json::Reader reader;
+            reader.parse(std::string(response.begin(), response.end()), root);
+            promise->set_value(std::move(root));
+        });
+        return future.get();
+    };
+
+    auto unknownHash = [](char c) { return "0x" + std::string(64, c); };
+    auto request = "[{\"jsonrpc\":\"2.0\",\"method\":\"getBlockNumber\",\"params\":[\"" + groupId +
+                   "\",\"\"],\"id\":1},"
+                   "{\"jsonrpc\":\"2.0\",\"method\":\"unknownMethod\",\"params\":[],\"id\":2},"
+                   "{\"jsonrpc\":\"2.0\",\"method\":\"getTransaction\",\"params\":[\"" +
+                   groupId + "\",\"\",\"" + unknownHash('a') + "\",false],\"id\":3},"
+                   "\"invalid\","
+                   "{\"jsonrpc\":\"2.0\",\"method\":\"getTransaction\",\"params\":[\"" +
+                   groupId + "\",\"\",\"" + unknownHash('b') + "\",false],\"id\":5},"
+                   "{\"jsonrpc\":\"2.0\",\"method\":\"getBlockNumber\",\"params\":[\"" + groupId +
+                   "\",\"\"],\"id\":6}]";
+    auto response = onRPCRequest(request);
+    // the responses are in the order of the requests
+    BOOST_REQUIRE(response.isArray());
+    BOOST_REQUIRE_EQUAL(response.size(), 6U);
+    BOOST_CHECK_EQUAL(response[0U]["id"].asInt64(), 1);
+    BOOST_CHECK_GT(response[0U]["result"].asInt64(), 0);
+    BOOST_CHECK_EQUAL(response[1U]["id"].asInt64(), 2);
+    BOOST_CHECK_EQUAL(response[1U]["error"]["code"].asInt(), JsonRpcError::MethodNotFound);
+    // the txs are missing in the ledger, the shared lookup falls back to the lookups one by one
+    BOOST_CHECK_EQUAL(response[2U]["id"].asInt64(), 3);
+    BOOST_CHECK(!response[2U].isMember("error"));
+    BOOST_CHECK(response[2U]["result"].isNull());
+    BOOST_CHECK_EQUAL(response[3U]["error"]["code"].asInt(), JsonRpcError::InvalidRequest);
+    BOOST_CHECK_EQUAL(response[4U]["id"].asInt64(), 5);
+    BOOST_CHECK(!response[4U].isMember("error"));
+    BOOST_CHECK_EQUAL(response[5U]["id"].asInt64(), 6);
+    BOOST_CHECK_EQUAL(response[5U]["result"], response[0U]["result"]);
+
+    // a single request is still answered with a single response
+    response = onRPCRequest("{\"jsonrpc\":\"2.0\",\"method\":\"getBlockNumber\",\"params\":[\"" +
+                            groupId + "\",\"\"],\"id\":7}");
+    BOOST_CHECK(response.isObject());
+    BOOST_CHECK_EQUAL(response["id"].asInt64(), 7);
+
+    response = onRPCRequest(" []");
+    BOOST_CHECK(response.isObject());
+    BOOST_CHECK_EQUAL(response["error"]["code"].asInt(), JsonRpcError::InvalidRequest);
+
+    response = onRPCRequest("[{\"jsonrpc\":\"2.0\"");
+    BOOST_CHECK_EQUAL(response["error"]["code"].asInt(), JsonRpcError::ParseError);
+
+    impl->setBatchRequestSizeLimit(2);
+    response = onRPCRequest(request);
+    BOOST_CHECK(response.isObject());
+    BOOST_CHECK_EQUAL(response["error"]["code"].asInt(), JsonRpcError::InvalidRequest);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
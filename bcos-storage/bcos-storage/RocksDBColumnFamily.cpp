@@ -0,0 +1,253 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the rocksDB split into a column family per class of tables
+ * @file RocksDBColumnFamily.cpp
+ */
+#include "RocksDBColumnFamily.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-framework/storage/Common.h"
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/Error.h>
+#include <rocksdb/write_batch.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <span>
+
+using namespace bcos::storage;
+
+#define STORAGE_ROCKSDB_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB]"
+
+namespace
+{
+constexpr static size_t MIGRATE_BATCH_ROWS = 10000;
+
+constexpr static std::array<std::string_view, 4> BLOCK_TABLES{
+    bcos::ledger::SYS_NUMBER_2_BLOCK_HEADER, bcos::ledger::SYS_NUMBER_2_TXS,
+    bcos::ledger::SYS_HASH_2_TX, bcos::ledger::SYS_HASH_2_RECEIPT};
+constexpr static std::array<std::string_view, 6> INDEX_TABLES{bcos::ledger::SYS_HASH_2_NUMBER,
+    bcos::ledger::SYS_NUMBER_2_HASH, bcos::ledger::SYS_BLOCK_NUMBER_2_NONCES,
+    bcos::ledger::SYS_LOG_INDEX, bcos::ledger::SYS_NUMBER_2_TX_MERKLE,
+    bcos::ledger::SYS_NUMBER_2_RECEIPT_MERKLE};
+
+void checkColumnFamilyStatus(::rocksdb::Status const& status, std::string_view message)
+{
+    if (!status.ok())
+    {
+        STORAGE_ROCKSDB_LOG(ERROR) << message << LOG_KV("status", status.ToString());
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(DatabaseError, std::string(message) + ": " + status.ToString()));
+    }
+}
+}  // namespace
+
+ColumnFamilyClass bcos::storage::columnFamilyClass(std::string_view table)
+{
+    if (std::ranges::find(BLOCK_TABLES, table) != BLOCK_TABLES.end())
+    {
+        return ColumnFamilyClass::BLOCK;
+    }
+    if (std::ranges::find(INDEX_TABLES, table) != INDEX_TABLES.end())
+    {
+        return ColumnFamilyClass::INDEX;
+    }
+    return ColumnFamilyClass::STATE;
+}
+
+std::string_view bcos::storage::tableOfDBKey(std::string_view dbKey)
+{
+    return dbKey.substr(0, dbKey.find(TABLE_KEY_SPLIT));
+}
+
+ColumnFamilyDB::ColumnFamilyDB(
+    ::rocksdb::DB* db, std::vector<::rocksdb::ColumnFamilyHandle*> handles)
+  : ::rocksdb::StackableDB(db), m_handles(std::move(handles))
+{}
+
+ColumnFamilyDB::~ColumnFamilyDB()
+{
+    releaseHandles();
+}
+
+std::unique_ptr<ColumnFamilyDB> ColumnFamilyDB::open(::rocksdb::DBOptions const& options,
+    std::string const& path, ColumnFamilyClassOptions const& columnFamilyOptions)
+{
+    std::vector<::rocksdb::ColumnFamilyDescriptor> descriptors;
+    for (size_t i = 0; i < COLUMN_FAMILY_CLASS_COUNT; ++i)
+    {
+        descriptors.emplace_back(std::string(COLUMN_FAMILY_NAMES[i]), columnFamilyOptions[i]);
+    }
+    auto dbOptions = options;
+    dbOptions.create_missing_column_families = true;
+
+    ::rocksdb::DB* db = nullptr;
+    std::vector<::rocksdb::ColumnFamilyHandle*> handles;
+    checkColumnFamilyStatus(::rocksdb::DB::Open(dbOptions, path, descriptors, &handles, &db),
+        "open rocksDB column families failed");
+
+    auto columnFamilyDB = std::make_unique<ColumnFamilyDB>(db, std::move(handles));
+    auto moved = columnFamilyDB->migrate();
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("open rocksDB column families") << LOG_KV("path", path)
+                              << LOG_KV("migrated", moved);
+    return columnFamilyDB;
+}
+
+bool ColumnFamilyDB::isSplit(::rocksdb::DBOptions const& options, std::string const& path)
+{
+    std::vector<std::string> columnFamilies;
+    // a DB that doesn't exist yet isn't split
+    auto status = ::rocksdb::DB::ListColumnFamilies(options, path, &columnFamilies);
+    return status.ok() && columnFamilies.size() > 1;
+}
+
+std::unique_ptr<::rocksdb::DB> ColumnFamilyDB::openForRead(::rocksdb::Options const& options,
+    std::string const& path, std::string const& secondaryPath)
+{
+    ::rocksdb::DB* db = nullptr;
+    if (!isSplit(options, path))
+    {
+        auto status = secondaryPath.empty() ?
+                          ::rocksdb::DB::OpenForReadOnly(options, path, &db) :
+                          ::rocksdb::DB::OpenAsSecondary(options, path, secondaryPath, &db);
+        checkColumnFamilyStatus(status, "open rocksDB for read failed");
+        std::unique_ptr<::rocksdb::DB> rocksDB(db);
+        if (!secondaryPath.empty())
+        {
+            checkColumnFamilyStatus(
+                rocksDB->TryCatchUpWithPrimary(), "rocksDB catch up with primary failed");
+        }
+        return rocksDB;
+    }
+
+    // the table options only matter to the writer, the defaults read every family
+    std::vector<::rocksdb::ColumnFamilyDescriptor> descriptors;
+    for (auto name : COLUMN_FAMILY_NAMES)
+    {
+        descriptors.emplace_back(std::string(name), ::rocksdb::ColumnFamilyOptions(options));
+    }
+    std::vector<::rocksdb::ColumnFamilyHandle*> handles;
+    checkColumnFamilyStatus(
+        secondaryPath.empty() ?
+            ::rocksdb::DB::OpenForReadOnly(options, path, descriptors, &handles, &db) :
+            ::rocksdb::DB::OpenAsSecondary(
+                options, path, secondaryPath, descriptors, &handles, &db),
+        "open rocksDB column families for read failed");
+    auto columnFamilyDB = std::make_unique<ColumnFamilyDB>(db, std::move(handles));
+    if (!secondaryPath.empty())
+    {
+        checkColumnFamilyStatus(
+            columnFamilyDB->TryCatchUpWithPrimary(), "rocksDB catch up with primary failed");
+    }
+    return columnFamilyDB;
+}
+
+::rocksdb::ColumnFamilyHandle* ColumnFamilyDB::columnFamily(
+    ColumnFamilyClass columnFamilyClass) const
+{
+    return m_handles[static_cast<size_t>(columnFamilyClass)];
+}
+
+::rocksdb::ColumnFamilyHandle* ColumnFamilyDB::columnFamilyOfTable(std::string_view table) const
+{
+    return columnFamily(columnFamilyClass(table));
+}
+
+::rocksdb::ColumnFamilyHandle* ColumnFamilyDB::columnFamilyOfKey(std::string_view dbKey) const
+{
+    return columnFamilyOfTable(tableOfDBKey(dbKey));
+}
+
+std::vector<::rocksdb::ColumnFamilyHandle*> const& ColumnFamilyDB::columnFamilies() const
+{
+    return m_handles;
+}
+
+size_t ColumnFamilyDB::migrate()
+{
+    auto* defaultColumnFamily = columnFamily(ColumnFamilyClass::STATE);
+    size_t moved = 0;
+    for (auto tables : {std::span<const std::string_view>(BLOCK_TABLES),
+             std::span<const std::string_view>(INDEX_TABLES)})
+    {
+        for (auto table : tables)
+        {
+            auto* target = columnFamilyOfTable(table);
+            auto prefix = toDBKey(table, {});
+            ::rocksdb::ReadOptions readOptions;
+            readOptions.total_order_seek = true;
+            std::unique_ptr<::rocksdb::Iterator> iterator(
+                NewIterator(readOptions, defaultColumnFamily));
+
+            ::rocksdb::WriteBatch writeBatch;
+            auto flush = [&]() {
+                checkColumnFamilyStatus(Write(::rocksdb::WriteOptions(), &writeBatch),
+                    "migrate rocksDB column families failed");
+                moved += writeBatch.Count() / 2;
+                writeBatch.Clear();
+            };
+            for (iterator->Seek(prefix); iterator->Valid() && iterator->key().starts_with(prefix);
+                 iterator->Next())
+            {
+                // move the row in the same batch so it is never lost nor read twice
+                writeBatch.Put(target, iterator->key(), iterator->value());
+                writeBatch.Delete(defaultColumnFamily, iterator->key());
+                if (writeBatch.Count() >= MIGRATE_BATCH_ROWS * 2)
+                {
+                    flush();
+                    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("migrating rocksDB column families")
+                                              << LOG_KV("table", table) << LOG_KV("moved", moved);
+                }
+            }
+            checkColumnFamilyStatus(iterator->status(), "migrate rocksDB column families failed");
+            flush();
+        }
+    }
+    return moved;
+}
+
+::rocksdb::Status ColumnFamilyDB::Close()
+{
+    // the handles must be released before the DB is closed
+    releaseHandles();
+    return ::rocksdb::StackableDB::Close();
+}
+
+void ColumnFamilyDB::releaseHandles()
+{
+    for (auto* handle : m_handles)
+    {
+        // the handle of the default column family is owned by the DB
+        if (handle != nullptr && handle != DefaultColumnFamily())
+        {
+            DestroyColumnFamilyHandle(handle);
+        }
+    }
+    m_handles.clear();
+}
+
+ColumnFamilyDB* bcos::storage::asColumnFamilyDB(::rocksdb::DB& db)
+{
+    return dynamic_cast<ColumnFamilyDB*>(std::addressof(db));
+}
+
+::rocksdb::ColumnFamilyHandle* bcos::storage::columnFamilyOfTable(
+    ::rocksdb::DB& db, std::string_view table)
+{
+    if (auto* columnFamilyDB = asColumnFamilyDB(db))
+    {
+        return columnFamilyDB->columnFamilyOfTable(table);
+    }
+    return db.DefaultColumnFamily();
+}
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the rocksDB split into a column family per class of tables
+ * @file RocksDBColumnFamily.h
+ */
+#pragma once
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <rocksdb/utilities/stackable_db.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos::storage
+{
+/**
+ * The tables are split into three classes with very different access patterns, each class is
+ * kept in its own column family with its own LSM, compaction and table options:
+ *  - STATE: the contract state and every table not listed as block or index, hot and updated in
+ *    place, it stays in the default column family so a DB that is not split reads the same
+ *  - BLOCK: the headers, transactions and receipts, written once and rarely read
+ *  - INDEX: the hash and number mappings, the nonces and the other ledger indices, small rows
+ *    read by point lookups
+ */
+enum class ColumnFamilyClass : uint8_t
+{
+    STATE = 0,
+    BLOCK = 1,
+    INDEX = 2,
+};
+constexpr static size_t COLUMN_FAMILY_CLASS_COUNT = 3;
+// the state keeps the name of the default column family, kDefaultColumnFamilyName
+constexpr static std::array<std::string_view, COLUMN_FAMILY_CLASS_COUNT> COLUMN_FAMILY_NAMES{
+    "default", "block", "index"};
+
+ColumnFamilyClass columnFamilyClass(std::string_view table);
+// the table of a key encoded by toDBKey
+std::string_view tableOfDBKey(std::string_view dbKey);
+
+using ColumnFamilyClassOptions =
+    std::array<::rocksdb::ColumnFamilyOptions, COLUMN_FAMILY_CLASS_COUNT>;
+
+class ColumnFamilyDB : public ::rocksdb::StackableDB
+{
+public:
+    ColumnFamilyDB(::rocksdb::DB* db, std::vector<::rocksdb::ColumnFamilyHandle*> handles);
+    ColumnFamilyDB(const ColumnFamilyDB&) = delete;
+    ColumnFamilyDB(ColumnFamilyDB&&) = delete;
+    ColumnFamilyDB& operator=(const ColumnFamilyDB&) = delete;
+    ColumnFamilyDB& operator=(ColumnFamilyDB&&) = delete;
+    ~ColumnFamilyDB() override;
+
+    // open the DB at path with a column family per class, the rows of the block and index tables
+    // written before the DB was split are moved out of the default column family
+    static std::unique_ptr<ColumnFamilyDB> open(::rocksdb::DBOptions const& options,
+        std::string const& path, ColumnFamilyClassOptions const& columnFamilyOptions);
+    // whether the DB at path has been split, a split DB can't be opened without its families
+    static bool isSplit(::rocksdb::DBOptions const& options, std::string const& path);
+    // open the existing DB at path read only, or as a secondary of the running node when
+    // secondaryPath is not empty, a split DB is returned as a ColumnFamilyDB and never migrated
+    static std::unique_ptr<::rocksdb::DB> openForRead(::rocksdb::Options const& options,
+        std::string const& path, std::string const& secondaryPath = {});
+
+    ::rocksdb::ColumnFamilyHandle* columnFamily(ColumnFamilyClass columnFamilyClass) const;
+    ::rocksdb::ColumnFamilyHandle* columnFamilyOfTable(std::string_view table) const;
+    ::rocksdb::ColumnFamilyHandle* columnFamilyOfKey(std::string_view dbKey) const;
+    // the handles of every class, in the order of ColumnFamilyClass
+    std::vector<::rocksdb::ColumnFamilyHandle*> const& columnFamilies() const;
+
+    // move the rows of the block and index tables still in the default column family, every
+    // batch moves the rows atomically so an interrupted migration resumes on the next open
+    size_t migrate();
+
+    ::rocksdb::Status Close() override;
+
+private:
+    void releaseHandles();
+
+    std::vector<::rocksdb::ColumnFamilyHandle*> m_handles;
+};
+
+// the split DB behind db, nullptr if db keeps every table in the default column family
+ColumnFamilyDB* asColumnFamilyDB(::rocksdb::DB& db);
+// the column family keeping table in db, whether db is split or not
+::rocksdb::ColumnFamilyHandle* columnFamilyOfTable(::rocksdb::DB& db, std::string_view table);
+}  // namespace bcos::storage
@@ -47,7 +47,7 @@ using namespace std;
 
 RocksDBStorage::RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
     const bcos::security::StorageEncryptInterface::Ptr dataEncryption)
-  : m_db(std::move(db)), m_dataEncryption(dataEncryption)
+  : m_db(std::move(db)), m_columnFamilies(asColumnFamilyDB(*m_db)), m_dataEncryption(dataEncryption)
 {
     m_writeBatch = std::make_shared<WriteBatch>();
 }
@@ -64,7 +64,8 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
 
     ReadOptions read_options;
     read_options.total_order_seek = true;
-    auto iter = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options));
+    auto iter =
+        std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options, columnFamily(_table)));
 
     // check performance
     for (iter->Seek(keyPrefix); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
@@ -103,7 +104,7 @@ void RocksDBStorage::asyncGetRow(std::string_view _table, std::string_view _key,
         auto dbKey = toDBKey(_table, _key);
 
         auto status = m_db->Get(
-            ReadOptions(), m_db->DefaultColumnFamily(), Slice(dbKey.data(), dbKey.size()), &value);
+            ReadOptions(), columnFamily(_table), Slice(dbKey.data(), dbKey.size()), &value);
 
         if (!value.empty() && nullptr != m_dataEncryption)
         {
@@ -184,7 +185,7 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
 
         std::vector<PinnableSlice> values(keys.size());
         std::vector<Status> statusList(keys.size());
-        m_db->MultiGet(ReadOptions(), m_db->DefaultColumnFamily(), slices.size(), slices.data(),
+        m_db->MultiGet(ReadOptions(), columnFamily(_table), slices.size(), slices.data(),
             values.data(), statusList.data());
         tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
             [&](const tbb::blocked_range<size_t>& range) {
@@ -254,7 +255,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
             STORAGE_ROCKSDB_LOG(TRACE)
                 << LOG_DESC("asyncSetRow delete") << LOG_KV("table", _table)
                 << LOG_KV("key", boost::algorithm::hex_lower(std::string(_key)));
-            status = m_db->Delete(options, dbKey);
+            status = m_db->Delete(options, columnFamily(_table), dbKey);
         }
         else
         {
@@ -270,7 +271,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
                 value = m_dataEncryption->encrypt(value);
             }
 
-            status = m_db->Put(options, dbKey, value);
+            status = m_db->Put(options, columnFamily(_table), dbKey, value);
         }
 
         if (!status.ok())
@@ -314,8 +315,8 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
         std::atomic_uint64_t deleteCount{0};
         atomic_bool isTableValid = true;
 
-        tbb::concurrent_vector<std::tuple<Entry::Status, std::string,
-            std::variant<std::monostate, std::string, Entry>>>
+        tbb::concurrent_vector<std::tuple<Entry::Status, rocksdb::ColumnFamilyHandle*,
+            std::string, std::variant<std::monostate, std::string, Entry>>>
             dataChanges;
         storage.parallelTraverse(true, [&](const std::string_view& table,
                                            const std::string_view& key, Entry const& entry) {
@@ -325,6 +326,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 return false;
             }
             auto dbKey = toDBKey(table, key);
+            auto* family = columnFamily(table);
 
             if (entry.status() == Entry::DELETED)
             {
@@ -335,7 +337,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 }
                 ++deleteCount;
                 dataChanges.emplace_back(
-                    std::tuple{entry.status(), std::move(dbKey), std::monostate{}});
+                    std::tuple{entry.status(), family, std::move(dbKey), std::monostate{}});
             }
             else
             {
@@ -352,36 +354,38 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 {
                     std::string encryptValue(value);
                     encryptValue = m_dataEncryption->encrypt(encryptValue);
-                    dataChanges.emplace_back(
-                        std::tuple{entry.status(), std::move(dbKey), std::move(encryptValue)});
+                    dataChanges.emplace_back(std::tuple{
+                        entry.status(), family, std::move(dbKey), std::move(encryptValue)});
                 }
                 else
                 {
-                    dataChanges.emplace_back(std::tuple{entry.status(), std::move(dbKey), entry});
+                    dataChanges.emplace_back(
+                        std::tuple{entry.status(), family, std::move(dbKey), entry});
                 }
             }
             return true;
         });
         auto encode = utcSteadyTime();
-        for (auto& [status, key, value] : dataChanges)
+        for (auto& [status, family, key, value] : dataChanges)
         {
             if (status == Entry::DELETED)
             {
-                m_writeBatch->Delete(key);
+                m_writeBatch->Delete(family, key);
             }
             else
             {
                 auto& localKey = key;
+                auto* localFamily = family;
                 std::visit(
-                    [this, &localKey](auto&& valueStr) {
+                    [this, &localKey, localFamily](auto&& valueStr) {
                         using ValueType = std::decay_t<decltype(valueStr)>;
                         if constexpr (std::same_as<ValueType, std::string>)
                         {
-                            m_writeBatch->Put(localKey, valueStr);
+                            m_writeBatch->Put(localFamily, localKey, valueStr);
                         }
                         else if constexpr (std::same_as<ValueType, Entry>)
                         {
-                            m_writeBatch->Put(localKey, valueStr.get());
+                            m_writeBatch->Put(localFamily, localKey, valueStr.get());
                         }
                         else
                         {
@@ -555,6 +559,7 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view tableName,
             }
         });
     auto writeBatch = WriteBatch();
+    auto* family = columnFamily(tableName);
     size_t dataSize = 0;
     for (size_t i = 0; i < keys.size(); ++i)
     {
@@ -562,12 +567,12 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view tableName,
         if (m_dataEncryption)
         {
             dataSize += realKeys[i].size() + encryptedValues[i].size();
-            writeBatch.Put(realKeys[i], encryptedValues[i]);
+            writeBatch.Put(family, realKeys[i], encryptedValues[i]);
         }
         else
         {
             dataSize += realKeys[i].size() + values[i].size();
-            writeBatch.Put(realKeys[i], values[i]);
+            writeBatch.Put(family, realKeys[i], values[i]);
         }
     }
     WriteOptions options;
@@ -609,9 +614,10 @@ bcos::Error::Ptr RocksDBStorage::deleteRows(std::string_view table,
                     }
                 });
             auto writeBatch = WriteBatch();
+            auto* family = columnFamily(table);
             for (size_t i = 0; i < keys.size(); ++i)
             {
-                writeBatch.Delete(realKeys[i]);
+                writeBatch.Delete(family, realKeys[i]);
             }
             WriteOptions options;
             auto status = m_db->Write(options, &writeBatch);
@@ -646,6 +652,15 @@ bcos::Error::Ptr RocksDBStorage::checkStatus(rocksdb::Status const& status)
     return BCOS_ERROR_PTR(DatabaseRetryable, errorInfo);
 }
 
+rocksdb::ColumnFamilyHandle* RocksDBStorage::columnFamily(std::string_view table) const
+{
+    if (m_columnFamilies != nullptr)
+    {
+        return m_columnFamilies->columnFamilyOfTable(table);
+    }
+    return m_db->DefaultColumnFamily();
+}
+
 void RocksDBStorage::stop()
 {
     if (!m_db)
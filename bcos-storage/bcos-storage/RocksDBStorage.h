@@ -23,6 +23,7 @@
  */
 #pragma once
 
+#include "RocksDBColumnFamily.h"
 #include <bcos-framework/storage/StorageInterface.h>
 #include <bcos-framework/security/StorageEncryptInterface.h>
 #include <rocksdb/db.h>
@@ -90,9 +91,12 @@ public:
 
 private:
     Error::Ptr checkStatus(rocksdb::Status const& status);
+    rocksdb::ColumnFamilyHandle* columnFamily(std::string_view table) const;
     std::shared_ptr<rocksdb::WriteBatch> m_writeBatch = nullptr;
     std::mutex m_writeBatchMutex;
     std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>> m_db;
+    // nullptr if the DB keeps every table in the default column family
+    ColumnFamilyDB* m_columnFamilies = nullptr;
 
     // Security Storage
     bcos::security::StorageEncryptInterface::Ptr m_dataEncryption{nullptr};
@@ -1,4 +1,5 @@
 #pragma once
+#include "RocksDBColumnFamily.h"
 #include "bcos-framework/storage2/Storage.h"
 #include "bcos-task/AwaitableValue.h"
 #include "bcos-utilities/Error.h"
@@ -30,13 +31,28 @@ class RocksDBStorage2
 {
 private:
     std::reference_wrapper<::rocksdb::DB> m_rocksDB;
+    // nullptr if the DB keeps every table in the default column family
+    storage::ColumnFamilyDB* m_columnFamilies;
     [[no_unique_address]] KeyResolver m_keyResolver;
     [[no_unique_address]] ValueResolver m_valueResolver;
 
+    ::rocksdb::ColumnFamilyHandle* columnFamily(auto const& encodedKey) const
+    {
+        if (m_columnFamilies != nullptr)
+        {
+            return m_columnFamilies->columnFamilyOfKey(
+                std::string_view(::ranges::data(encodedKey), ::ranges::size(encodedKey)));
+        }
+        return m_rocksDB.get().DefaultColumnFamily();
+    }
+
 public:
-    RocksDBStorage2(::rocksdb::DB& rocksDB) : m_rocksDB(rocksDB) {}
+    RocksDBStorage2(::rocksdb::DB& rocksDB)
+      : m_rocksDB(rocksDB), m_columnFamilies(storage::asColumnFamilyDB(rocksDB))
+    {}
     RocksDBStorage2(::rocksdb::DB& rocksDB, KeyResolver keyResolver, ValueResolver valueResolver)
       : m_rocksDB(rocksDB),
+        m_columnFamilies(storage::asColumnFamilyDB(rocksDB)),
         m_keyResolver(std::move(keyResolver)),
         m_valueResolver(std::move(valueResolver))
     {}
@@ -56,8 +72,21 @@ public:
         auto rocksDBKeys = encodedKeys | ::ranges::views::transform([](const auto& encodedKey) {
             return ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey));
         }) | ::ranges::to<std::vector>();
-        m_rocksDB.get().MultiGet(::rocksdb::ReadOptions(), m_rocksDB.get().DefaultColumnFamily(),
-            rocksDBKeys.size(), rocksDBKeys.data(), results.data(), status.data());
+        if (m_columnFamilies != nullptr)
+        {
+            // the keys may belong to tables in different column families
+            auto columnFamilies = encodedKeys | ::ranges::views::transform([&](const auto& key) {
+                return columnFamily(key);
+            }) | ::ranges::to<std::vector>();
+            m_rocksDB.get().MultiGet(::rocksdb::ReadOptions(), rocksDBKeys.size(),
+                columnFamilies.data(), rocksDBKeys.data(), results.data(), status.data());
+        }
+        else
+        {
+            m_rocksDB.get().MultiGet(::rocksdb::ReadOptions(),
+                m_rocksDB.get().DefaultColumnFamily(), rocksDBKeys.size(), rocksDBKeys.data(),
+                results.data(), status.data());
+        }
 
         auto values =
             ::ranges::views::zip(results, status) |
@@ -84,8 +113,7 @@ public:
 
         auto encodedKey = m_keyResolver.encode(std::move(key));
         ::rocksdb::PinnableSlice result;
-        auto status = m_rocksDB.get().Get(::rocksdb::ReadOptions(),
-            m_rocksDB.get().DefaultColumnFamily(),
+        auto status = m_rocksDB.get().Get(::rocksdb::ReadOptions(), columnFamily(encodedKey),
             ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)), &result);
 
         if (!status.ok())
@@ -131,7 +159,8 @@ public:
         {
             auto encodedKey = m_keyResolver.encode(key);
             auto encodedValue = m_valueResolver.encode(value);
-            writeBatch.Put(::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)),
+            writeBatch.Put(columnFamily(encodedKey),
+                ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)),
                 ::rocksdb::Slice(::ranges::data(encodedValue), ::ranges::size(encodedValue)));
         }
 
@@ -150,7 +179,7 @@ public:
         auto rocksDBValue = m_valueResolver.encode(value);
 
         ::rocksdb::WriteOptions options;
-        auto status = m_rocksDB.get().Put(options,
+        auto status = m_rocksDB.get().Put(options, columnFamily(rocksDBKey),
             ::rocksdb::Slice(::ranges::data(rocksDBKey), ::ranges::size(rocksDBKey)),
             ::rocksdb::Slice(::ranges::data(rocksDBValue), ::ranges::size(rocksDBValue)));
 
@@ -168,7 +197,7 @@ public:
         for (auto const& key : keys)
         {
             auto encodedKey = m_keyResolver.encode(key);
-            writeBatch.Delete(
+            writeBatch.Delete(columnFamily(encodedKey),
                 ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)));
         }
 
@@ -194,13 +223,13 @@ public:
             if (auto* value = std::get_if<ValueType>(std::addressof(variantValue)))
             {
                 auto encodedValue = m_valueResolver.encode(*value);
-                writeBatch.Put(
+                writeBatch.Put(columnFamily(encodedKey),
                     ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)),
                     ::rocksdb::Slice(::ranges::data(encodedValue), ::ranges::size(encodedValue)));
             }
             else
             {
-                writeBatch.Delete(
+                writeBatch.Delete(columnFamily(encodedKey),
                     ::rocksdb::Slice(::ranges::data(encodedKey), ::ranges::size(encodedKey)));
             }
         }
@@ -283,6 +312,7 @@ public:
         }
     };
 
+    // only the state is iterated, the block and index tables of a split DB are read by key
     static task::AwaitableValue<Iterator> rangeImpl(
         RocksDBStorage2& storage, const ::rocksdb::Slice* startSlice = nullptr)
     {
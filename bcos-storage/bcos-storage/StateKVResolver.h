@@ -3,6 +3,7 @@
 #include <bcos-framework/storage/Entry.h>
 #include <fmt/format.h>
 #include <boost/algorithm/hex.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/throw_exception.hpp>
 
 namespace bcos::storage2::rocksdb
@@ -32,25 +33,27 @@ struct StateValueResolver
 
 struct StateKeyResolver
 {
-    static std::string_view encode(const executor_v1::StateKey& stateKey)
-    {
-        return {stateKey.data(), stateKey.size()};
-    }
-    static executor_v1::StateKey encode(executor_v1::StateKey&& stateKey)
+    // "<table>:<key>", inline for a contract table and a storage slot
+    constexpr static size_t INLINE_ENCODED_KEY_SIZE = 96;
+    using EncodedKey = boost::container::small_vector<char, INLINE_ENCODED_KEY_SIZE>;
+
+    static EncodedKey encode(const executor_v1::StateKeyView& stateKeyView)
     {
-        return std::move(stateKey);
+        auto [table, key] = stateKeyView.get();
+        EncodedKey encodedKey;
+        encodedKey.reserve(table.size() + 1 + key.size());
+        encodedKey.insert(encodedKey.end(), table.begin(), table.end());
+        encodedKey.push_back(':');
+        encodedKey.insert(encodedKey.end(), key.begin(), key.end());
+        return encodedKey;
     }
-    static executor_v1::StateKey encode(const executor_v1::StateKeyView& stateKeyView)
+    static EncodedKey encode(const executor_v1::StateKey& stateKey)
     {
-        return executor_v1::StateKey(stateKeyView);
+        return encode(executor_v1::StateKeyView(stateKey));
     }
     static executor_v1::StateKey decode(std::string_view view)
     {
-        return executor_v1::StateKey(std::string(view));
-    }
-    static executor_v1::StateKey decode(std::string buffer)
-    {
-        return executor_v1::StateKey(std::move(buffer));
+        return executor_v1::StateKey(view);
     }
 };
 
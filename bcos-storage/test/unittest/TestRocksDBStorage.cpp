@@ -1,6 +1,8 @@
 #include "bcos-crypto/hasher/OpenSSLHasher.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
 #include "bcos-framework/storage/StorageInterface.h"
 #include "bcos-table/src/StateStorage.h"
+#include <bcos-storage/RocksDBColumnFamily.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <rocksdb/write_batch.h>
@@ -691,6 +693,86 @@ BOOST_AUTO_TEST_CASE(commitAndCheck)
             params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
     }
 }
+
+BOOST_AUTO_TEST_CASE(columnFamilies)
+{
+    auto splitPath = path + "_split";
+    auto setRow = [](RocksDBStorage& storage, std::string_view table, std::string_view key,
+                      std::string value) {
+        Entry entry;
+        entry.set(std::move(value));
+        storage.asyncSetRow(
+            table, key, std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    };
+    auto getRow = [](RocksDBStorage& storage, std::string_view table, std::string_view key) {
+        std::optional<Entry> row;
+        storage.asyncGetRow(table, key, [&](Error::UniquePtr error, std::optional<Entry> entry) {
+            BOOST_CHECK(!error);
+            row = std::move(entry);
+        });
+        return row ? std::string(row->get()) : std::string();
+    };
+
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    {
+        // the rows written before the DB is split are all in the default column family
+        rocksdb::DB* db = nullptr;
+        BOOST_REQUIRE(rocksdb::DB::Open(options, splitPath, &db).ok());
+        RocksDBStorage storage(std::unique_ptr<rocksdb::DB>(db), nullptr);
+        setRow(storage, "t_state", "key", "state");
+        setRow(storage, ledger::SYS_HASH_2_TX, "hash", "tx");
+        setRow(storage, ledger::SYS_NUMBER_2_HASH, "1", "hash");
+    }
+    BOOST_CHECK(!ColumnFamilyDB::isSplit(options, splitPath));
+
+    ColumnFamilyClassOptions columnFamilyOptions;
+    columnFamilyOptions.fill(rocksdb::ColumnFamilyOptions(options));
+    {
+        auto db = ColumnFamilyDB::open(options, splitPath, columnFamilyOptions);
+        std::string value;
+        auto txKey = toDBKey(ledger::SYS_HASH_2_TX, "hash");
+        BOOST_CHECK(db->Get(rocksdb::ReadOptions(), db->DefaultColumnFamily(), txKey, &value)
+                        .IsNotFound());
+        BOOST_CHECK(db->Get(rocksdb::ReadOptions(), db->columnFamily(ColumnFamilyClass::BLOCK),
+                          txKey, &value)
+                        .ok());
+        BOOST_CHECK_EQUAL(value, "tx");
+
+        RocksDBStorage storage(std::unique_ptr<rocksdb::DB>(db.release()), nullptr);
+        BOOST_CHECK_EQUAL(getRow(storage, "t_state", "key"), "state");
+        BOOST_CHECK_EQUAL(getRow(storage, ledger::SYS_HASH_2_TX, "hash"), "tx");
+        BOOST_CHECK_EQUAL(getRow(storage, ledger::SYS_NUMBER_2_HASH, "1"), "hash");
+
+        setRow(storage, ledger::SYS_HASH_2_RECEIPT, "hash", "receipt");
+        BOOST_CHECK_EQUAL(getRow(storage, ledger::SYS_HASH_2_RECEIPT, "hash"), "receipt");
+        storage.asyncGetPrimaryKeys(ledger::SYS_HASH_2_TX, std::nullopt,
+            [](Error::UniquePtr error, std::vector<std::string> keys) {
+                BOOST_CHECK(!error);
+                BOOST_CHECK_EQUAL(keys.size(), 1);
+            });
+    }
+    BOOST_CHECK(ColumnFamilyDB::isSplit(options, splitPath));
+
+    // nothing is left to migrate when the split DB is opened again
+    {
+        auto db = ColumnFamilyDB::open(options, splitPath, columnFamilyOptions);
+        BOOST_CHECK_EQUAL(db->migrate(), 0);
+    }
+
+    // the tools open the split DB read only with all of its column families
+    {
+        auto db = ColumnFamilyDB::openForRead(options, splitPath);
+        BOOST_REQUIRE(asColumnFamilyDB(*db) != nullptr);
+        BOOST_CHECK_EQUAL(columnFamilyOfTable(*db, ledger::SYS_HASH_2_TX),
+            asColumnFamilyDB(*db)->columnFamily(ColumnFamilyClass::BLOCK));
+        RocksDBStorage storage(std::move(db), nullptr);
+        BOOST_CHECK_EQUAL(getRow(storage, "t_state", "key"), "state");
+        BOOST_CHECK_EQUAL(getRow(storage, ledger::SYS_HASH_2_TX, "hash"), "tx");
+        BOOST_CHECK_EQUAL(getRow(storage, ledger::SYS_NUMBER_2_HASH, "1"), "hash");
+    }
+    boost::filesystem::remove_all(splitPath);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace bcos::test::rocksdb_test
\ No newline at end of file
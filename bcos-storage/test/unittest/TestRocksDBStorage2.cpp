@@ -48,6 +48,9 @@ BOOST_AUTO_TEST_CASE(kvResolver)
 
     StateKey key("test_table!!!"sv, "key100"sv);
     BOOST_CHECK(key == decodedKey);
+
+    auto encodedKey = bcos::storage2::rocksdb::StateKeyResolver::encode(key);
+    BOOST_CHECK_EQUAL(std::string_view(encodedKey.data(), encodedKey.size()), mergedKey);
 }
 
 BOOST_AUTO_TEST_CASE(readWriteRemoveSeek)
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the flat on-disk format of the KeyPage pages and table metas
+ *
+ * A flat page is laid out as
+ *   magic(4) | version(1) | count(u32) | boundaries((2 * count + 1) x u32) | key0 value0 key1 ...
+ * where boundaries[2i] and boundaries[2i + 1] are the payload offsets of key i and value i and
+ * boundaries[2 * count] is the payload size. The keys are sorted, so a point read binary searches
+ * the encoded page in place. All the integers are little-endian.
+ *
+ * The pages and metas written by boost::serialization start with their element count, the
+ * magics below read as counts no page or meta can reach, so both formats can be told apart.
+ *
+ * @file KeyPageFormat.h
+ */
+#pragma once
+
+#include "bcos-framework/storage/Common.h"
+#include <bcos-utilities/Error.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace bcos::storage::keypage
+{
+constexpr static std::array<char, 4> FLAT_PAGE_MAGIC = {'K', 'P', 'F', '\xff'};
+constexpr static std::array<char, 4> FLAT_META_MAGIC = {'K', 'M', 'F', '\xff'};
+constexpr static uint8_t FLAT_FORMAT_VERSION = 1;
+constexpr static size_t FLAT_HEADER_SIZE = FLAT_PAGE_MAGIC.size() + 1;
+
+template <class Integer>
+inline void appendLE(std::string& out, Integer value)
+{
+    for (size_t i = 0; i < sizeof(Integer); ++i)
+    {
+        out.push_back(static_cast<char>(value >> (i * 8)));
+    }
+}
+
+template <class Integer>
+inline Integer readLE(const char* data)
+{
+    Integer value = 0;
+    for (size_t i = 0; i < sizeof(Integer); ++i)
+    {
+        value |= Integer(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return value;
+}
+
+inline bool hasMagic(std::string_view data, std::array<char, 4> const& magic)
+{
+    return data.size() >= magic.size() &&
+           std::memcmp(data.data(), magic.data(), magic.size()) == 0;
+}
+
+// check the version of a flat page or meta and return what follows the header
+inline std::string_view flatBody(std::string_view data)
+{
+    if (data.size() < FLAT_HEADER_SIZE ||
+        static_cast<uint8_t>(data[FLAT_PAGE_MAGIC.size()]) != FLAT_FORMAT_VERSION)
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(StorageError::ReadError, "unsupported flat key page version"));
+    }
+    return data.substr(FLAT_HEADER_SIZE);
+}
+
+// A read only view of a flat page, the viewed buffer must outlive it
+class FlatPageView
+{
+public:
+    FlatPageView() = default;
+    explicit FlatPageView(std::string_view data)
+    {
+        auto body = flatBody(data);
+        if (body.size() < sizeof(uint32_t))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "truncated flat page"));
+        }
+        m_count = readLE<uint32_t>(body.data());
+        auto boundariesSize = (2 * m_count + 1) * sizeof(uint32_t);
+        if (body.size() - sizeof(uint32_t) < boundariesSize)
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "truncated flat page"));
+        }
+        m_boundaries = body.data() + sizeof(uint32_t);
+        m_payload = body.substr(sizeof(uint32_t) + boundariesSize);
+        uint32_t last = 0;
+        for (size_t i = 0; i <= 2 * m_count; ++i)
+        {
+            auto offset = boundary(i);
+            if (offset < last || offset > m_payload.size())
+            {
+                BOOST_THROW_EXCEPTION(
+                    BCOS_ERROR(StorageError::ReadError, "invalid flat page offsets"));
+            }
+            last = offset;
+        }
+        if (last != m_payload.size())
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "invalid flat page size"));
+        }
+    }
+
+    size_t count() const { return m_count; }
+    // the size of all the keys and values
+    size_t payloadSize() const { return m_payload.size(); }
+    std::string_view key(size_t index) const
+    {
+        return m_payload.substr(boundary(2 * index), boundary(2 * index + 1) - boundary(2 * index));
+    }
+    std::string_view value(size_t index) const
+    {
+        return m_payload.substr(
+            boundary(2 * index + 1), boundary(2 * index + 2) - boundary(2 * index + 1));
+    }
+    std::optional<size_t> find(std::string_view key) const
+    {
+        size_t low = 0;
+        size_t high = m_count;
+        while (low < high)
+        {
+            auto middle = low + (high - low) / 2;
+            if (this->key(middle) < key)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        if (low < m_count && this->key(low) == key)
+        {
+            return low;
+        }
+        return std::nullopt;
+    }
+
+private:
+    uint32_t boundary(size_t index) const
+    {
+        return readLE<uint32_t>(m_boundaries + index * sizeof(uint32_t));
+    }
+
+    size_t m_count = 0;
+    const char* m_boundaries = nullptr;
+    std::string_view m_payload;
+};
+
+// encode the sorted key/value pairs as a flat page
+inline std::string encodeFlatPage(
+    std::span<const std::pair<std::string_view, std::string_view>> entries)
+{
+    size_t payloadSize = 0;
+    for (auto const& [key, value] : entries)
+    {
+        payloadSize += key.size() + value.size();
+    }
+    std::string out;
+    out.reserve(FLAT_HEADER_SIZE + (2 * entries.size() + 2) * sizeof(uint32_t) + payloadSize);
+    out.append(FLAT_PAGE_MAGIC.data(), FLAT_PAGE_MAGIC.size());
+    out.push_back(static_cast<char>(FLAT_FORMAT_VERSION));
+    appendLE<uint32_t>(out, entries.size());
+    uint32_t offset = 0;
+    for (auto const& [key, value] : entries)
+    {
+        appendLE<uint32_t>(out, offset);
+        offset += key.size();
+        appendLE<uint32_t>(out, offset);
+        offset += value.size();
+    }
+    appendLE<uint32_t>(out, offset);
+    for (auto const& [key, value] : entries)
+    {
+        out.append(key);
+        out.append(value);
+    }
+    return out;
+}
+}  // namespace bcos::storage::keypage
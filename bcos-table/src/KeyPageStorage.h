@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "KeyPageFormat.h"
 #include "StateStorageInterface.h"
 #include <fmt/format.h>
 #include <boost/archive/basic_archive.hpp>
@@ -243,6 +244,12 @@ public:
             {
                 return;
             }
+            if (keypage::hasMagic(value, keypage::FLAT_META_MAGIC))
+            {
+                decodeFlat(value);
+                return;
+            }
+            // the metas written before the flat format
             boost::iostreams::stream<boost::iostreams::array_source> inputStream(
                 value.data(), value.size());
             boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
@@ -478,6 +485,28 @@ public:
             auto it = lower_bound(pageKey);
             return it != pages->end() && it->getPageKey() == pageKey;
         }
+        // encode as magic(4) | version(1) | count(u32) | count x (keySize(u32) key count(u16)
+        // size(u16)), all the integers are little-endian
+        std::string encode() const
+        {
+            auto writeLock = lock();
+            auto invalid = erasePagesNoLock();
+            std::string out;
+            out.append(keypage::FLAT_META_MAGIC.data(), keypage::FLAT_META_MAGIC.size());
+            out.push_back(static_cast<char>(keypage::FLAT_FORMAT_VERSION));
+            keypage::appendLE<uint32_t>(out, pages->size());
+            for (const auto& pageInfo : *pages)
+            {
+                auto pageKey = pageInfo.getPageKey();
+                keypage::appendLE<uint32_t>(out, pageKey.size());
+                out.append(pageKey);
+                keypage::appendLE<uint16_t>(out, pageInfo.getCount());
+                keypage::appendLE<uint16_t>(out, pageInfo.getSize());
+            }
+            KeyPage_LOG(DEBUG) << LOG_DESC("Encode meta") << LOG_KV("valid", pages->size())
+                               << LOG_KV("invalid", invalid);
+            return out;
+        }
 
     private:
         uint32_t getPageInfoCount = 0;
@@ -487,23 +516,46 @@ public:
         std::unique_ptr<std::vector<PageInfo>> pages = nullptr;
         friend class boost::serialization::access;
         size_t lastPageInfoIndex = 0;
-        template <class Archive>
-        void save(Archive& ar, const unsigned int version) const
+
+        void decodeFlat(std::string_view value)
+        {
+            auto body = keypage::flatBody(value);
+            auto read = [&body]<class Integer>(Integer& integer) {
+                if (body.size() < sizeof(Integer))
+                {
+                    BOOST_THROW_EXCEPTION(
+                        BCOS_ERROR(StorageError::ReadError, "truncated flat table meta"));
+                }
+                integer = keypage::readLE<Integer>(body.data());
+                body.remove_prefix(sizeof(Integer));
+            };
+            uint32_t count = 0;
+            read(count);
+            pages = std::make_unique<std::vector<PageInfo>>();
+            pages->reserve(std::min<size_t>(count, body.size()));
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                uint32_t keySize = 0;
+                read(keySize);
+                if (body.size() < keySize)
+                {
+                    BOOST_THROW_EXCEPTION(
+                        BCOS_ERROR(StorageError::ReadError, "truncated flat table meta"));
+                }
+                auto pageKey = std::string(body.substr(0, keySize));
+                body.remove_prefix(keySize);
+                uint16_t pageCount = 0;
+                uint16_t pageSize = 0;
+                read(pageCount);
+                read(pageSize);
+                pages->emplace_back(std::move(pageKey), pageCount, pageSize, nullptr);
+            }
+        }
+        // erase the empty pages and count the rows, return the count of the erased pages
+        int erasePagesNoLock() const
         {
-            std::ignore = version;
-            // auto len = (uint32_t)pages->size();
-            // ar& len;
-            // for (size_t i = 0; i < pages->size(); ++i)
-            // {
-            //     if (pages->at(i).getCount() == 0)
-            //     {
-            //         continue;
-            //     }
-            //     ar & pages->at(i);
-            // }
             int invalid = 0;
             m_rows = 0;
-            auto writeLock = lock();
             for (auto it = pages->begin(); it != pages->end();)
             {
                 if (it->getCount() == 0 || it->getPageKey().empty())
@@ -521,6 +573,24 @@ public:
                     ++it;
                 }
             }
+            return invalid;
+        }
+        template <class Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            std::ignore = version;
+            // auto len = (uint32_t)pages->size();
+            // ar& len;
+            // for (size_t i = 0; i < pages->size(); ++i)
+            // {
+            //     if (pages->at(i).getCount() == 0)
+            //     {
+            //         continue;
+            //     }
+            //     ar & pages->at(i);
+            // }
+            auto writeLock = lock();
+            auto invalid = erasePagesNoLock();
             ar << *pages;
             KeyPage_LOG(DEBUG) << LOG_DESC("Serialize meta") << LOG_KV("valid", pages->size())
                                << LOG_KV("invalid", invalid);
@@ -552,17 +622,27 @@ public:
             {
                 return;
             }
-            boost::iostreams::stream<boost::iostreams::array_source> inputStream(
-                value.data(), value.size());
-            boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
-            archive >> *this;
-            if (pageKey != entries.rbegin()->first)
+            if (keypage::hasMagic(value, keypage::FLAT_PAGE_MAGIC))
+            {  // keep the flat page as it is, it's decoded on the first write
+                m_flat = std::string(value);
+                m_flatView = keypage::FlatPageView(m_flat);
+                m_validCount = m_flatView.count();
+                m_size = m_flatView.payloadSize();
+            }
+            else
+            {  // the pages written before the flat format
+                boost::iostreams::stream<boost::iostreams::array_source> inputStream(
+                    value.data(), value.size());
+                boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
+                archive >> *this;
+            }
+            if (pageKey != endKeyNoLock())
             {
                 KeyPage_LOG(INFO) << LOG_DESC("load page with invalid pageKey")
                                   << LOG_KV("pageKey", toHex(pageKey))
-                                  << LOG_KV("validPageKey", toHex(entries.rbegin()->first))
+                                  << LOG_KV("validPageKey", toHex(endKeyNoLock()))
                                   << LOG_KV("valid", m_validCount)
-                                  << LOG_KV("count", entries.size());
+                                  << LOG_KV("count", countNoLock());
                 m_invalidPageKeys.insert(std::string(pageKey));
             }
         }
@@ -570,8 +650,11 @@ public:
           : entries(page.entries),
             m_size(page.m_size),
             m_validCount(page.m_validCount),
-            m_invalidPageKeys(page.m_invalidPageKeys)
-        {}
+            m_invalidPageKeys(page.m_invalidPageKeys),
+            m_flat(page.m_flat)
+        {
+            resetFlatView();
+        }
         Page& operator=(const Page& p)
         {
             if (this != &p)
@@ -580,6 +663,8 @@ public:
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = p.m_invalidPageKeys;
+                m_flat = p.m_flat;
+                resetFlatView();
             }
             return *this;
         }
@@ -589,6 +674,10 @@ public:
             m_size = p.m_size;
             m_validCount = p.m_validCount;
             m_invalidPageKeys = std::move(p.m_invalidPageKeys);
+            m_flat = std::move(p.m_flat);
+            resetFlatView();
+            p.m_flat.clear();
+            p.resetFlatView();
         }
         Page& operator=(Page&& p)
         {
@@ -598,6 +687,10 @@ public:
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = std::move(p.m_invalidPageKeys);
+                m_flat = std::move(p.m_flat);
+                resetFlatView();
+                p.m_flat.clear();
+                p.resetFlatView();
             }
             return *this;
         }
@@ -605,6 +698,18 @@ public:
         std::optional<Entry> getEntry(std::string_view key)
         {
             std::shared_lock lock(mutex);
+            if (!m_flat.empty())
+            {  // binary search the flat page in place
+                auto index = m_flatView.find(key);
+                if (!index)
+                {
+                    return std::nullopt;
+                }
+                Entry entry;
+                entry.setPointer(flatValueNoLock(*index));
+                entry.setStatus(Entry::Status::NORMAL);
+                return std::make_optional(std::move(entry));
+            }
             auto it = entries.find(key);
             if (it != entries.end())
             {
@@ -642,6 +747,7 @@ public:
         getEntries()
         {
             std::unique_lock lock(mutex);
+            materializeNoLock();
             return std::make_pair(std::ref(entries), std::move(lock));
         }
         inline std::tuple<std::optional<Entry>, bool> setEntry(
@@ -651,6 +757,7 @@ public:
             bool pageInfoChanged = false;
             std::optional<Entry> ret;
             std::unique_lock lock(mutex);
+            materializeNoLock();
             auto it = entries.lower_bound(key);
             m_size += entry.size();
             if (it != entries.end() && it->first == key)
@@ -745,7 +852,7 @@ public:
         auto count() const -> size_t
         {
             std::shared_lock lock(mutex);
-            return entries.size();
+            return countNoLock();
         }
         auto invalidKeySet() const -> const std::set<std::string>&
         {
@@ -756,6 +863,10 @@ public:
         auto startKey() const -> std::string
         {
             std::shared_lock lock(mutex);
+            if (!m_flat.empty())
+            {
+                return m_flatView.count() > 0 ? std::string(m_flatView.key(0)) : "";
+            }
             if (entries.empty())
             {
                 return "";
@@ -765,16 +876,37 @@ public:
         std::string endKey() const
         {
             std::shared_lock lock(mutex);
-            if (entries.empty())
+            return std::string(endKeyNoLock());
+        }
+        // true if the page is still the flat page it was loaded from
+        bool flat() const
+        {
+            std::shared_lock lock(mutex);
+            return !m_flat.empty();
+        }
+        // encode the valid entries as a flat page, the caller holds the lock of the page if needed
+        std::string encode() const
+        {
+            if (!m_flat.empty())
             {
-                return "";
+                return m_flat;
             }
-            return entries.rbegin()->first;
+            std::vector<std::pair<std::string_view, std::string_view>> validEntries;
+            validEntries.reserve(m_validCount);
+            for (const auto& [key, entry] : entries)
+            {
+                if (entry.status() != Entry::Status::DELETED)
+                {
+                    validEntries.emplace_back(key, entry.get());
+                }
+            }
+            return keypage::encodeFlatPage(validEntries);
         }
         auto split(size_t threshold)
         {
             auto page = Page();
             std::unique_lock lock(mutex);
+            materializeNoLock();
             // split this page to two pages
             auto iter = entries.begin();
             while (iter != entries.end())
@@ -823,7 +955,12 @@ public:
         {
             if (this != &p)
             {
+                {
+                    std::unique_lock pageLock(p.mutex);
+                    p.materializeNoLock();
+                }
                 std::unique_lock lock(mutex);
+                materializeNoLock();
                 for (auto iter = p.entries.begin(); iter != p.entries.end();)
                 {
                     m_size += iter->second.size();
@@ -844,9 +981,9 @@ public:
             else
             {
                 KeyPage_LOG(WARNING)
-                    << LOG_DESC("merge self") << LOG_KV("startKey", toHex(entries.begin()->first))
-                    << LOG_KV("endKey", toHex(entries.rbegin()->first))
-                    << LOG_KV("valid", m_validCount) << LOG_KV("count", entries.size());
+                    << LOG_DESC("merge self") << LOG_KV("startKey", toHex(startKey()))
+                    << LOG_KV("endKey", toHex(endKey())) << LOG_KV("valid", m_validCount)
+                    << LOG_KV("count", count());
             }
         }
         void clean(const std::string_view& pageKey)
@@ -865,19 +1002,19 @@ public:
                 }
             }
             m_invalidPageKeys.clear();
-            if (!entries.empty() && pageKey != entries.rbegin()->first)
+            if (countNoLock() > 0 && pageKey != endKeyNoLock())
             {
                 KeyPage_LOG(DEBUG) << LOG_DESC("import page with invalid pageKey")
                                    << LOG_KV("pageKey", toHex(pageKey))
-                                   << LOG_KV("validPageKey", toHex(entries.rbegin()->first))
-                                   << LOG_KV("count", entries.size());
+                                   << LOG_KV("validPageKey", toHex(endKeyNoLock()))
+                                   << LOG_KV("count", countNoLock());
                 m_invalidPageKeys.insert(std::string(pageKey));
             }
-            if (entries.empty())
+            if (countNoLock() == 0)
             {
                 KeyPage_LOG(DEBUG)
                     << LOG_DESC("import empty page") << LOG_KV("pageKey", toHex(pageKey))
-                    << LOG_KV("count", entries.size());
+                    << LOG_KV("count", countNoLock());
             }
         }
         auto hash(const std::string& table, const bcos::crypto::Hash::Ptr& hashImpl,
@@ -916,6 +1053,7 @@ public:
         void rollback(const Recoder::Change& change)
         {
             std::unique_lock lock(mutex);
+            materializeNoLock();
             auto it = entries.find(change.key);
             if (change.entry)
             {
@@ -1004,13 +1142,80 @@ public:
         // if startKey changed the old startKey need keep to delete old page
         std::set<std::string> m_invalidPageKeys;
         TableMeta* m_meta = nullptr;
+        // the flat page loaded from the storage, all its entries are NORMAL and entries is empty
+        // until the page is modified
+        std::string m_flat;
+        keypage::FlatPageView m_flatView;
+        // the values of the flat page read so far, shared by the entries returned for them like
+        // the entries of the map, so a cached page copies each value once
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> m_flatValues;
+        std::mutex m_flatValuesMutex;
+
+        void resetFlatView()
+        {
+            m_flatView =
+                m_flat.empty() ? keypage::FlatPageView() : keypage::FlatPageView(m_flat);
+            m_flatValues.clear();
+        }
+        // called with the lock of the page held, shared or unique
+        std::shared_ptr<std::vector<uint8_t>> flatValueNoLock(size_t index)
+        {
+            std::unique_lock lock(m_flatValuesMutex);
+            if (m_flatValues.empty())
+            {
+                m_flatValues.resize(m_flatView.count());
+            }
+            auto& value = m_flatValues[index];
+            if (!value)
+            {
+                auto view = m_flatView.value(index);
+                value = std::make_shared<std::vector<uint8_t>>(view.begin(), view.end());
+            }
+            return value;
+        }
+        size_t countNoLock() const { return m_flat.empty() ? entries.size() : m_flatView.count(); }
+        std::string_view endKeyNoLock() const
+        {
+            if (!m_flat.empty())
+            {
+                return m_flatView.count() > 0 ? m_flatView.key(m_flatView.count() - 1) : "";
+            }
+            return entries.empty() ? "" : std::string_view(entries.rbegin()->first);
+        }
+        // copy on write, decode the flat page before the first modification
+        void materializeNoLock()
+        {
+            if (m_flat.empty())
+            {
+                return;
+            }
+            auto iter = entries.begin();
+            for (size_t i = 0; i < m_flatView.count(); ++i)
+            {
+                Entry e;
+                e.setPointer(flatValueNoLock(i));
+                e.setStatus(Entry::Status::NORMAL);
+                iter = entries.emplace_hint(iter, m_flatView.key(i), std::move(e));
+            }
+            m_flat.clear();
+            m_flat.shrink_to_fit();
+            resetFlatView();
+        }
 
         template <class Archive>
         void save(Archive& ar, const unsigned int version) const
         {
             std::ignore = version;
             ar&(uint32_t)m_validCount;
-            [[maybe_unused]] size_t count = 0;
+            for (size_t i = 0; i < m_flatView.count(); ++i)
+            {
+                auto key = std::string(m_flatView.key(i));
+                ar & key;
+                auto value = m_flatView.value(i);
+                ar&(uint32_t)value.size();
+                ar.save_binary(value.data(), value.size());
+            }
+            [[maybe_unused]] size_t count = m_flatView.count();
             for (const auto& i : entries)
             {
                 if (i.second.status() == Entry::Status::DELETED)
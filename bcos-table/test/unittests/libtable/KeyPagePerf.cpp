@@ -0,0 +1,112 @@
+#include "bcos-table/src/KeyPageStorage.h"
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+namespace bcos::test
+{
+using namespace bcos::storage;
+
+// Compare the pages written by boost::serialization with the flat pages on the paths a block
+// takes through KeyPageStorage: load a page and read a key, read the keys of a cached page, update
+// a key and write the page back, split a full page and write both halves back
+struct KeyPagePerfFixture
+{
+    KeyPagePerfFixture()
+    {
+        KeyPageStorage::Page page;
+        for (size_t i = 0; i < pageEntries; ++i)
+        {
+            Entry entry;
+            entry.set(std::string(valueSize, 'v'));
+            page.setEntry(fmt::format("key_{:08}", i), std::move(entry));
+        }
+        pageKey = page.endKey();
+        Entry entry;
+        entry.setObject(page);
+        legacy = std::string(entry.get());
+        flat = page.encode();
+    }
+
+    static std::string encodeLegacy(KeyPageStorage::Page& page)
+    {
+        Entry entry;
+        entry.setObject(page);
+        return std::string(entry.get());
+    }
+
+    template <class Func>
+    void compare(const std::string& name, Func&& func)
+    {
+        auto now = bcos::utcSteadyTime();
+        for (size_t i = 0; i < loop; ++i)
+        {
+            func(legacy, i, true);
+        }
+        auto legacyCost = bcos::utcSteadyTime() - now;
+        now = bcos::utcSteadyTime();
+        for (size_t i = 0; i < loop; ++i)
+        {
+            func(flat, i, false);
+        }
+        std::cout << name << " legacy cost: " << legacyCost
+                  << ", flat cost: " << bcos::utcSteadyTime() - now << "\n";
+    }
+
+    std::string pageKey;
+    std::string legacy;
+    std::string flat;
+    size_t pageEntries = 256;
+    size_t valueSize = 32;
+    size_t loop = 10000;
+};
+
+BOOST_FIXTURE_TEST_SUITE(KeyPagePerf, KeyPagePerfFixture)
+
+BOOST_AUTO_TEST_CASE(pointRead)
+{
+    compare("point read", [this](const std::string& value, size_t i, bool) {
+        KeyPageStorage::Page page(value, pageKey);
+        auto entry = page.getEntry(fmt::format("key_{:08}", i % pageEntries));
+        BOOST_CHECK_EQUAL(entry->size(), valueSize);
+    });
+}
+
+// a page cached for a block and read again and again without being modified
+BOOST_AUTO_TEST_CASE(repeatedRead)
+{
+    KeyPageStorage::Page legacyPage(legacy, pageKey);
+    KeyPageStorage::Page flatPage(flat, pageKey);
+    compare("repeated read", [&, this](const std::string&, size_t i, bool isLegacy) {
+        auto& page = isLegacy ? legacyPage : flatPage;
+        auto entry = page.getEntry(fmt::format("key_{:08}", i % pageEntries));
+        BOOST_CHECK_EQUAL(entry->size(), valueSize);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(update)
+{
+    compare("update", [this](const std::string& value, size_t i, bool isLegacy) {
+        KeyPageStorage::Page page(value, pageKey);
+        Entry entry;
+        entry.set(std::string(valueSize, 'u'));
+        page.setEntry(fmt::format("key_{:08}", i % pageEntries), std::move(entry));
+        auto encoded = isLegacy ? encodeLegacy(page) : page.encode();
+        BOOST_CHECK(!encoded.empty());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(split)
+{
+    compare("split", [this](const std::string& value, size_t, bool isLegacy) {
+        KeyPageStorage::Page page(value, pageKey);
+        auto left = page.split(page.size() / 2);
+        auto encoded = isLegacy ? encodeLegacy(left) + encodeLegacy(page) :
+                                  left.encode() + page.encode();
+        BOOST_CHECK(!encoded.empty());
+        BOOST_CHECK_EQUAL(left.count() + page.count(), pageEntries);
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
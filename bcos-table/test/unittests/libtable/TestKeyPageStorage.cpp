@@ -3070,5 +3070,141 @@ BOOST_AUTO_TEST_CASE(bugfix_keypage_system_entry_hash)
     BOOST_TEST(hash0.hex() == hash1.hex());
 }
 
+BOOST_AUTO_TEST_CASE(flatPageFormat)
+{
+    KeyPageStorage::Page page;
+    for (int i = 0; i < 100; ++i)
+    {
+        Entry entry;
+        entry.set(fmt::format("value_{:03}", i));
+        page.setEntry(fmt::format("key_{:03}", i), std::move(entry));
+    }
+    Entry deleted;
+    deleted.setStatus(Entry::Status::DELETED);
+    page.setEntry("key_050", std::move(deleted));
+
+    auto encoded = page.encode();
+    BOOST_REQUIRE(keypage::hasMagic(encoded, keypage::FLAT_PAGE_MAGIC));
+    KeyPageStorage::Page flat(encoded, page.endKey());
+    BOOST_CHECK(flat.flat());
+    BOOST_CHECK(flat.invalidKeySet().empty());
+    BOOST_CHECK_EQUAL(flat.validCount(), 99);
+    BOOST_CHECK_EQUAL(flat.count(), 99);
+    BOOST_CHECK_EQUAL(flat.startKey(), "key_000");
+    BOOST_CHECK_EQUAL(flat.endKey(), "key_099");
+    BOOST_CHECK_EQUAL(flat.getEntry("key_010")->get(), "value_010");
+    BOOST_CHECK(flat.getEntry("key_010")->status() == Entry::Status::NORMAL);
+    BOOST_CHECK(!flat.getEntry("key_050"));
+    BOOST_CHECK(!flat.getEntry("key_100"));
+    BOOST_CHECK(!flat.getEntry(""));
+    BOOST_CHECK_EQUAL(flat.encode(), encoded);
+
+    // the pages written by boost::serialization are still readable and rewritten flat
+    Entry legacy;
+    legacy.setObject(page);
+    BOOST_REQUIRE(!keypage::hasMagic(legacy.get(), keypage::FLAT_PAGE_MAGIC));
+    KeyPageStorage::Page converted(legacy.get(), page.endKey());
+    BOOST_CHECK(!converted.flat());
+    BOOST_CHECK_EQUAL(converted.validCount(), 99);
+    BOOST_CHECK_EQUAL(converted.size(), flat.size());
+    BOOST_CHECK_EQUAL(converted.encode(), encoded);
+
+    // a page loaded with a stale pageKey keeps it to delete the old page
+    KeyPageStorage::Page stale(encoded, "key_100");
+    BOOST_CHECK_EQUAL(stale.invalidKeySet().size(), 1);
+
+    // corrupted pages are rejected
+    auto truncated = encoded.substr(0, encoded.size() - 1);
+    BOOST_CHECK_THROW(KeyPageStorage::Page(truncated, "key_099"), bcos::Error);
+    auto newer = encoded;
+    newer[keypage::FLAT_PAGE_MAGIC.size()] = keypage::FLAT_FORMAT_VERSION + 1;
+    BOOST_CHECK_THROW(KeyPageStorage::Page(newer, "key_099"), bcos::Error);
+}
+
+BOOST_AUTO_TEST_CASE(flatPageCopyOnWrite)
+{
+    KeyPageStorage::Page page;
+    for (int i = 0; i < 10; ++i)
+    {
+        Entry entry;
+        entry.set(fmt::format("value_{}", i));
+        page.setEntry(fmt::format("key_{}", i), std::move(entry));
+    }
+    auto encoded = page.encode();
+    KeyPageStorage::Page flat(encoded, page.endKey());
+    auto copy = flat;
+    BOOST_CHECK(copy.flat());
+    BOOST_CHECK_EQUAL(copy.getEntry("key_3")->get(), "value_3");
+    // the repeated reads of a flat page share the value read first
+    auto read = flat.getEntry("key_5");
+    BOOST_CHECK(flat.getEntry("key_5")->data() == read->data());
+
+    // the first write decodes the page
+    Entry entry;
+    entry.set("value_new");
+    auto [old, pageInfoChanged] = flat.setEntry("key_3", std::move(entry));
+    BOOST_CHECK(!flat.flat());
+    BOOST_CHECK_EQUAL(old->get(), "value_3");
+    BOOST_CHECK(old->status() == Entry::Status::NORMAL);
+    BOOST_CHECK(flat.getEntry("key_5")->data() == read->data());
+    BOOST_CHECK_EQUAL(flat.getEntry("key_3")->get(), "value_new");
+    BOOST_CHECK_EQUAL(flat.getEntry("key_4")->get(), "value_4");
+    BOOST_CHECK_EQUAL(flat.count(), 10);
+    BOOST_CHECK_EQUAL(flat.validCount(), 10);
+    BOOST_CHECK_EQUAL(copy.getEntry("key_3")->get(), "value_3");
+
+    // only the modified entry is hashed
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto blockVersion = (uint32_t)bcos::protocol::BlockVersion::V3_1_VERSION;
+    BOOST_CHECK(copy.hash("t", hashImpl, blockVersion) == HashType(0));
+    BOOST_CHECK(flat.hash("t", hashImpl, blockVersion) != HashType(0));
+
+    // split and merge a flat page
+    KeyPageStorage::Page right(encoded, page.endKey());
+    auto left = right.split(right.size() / 2);
+    BOOST_CHECK(!right.flat());
+    BOOST_CHECK_EQUAL(left.count() + right.count(), 10);
+    BOOST_CHECK_LT(left.endKey(), right.startKey());
+    KeyPageStorage::Page merged(encoded, page.endKey());
+    KeyPageStorage::Page empty;
+    empty.merge(merged);
+    BOOST_CHECK_EQUAL(empty.count(), 10);
+    BOOST_CHECK_EQUAL(merged.count(), 0);
+    BOOST_CHECK_EQUAL(empty.encode(), encoded);
+}
+
+BOOST_AUTO_TEST_CASE(flatTableMetaFormat)
+{
+    KeyPageStorage::TableMeta meta;
+    for (int i = 0; i < 100; ++i)
+    {
+        meta.insertPageInfoNoLock(KeyPageStorage::PageInfo(
+            fmt::format("key_{:03}", i), i % 10 == 0 ? 0 : i, i * 10, nullptr));
+    }
+    auto encoded = meta.encode();
+    BOOST_REQUIRE(keypage::hasMagic(encoded, keypage::FLAT_META_MAGIC));
+    BOOST_CHECK_EQUAL(meta.size(), 90);
+    BOOST_CHECK_EQUAL(meta.rowCount(), 4500);
+
+    KeyPageStorage::TableMeta flat(encoded);
+    Entry legacy;
+    legacy.setObject(meta);
+    KeyPageStorage::TableMeta converted(legacy.get());
+    auto& flatPages = flat.getAllPageInfoNoLock();
+    auto& convertedPages = converted.getAllPageInfoNoLock();
+    BOOST_REQUIRE_EQUAL(flatPages.size(), 90);
+    BOOST_REQUIRE_EQUAL(convertedPages.size(), 90);
+    for (size_t i = 0; i < flatPages.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(flatPages[i].getPageKey(), convertedPages[i].getPageKey());
+        BOOST_CHECK_EQUAL(flatPages[i].getCount(), convertedPages[i].getCount());
+        BOOST_CHECK_EQUAL(flatPages[i].getSize(), convertedPages[i].getSize());
+    }
+    BOOST_CHECK_EQUAL(converted.encode(), encoded);
+    BOOST_CHECK_THROW(
+        KeyPageStorage::TableMeta(std::string_view(encoded).substr(0, encoded.size() - 1)),
+        bcos::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
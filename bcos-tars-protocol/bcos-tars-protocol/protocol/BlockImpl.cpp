@@ -36,8 +36,197 @@
 #include "bcos-tars-protocol/tars/TransactionReceipt.h"
 #include "bcos-utilities/AnyHolder.h"
 #include <boost/throw_exception.hpp>
+#include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
 
+namespace
+{
+constexpr static uint8_t TRANSACTIONS_TAG = 4;
+constexpr static uint8_t RECEIPTS_TAG = 5;
+
+// the wire types of the tars encoding
+enum TarsType : uint8_t
+{
+    Char = 0,
+    Short = 1,
+    Int32 = 2,
+    Int64 = 3,
+    Float = 4,
+    Double = 5,
+    String1 = 6,
+    String4 = 7,
+    Map = 8,
+    List = 9,
+    StructBegin = 10,
+    StructEnd = 11,
+    ZeroTag = 12,
+    SimpleList = 13,
+};
+
+// walks the encoded fields of a tars struct, without decoding them
+class TarsFieldReader
+{
+public:
+    explicit TarsFieldReader(std::span<const bcos::byte> _data) : m_data(_data) {}
+
+    bool end() const { return m_offset >= m_data.size(); }
+    size_t offset() const { return m_offset; }
+
+    // returns the tag and the type of the next field
+    std::pair<uint8_t, uint8_t> readHead()
+    {
+        auto head = take(1)[0];
+        uint8_t tag = head >> 4;
+        if (tag == 15)
+        {
+            tag = take(1)[0];
+        }
+        return {tag, uint8_t(head & 0x0f)};
+    }
+
+    // reads an integer field with its head, the way tars encodes the sizes
+    int64_t readInt()
+    {
+        switch (readHead().second)
+        {
+        case ZeroTag:
+            return 0;
+        case Char:
+            return (int8_t)readBigEndian(1);
+        case Short:
+            return (int16_t)readBigEndian(2);
+        case Int32:
+            return (int32_t)readBigEndian(4);
+        case Int64:
+            return (int64_t)readBigEndian(8);
+        default:
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid tars integer type"));
+        }
+    }
+
+    void skipField(uint8_t _type)
+    {
+        switch (_type)
+        {
+        case Char:
+            take(1);
+            break;
+        case Short:
+            take(2);
+            break;
+        case Int32:
+        case Float:
+            take(4);
+            break;
+        case Int64:
+        case Double:
+            take(8);
+            break;
+        case String1:
+            take(readBigEndian(1));
+            break;
+        case String4:
+            take(readBigEndian(4));
+            break;
+        case Map:
+            skipFields(readSize() * 2);
+            break;
+        case List:
+            skipFields(readSize());
+            break;
+        case SimpleList:
+            readHead();
+            take(readSize());
+            break;
+        case StructBegin:
+            skipToStructEnd();
+            break;
+        case StructEnd:
+        case ZeroTag:
+            break;
+        default:
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid tars field type"));
+        }
+    }
+
+    void skipToStructEnd()
+    {
+        while (true)
+        {
+            auto type = readHead().second;
+            if (type == StructEnd)
+            {
+                return;
+            }
+            skipField(type);
+        }
+    }
+
+    size_t readSize()
+    {
+        auto size = readInt();
+        if (size < 0 || (uint64_t)size > m_data.size() - m_offset)
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("invalid tars container size"));
+        }
+        return size;
+    }
+
+private:
+    void skipFields(size_t _count)
+    {
+        for (size_t i = 0; i < _count; ++i)
+        {
+            skipField(readHead().second);
+        }
+    }
+
+    uint64_t readBigEndian(size_t _size)
+    {
+        uint64_t value = 0;
+        for (auto byte : take(_size))
+        {
+            value = (value << 8) | byte;
+        }
+        return value;
+    }
+
+    std::span<const bcos::byte> take(size_t _size)
+    {
+        if (_size > m_data.size() - m_offset)
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("truncated tars data"));
+        }
+        auto data = m_data.subspan(m_offset, _size);
+        m_offset += _size;
+        return data;
+    }
+
+    std::span<const bcos::byte> m_data;
+    size_t m_offset = 0;
+};
+
+// returns whether the element at _index was decoded by this call
+template <class Element>
+bool decodeElement(const std::vector<std::span<const bcos::byte>>& _encoded,
+    std::vector<bool>& _decoded, std::vector<Element>& _elements, size_t _size, uint64_t _index)
+{
+    if (_decoded.size() != _size)
+    {
+        _elements.resize(_size);
+        _decoded.assign(_size, false);
+    }
+    if (_decoded[_index])
+    {
+        return false;
+    }
+    bcos::concepts::serialize::decode(
+        bcos::bytesConstRef(_encoded[_index].data(), _encoded[_index].size()), _elements[_index]);
+    _decoded[_index] = true;
+    return true;
+}
+}  // namespace
+
 bcostars::protocol::BlockImpl::BlockImpl(bcostars::Block _block) : BlockImpl()
 {
     m_inner = std::move(_block);
@@ -55,14 +244,146 @@ void bcostars::protocol::BlockImpl::setVersion(int32_t _version)
 
 void bcostars::protocol::BlockImpl::decode(bcos::bytesConstRef _data, bool, bool)
 {
-    bcos::concepts::serialize::decode(_data, m_inner);
+    // decode everything but the transactions and the receipts, of which only the position of each
+    // element in the encoded block is kept
+    auto lazy = std::make_unique<LazyElements>();
+    lazy->buffer.assign(_data.begin(), _data.end());
+    TarsFieldReader reader(lazy->buffer);
+    bcos::bytes eagerFields;
+    while (!reader.end())
+    {
+        auto begin = reader.offset();
+        auto [tag, type] = reader.readHead();
+        if ((tag == TRANSACTIONS_TAG || tag == RECEIPTS_TAG) && type == List)
+        {
+            auto& elements = tag == TRANSACTIONS_TAG ? lazy->transactions : lazy->receipts;
+            auto size = reader.readSize();
+            elements.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (reader.readHead().second != StructBegin)
+                {
+                    BOOST_THROW_EXCEPTION(std::invalid_argument("invalid tars struct"));
+                }
+                auto elementBegin = reader.offset();
+                reader.skipToStructEnd();
+                // without the one byte head of StructEnd
+                elements.emplace_back(
+                    lazy->buffer.data() + elementBegin, reader.offset() - elementBegin - 1);
+            }
+            continue;
+        }
+        reader.skipField(type);
+        eagerFields.insert(eagerFields.end(), lazy->buffer.begin() + begin,
+            lazy->buffer.begin() + reader.offset());
+    }
+    m_inner = bcostars::Block();
+    bcos::concepts::serialize::decode(eagerFields, m_inner);
+
+    m_lazy.reset();
+    if (!lazy->transactions.empty() || !lazy->receipts.empty())
+    {
+        lazy->transactionsSize = lazy->transactions.size();
+        lazy->receiptsSize = lazy->receipts.size();
+        lazy->pendingSize = lazy->transactionsSize + lazy->receiptsSize;
+        m_lazy = std::move(lazy);
+    }
 }
 
 void bcostars::protocol::BlockImpl::encode(bcos::bytes& _encodeData) const
 {
+    decodeAll();
     bcos::concepts::serialize::encode(m_inner, _encodeData);
 }
 
+void bcostars::protocol::BlockImpl::decodeTransaction(uint64_t _index) const
+{
+    if (!m_lazy)
+    {
+        return;
+    }
+    std::unique_lock lock(m_lazy->mutex);
+    onElementDecoded(decodeElement(m_lazy->transactions, m_lazy->decodedTransactions,
+        m_inner.transactions, m_lazy->transactionsSize, _index));
+}
+
+void bcostars::protocol::BlockImpl::decodeReceipt(uint64_t _index) const
+{
+    if (!m_lazy)
+    {
+        return;
+    }
+    std::unique_lock lock(m_lazy->mutex);
+    onElementDecoded(decodeElement(m_lazy->receipts, m_lazy->decodedReceipts, m_inner.receipts,
+        m_lazy->receiptsSize, _index));
+}
+
+void bcostars::protocol::BlockImpl::decodeAll() const
+{
+    if (!m_lazy)
+    {
+        return;
+    }
+    std::unique_lock lock(m_lazy->mutex);
+    for (uint64_t i = 0; i < m_lazy->transactionsSize; ++i)
+    {
+        onElementDecoded(decodeElement(m_lazy->transactions, m_lazy->decodedTransactions,
+            m_inner.transactions, m_lazy->transactionsSize, i));
+    }
+    for (uint64_t i = 0; i < m_lazy->receiptsSize; ++i)
+    {
+        onElementDecoded(decodeElement(m_lazy->receipts, m_lazy->decodedReceipts,
+            m_inner.receipts, m_lazy->receiptsSize, i));
+    }
+}
+
+void bcostars::protocol::BlockImpl::onElementDecoded(bool _decoded) const
+{
+    // everything is in m_inner once the last element is decoded, the encoded block would only
+    // double the memory of a block that is fully accessed
+    if (_decoded && --m_lazy->pendingSize == 0)
+    {
+        m_lazy->buffer = bcos::bytes();
+        m_lazy->transactions = std::vector<std::span<const bcos::byte>>();
+        m_lazy->receipts = std::vector<std::span<const bcos::byte>>();
+    }
+}
+
+void bcostars::protocol::BlockImpl::materialize()
+{
+    decodeAll();
+    m_lazy.reset();
+}
+
+std::span<const bcos::byte> bcostars::protocol::BlockImpl::encodedTransaction(
+    uint64_t _index) const
+{
+    if (!m_lazy)
+    {
+        return {};
+    }
+    std::unique_lock lock(m_lazy->mutex);
+    if (_index >= m_lazy->transactions.size())
+    {
+        return {};
+    }
+    return m_lazy->transactions[_index];
+}
+
+std::span<const bcos::byte> bcostars::protocol::BlockImpl::encodedReceipt(uint64_t _index) const
+{
+    if (!m_lazy)
+    {
+        return {};
+    }
+    std::unique_lock lock(m_lazy->mutex);
+    if (_index >= m_lazy->receipts.size())
+    {
+        return {};
+    }
+    return m_lazy->receipts[_index];
+}
+
 bcos::protocol::BlockHeader::Ptr bcostars::protocol::BlockImpl::blockHeader()
 {
     return std::make_shared<bcostars::protocol::BlockHeaderImpl>(
@@ -91,6 +412,7 @@ void bcostars::protocol::BlockImpl::setBlockHeader(bcos::protocol::BlockHeader::
 void bcostars::protocol::BlockImpl::setReceipt(
     uint64_t _index, bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    materialize();
     if (_index >= m_inner.receipts.size())
     {
         m_inner.receipts.resize(m_inner.transactions.size());
@@ -102,12 +424,14 @@ void bcostars::protocol::BlockImpl::setReceipt(
 
 void bcostars::protocol::BlockImpl::appendReceipt(bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    materialize();
     m_inner.receipts.emplace_back(
         std::dynamic_pointer_cast<bcostars::protocol::TransactionReceiptImpl>(_receipt)->inner());
 }
 
 void bcostars::protocol::BlockImpl::clearReceipts()
 {
+    materialize();
     m_inner.receipts.clear();
 }
 
@@ -151,33 +475,38 @@ void bcostars::protocol::BlockImpl::setBlockType(bcos::protocol::BlockType _bloc
 void bcostars::protocol::BlockImpl::setTransaction(
     uint64_t _index, bcos::protocol::Transaction::Ptr _transaction)
 {
+    materialize();
     m_inner.transactions[_index] =
         std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner();
 }
 void bcostars::protocol::BlockImpl::appendTransaction(bcos::protocol::Transaction::Ptr _transaction)
 {
+    materialize();
     m_inner.transactions.emplace_back(
         std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner());
 }
 uint64_t bcostars::protocol::BlockImpl::transactionsSize() const
 {
-    return m_inner.transactions.size();
+    return m_lazy ? m_lazy->transactionsSize : m_inner.transactions.size();
 }
 
 uint64_t bcostars::protocol::BlockImpl::receiptsSize() const
 {
-    return m_inner.receipts.size();
+    return m_lazy ? m_lazy->receiptsSize : m_inner.receipts.size();
 }
 const bcostars::Block& bcostars::protocol::BlockImpl::inner() const
 {
+    decodeAll();
     return m_inner;
 }
 bcostars::Block& bcostars::protocol::BlockImpl::inner()
 {
+    materialize();
     return m_inner;
 }
 void bcostars::protocol::BlockImpl::setInner(bcostars::Block inner)
 {
+    m_lazy.reset();
     m_inner = std::move(inner);
 }
 bcos::crypto::HashType bcostars::protocol::BlockImpl::calculateTransactionRoot(
@@ -190,6 +519,7 @@ bcos::crypto::HashType bcostars::protocol::BlockImpl::calculateTransactionRoot(
         return txsRoot;
     }
 
+    decodeAll();
     bcos::crypto::merkle::Merkle merkle(hashImpl.hasher());
     if (transactionsSize() > 0)
     {
@@ -224,6 +554,7 @@ bcos::crypto::HashType bcostars::protocol::BlockImpl::calculateReceiptRoot(
     {
         return receiptsRoot;
     }
+    decodeAll();
     auto hashesRange = m_inner.receipts |
                        ::ranges::views::transform([&](const bcostars::TransactionReceipt& receipt) {
                            bcos::bytes hash;
@@ -257,19 +588,26 @@ bcostars::protocol::BlockImpl::transactionMetaDatas() const
 bcos::protocol::ViewResult<bcos::protocol::AnyTransaction>
 bcostars::protocol::BlockImpl::transactions() const
 {
-    return ::ranges::views::transform(m_inner.transactions, [](auto& inner) {
-        return bcos::protocol::AnyTransaction(
-            bcos::InPlace<bcostars::protocol::TransactionImpl>{}, [&]() mutable { return &inner; });
-    });
+    return ::ranges::views::iota(uint64_t(0), transactionsSize()) |
+           ::ranges::views::transform([this](uint64_t index) {
+               decodeTransaction(index);
+               auto* inner = std::addressof(m_inner.transactions[index]);
+               return bcos::protocol::AnyTransaction(
+                   bcos::InPlace<bcostars::protocol::TransactionImpl>{},
+                   [inner]() mutable { return inner; });
+           });
 }
 bcos::protocol::ViewResult<bcos::protocol::AnyTransactionReceipt>
 bcostars::protocol::BlockImpl::receipts() const
 {
-    return ::ranges::views::transform(m_inner.receipts, [](auto& receipt) {
-        return bcos::protocol::AnyTransactionReceipt(
-            bcos::InPlace<bcostars::protocol::TransactionReceiptImpl>{},
-            [&receipt]() { return std::addressof(receipt); });
-    });
+    return ::ranges::views::iota(uint64_t(0), receiptsSize()) |
+           ::ranges::views::transform([this](uint64_t index) {
+               decodeReceipt(index);
+               auto* receipt = std::addressof(m_inner.receipts[index]);
+               return bcos::protocol::AnyTransactionReceipt(
+                   bcos::InPlace<bcostars::protocol::TransactionReceiptImpl>{},
+                   [receipt]() { return receipt; });
+           });
 }
 size_t bcostars::protocol::BlockImpl::size() const
 {
@@ -288,12 +626,10 @@ size_t bcostars::protocol::BlockImpl::size() const
 
 bcos::bytesConstRef bcostars::protocol::BlockImpl::logsBloom() const
 {
-    const auto& data = inner();
-    return {(const unsigned char*)data.logsBloom.data(), data.logsBloom.size()};
+    return {(const unsigned char*)m_inner.logsBloom.data(), m_inner.logsBloom.size()};
 }
 
 void bcostars::protocol::BlockImpl::setLogsBloom(bcos::bytesConstRef logsBloom)
 {
-    auto& data = inner();
-    data.logsBloom.assign(logsBloom.data(), logsBloom.data() + logsBloom.size());
+    m_inner.logsBloom.assign(logsBloom.data(), logsBloom.data() + logsBloom.size());
 }
\ No newline at end of file
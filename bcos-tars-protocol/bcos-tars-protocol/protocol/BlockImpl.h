@@ -33,7 +33,9 @@
 #include <bcos-framework/protocol/BlockHeader.h>
 #include <gsl/span>
 #include <memory>
+#include <mutex>
 #include <range/v3/view/any_view.hpp>
+#include <span>
 
 namespace bcostars::protocol
 {
@@ -84,10 +86,16 @@ public:
     void setNonceList(::ranges::any_view<std::string> nonces) override;
     ::ranges::any_view<std::string> nonceList() const override;
 
+    // inner() decodes all the transactions and receipts of a decoded block first
     const bcostars::Block& inner() const;
     bcostars::Block& inner();
     void setInner(bcostars::Block inner);
 
+    // the encoded transaction or receipt at _index in the buffer the block was decoded from,
+    // empty if the block was built or modified since, or once all its elements are decoded
+    std::span<const bcos::byte> encodedTransaction(uint64_t _index) const;
+    std::span<const bcos::byte> encodedReceipt(uint64_t _index) const;
+
     bcos::crypto::HashType calculateTransactionRoot(
         const bcos::crypto::Hash& hashImpl) const override;
 
@@ -104,6 +112,31 @@ public:
     void setLogsBloom(bcos::bytesConstRef logsBloom) override;
 
 private:
+    // decode() keeps the encoded block and decodes its transactions and receipts on first access,
+    // the encoded block is released once the last of them is decoded
+    struct LazyElements
+    {
+        bcos::bytes buffer;
+        std::vector<std::span<const bcos::byte>> transactions;
+        std::vector<std::span<const bcos::byte>> receipts;
+        std::vector<bool> decodedTransactions;
+        std::vector<bool> decodedReceipts;
+        size_t transactionsSize = 0;
+        size_t receiptsSize = 0;
+        // the elements not decoded yet
+        size_t pendingSize = 0;
+        std::mutex mutex;
+    };
+
+    void decodeTransaction(uint64_t _index) const;
+    void decodeReceipt(uint64_t _index) const;
+    void decodeAll() const;
+    // called with the lock of m_lazy held
+    void onElementDecoded(bool _decoded) const;
+    // decodes everything and drops the encoded block, before m_inner is modified
+    void materialize();
+
     mutable bcostars::Block m_inner;
+    std::unique_ptr<LazyElements> m_lazy;
 };
 }  // namespace bcostars::protocol
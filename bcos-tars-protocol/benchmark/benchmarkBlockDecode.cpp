@@ -0,0 +1,165 @@
+#include "bcos-tars-protocol/impl/TarsSerializable.h"
+#include "bcos-tars-protocol/protocol/BlockImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptImpl.h"
+#include <bcos-concepts/Serialize.h>
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace bcos;
+
+// count the bytes allocated on the heap to report the peak memory of a decoding
+static std::atomic<size_t> g_allocatedBytes = 0;
+static std::atomic<size_t> g_peakBytes = 0;
+constexpr static size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    auto* memory = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER));
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(memory) = size;
+    auto allocated = g_allocatedBytes.fetch_add(size) + size;
+    auto peak = g_peakBytes.load();
+    while (allocated > peak && !g_peakBytes.compare_exchange_weak(peak, allocated))
+    {
+    }
+    return memory + ALLOCATION_HEADER;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    auto* memory = static_cast<char*>(pointer) - ALLOCATION_HEADER;
+    g_allocatedBytes.fetch_sub(*reinterpret_cast<size_t*>(memory));
+    std::free(memory);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+// the encoded block of range(0) txs and receipts
+static bytes encodeBlock(size_t txCount)
+{
+    auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+    auto header = block->blockHeader();
+    header->setNumber(1);
+    header->setSealerList(std::vector<bytes>(4, bytes(64, 's')));
+    header->setConsensusWeights(std::vector<uint64_t>(4, 1));
+    std::vector<std::string> nonces;
+    for (size_t i = 0; i < txCount; ++i)
+    {
+        auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>();
+        auto& inner = transaction->mutableInner();
+        inner.data.version = 1;
+        inner.data.chainID = "chain0";
+        inner.data.groupID = "group0";
+        inner.data.blockLimit = 500;
+        inner.data.nonce = fmt::format("{:0>64}", i);
+        inner.data.to = fmt::format("0x{:0>40x}", i % 100);
+        inner.data.input.assign(164, 'i');
+        inner.signature.assign(65, 's');
+        inner.importTime = 1700000000000 + i;
+        nonces.emplace_back(inner.data.nonce);
+        block->appendTransaction(std::move(transaction));
+
+        auto receipt = std::make_shared<bcostars::protocol::TransactionReceiptImpl>();
+        std::vector<protocol::LogEntry> logs;
+        logs.emplace_back(bytes(20, 'a'), h256s{h256(i)}, bytes(64, 'd'));
+        receipt->setLogEntries(logs);
+        block->appendReceipt(std::move(receipt));
+    }
+    block->setNonceList(nonces);
+    bytes encoded;
+    block->encode(encoded);
+    return encoded;
+}
+
+// decode returns the decoded block, the memory it still holds once decode returns is retainedBytes
+template <class Decode>
+static void decodeBlock(benchmark::State& state, Decode decode)
+{
+    auto encoded = encodeBlock(state.range(0));
+    size_t peakBytes = 0;
+    size_t retainedBytes = 0;
+    for (auto const& it : state)
+    {
+        auto base = g_allocatedBytes.load();
+        g_peakBytes = base;
+        auto block = decode(encoded);
+        peakBytes = g_peakBytes.load() - base;
+        retainedBytes = g_allocatedBytes.load() - base;
+    }
+    state.counters["blockBytes"] = benchmark::Counter(encoded.size());
+    state.counters["peakBytes"] = benchmark::Counter(peakBytes);
+    state.counters["retainedBytes"] = benchmark::Counter(retainedBytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Before: the whole bcostars::Block is decoded to read the header and the nonces
+static void eagerHeader(benchmark::State& state)
+{
+    decodeBlock(state, [](const bytes& encoded) {
+        auto block = std::make_shared<bcostars::Block>();
+        bcos::concepts::serialize::decode(encoded, *block);
+        benchmark::DoNotOptimize(block->blockHeader.data.blockNumber);
+        benchmark::DoNotOptimize(block->nonceList.size());
+        return block;
+    });
+}
+
+// Only the header and the nonces are decoded, the txs and receipts are left in the buffer
+static void lazyHeader(benchmark::State& state)
+{
+    decodeBlock(state, [](const bytes& encoded) {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->decode(ref(encoded), false, false);
+        benchmark::DoNotOptimize(block->blockHeader()->number());
+        benchmark::DoNotOptimize(::ranges::distance(block->nonceList()));
+        return block;
+    });
+}
+
+// Every tx is read after the lazy decoding, the worst case of it
+static void lazyAllTransactions(benchmark::State& state)
+{
+    decodeBlock(state, [](const bytes& encoded) {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->decode(ref(encoded), false, false);
+        for (auto transaction : block->transactions())
+        {
+            benchmark::DoNotOptimize(transaction->nonce());
+        }
+        return block;
+    });
+}
+
+// The execution, prewrite and sync paths access every tx and receipt of the block, the encoded
+// block is released then and only the decoded one is retained
+static void lazyFullAccess(benchmark::State& state)
+{
+    decodeBlock(state, [](const bytes& encoded) {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->decode(ref(encoded), false, false);
+        benchmark::DoNotOptimize(block->inner().transactions.size());
+        benchmark::DoNotOptimize(block->inner().receipts.size());
+        return block;
+    });
+}
+
+BENCHMARK(eagerHeader)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(lazyHeader)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(lazyAllTransactions)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(lazyFullAccess)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
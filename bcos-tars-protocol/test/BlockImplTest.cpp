@@ -8,6 +8,8 @@
  *   http://www.apache.org/licenses/LICENSE-2.0
  */
 
+#include "bcos-concepts/Serialize.h"
+#include "bcos-tars-protocol/impl/TarsSerializable.h"
 #include "bcos-tars-protocol/protocol/BlockImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
@@ -102,5 +104,86 @@ BOOST_AUTO_TEST_CASE(nonceListRoundTrip)
     BOOST_CHECK_EQUAL_COLLECTIONS(readBack.begin(), readBack.end(), nonces.begin(), nonces.end());
 }
 
+// decode() reads the header eagerly and the transactions and receipts on first access, with the
+// same result as the decoding of the whole block
+BOOST_AUTO_TEST_CASE(lazyDecode)
+{
+    auto suite = makeSuite();
+    TransactionFactoryImpl txFactory(suite);
+    TransactionReceiptFactoryImpl receiptFactory(suite);
+    auto block = std::make_shared<BlockImpl>();
+    block->blockHeader()->setNumber(100);
+    block->setNonceList(std::vector<std::string>{"0x1", "0x2", "0x3"});
+    std::vector<bcos::protocol::LogEntry> logs;
+    logs.emplace_back(bcos::bytes{'a'}, bcos::h256s{bcos::h256(1)}, bcos::bytes{1, 2});
+    bcos::bytes output{3};
+    for (auto i = 0; i < 3; ++i)
+    {
+        block->appendTransaction(txFactory.createTransaction(
+            0, "0xa", bcos::bytes(i + 1, 'i'), std::to_string(i), 1, "c", "g", 0));
+        block->appendReceipt(receiptFactory.createReceipt(
+            bcos::u256(i), "", logs, 0, bcos::ref(output), i));
+    }
+    bcos::bytes encoded;
+    block->encode(encoded);
+
+    auto decoded = std::make_shared<BlockImpl>();
+    decoded->decode(bcos::ref(encoded), false, false);
+    BOOST_CHECK_EQUAL(decoded->blockHeader()->number(), 100);
+    BOOST_CHECK_EQUAL(decoded->transactionsSize(), 3U);
+    BOOST_CHECK_EQUAL(decoded->receiptsSize(), 3U);
+    BOOST_CHECK_EQUAL(::ranges::distance(decoded->nonceList()), 3);
+
+    for (auto i = 0U; i < 3; ++i)
+    {
+        bcos::bytes transaction;
+        bcos::concepts::serialize::encode(block->inner().transactions[i], transaction);
+        auto encodedTransaction = decoded->encodedTransaction(i);
+        BOOST_CHECK(std::equal(encodedTransaction.begin(), encodedTransaction.end(),
+            transaction.begin(), transaction.end()));
+        bcos::bytes receipt;
+        bcos::concepts::serialize::encode(block->inner().receipts[i], receipt);
+        auto encodedReceipt = decoded->encodedReceipt(i);
+        BOOST_CHECK(std::equal(
+            encodedReceipt.begin(), encodedReceipt.end(), receipt.begin(), receipt.end()));
+    }
+    BOOST_CHECK(decoded->encodedTransaction(3).empty());
+
+    // the transactions are decoded by index, in any order
+    BOOST_CHECK_EQUAL(decoded->transactions()[2]->nonce(), "2");
+    BOOST_CHECK_EQUAL(decoded->transactions()[0]->nonce(), "0");
+    BOOST_CHECK_EQUAL(decoded->receipts()[1]->blockNumber(), 1);
+    BOOST_CHECK_EQUAL(decoded->calculateTransactionRoot(*suite->hashImpl()),
+        block->calculateTransactionRoot(*suite->hashImpl()));
+    BOOST_CHECK_EQUAL(decoded->calculateReceiptRoot(*suite->hashImpl()),
+        block->calculateReceiptRoot(*suite->hashImpl()));
+    bcos::bytes reencoded;
+    decoded->encode(reencoded);
+    BOOST_CHECK(reencoded == encoded);
+    // every element is decoded, the encoded block is released
+    BOOST_CHECK(decoded->encodedTransaction(0).empty());
+    BOOST_CHECK(decoded->encodedReceipt(2).empty());
+    BOOST_CHECK_EQUAL(decoded->transactionsSize(), 3U);
+    BOOST_CHECK_EQUAL(decoded->transactions()[1]->nonce(), "1");
+
+    // modifying the block drops the encoded one
+    decoded->appendTransaction(
+        txFactory.createTransaction(0, "0xb", bcos::bytes{1}, "3", 1, "c", "g", 0));
+    BOOST_CHECK_EQUAL(decoded->transactionsSize(), 4U);
+    BOOST_CHECK(decoded->encodedTransaction(0).empty());
+    BOOST_CHECK_EQUAL(decoded->transactions()[1]->nonce(), "1");
+    BOOST_CHECK_EQUAL(decoded->transactions()[3]->nonce(), "3");
+
+    // a block without transactions
+    auto emptyBlock = std::make_shared<BlockImpl>();
+    emptyBlock->blockHeader()->setNumber(1);
+    bcos::bytes emptyEncoded;
+    emptyBlock->encode(emptyEncoded);
+    decoded->decode(bcos::ref(emptyEncoded), false, false);
+    BOOST_CHECK_EQUAL(decoded->blockHeader()->number(), 1);
+    BOOST_CHECK_EQUAL(decoded->transactionsSize(), 0U);
+    BOOST_CHECK_EQUAL(decoded->receiptsSize(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
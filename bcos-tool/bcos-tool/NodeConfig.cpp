@@ -399,6 +399,10 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
         ; 300s
         filter_timeout=300
         filter_max_process_block=10
+        ; the max number of requests in a batch request
+        batch_request_size_limit=100
+        ; the methods writing the result straight into the response, empty to disable
+        stream_response_methods=getBlockByHash,getBlockByNumber
     */
     std::string listenIP = _pt.get<std::string>("rpc.listen_ip", "0.0.0.0");
     int listenPort = _pt.get<int>("rpc.listen_port", 20200);
@@ -413,6 +417,25 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
         disableSsl = !enableSsl.value();
     }
     bool needRetInput = _pt.get<bool>("rpc.return_input_params", true);
+    int batchRequestSizeLimit = _pt.get<int>("rpc.batch_request_size_limit", 100);
+    if (batchRequestSizeLimit <= 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set rpc.batch_request_size_limit to positive!"));
+    }
+    auto streamResponseMethods = _pt.get<std::string>(
+        "rpc.stream_response_methods", "getBlockByHash,getBlockByNumber");
+    std::vector<std::string> methods;
+    boost::split(methods, streamResponseMethods, boost::is_any_of(","));
+    m_rpcStreamResponseMethods.clear();
+    for (auto& method : methods)
+    {
+        boost::trim(method);
+        if (!method.empty())
+        {
+            m_rpcStreamResponseMethods.insert(std::move(method));
+        }
+    }
 
     m_rpcListenIP = listenIP;
     m_rpcListenPort = listenPort;
@@ -421,12 +444,15 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
     m_rpcSmSsl = smSsl;
     m_rpcFilterTimeout = filterTimeout * 1000;  // to milliseconds
     m_rpcMaxProcessBlock = maxProcessBlock;
+    m_rpcBatchRequestSizeLimit = batchRequestSizeLimit;
     g_BCOSConfig.setNeedRetInput(needRetInput);
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadRpcConfig") << LOG_KV("listenIP", listenIP)
                          << LOG_KV("listenPort", listenPort) << LOG_KV("listenPort", listenPort)
                          << LOG_KV("smSsl", smSsl) << LOG_KV("disableSsl", disableSsl)
-                         << LOG_KV("needRetInput", needRetInput);
+                         << LOG_KV("needRetInput", needRetInput)
+                         << LOG_KV("batchRequestSizeLimit", batchRequestSizeLimit)
+                         << LOG_KV("streamResponseMethods", streamResponseMethods);
 }
 
 void NodeConfig::loadWeb3RpcConfig(boost::property_tree::ptree const& _pt)
@@ -647,6 +673,7 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
                                   "Please set txpool.pre_store_max_inflight to positive !"));
     }
     m_preStoreMaxInflight = static_cast<size_t>(preStoreCap);
+    m_compactTxsRelay = _pt.get<bool>("txpool.compact_relay", false);
     NodeConfig_LOG(INFO) << LOG_DESC("loadTxPoolConfig") << LOG_KV("txpoolLimit", m_txpoolLimit)
                          << LOG_KV("notifierWorkers", m_notifyWorkerNum)
                          << LOG_KV("verifierWorkers", m_verifierWorkerNum)
@@ -654,7 +681,8 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
                          << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime)
                          << LOG_KV("enableTxsFromFreeNode", m_enableTxsFromFreeNode)
                          << LOG_KV("preStoreBackpressureEnabled", m_preStoreBackpressureEnabled)
-                         << LOG_KV("preStoreMaxInflight", m_preStoreMaxInflight);
+                         << LOG_KV("preStoreMaxInflight", m_preStoreMaxInflight)
+                         << LOG_KV("compactTxsRelay", m_compactTxsRelay);
 }
 
 void NodeConfig::loadChainConfig(boost::property_tree::ptree const& _pt, bool _enforceGroupId)
@@ -939,12 +967,16 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     m_blockCacheSize = _pt.get<size_t>("storage.block_cache_size", 128 << 20);
     m_enableDBStatistics = _pt.get<bool>("storage.enable_statistics", false);
     m_enableRocksDBBlob = _pt.get<bool>("storage.enable_rocksdb_blob", false);
+    m_enableColumnFamilies = _pt.get<bool>("storage.enable_column_families", false);
+    m_blockDataCacheSize = _pt.get<size_t>("storage.block_data_cache_size", 32 << 20);
+    m_indexCacheSize = _pt.get<size_t>("storage.index_cache_size", 32 << 20);
     m_pdCaPath = _pt.get<std::string>("storage.pd_ssl_ca_path", "");
     m_pdCertPath = _pt.get<std::string>("storage.pd_ssl_cert_path", "");
     m_pdKeyPath = _pt.get<std::string>("storage.pd_ssl_key_path", "");
     m_enableArchive = _pt.get<bool>("storage.enable_archive", false);
     m_syncArchivedBlocks = _pt.get<bool>("storage.sync_archived_blocks", false);
     m_enableSeparateBlockAndState = _pt.get<bool>("storage.enable_separate_block_state", false);
+    m_enableLogIndexBackfill = _pt.get<bool>("storage.enable_log_index_backfill", false);
     if (boost::iequals(m_storageType, bcos::storage::TiKV))
     {
         m_enableSeparateBlockAndState = false;
@@ -977,9 +1009,11 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
                          << LOG_KV("pdAddrs", pd_addrs) << LOG_KV("pdCaPath", m_pdCaPath)
                          << LOG_KV("enableArchive", m_enableArchive)
                          << LOG_KV("enableSeparateBlockAndState", m_enableSeparateBlockAndState)
+                         << LOG_KV("enableLogIndexBackfill", m_enableLogIndexBackfill)
                          << LOG_KV("archiveListenIP", m_archiveListenIP)
                          << LOG_KV("archiveListenPort", m_archiveListenPort)
                          << LOG_KV("enable_rocksdb_blob", m_enableRocksDBBlob)
+                         << LOG_KV("enableColumnFamilies", m_enableColumnFamilies)
                          << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
 }
 
@@ -1024,6 +1058,12 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
     m_baselineSchedulerConfig.maxThread = _pt.get<int>("executor.baseline_scheduler_maxthread", 16);
     m_baselineSchedulerConfig.parallel =
         _pt.get<bool>("executor.baseline_scheduler_parallel", false);
+    m_baselineSchedulerConfig.blockSTM =
+        _pt.get<bool>("executor.baseline_scheduler_block_stm", false);
+    m_baselineSchedulerConfig.maxLayerDepth =
+        _pt.get<int>("executor.baseline_scheduler_max_layer_depth", 0);
+    m_baselineSchedulerConfig.codeCachePath =
+        _pt.get<std::string>("executor.baseline_scheduler_code_cache_path", "");
 
     m_tarsRPCConfig.host = _pt.get<std::string>("rpc.tars_rpc_host", "127.0.0.1");
     m_tarsRPCConfig.port = _pt.get<int>("rpc.tars_rpc_port", 0);
@@ -1074,13 +1114,17 @@ void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
                                   "pipeline_per_peer_capacity / pipeline_lru_capacity / "
                                   "pipeline_max_peers must all be > 0"));
     }
+    m_verifyThreadCount = checkAndGetValue(_pt, "consensus.verify_thread_count", "4");
+    m_verifyCacheCapacity = checkAndGetValue(_pt, "consensus.verify_cache_capacity", "4096");
     NodeConfig_LOG(INFO) << LOG_DESC("loadConsensusConfig")
                          << LOG_KV("checkPointTimeoutInterval", m_checkPointTimeoutInterval)
                          << LOG_KV("pipeline_size", m_pipelineSize)
                          << LOG_KV("pipeline_admission_enabled", m_pipelineAdmissionEnabled)
                          << LOG_KV("pipeline_per_peer_capacity", m_pipelinePerPeerCapacity)
                          << LOG_KV("pipeline_lru_capacity", m_pipelineLruCapacity)
-                         << LOG_KV("pipeline_max_peers", m_pipelineMaxPeers);
+                         << LOG_KV("pipeline_max_peers", m_pipelineMaxPeers)
+                         << LOG_KV("verify_thread_count", m_verifyThreadCount)
+                         << LOG_KV("verify_cache_capacity", m_verifyCacheCapacity);
 }
 
 void NodeConfig::loadLedgerConfig(boost::property_tree::ptree const& _genesisConfig)
@@ -1517,6 +1561,21 @@ bool NodeConfig::enableRocksDBBlob() const
     return m_enableRocksDBBlob;
 }
 
+bool NodeConfig::enableColumnFamilies() const
+{
+    return m_enableColumnFamilies;
+}
+
+size_t NodeConfig::blockDataCacheSize() const
+{
+    return m_blockDataCacheSize;
+}
+
+size_t NodeConfig::indexCacheSize() const
+{
+    return m_indexCacheSize;
+}
+
 std::vector<std::string> const& NodeConfig::pdAddrs() const
 {
     return m_pd_addrs;
@@ -1562,6 +1621,11 @@ bool NodeConfig::enableSeparateBlockAndState() const
     return m_enableSeparateBlockAndState;
 }
 
+bool NodeConfig::enableLogIndexBackfill() const
+{
+    return m_enableLogIndexBackfill;
+}
+
 std::string const& NodeConfig::archiveListenIP() const
 {
     return m_archiveListenIP;
@@ -1687,6 +1751,16 @@ uint32_t NodeConfig::rpcMaxProcessBlock() const
     return m_rpcMaxProcessBlock;
 }
 
+uint32_t NodeConfig::rpcBatchRequestSizeLimit() const
+{
+    return m_rpcBatchRequestSizeLimit;
+}
+
+const std::set<std::string>& NodeConfig::rpcStreamResponseMethods() const
+{
+    return m_rpcStreamResponseMethods;
+}
+
 bool NodeConfig::rpcSmSsl() const
 {
     return m_rpcSmSsl;
@@ -2024,6 +2098,11 @@ size_t NodeConfig::preStoreMaxInflight() const
     return m_preStoreMaxInflight;
 }
 
+bool NodeConfig::compactTxsRelay() const
+{
+    return m_compactTxsRelay;
+}
+
 void NodeConfig::loadAlloc(boost::property_tree::ptree const& ptree)
 {
     if (auto node = ptree.get_child_optional("alloc"))
@@ -31,6 +31,7 @@
 #include <boost/property_tree/ini_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <cstddef>
+#include <set>
 #include <unordered_map>
 
 #define NodeConfig_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("NodeConfig")
@@ -107,6 +108,8 @@ public:
     size_t pipelinePerPeerCapacity() const { return m_pipelinePerPeerCapacity; }
     size_t pipelineLruCapacity() const { return m_pipelineLruCapacity; }
     size_t pipelineMaxPeers() const { return m_pipelineMaxPeers; }
+    size_t verifyThreadCount() const { return m_verifyThreadCount; }
+    size_t verifyCacheCapacity() const { return m_verifyCacheCapacity; }
 
     std::string const& storagePath() const;
     std::string const& stateDBPath() const;
@@ -120,6 +123,9 @@ public:
     int minWriteBufferNumberToMerge() const;
     size_t blockCacheSize() const;
     bool enableRocksDBBlob() const;
+    bool enableColumnFamilies() const;
+    size_t blockDataCacheSize() const;
+    size_t indexCacheSize() const;
     std::vector<std::string> const& pdAddrs() const;
     std::string const& pdCaPath() const;
     std::string const& pdCertPath() const;
@@ -129,6 +135,7 @@ public:
     bool enableArchive() const;
     bool syncArchivedBlocks() const;
     bool enableSeparateBlockAndState() const;
+    bool enableLogIndexBackfill() const;
     std::string const& archiveListenIP() const;
     uint16_t archiveListenPort() const;
 
@@ -168,6 +175,8 @@ public:
     uint32_t rpcThreadPoolSize() const;
     uint32_t rpcFilterTimeout() const;
     uint32_t rpcMaxProcessBlock() const;
+    uint32_t rpcBatchRequestSizeLimit() const;
+    const std::set<std::string>& rpcStreamResponseMethods() const;
     bool rpcSmSsl() const;
     bool rpcDisableSsl() const;
 
@@ -258,8 +267,12 @@ public:
     struct BaselineSchedulerConfig
     {
         bool parallel = false;
+        bool blockSTM = false;
         int grainSize = 0;
         int maxThread = 0;
+        int maxLayerDepth = 0;
+        // where the code hashes of the hottest contracts are kept across restarts, empty disables
+        std::string codeCachePath;
     };
     BaselineSchedulerConfig const& baselineSchedulerConfig() const;
 
@@ -283,6 +296,7 @@ public:
     bool enableTxsFromFreeNode() const;
     bool preStoreBackpressureEnabled() const;
     size_t preStoreMaxInflight() const;
+    bool compactTxsRelay() const;
     int executorVersion() const;
 
 protected:
@@ -342,6 +356,8 @@ private:
     // pre-store backpressure tunables
     bool m_preStoreBackpressureEnabled = true;
     size_t m_preStoreMaxInflight = 1024;
+    // request the txs missed by a proposal with salted short ids
+    bool m_compactTxsRelay = false;
     // TODO: the block sync module need some configurations?
 
     // chain configuration
@@ -356,6 +372,8 @@ private:
     size_t m_pipelinePerPeerCapacity = 64;
     size_t m_pipelineLruCapacity = 256;
     size_t m_pipelineMaxPeers = 1024;
+    size_t m_verifyThreadCount = 4;
+    size_t m_verifyCacheCapacity = 4096;
 
     // for security
     std::string m_privateKeyPath;
@@ -404,10 +422,14 @@ private:
     int m_minWriteBufferNumberToMerge = 2;
     size_t m_blockCacheSize = 128 << 20;
     bool m_enableRocksDBBlob = false;
+    bool m_enableColumnFamilies = false;
+    size_t m_blockDataCacheSize = 32 << 20;
+    size_t m_indexCacheSize = 32 << 20;
 
     bool m_enableArchive = false;
     bool m_syncArchivedBlocks = false;
     bool m_enableSeparateBlockAndState = false;
+    bool m_enableLogIndexBackfill = false;
     std::string m_stateDBPath;
     std::string m_blockDBPath;
     std::string m_archiveListenIP;
@@ -442,6 +464,8 @@ private:
     uint32_t m_rpcThreadPoolSize{};
     uint32_t m_rpcFilterTimeout{};
     uint32_t m_rpcMaxProcessBlock{};
+    uint32_t m_rpcBatchRequestSizeLimit{};
+    std::set<std::string> m_rpcStreamResponseMethods;
     bool m_rpcSmSsl{};
     bool m_rpcDisableSsl = false;
 
@@ -28,15 +28,21 @@ BOOST_AUTO_TEST_CASE(rpcConfigDefaultsAndPopulated)
     LoaderProbe a;
     a.loadRpcConfig({});  // all defaults
     BOOST_CHECK_EQUAL(a.rpcListenIP(), "0.0.0.0");
+    BOOST_CHECK_EQUAL(a.rpcBatchRequestSizeLimit(), 100U);
+    BOOST_CHECK(a.rpcStreamResponseMethods() ==
+                std::set<std::string>({"getBlockByHash", "getBlockByNumber"}));
 
     LoaderProbe b;
     auto pt = fromIni(
         "[rpc]\nlisten_ip=1.2.3.4\nlisten_port=12345\nthread_count=4\nsm_ssl=true\n"
-        "enable_ssl=true\nfilter_timeout=10\nreturn_input_params=false\n");
+        "enable_ssl=true\nfilter_timeout=10\nreturn_input_params=false\n"
+        "batch_request_size_limit=20\nstream_response_methods= getBlockByNumber ,\n");
     b.loadRpcConfig(pt);
     BOOST_CHECK_EQUAL(b.rpcListenIP(), "1.2.3.4");
     BOOST_CHECK_EQUAL(b.rpcListenPort(), 12345);
     BOOST_CHECK(!b.rpcDisableSsl());  // enable_ssl=true → disableSsl=false
+    BOOST_CHECK_EQUAL(b.rpcBatchRequestSizeLimit(), 20U);
+    BOOST_CHECK(b.rpcStreamResponseMethods() == std::set<std::string>({"getBlockByNumber"}));
 }
 
 
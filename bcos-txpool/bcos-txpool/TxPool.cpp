@@ -114,6 +114,12 @@ task::Task<protocol::TransactionSubmitResult::Ptr> TxPool::submitTransaction(
     co_return co_await m_txpoolStorage->submitTransaction(std::move(transaction), waitForReceipt);
 }
 
+std::vector<protocol::TransactionStatus> TxPool::batchSubmitTransactions(
+    std::span<const protocol::Transaction::Ptr> transactions)
+{
+    return m_txpoolStorage->batchVerifyAndSubmitTransactions(transactions, true);
+}
+
 task::Task<void> TxPool::broadcastTransaction(const protocol::Transaction& transaction)
 {
     ittapi::Report report(
@@ -395,6 +401,49 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, protocol::Block::Const
     });
 }
 
+bool TxPool::compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer)
+{
+    return m_transactionSync->compactRelayPeer(_peer);
+}
+
+void TxPool::asyncRebuildCompactProposal(PublicPtr _generatedNodeID,
+    protocol::Block::Ptr _proposal, std::vector<ShortTxID> _shortIDs,
+    std::function<void(Error::Ptr, protocol::Block::Ptr)> _onRebuilt)
+{
+    TXPOOL_LOG(DEBUG) << LOG_DESC("begin asyncRebuildCompactProposal")
+                      << LOG_KV("consNum", _proposal->blockHeader()->number())
+                      << LOG_KV("hash", _proposal->blockHeader()->hash().abridged())
+                      << LOG_KV("txs", _shortIDs.size());
+    // matching the short ids walks the pool, keep it off the network thread as asyncVerifyBlock
+    auto self = weak_from_this();
+    m_verifier->enqueue([self, _generatedNodeID = std::move(_generatedNodeID),
+                            proposal = std::move(_proposal), shortIDs = std::move(_shortIDs),
+                            _onRebuilt = std::move(_onRebuilt)]() mutable {
+        auto txpool = self.lock();
+        if (!txpool)
+        {
+            _onRebuilt(
+                BCOS_ERROR_PTR(-1, "asyncRebuildCompactProposal failed for lock txpool failed"),
+                nullptr);
+            return;
+        }
+        try
+        {
+            txpool->m_transactionSync->rebuildCompactProposal(std::move(_generatedNodeID),
+                std::move(proposal), std::move(shortIDs), _onRebuilt);
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("asyncRebuildCompactProposal exception")
+                                << LOG_KV("message", boost::diagnostic_information(e));
+            _onRebuilt(BCOS_ERROR_PTR(CommonError::FetchTransactionsFailed,
+                           "asyncRebuildCompactProposal exception: " +
+                               boost::diagnostic_information(e)),
+                nullptr);
+        }
+    });
+}
+
 void TxPool::asyncNotifyTxsSyncMessage(Error::Ptr _error, std::string const& _uuid,
     NodeIDPtr _nodeID, bytesConstRef _data, std::function<void(Error::Ptr)> _onRecv)
 {
@@ -760,7 +809,7 @@ void TxPool::storeVerifiedBlock(bcos::protocol::Block::ConstPtr _block)
 void bcos::txpool::TxPool::notifyConnectedNodes(
     bcos::crypto::NodeIDSet const& _connectedNodes, std::function<void(Error::Ptr)> _onResponse)
 {
-    m_transactionSync->config()->notifyConnectedNodes(_connectedNodes, _onResponse);
+    m_transactionSync->notifyConnectedNodes(_connectedNodes, _onResponse);
     if (m_txpoolStorage->size() > 0)
     {
         return;
@@ -48,6 +48,10 @@ public:
     // New interfaces ==================
     task::Task<protocol::TransactionSubmitResult::Ptr> submitTransaction(
         protocol::Transaction::Ptr transaction, bool waitForReceipt) override;
+    // verify the signatures of a batch of transactions in parallel and insert the valid ones,
+    // return the submit status of every transaction
+    std::vector<protocol::TransactionStatus> batchSubmitTransactions(
+        std::span<const protocol::Transaction::Ptr> transactions);
 
     task::Task<void> broadcastTransaction(const protocol::Transaction& transaction) override;
     task::Task<void> broadcastTransactionBuffer(bytesConstRef data) override;
@@ -74,6 +78,11 @@ public:
         protocol::Block::ConstPtr _block,
         std::function<void(Error::Ptr, bool)> _onVerifyFinished) override;
 
+    bool compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer) override;
+    void asyncRebuildCompactProposal(bcos::crypto::PublicPtr _generatedNodeID,
+        protocol::Block::Ptr _proposal, std::vector<ShortTxID> _shortIDs,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _onRebuilt) override;
+
     // hook for tx/consensus sync message receive
     void asyncNotifyTxsSyncMessage(bcos::Error::Ptr _error, std::string const& _uuid,
         bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _data,
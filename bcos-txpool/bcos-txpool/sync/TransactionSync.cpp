@@ -25,6 +25,7 @@
 #include <bcos-framework/protocol/Protocol.h>
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/zip.hpp>
+#include <algorithm>
 
 using namespace bcos;
 using namespace bcos::sync;
@@ -66,6 +67,25 @@ void TransactionSync::onRecvSyncMessage(
                                   << LOG_KV("peer", _nodeID->shortHex());
             }
         }
+        if (txsSyncMsg->type() ==
+            static_cast<int32_t>(TxsSyncPacketType::TxsCompactRequestPacket))
+        {
+            try
+            {
+                onReceiveCompactTxsRequest(txsSyncMsg, _sendResponse, _nodeID);
+            }
+            catch (std::exception const& e)
+            {
+                SYNC_LOG(WARNING)
+                    << LOG_DESC("onRecvSyncMessage: send compact txs response exception")
+                    << LOG_KV("message", boost::diagnostic_information(e))
+                    << LOG_KV("peer", _nodeID->shortHex());
+            }
+        }
+        if (txsSyncMsg->type() == static_cast<int32_t>(TxsSyncPacketType::TxsCapabilityPacket))
+        {
+            onPeerCapability(_nodeID, txsSyncMsg);
+        }
         if (txsSyncMsg->type() == static_cast<int32_t>(TxsSyncPacketType::TxsStatusPacket))
         {
             try
@@ -112,8 +132,174 @@ void TransactionSync::onReceiveTxsRequest(TxsSyncMsgInterface::Ptr _txsRequest,
                        << LOG_KV("nodeId", m_config->nodeID()->shortHex());
     }
     // response the txs
+    auto packetData = encodeTxsResponse(txs);
+    _sendResponse(ref(*packetData));
+    SYNC_LOG(INFO) << LOG_DESC("onReceiveTxsRequest: response txs")
+                   << LOG_KV("peer", _peer ? _peer->shortHex() : "unknown")
+                   << LOG_KV("txsSize", txs.size());
+}
+
+void TransactionSync::onReceiveCompactTxsRequest(TxsSyncMsgInterface::Ptr _txsRequest,
+    SendResponseCallback _sendResponse, bcos::crypto::PublicPtr _peer)
+{
+    uint64_t salt = 0;
+    std::vector<txpool::ShortTxID> shortIDs;
+    if (!txpool::decodeShortTxIDs(_txsRequest->txsData(), salt, shortIDs) ||
+        shortIDs.size() > MAX_SYNC_TXSHASH_COUNT)
+    {
+        SYNC_LOG(WARNING) << LOG_DESC("onReceiveCompactTxsRequest: invalid short ids")
+                          << LOG_KV("dataSize", _txsRequest->txsData().size())
+                          << LOG_KV("peer", _peer ? _peer->shortHex() : "unknown");
+        return;
+    }
+    // an empty response over the limit, the requester fetches by hash and backs off
+    std::vector<Transaction::ConstPtr> txs;
+    if (admitCompactRequest(_peer))
+    {
+        // the txs the pool can't match are left for the requester to fetch by hash
+        txs = m_config->txpoolStorage()->getTransactionsByShortIDs(salt, shortIDs);
+    }
+    auto packetData = encodeTxsResponse(txs);
+    _sendResponse(ref(*packetData));
+    SYNC_LOG(INFO) << LOG_DESC("onReceiveCompactTxsRequest: response txs")
+                   << LOG_KV("peer", _peer ? _peer->shortHex() : "unknown")
+                   << LOG_KV("reqSize", shortIDs.size()) << LOG_KV("txsSize", txs.size());
+}
+
+bool TransactionSync::admitCompactRequest(bcos::crypto::PublicPtr const& _peer)
+{
+    if (!_peer)
+    {
+        return false;
+    }
+    auto second = utcTime() / 1000;
+    std::unique_lock lock(x_compactPeers);
+    auto& [window, count] = m_compactRequests[_peer->hex()];
+    if (window != second)
+    {
+        window = second;
+        count = 0;
+    }
+    return ++count <= MAX_COMPACT_REQUESTS_PER_SECOND;
+}
+
+bool TransactionSync::useCompactRequest(
+    bcos::crypto::PublicPtr const& _peer, size_t _missedTxsSize)
+{
+    if (_missedTxsSize < MIN_COMPACT_REQUEST_TXS)
+    {
+        return false;
+    }
+    std::unique_lock lock(x_compactPeers);
+    if (!m_compactPeers.contains(_peer->hex()))
+    {
+        return false;
+    }
+    auto it = m_compactBackoff.find(_peer->hex());
+    if (it == m_compactBackoff.end())
+    {
+        return true;
+    }
+    if (it->second > utcTime())
+    {
+        return false;
+    }
+    m_compactBackoff.erase(it);
+    return true;
+}
+
+bool TransactionSync::compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer)
+{
+    if (!m_config->compactTxsRelay())
+    {
+        return false;
+    }
+    std::unique_lock lock(x_compactPeers);
+    return m_compactPeers.contains(_peer->hex());
+}
+
+void TransactionSync::notifyConnectedNodes(
+    NodeIDSet const& _connectedNodes, std::function<void(Error::Ptr)> _onResponse)
+{
+    auto lastConnectedNodes = m_config->connectedNodeList();
+    m_config->notifyConnectedNodes(_connectedNodes, std::move(_onResponse));
+    {
+        std::unordered_set<std::string> connected;
+        for (auto const& node : _connectedNodes)
+        {
+            connected.insert(node->hex());
+        }
+        std::unique_lock lock(x_compactPeers);
+        std::erase_if(m_compactPeers, [&](auto const& peer) { return !connected.contains(peer); });
+        std::erase_if(m_compactBackoff,
+            [&](auto const& entry) { return !connected.contains(entry.first); });
+        std::erase_if(m_compactRequests,
+            [&](auto const& entry) { return !connected.contains(entry.first); });
+    }
+    for (auto const& node : _connectedNodes)
+    {
+        if (!lastConnectedNodes.contains(node) && node->data() != m_config->nodeID()->data())
+        {
+            sendCapability(node);
+        }
+    }
+}
+
+void TransactionSync::sendCapability(NodeIDPtr _toNode)
+{
+    // only a node relaying compact proposals announces it, the others are sent the full ones
+    if (!m_config->compactTxsRelay())
+    {
+        return;
+    }
+    uint32_t capabilities = TxsCapability::COMPACT_RELAY;
+    bytes capabilityData(sizeof(capabilities));
+    for (size_t i = 0; i < sizeof(capabilities); ++i)
+    {
+        capabilityData[i] = static_cast<byte>(capabilities >> (i * 8));
+    }
+    auto capability = m_config->msgFactory()->createTxsSyncMsg(
+        static_cast<uint32_t>(TxsSyncPacketType::TxsCapabilityPacket), std::move(capabilityData));
+    auto packetData = capability->encode();
+    m_config->frontService()->asyncSendMessageByNodeID(
+        ModuleID::TxsSync, _toNode, ref(*packetData), 0, nullptr);
+}
+
+void TransactionSync::onPeerCapability(NodeIDPtr _fromNode, TxsSyncMsgInterface::Ptr _capability)
+{
+    uint32_t capabilities = 0;
+    auto capabilityData = _capability->txsData();
+    for (size_t i = 0; i < std::min(capabilityData.size(), sizeof(capabilities)); ++i)
+    {
+        capabilities |= uint32_t(capabilityData[i]) << (i * 8);
+    }
+    bool known = false;
+    {
+        std::unique_lock lock(x_compactPeers);
+        known = m_compactPeers.contains(_fromNode->hex());
+        if (capabilities & TxsCapability::COMPACT_RELAY)
+        {
+            m_compactPeers.insert(_fromNode->hex());
+        }
+        else
+        {
+            m_compactPeers.erase(_fromNode->hex());
+        }
+    }
+    SYNC_LOG(INFO) << LOG_DESC("onPeerCapability") << LOG_KV("peer", _fromNode->shortHex())
+                   << LOG_KV("capabilities", capabilities);
+    // a peer restarted between two connection notifications has forgotten the capabilities
+    // announced to it, answer the first announcement of it
+    if (!known && (capabilities & TxsCapability::COMPACT_RELAY))
+    {
+        sendCapability(std::move(_fromNode));
+    }
+}
+
+bytesPointer TransactionSync::encodeTxsResponse(std::vector<Transaction::ConstPtr> const& _txs)
+{
     auto block = m_config->blockFactory()->createBlock();
-    for (const auto& constTx : txs)
+    for (const auto& constTx : _txs)
     {
         if (constTx)
         {
@@ -124,11 +310,7 @@ void TransactionSync::onReceiveTxsRequest(TxsSyncMsgInterface::Ptr _txsRequest,
     block->encode(txsData);
     auto txsResponse = m_config->msgFactory()->createTxsSyncMsg(
         static_cast<uint32_t>(TxsSyncPacketType::TxsResponsePacket), std::move(txsData));
-    auto packetData = txsResponse->encode();
-    _sendResponse(ref(*packetData));
-    SYNC_LOG(INFO) << LOG_DESC("onReceiveTxsRequest: response txs")
-                   << LOG_KV("peer", _peer ? _peer->shortHex() : "unknown")
-                   << LOG_KV("txsSize", txs.size());
+    return txsResponse->encode();
 }
 
 void TransactionSync::requestMissedTxs(PublicPtr _generatedNodeID, HashListPtr _missedTxs,
@@ -193,6 +375,13 @@ void TransactionSync::requestMissedTxs(PublicPtr _generatedNodeID, HashListPtr _
                 << LOG_KV("hash", _verifiedProposal ?
                                       _verifiedProposal->blockHeader()->hash().abridged() :
                                       "null");
+            if (_verifiedProposal && txsSync->m_config->compactTxsRelay() &&
+                txsSync->useCompactRequest(_generatedNodeID, ledgerMissedTxs->size()))
+            {
+                txsSync->requestMissedTxsByShortIDs(
+                    _generatedNodeID, ledgerMissedTxs, _verifiedProposal, _onVerifyFinished);
+                return;
+            }
             txsSync->requestMissedTxsFromPeer(
                 _generatedNodeID, ledgerMissedTxs, _verifiedProposal, _onVerifyFinished);
         });
@@ -310,6 +499,278 @@ void TransactionSync::requestMissedTxsFromPeer(PublicPtr _generatedNodeID, HashL
         });
 }
 
+void TransactionSync::requestMissedTxsByShortIDs(PublicPtr _generatedNodeID,
+    HashListPtr _missedTxs, Block::ConstPtr _verifiedProposal,
+    VerifyResponseCallback _onVerifyFinished)
+{
+    // all the followers use the salt of the proposal, the leader indexes its sealed txs once
+    auto salt = txpool::shortTxIDSalt(_verifiedProposal->blockHeader()->hash());
+    auto txsRequest = m_config->msgFactory()->createTxsSyncMsg(
+        static_cast<uint32_t>(TxsSyncPacketType::TxsCompactRequestPacket),
+        txpool::encodeShortTxIDs(salt, *_missedTxs));
+    auto encodedData = txsRequest->encode();
+    auto startT = utcTime();
+    auto self = weak_from_this();
+    m_config->frontService()->asyncSendMessageByNodeID(ModuleID::ConsTxsSync, _generatedNodeID,
+        ref(*encodedData), m_config->networkTimeout(),
+        [self, startT, _generatedNodeID, _missedTxs, _verifiedProposal, _onVerifyFinished](
+            auto&& _error, auto&&, bytesConstRef _data, const std::string&, auto&&) {
+            auto transactionSync = self.lock();
+            if (!transactionSync)
+            {
+                return;
+            }
+            try
+            {
+                SYNC_LOG(DEBUG) << LOG_DESC("requestMissedTxsByShortIDs: receive response")
+                                << LOG_KV("peer", _generatedNodeID->shortHex())
+                                << LOG_KV("missedTxs", _missedTxs->size())
+                                << LOG_KV("networkT", utcTime() - startT);
+                transactionSync->verifyCompactFetchedTxs(_error, _generatedNodeID, _data,
+                    _missedTxs, _verifiedProposal, _onVerifyFinished);
+            }
+            catch (std::exception const& e)
+            {
+                SYNC_LOG(WARNING) << LOG_DESC("requestMissedTxsByShortIDs: verify exception")
+                                  << LOG_KV("message", boost::diagnostic_information(e))
+                                  << LOG_KV("peer", _generatedNodeID->shortHex());
+                _onVerifyFinished(
+                    BCOS_ERROR_PTR(CommonError::FetchTransactionsFailed,
+                        "verifyCompactFetchedTxs exception: " + boost::diagnostic_information(e)),
+                    false);
+            }
+        });
+}
+
+void TransactionSync::verifyCompactFetchedTxs(Error::Ptr _error, PublicPtr _peer,
+    bytesConstRef _data, HashListPtr _missedTxs, Block::ConstPtr _verifiedProposal,
+    VerifyResponseCallback _onVerifyFinished)
+{
+    std::set<HashType> missedTxs(_missedTxs->begin(), _missedTxs->end());
+    auto fetchedTxs = std::make_shared<Transactions>();
+    // a failed or rate limited request matches nothing, all the txs are fetched by hash then
+    if (_error == nullptr)
+    {
+        auto txsResponse = m_config->msgFactory()->createTxsSyncMsg(_data);
+        if (txsResponse->type() == static_cast<int32_t>(TxsSyncPacketType::TxsResponsePacket))
+        {
+            auto transactions =
+                m_config->blockFactory()->createBlock(txsResponse->txsData(), true, false);
+            auto txFactory = m_config->blockFactory()->transactionFactory();
+            fetchedTxs->reserve(transactions->transactionsSize());
+            for (auto&& tx : transactions->transactions())
+            {
+                // the txs matched on a colliding short id are not the ones missed
+                if (missedTxs.contains(tx->hash()))
+                {
+                    fetchedTxs->emplace_back(txFactory->createTransaction(*tx));
+                }
+            }
+        }
+    }
+    if (!importDownloadedTxs(fetchedTxs, _verifiedProposal))
+    {
+        _onVerifyFinished(BCOS_ERROR_PTR(CommonError::TxsSignatureVerifyFailed,
+                              "invalid transaction for invalid signature or nonce or blockLimit"),
+            false);
+        return;
+    }
+    for (auto const& tx : *fetchedTxs)
+    {
+        missedTxs.erase(tx->hash());
+    }
+    SYNC_LOG(DEBUG) << LOG_DESC("verifyCompactFetchedTxs")
+                    << LOG_KV("code", _error ? _error->errorCode() : 0)
+                    << LOG_KV("missedTxs", _missedTxs->size())
+                    << LOG_KV("fetchedTxs", fetchedTxs->size())
+                    << LOG_KV("unmatchedTxs", missedTxs.size())
+                    << LOG_KV("consNum", _verifiedProposal->blockHeader()->number());
+    if (missedTxs.empty())
+    {
+        _onVerifyFinished(nullptr, true);
+        return;
+    }
+    // the second exchange only pays off while the peer matches almost all the txs, request it by
+    // hash only for a while otherwise
+    if (fetchedTxs->size() * 100 < _missedTxs->size() * MIN_COMPACT_MATCH_PERCENT)
+    {
+        std::unique_lock lock(x_compactPeers);
+        m_compactBackoff[_peer->hex()] = utcTime() + COMPACT_REQUEST_BACKOFF_MS;
+    }
+    // fetch only the unmatched ones by hash
+    requestMissedTxsFromPeer(std::move(_peer),
+        std::make_shared<HashList>(missedTxs.begin(), missedTxs.end()),
+        std::move(_verifiedProposal), std::move(_onVerifyFinished));
+}
+
+void TransactionSync::rebuildCompactProposal(PublicPtr _generatedNodeID, Block::Ptr _proposal,
+    std::vector<ShortTxID> _shortIDs, RebuildCallback _onRebuilt)
+{
+    auto compact = std::make_shared<CompactProposal>();
+    compact->leader = std::move(_generatedNodeID);
+    compact->salt = shortTxIDSalt(_proposal->blockHeader()->hash());
+    compact->proposal = std::move(_proposal);
+    compact->shortIDs = std::move(_shortIDs);
+    compact->txs = m_config->txpoolStorage()->matchShortTxIDs(compact->salt, compact->shortIDs);
+    compact->matchedLocally = ::ranges::any_of(compact->txs, [](auto const& tx) { return !!tx; });
+    compact->onRebuilt = std::move(_onRebuilt);
+    fetchUnmatchedTxs(std::move(compact));
+}
+
+void TransactionSync::fetchUnmatchedTxs(std::shared_ptr<CompactProposal> _compact)
+{
+    std::vector<size_t> unmatched;
+    std::vector<ShortTxID> unmatchedIDs;
+    for (size_t i = 0; i < _compact->txs.size(); ++i)
+    {
+        if (!_compact->txs[i])
+        {
+            unmatched.emplace_back(i);
+            unmatchedIDs.emplace_back(_compact->shortIDs[i]);
+        }
+    }
+    if (unmatched.empty())
+    {
+        buildCompactProposal(std::move(_compact));
+        return;
+    }
+    auto txsRequest = m_config->msgFactory()->createTxsSyncMsg(
+        static_cast<uint32_t>(TxsSyncPacketType::TxsCompactRequestPacket),
+        txpool::encodeShortTxIDs(_compact->salt, unmatchedIDs));
+    auto encodedData = txsRequest->encode();
+    auto leader = _compact->leader;
+    auto startT = utcTime();
+    auto self = weak_from_this();
+    m_config->frontService()->asyncSendMessageByNodeID(ModuleID::ConsTxsSync, std::move(leader),
+        ref(*encodedData), m_config->networkTimeout(),
+        [self, startT, unmatched = std::move(unmatched), _compact](
+            auto&& _error, auto&&, bytesConstRef _data, const std::string&, auto&&) {
+            auto transactionSync = self.lock();
+            if (!transactionSync)
+            {
+                return;
+            }
+            try
+            {
+                SYNC_LOG(DEBUG) << LOG_DESC("fetchUnmatchedTxs: receive response")
+                                << LOG_KV("peer", _compact->leader->shortHex())
+                                << LOG_KV("unmatchedTxs", unmatched.size())
+                                << LOG_KV("networkT", utcTime() - startT);
+                transactionSync->onFetchUnmatchedTxs(_error, _data, unmatched, _compact);
+            }
+            catch (std::exception const& e)
+            {
+                SYNC_LOG(WARNING) << LOG_DESC("fetchUnmatchedTxs: rebuild exception")
+                                  << LOG_KV("message", boost::diagnostic_information(e))
+                                  << LOG_KV("peer", _compact->leader->shortHex());
+                _compact->onRebuilt(
+                    BCOS_ERROR_PTR(CommonError::FetchTransactionsFailed,
+                        "rebuild compact proposal exception: " + boost::diagnostic_information(e)),
+                    nullptr);
+            }
+        });
+}
+
+void TransactionSync::onFetchUnmatchedTxs(Error::Ptr _error, bytesConstRef _data,
+    std::vector<size_t> const& _unmatched, std::shared_ptr<CompactProposal> _compact)
+{
+    if (_error != nullptr)
+    {
+        _compact->onRebuilt(std::move(_error), nullptr);
+        return;
+    }
+    auto txsResponse = m_config->msgFactory()->createTxsSyncMsg(_data);
+    if (txsResponse->type() != static_cast<int32_t>(TxsSyncPacketType::TxsResponsePacket))
+    {
+        _compact->onRebuilt(
+            BCOS_ERROR_PTR(CommonError::FetchTransactionsFailed, "FetchTransactionsFailed"),
+            nullptr);
+        return;
+    }
+    std::unordered_map<ShortTxID, size_t> positions;
+    positions.reserve(_unmatched.size());
+    for (auto position : _unmatched)
+    {
+        positions.emplace(_compact->shortIDs[position], position);
+    }
+    auto transactions = m_config->blockFactory()->createBlock(txsResponse->txsData(), true, false);
+    auto txFactory = m_config->blockFactory()->transactionFactory();
+    auto fetchedTxs = std::make_shared<Transactions>();
+    fetchedTxs->reserve(transactions->transactionsSize());
+    for (auto&& tx : transactions->transactions())
+    {
+        auto it = positions.find(shortTxID(_compact->salt, tx->hash()));
+        if (it == positions.end() || _compact->txs[it->second])
+        {
+            continue;
+        }
+        auto fetchedTx = txFactory->createTransaction(*tx);
+        _compact->txs[it->second] = fetchedTx;
+        fetchedTxs->emplace_back(std::move(fetchedTx));
+    }
+    if (!importDownloadedTxs(fetchedTxs, _compact->proposal))
+    {
+        _compact->onRebuilt(BCOS_ERROR_PTR(CommonError::TxsSignatureVerifyFailed,
+                                "invalid transaction for invalid signature or nonce or blockLimit"),
+            nullptr);
+        return;
+    }
+    if (fetchedTxs->size() < _unmatched.size())
+    {
+        SYNC_LOG(WARNING) << LOG_DESC("onFetchUnmatchedTxs: the leader missed txs")
+                          << LOG_KV("unmatchedTxs", _unmatched.size())
+                          << LOG_KV("fetchedTxs", fetchedTxs->size())
+                          << LOG_KV("peer", _compact->leader->shortHex());
+        _compact->onRebuilt(
+            BCOS_ERROR_PTR(CommonError::TransactionsMissing, "TransactionsMissing"), nullptr);
+        return;
+    }
+    buildCompactProposal(std::move(_compact));
+}
+
+void TransactionSync::buildCompactProposal(std::shared_ptr<CompactProposal> _compact)
+{
+    auto blockFactory = m_config->blockFactory();
+    auto block = blockFactory->createBlock();
+    block->setVersion(_compact->proposal->version());
+    block->setBlockType(_compact->proposal->blockType());
+    block->setBlockHeader(_compact->proposal->blockHeader());
+    // the same metadata the leader sealed the txs with
+    for (auto const& tx : _compact->txs)
+    {
+        auto txMetaData = blockFactory->createTransactionMetaData();
+        txMetaData->setHash(tx->hash());
+        txMetaData->setTo(std::string(tx->to()));
+        txMetaData->setAttribute(tx->attribute());
+        block->appendTransactionMetaData(std::move(txMetaData));
+    }
+    auto const& header = _compact->proposal->blockHeader();
+    if (block->calculateTransactionRoot(*m_hashImpl) == header->txsRoot())
+    {
+        SYNC_LOG(DEBUG) << LOG_DESC("rebuild compact proposal success")
+                        << LOG_KV("consNum", header->number())
+                        << LOG_KV("hash", header->hash().abridged())
+                        << LOG_KV("txs", _compact->txs.size());
+        _compact->onRebuilt(nullptr, std::move(block));
+        return;
+    }
+    SYNC_LOG(WARNING) << LOG_DESC("rebuild compact proposal: txsRoot mismatch")
+                      << LOG_KV("consNum", header->number())
+                      << LOG_KV("hash", header->hash().abridged())
+                      << LOG_KV("matchedLocally", _compact->matchedLocally);
+    if (!_compact->matchedLocally)
+    {
+        _compact->onRebuilt(
+            BCOS_ERROR_PTR(CommonError::InconsistentTransactions, "InconsistentTransactions"),
+            nullptr);
+        return;
+    }
+    // a tx of the pool collides with one of the proposal on its short id, fetch them all
+    _compact->matchedLocally = false;
+    std::fill(_compact->txs.begin(), _compact->txs.end(), nullptr);
+    fetchUnmatchedTxs(std::move(_compact));
+}
+
 void TransactionSync::verifyFetchedTxs(Error::Ptr _error, NodeIDPtr _nodeID, bytesConstRef _data,
     HashListPtr _missedTxs, Block::ConstPtr _verifiedProposal,
     VerifyResponseCallback _onVerifyFinished)
@@ -26,6 +26,9 @@
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Worker.h>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace bcos::sync
 {
@@ -59,6 +62,16 @@ public:
 
     void onEmptyTxs() override;
 
+    bool compactRelayPeer(bcos::crypto::NodeIDPtr const& _peer) override;
+    using RebuildCallback = std::function<void(Error::Ptr, bcos::protocol::Block::Ptr)>;
+    void rebuildCompactProposal(bcos::crypto::PublicPtr _generatedNodeID,
+        bcos::protocol::Block::Ptr _proposal, std::vector<txpool::ShortTxID> _shortIDs,
+        RebuildCallback _onRebuilt) override;
+
+    // announce the capabilities to the newly connected peers and forget the disconnected ones
+    void notifyConnectedNodes(bcos::crypto::NodeIDSet const& _connectedNodes,
+        std::function<void(Error::Ptr)> _onResponse) override;
+
     void stop() override;
 
 protected:
@@ -69,6 +82,11 @@ protected:
 
     virtual void onReceiveTxsRequest(TxsSyncMsgInterface::Ptr _txsRequest,
         SendResponseCallback _sendResponse, bcos::crypto::PublicPtr _peer);
+    virtual void onReceiveCompactTxsRequest(TxsSyncMsgInterface::Ptr _txsRequest,
+        SendResponseCallback _sendResponse, bcos::crypto::PublicPtr _peer);
+    virtual void onPeerCapability(
+        bcos::crypto::NodeIDPtr _fromNode, TxsSyncMsgInterface::Ptr _capability);
+    virtual void sendCapability(bcos::crypto::NodeIDPtr _toNode);
 
     // functions called by requestMissedTxs
     virtual void verifyFetchedTxs(Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
@@ -78,6 +96,15 @@ protected:
     virtual void requestMissedTxsFromPeer(bcos::crypto::PublicPtr _generatedNodeID,
         bcos::crypto::HashListPtr _missedTxs, bcos::protocol::Block::ConstPtr _verifiedProposal,
         VerifyResponseCallback _onVerifyFinished);
+    // request the txs by their short ids, the txs the peer can't match are requested again by
+    // requestMissedTxsFromPeer
+    virtual void requestMissedTxsByShortIDs(bcos::crypto::PublicPtr _generatedNodeID,
+        bcos::crypto::HashListPtr _missedTxs, bcos::protocol::Block::ConstPtr _verifiedProposal,
+        VerifyResponseCallback _onVerifyFinished);
+    virtual void verifyCompactFetchedTxs(Error::Ptr _error, bcos::crypto::PublicPtr _peer,
+        bytesConstRef _data, bcos::crypto::HashListPtr _missedTxs,
+        bcos::protocol::Block::ConstPtr _verifiedProposal,
+        VerifyResponseCallback _onVerifyFinished);
 
     virtual size_t onGetMissedTxsFromLedger(std::set<bcos::crypto::HashType>& _missedTxs,
         Error::Ptr _error, bcos::protocol::TransactionsPtr _fetchedTxs,
@@ -91,10 +118,44 @@ protected:
     virtual bool importDownloadedTxs(bcos::protocol::TransactionsPtr _txs,
         bcos::protocol::Block::ConstPtr _verifiedProposal = nullptr);
 
+    // a proposal relayed by the short ids of its txs, being rebuilt from the pool and the leader
+    struct CompactProposal
+    {
+        bcos::crypto::PublicPtr leader;
+        bcos::protocol::Block::Ptr proposal;
+        uint64_t salt;
+        std::vector<txpool::ShortTxID> shortIDs;
+        // the tx of each short id, nullptr until matched or fetched
+        std::vector<bcos::protocol::Transaction::ConstPtr> txs;
+        // whether some txs were matched in the pool, where a tx colliding on a short id can be
+        // matched instead of the one of the proposal
+        bool matchedLocally;
+        RebuildCallback onRebuilt;
+    };
+    virtual void fetchUnmatchedTxs(std::shared_ptr<CompactProposal> _compact);
+    virtual void onFetchUnmatchedTxs(Error::Ptr _error, bytesConstRef _data,
+        std::vector<size_t> const& _unmatched, std::shared_ptr<CompactProposal> _compact);
+    // build the proposal with the txs and check it against the txsRoot of the signed header
+    virtual void buildCompactProposal(std::shared_ptr<CompactProposal> _compact);
+
 private:
+    bytesPointer encodeTxsResponse(std::vector<bcos::protocol::Transaction::ConstPtr> const& _txs);
+    // whether the missed txs are worth a compact request to the peer
+    bool useCompactRequest(bcos::crypto::PublicPtr const& _peer, size_t _missedTxsSize);
+    // whether the peer is still under MAX_COMPACT_REQUESTS_PER_SECOND
+    bool admitCompactRequest(bcos::crypto::PublicPtr const& _peer);
+
     bcos::crypto::Hash::Ptr m_hashImpl;
     bcos::crypto::SignatureCrypto::Ptr m_signatureImpl;
 
     bool m_checkTransactionSignature;
+
+    std::mutex x_compactPeers;
+    // the peers that announced TxsCapability::COMPACT_RELAY
+    std::unordered_set<std::string> m_compactPeers;
+    // peer => the time until which it is only requested by hash
+    std::unordered_map<std::string, uint64_t> m_compactBackoff;
+    // peer => the second and the number of compact requests of the peer answered in it
+    std::unordered_map<std::string, std::pair<uint64_t, size_t>> m_compactRequests;
 };
 }  // namespace bcos::sync
\ No newline at end of file
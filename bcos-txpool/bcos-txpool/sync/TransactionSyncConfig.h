@@ -64,6 +64,11 @@ public:
     void setForwardPercent(unsigned _forwardPercent) { m_forwardPercent = _forwardPercent; }
     std::shared_ptr<bcos::ledger::LedgerInterface> ledger() { return m_ledger; }
 
+    // request the txs missed by a proposal with short ids instead of full hashes, the peers must
+    // all understand TxsCompactRequestPacket
+    bool compactTxsRelay() const { return m_compactTxsRelay; }
+    void setCompactTxsRelay(bool _compactTxsRelay) { m_compactTxsRelay = _compactTxsRelay; }
+
     // for ut
     void setTxPoolStorage(bcos::txpool::TxPoolStorageInterface::Ptr _txpoolStorage)
     {
@@ -99,6 +104,8 @@ private:
 
     unsigned m_forwardPercent = 25;
 
+    bool m_compactTxsRelay = false;
+
     size_t m_maxResponseTxsToNodesWithEmptyTxs = 1000;
 
     // FIB-167: separate from m_maxResponseTxsToNodesWithEmptyTxs (sync-response cap).
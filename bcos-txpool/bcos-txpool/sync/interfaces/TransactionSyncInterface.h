@@ -23,6 +23,9 @@
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
 #include <bcos-framework/front/FrontServiceInterface.h>
 #include <bcos-framework/protocol/Block.h>
+#include <bcos-framework/protocol/CommonError.h>
+#include <bcos-framework/txpool/ShortTxID.h>
+#include <bcos-utilities/Error.h>
 
 namespace bcos::sync
 {
@@ -43,6 +46,24 @@ public:
     virtual void onRecvSyncMessage(bcos::Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, std::function<void(bytesConstRef)> _sendResponse) = 0;
 
+    // whether the peer announced it rebuilds the proposals relayed by the short ids of their txs
+    virtual bool compactRelayPeer(bcos::crypto::NodeIDPtr const&) { return false; }
+    // rebuild the txs of _proposal, of which only the header was relayed, from their short ids
+    virtual void rebuildCompactProposal(bcos::crypto::PublicPtr, bcos::protocol::Block::Ptr,
+        std::vector<txpool::ShortTxID>,
+        std::function<void(Error::Ptr, bcos::protocol::Block::Ptr)> _onRebuilt)
+    {
+        _onRebuilt(BCOS_ERROR_PTR(bcos::protocol::CommonError::FetchTransactionsFailed,
+                       "compact proposal relay not supported"),
+            nullptr);
+    }
+
+    virtual void notifyConnectedNodes(bcos::crypto::NodeIDSet const& _connectedNodes,
+        std::function<void(Error::Ptr)> _onResponse)
+    {
+        m_config->notifyConnectedNodes(_connectedNodes, _onResponse);
+    }
+
     virtual TransactionSyncConfig::Ptr config() { return m_config; }
     virtual void onEmptyTxs() = 0;
     virtual void stop() = 0;
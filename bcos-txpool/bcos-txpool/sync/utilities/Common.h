@@ -31,11 +31,33 @@ enum class TxsSyncPacketType : int32_t
     TxsStatusPacket = 0x01,
     TxsRequestPacket = 0x02,
     TxsResponsePacket = 0x03,
-    PacketCount = 0x04,
+    // request the txs by the salted short ids of their hashes, see txpool/ShortTxID.h
+    TxsCompactRequestPacket = 0x04,
+    // the TxsCapability bits of the sender, sent to every newly connected peer, older nodes drop
+    // the unknown packet and are never sent a compact request or proposal
+    TxsCapabilityPacket = 0x05,
+    PacketCount = 0x06,
+};
+
+enum TxsCapability : uint32_t
+{
+    // answers TxsCompactRequestPacket and rebuilds the proposals relayed by short ids
+    COMPACT_RELAY = 1U << 0,
 };
 
 // Maximum number of transaction hashes allowed in a single sync message.
 // No block can exceed the pool limit, so this is a safe upper bound.
 static constexpr const size_t MAX_SYNC_TXSHASH_COUNT = 100000;
 
+// A compact request saves 26 bytes per missed tx but costs a second exchange for the txs it can't
+// match, below this many missed txs the saving isn't worth it and the hashes are requested
+static constexpr const size_t MIN_COMPACT_REQUEST_TXS = 16;
+// A peer that matched less than this percent of a compact request, because it has fewer of the
+// txs or rate limits the request, is only requested by hash for a while
+static constexpr const size_t MIN_COMPACT_MATCH_PERCENT = 90;
+static constexpr const uint64_t COMPACT_REQUEST_BACKOFF_MS = 10 * 1000;
+// Every compact request with a new salt walks the sealed txs, a peer gets at most this many
+// compact requests answered per second and an empty response beyond
+static constexpr const size_t MAX_COMPACT_REQUESTS_PER_SECOND = 16;
+
 }  // namespace bcos::sync
@@ -21,9 +21,11 @@
 #pragma once
 #include <bcos-framework/protocol/Block.h>
 #include <bcos-framework/protocol/Transaction.h>
+#include <bcos-framework/txpool/ShortTxID.h>
 #include <bcos-framework/txpool/TxPoolTypeDef.h>
 #include <bcos-protocol/TransactionStatus.h>
 #include <bcos-task/Task.h>
+#include <span>
 #include <utility>
 
 namespace bcos::txpool
@@ -39,6 +41,26 @@ public:
         protocol::Transaction::Ptr transaction, bool waitForReceipt) = 0;
     virtual std::vector<protocol::Transaction::ConstPtr> getTransactions(
         crypto::HashListView hashes) = 0;
+    /**
+     * @brief Get the sealed transactions of the pool whose salted short id is in _shortIDs
+     *
+     * @param _salt the salt the short ids are computed with, the one of the proposal
+     * @param _shortIDs the short ids to look up
+     * @return the matched transactions in no particular order, a short id matching more than one
+     *         sealed transaction is left unmatched
+     */
+    virtual std::vector<protocol::Transaction::ConstPtr> getTransactionsByShortIDs(
+        uint64_t _salt, std::span<const ShortTxID> _shortIDs) = 0;
+    /**
+     * @brief Match the short ids of a compact proposal against all the transactions of the pool
+     *
+     * @param _salt the salt the short ids are computed with, the one of the proposal
+     * @param _shortIDs the short ids of the proposal in order
+     * @return the transaction of each short id, nullptr where no transaction or more than one
+     *         matches it
+     */
+    virtual std::vector<protocol::Transaction::ConstPtr> matchShortTxIDs(
+        uint64_t _salt, std::span<const ShortTxID> _shortIDs) = 0;
 
     virtual void batchRemoveSealedTxs(bcos::protocol::BlockNumber _batchId,
         bcos::protocol::TransactionSubmitResults const& _txsResult) = 0;
@@ -47,6 +69,16 @@ public:
         bcos::protocol::BlockHeader::ConstPtr _header, bcos::protocol::TransactionsPtr _txs) = 0;
     virtual void batchImportTxs(bcos::protocol::TransactionsPtr _txs) = 0;
 
+    /**
+     * @brief Verify a batch of submitted transactions in parallel and insert the valid ones
+     *
+     * @param _txs the transactions to submit
+     * @param _checkPoolLimit reject the transactions exceeding the pool limit or not
+     * @return the submit status of every transaction, in the same order as _txs
+     */
+    virtual std::vector<protocol::TransactionStatus> batchVerifyAndSubmitTransactions(
+        std::span<const protocol::Transaction::Ptr> _txs, bool _checkPoolLimit) = 0;
+
     /**
      * @brief Get newly inserted transactions from the txpool
      *
@@ -35,12 +35,17 @@
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/remove_if.hpp>
 #include <range/v3/view/concat.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/filter.hpp>
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/map.hpp>
+#include <range/v3/view/single.hpp>
 #include <range/v3/view/transform.hpp>
+#include <unordered_set>
 #include <variant>
 
 const static auto CPU_CORES = std::thread::hardware_concurrency() + 1;
@@ -225,6 +230,105 @@ std::vector<protocol::Transaction::ConstPtr> MemoryStorage::getTransactions(
            ::ranges::to<std::vector>();
 }
 
+std::vector<protocol::Transaction::ConstPtr> MemoryStorage::getTransactionsByShortIDs(
+    uint64_t _salt, std::span<const ShortTxID> _shortIDs)
+{
+    auto index = shortIDIndex(_salt);
+    std::unordered_set<ShortTxID> requested;
+    std::vector<protocol::Transaction::ConstPtr> txs;
+    txs.reserve(_shortIDs.size());
+    for (auto shortID : _shortIDs)
+    {
+        auto it = index->find(shortID);
+        if (it != index->end() && it->second && requested.insert(shortID).second)
+        {
+            txs.emplace_back(it->second);
+        }
+    }
+    return txs;
+}
+
+std::vector<protocol::Transaction::ConstPtr> MemoryStorage::matchShortTxIDs(
+    uint64_t _salt, std::span<const ShortTxID> _shortIDs)
+{
+    // a proposal has one salt, every pool walks its txs once for it and nothing is kept
+    std::unordered_map<ShortTxID, std::vector<size_t>> positions;
+    positions.reserve(_shortIDs.size());
+    for (size_t i = 0; i < _shortIDs.size(); ++i)
+    {
+        positions[_shortIDs[i]].emplace_back(i);
+    }
+    std::vector<protocol::Transaction::ConstPtr> txs(_shortIDs.size());
+    // the short ids matching more than one tx of the pool, or listed twice in the proposal
+    std::unordered_set<ShortTxID> ambiguous;
+    auto match = [&](TxsMap& _txsMap) {
+        for (auto& accessor : _txsMap.range<TxsMap::ReadAccessor>())
+        {
+            auto shortID = shortTxID(_salt, accessor.key());
+            auto it = positions.find(shortID);
+            if (it == positions.end())
+            {
+                continue;
+            }
+            auto& tx = txs[it->second.front()];
+            // a tx sealed while the maps are walked is seen in both of them
+            if (tx && tx->hash() == accessor.key())
+            {
+                continue;
+            }
+            if (it->second.size() > 1 || tx)
+            {
+                ambiguous.insert(shortID);
+                continue;
+            }
+            tx = accessor.value();
+        }
+    };
+    match(m_bcosTransactions.unsealTransactions);
+    match(m_bcosTransactions.sealedTransactions);
+    for (auto shortID : ambiguous)
+    {
+        for (auto position : positions[shortID])
+        {
+            txs[position] = nullptr;
+        }
+    }
+    return txs;
+}
+
+std::shared_ptr<const MemoryStorage::ShortIDIndex> MemoryStorage::shortIDIndex(uint64_t _salt)
+{
+    {
+        std::unique_lock lock(m_shortIDIndexesMutex);
+        auto it = std::find_if(m_shortIDIndexes.begin(), m_shortIDIndexes.end(),
+            [_salt](auto const& _index) { return _index.first == _salt; });
+        if (it != m_shortIDIndexes.end())
+        {
+            m_shortIDIndexes.splice(m_shortIDIndexes.begin(), m_shortIDIndexes, it);
+            return it->second;
+        }
+    }
+    // the txs of a proposal are sealed by the leader before it is sent, the unsealed txs are
+    // never walked so the cost is bounded by the proposals in flight and not by the pool
+    auto index = std::make_shared<ShortIDIndex>();
+    for (auto& accessor : m_bcosTransactions.sealedTransactions.range<TxsMap::ReadAccessor>())
+    {
+        auto [it, inserted] =
+            index->try_emplace(shortTxID(_salt, accessor.key()), accessor.value());
+        if (!inserted)
+        {
+            it->second = nullptr;
+        }
+    }
+    std::unique_lock lock(m_shortIDIndexesMutex);
+    m_shortIDIndexes.emplace_front(_salt, index);
+    if (m_shortIDIndexes.size() > MAX_SHORT_ID_INDEXES)
+    {
+        m_shortIDIndexes.pop_back();
+    }
+    return index;
+}
+
 TransactionStatus MemoryStorage::txpoolStorageCheck(
     const Transaction& transaction, protocol::TxSubmitCallback& txSubmitCallback)
 {
@@ -369,21 +473,12 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
     return TransactionStatus::None;
 }
 
-TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
-    Transaction::Ptr transaction, TxSubmitCallback txSubmitCallback, bool checkPoolLimit, bool lock)
+TransactionStatus MemoryStorage::verifyTransaction(const Transaction::Ptr& transaction,
+    TxSubmitCallback& txSubmitCallback, bool checkPoolLimit)
 {
-    ittapi::Report report(
-        ittapi::ITT_DOMAINS::instance().TXPOOL, ittapi::ITT_DOMAINS::instance().SUBMIT_TX);
-
     // Step 1: Check if transaction already exists in txpool
     {
         auto result = txpoolStorageCheck(*transaction, txSubmitCallback);
-        if (result == TransactionStatus::AlreadyInTxPoolAndAccept) [[unlikely]]
-        {
-            // Callback has been moved to the existing transaction; return success immediately
-            // without proceeding to insert() to avoid use-after-free and double-resume (FIB-48)
-            return TransactionStatus::None;
-        }
         if (result != TransactionStatus::None)
         {
             return result;
@@ -449,7 +544,11 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
             return result;
         }
     }
+    return TransactionStatus::None;
+}
 
+TransactionStatus MemoryStorage::reserveNonce(const Transaction& transaction)
+{
     // All validations passed — now insert nonce atomically before inserting the transaction.
     // Nonce insertion is done here (not inside verify()) so that failures in validateTransaction()
     // or validateChainId() cannot leave a stale nonce in the pool (FIB-50).
@@ -457,9 +556,9 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     // eliminating the TOCTOU window between separate checkNonce() + insert() calls (FIB-51).
     if (m_config->checkTransactionSignature())
     {
-        if (transaction->type() != static_cast<uint8_t>(TransactionType::Web3Transaction))
+        if (transaction.type() != static_cast<uint8_t>(TransactionType::Web3Transaction))
         {
-            if (!m_config->txPoolNonceChecker()->insert(std::string(transaction->nonce())))
+            if (!m_config->txPoolNonceChecker()->insert(std::string(transaction.nonce())))
                 [[unlikely]]
             {
                 return TransactionStatus::NonceCheckFail;
@@ -468,13 +567,37 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
         else
         {
             if (!task::syncWait(m_config->txValidator()->web3NonceChecker()->insertMemoryNonce(
-                    std::string(transaction->sender()), std::string(transaction->nonce()))))
+                    std::string(transaction.sender()), std::string(transaction.nonce()))))
                 [[unlikely]]
             {
                 return TransactionStatus::NonceCheckFail;
             }
         }
     }
+    return TransactionStatus::None;
+}
+
+TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
+    Transaction::Ptr transaction, TxSubmitCallback txSubmitCallback, bool checkPoolLimit, bool lock)
+{
+    ittapi::Report report(
+        ittapi::ITT_DOMAINS::instance().TXPOOL, ittapi::ITT_DOMAINS::instance().SUBMIT_TX);
+
+    if (auto result = verifyTransaction(transaction, txSubmitCallback, checkPoolLimit);
+        result != TransactionStatus::None)
+    {
+        if (result == TransactionStatus::AlreadyInTxPoolAndAccept) [[unlikely]]
+        {
+            // Callback has been moved to the existing transaction; return success immediately
+            // without proceeding to insert() to avoid use-after-free and double-resume (FIB-48)
+            return TransactionStatus::None;
+        }
+        return result;
+    }
+    if (auto result = reserveNonce(*transaction); result != TransactionStatus::None)
+    {
+        return result;
+    }
 
     // Prepare for insertion
     auto const txImportTime = transaction->importTime();
@@ -492,13 +615,94 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     return insert(std::move(transaction));
 }
 
+std::vector<TransactionStatus> MemoryStorage::batchVerifyAndSubmitTransactions(
+    std::span<const Transaction::Ptr> transactions, bool checkPoolLimit)
+{
+    ittapi::Report report(
+        ittapi::ITT_DOMAINS::instance().TXPOOL, ittapi::ITT_DOMAINS::instance().SUBMIT_TX);
+    auto recordT = utcTime();
+    std::vector<TransactionStatus> results(transactions.size(), TransactionStatus::None);
+
+    // Step 1: hash and recover the signatures in parallel, the pool limit is enforced below
+    // for the whole batch instead
+    tbb::parallel_for(tbb::blocked_range(0LU, transactions.size()), [&](auto const& range) {
+        for (auto index = range.begin(); index != range.end(); ++index)
+        {
+            const auto& transaction = transactions[index];
+            if (!transaction) [[unlikely]]
+            {
+                results[index] = TransactionStatus::Malformed;
+                continue;
+            }
+            transaction->setImportTime(utcTime());
+            TxSubmitCallback txSubmitCallback;
+            results[index] = verifyTransaction(transaction, txSubmitCallback, false);
+        }
+    });
+    auto verifyT = utcTime() - recordT;
+
+    // Step 2: admit the valid txs as long as the pool has room, and reserve their nonces
+    // sequentially so that duplicated nonces inside the batch are rejected
+    auto poolSize = size();
+    auto poolLimit = m_config->poolLimit();
+    std::vector<size_t> admitted;
+    admitted.reserve(transactions.size());
+    for (auto index : ::ranges::views::iota(0LU, transactions.size()))
+    {
+        if (results[index] != TransactionStatus::None)
+        {
+            continue;
+        }
+        if (checkPoolLimit && poolSize + admitted.size() >= poolLimit)
+        {
+            results[index] = TransactionStatus::TxPoolIsFull;
+            continue;
+        }
+        if (auto result = reserveNonce(*transactions[index]); result != TransactionStatus::None)
+        {
+            results[index] = result;
+            continue;
+        }
+        admitted.emplace_back(index);
+    }
+
+    // Step 3: insert the admitted txs, locking every bucket only once
+    std::vector<Transaction::Ptr> inserted(admitted.size());
+    m_bcosTransactions.unsealTransactions.traverse<TxsMap::WriteAccessor, true>(
+        ::ranges::views::transform(
+            admitted, [&](size_t index) { return transactions[index]->hash(); }),
+        [&](TxsMap::WriteAccessor& accessor, const auto& range, auto& bucket) {
+            for (auto position : range)
+            {
+                const auto& transaction = transactions[admitted[position]];
+                if (bucket.insert(accessor, {transaction->hash(), transaction}))
+                {
+                    inserted[position] = transaction;
+                }
+                else
+                {
+                    results[admitted[position]] = TransactionStatus::AlreadyInTxPool;
+                }
+            }
+        });
+    std::erase(inserted, nullptr);
+    indexUnsealedTxs(inserted);
+
+    TXPOOL_LOG(DEBUG) << LOG_DESC("batchVerifyAndSubmitTransactions")
+                      << LOG_KV("txsSize", transactions.size())
+                      << LOG_KV("insertedTxs", inserted.size()) << LOG_KV("verifyT", verifyT)
+                      << LOG_KV("timecost", utcTime() - recordT);
+    return results;
+}
+
 TransactionStatus MemoryStorage::insert(Transaction::Ptr transaction)
 {
-    auto* toMap = transaction->sealed() ? &m_bcosTransactions.sealedTransactions :
-                                          &m_bcosTransactions.unsealTransactions;
+    auto sealed = transaction->sealed();
+    auto* toMap = sealed ? &m_bcosTransactions.sealedTransactions :
+                           &m_bcosTransactions.unsealTransactions;
     auto* ptr = transaction.get();
     if (TxsMap::WriteAccessor accessor;
-        !toMap->insert(accessor, {transaction->hash(), std::move(transaction)}))
+        !toMap->insert(accessor, {transaction->hash(), transaction}))
     {
         if (ptr->submitCallback() && !accessor.value()->submitCallback())
         {
@@ -507,6 +711,10 @@ TransactionStatus MemoryStorage::insert(Transaction::Ptr transaction)
         }
         return TransactionStatus::AlreadyInTxPool;
     }
+    if (!sealed)
+    {
+        indexUnsealedTxs(::ranges::views::single(std::move(transaction)));
+    }
     return TransactionStatus::None;
 }
 
@@ -778,20 +986,32 @@ bool MemoryStorage::batchSealTransactions(std::vector<protocol::TransactionMetaD
         tx->setSealed(true);
         tx->setBatchId(-1);
         tx->setBatchHash(HashType());
-        m_knownLatestSealedTxHash = txHash;
         return true;
     };
 
-    // Use WriteAccessor so that mutations inside handleTx (setSealed, setBatchId, setBatchHash)
-    // are performed under an exclusive bucket lock (FIB-54)
-    for (auto& accessor : m_bcosTransactions.unsealTransactions.rangeByKey<TxsMap::WriteAccessor>(
-             m_knownLatestSealedTxHash))
+    // Pop the oldest txs from the sealing index, so the cost only depends on _txsLimit and the
+    // number of stale entries met on the way, not on the pool size
+    size_t staleCount = 0;
     {
-        const auto& tx = accessor.value();
-        handleTx(tx);
-        if (!((_txsList.size() + _sysTxsList.size()) < _txsLimit))
+        std::unique_lock indexLock(m_unsealedIndexMutex);
+        auto it = m_unsealedIndex.begin();
+        while (it != m_unsealedIndex.end() && (_txsList.size() + _sysTxsList.size()) < _txsLimit)
         {
-            break;
+            const auto& tx = it->second;
+            // Use WriteAccessor so that mutations inside handleTx (setSealed, setBatchId,
+            // setBatchHash) are performed under an exclusive bucket lock (FIB-54)
+            if (TxsMap::WriteAccessor accessor;
+                m_bcosTransactions.unsealTransactions.find(accessor, tx->hash()) &&
+                accessor.value() == tx)
+            {
+                handleTx(tx);
+            }
+            else
+            {
+                // the tx has been sealed or removed since it was indexed
+                ++staleCount;
+            }
+            it = m_unsealedIndex.erase(it);
         }
     }
     const auto invalidTxsSize = invalidTxs.size();
@@ -828,7 +1048,8 @@ bool MemoryStorage::batchSealTransactions(std::vector<protocol::TransactionMetaD
                      << LOG_KV("pendingTxs", m_bcosTransactions.unsealTransactions.size())
                      << LOG_KV("limit", _txsLimit) << LOG_KV("fetchTxsT", fetchTxsT)
                      << LOG_KV("lockT", lockT) << LOG_KV("invalidBefore", invalidTxsSize)
-                     << LOG_KV("sealed", sealed) << LOG_KV("traverseCount", traverseCount);
+                     << LOG_KV("sealed", sealed) << LOG_KV("traverseCount", traverseCount)
+                     << LOG_KV("staleIndex", staleCount);
     return true;
 }
 
@@ -909,6 +1130,8 @@ void MemoryStorage::clear()
 {
     m_bcosTransactions.sealedTransactions.clear();
     m_bcosTransactions.unsealTransactions.clear();
+    std::unique_lock lock(m_unsealedIndexMutex);
+    m_unsealedIndex.clear();
 }
 
 HashList MemoryStorage::filterUnknownTxs(crypto::HashListView _txsHashList, NodeIDPtr _peer)
@@ -938,7 +1161,6 @@ bool MemoryStorage::batchMarkTxs(crypto::HashListView _txsHashList, BlockNumber
     std::atomic_size_t successCount = 0;
     std::atomic_size_t notFound = 0;
     std::atomic_size_t reSealed = 0;
-    std::atomic_int64_t knownLatestSealedTxIndex = -1;
 
     TxsMap* fromMap = _sealFlag ? std::addressof(m_bcosTransactions.unsealTransactions) :
                                   std::addressof(m_bcosTransactions.sealedTransactions);
@@ -953,7 +1175,6 @@ bool MemoryStorage::batchMarkTxs(crypto::HashListView _txsHashList, BlockNumber
             size_t localNotFound = 0;
             size_t localReSealed = 0;
             size_t localSuccess = 0;
-            int64_t localKnownLatestSealedTxIndex = -1;
             for (auto index : range)
             {
                 auto hash = _txsHashList[index];
@@ -998,32 +1219,13 @@ bool MemoryStorage::batchMarkTxs(crypto::HashListView _txsHashList, BlockNumber
                 {
                     transaction->setBatchId(_batchId);
                     transaction->setBatchHash(_batchHash);
-                    if (static_cast<int64_t>(index) > localKnownLatestSealedTxIndex)
-                    {
-                        localKnownLatestSealedTxIndex = index;
-                    }
                 }
             }
 
             successCount += localSuccess;
             notFound += localNotFound;
             reSealed += localReSealed;
-            // FIB-65: sentinel is -1; index 0 is valid, so use >= 0 not > 0
-            if (localKnownLatestSealedTxIndex >= 0)
-            {
-                auto current = knownLatestSealedTxIndex.load();
-                while (localKnownLatestSealedTxIndex > current &&
-                       !knownLatestSealedTxIndex.compare_exchange_strong(
-                           current, localKnownLatestSealedTxIndex))
-                {
-                }
-            }
         });
-    // FIB-65: sentinel is -1; index 0 is valid, so use >= 0 not > 0
-    if (knownLatestSealedTxIndex >= 0)
-    {
-        m_knownLatestSealedTxHash = _txsHashList[knownLatestSealedTxIndex];
-    }
 
     auto removedEnd =
         ::ranges::remove_if(moveTransactions, [](const auto& tx) { return tx == nullptr; });
@@ -1032,6 +1234,10 @@ bool MemoryStorage::batchMarkTxs(crypto::HashListView _txsHashList, BlockNumber
         ::ranges::views::transform(removedRange, [](const auto& tx) { return tx->hash(); }));
     toMap->batchInsert(::ranges::views::transform(
         removedRange, [](const auto& tx) { return std::make_pair(tx->hash(), tx); }));
+    if (!_sealFlag)
+    {
+        indexUnsealedTxs(removedRange);
+    }
 
     TXPOOL_LOG(INFO) << LOG_DESC("batchMarkTxs") << LOG_KV("txsSize", _txsHashList.size())
                      << LOG_KV("batchId", _batchId) << LOG_KV("hash", _batchHash.abridged())
@@ -1067,6 +1273,10 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
             tx->setBatchHash(HashType());
         }
     }
+    if (!_sealFlag)
+    {
+        indexUnsealedTxs(::ranges::views::values(moveTxs));
+    }
 }
 
 std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::ConstPtr _block)
@@ -1180,9 +1390,44 @@ HashListPtr MemoryStorage::getTxsHash(int _limit)
     return txsHash;
 }
 
+void MemoryStorage::compactUnsealedIndex()
+{
+    std::unique_lock lock(m_unsealedIndexMutex);
+    auto indexSize = m_unsealedIndex.size();
+    auto unsealedSize = m_bcosTransactions.unsealTransactions.size();
+    auto drift = indexSize > unsealedSize ? indexSize - unsealedSize : unsealedSize - indexSize;
+    if (drift <= MIN_UNSEALED_INDEX_DRIFT + unsealedSize / 4)
+    {
+        return;
+    }
+
+    // drop the entries whose tx has been sealed or removed, then re-index the unsealed txs which
+    // are missing from the index
+    std::erase_if(m_unsealedIndex, [this](const auto& entry) {
+        const auto& tx = entry.second;
+        TxsMap::ReadAccessor accessor;
+        return tx->sealed() ||
+               !m_bcosTransactions.unsealTransactions.find<TxsMap::ReadAccessor>(
+                   accessor, tx->hash()) ||
+               accessor.value() != tx;
+    });
+    for (auto& accessor : m_bcosTransactions.unsealTransactions.range<TxsMap::ReadAccessor>())
+    {
+        const auto& tx = accessor.value();
+        if (!tx->sealed())
+        {
+            m_unsealedIndex.try_emplace(UnsealedIndexKey{tx->importTime(), tx->hash()}, tx);
+        }
+    }
+    TXPOOL_LOG(DEBUG) << LOG_DESC("compactUnsealedIndex") << LOG_KV("indexSizeBefore", indexSize)
+                      << LOG_KV("indexSize", m_unsealedIndex.size())
+                      << LOG_KV("unsealedSize", unsealedSize);
+}
+
 void MemoryStorage::cleanUpExpiredTransactions()
 {
     m_cleanUpTimer->restart();
+    compactUnsealedIndex();
     // Note: In order to minimize the impact of cleanUp on performance,
     // the normal consensus node does not clear expired txs in m_clearUpTimer, but clears
     // expired txs in the process of sealing txs
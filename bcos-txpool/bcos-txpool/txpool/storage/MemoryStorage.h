@@ -30,6 +30,11 @@
 #include <bcos-utilities/FixedBytes.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Timer.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <range/v3/range/concepts.hpp>
+#include <tuple>
 
 namespace bcos::txpool
 {
@@ -51,6 +56,10 @@ public:
         protocol::Transaction::Ptr transaction, bool waitForReceipt) override;
     std::vector<protocol::Transaction::ConstPtr> getTransactions(
         crypto::HashListView hashes) override;
+    std::vector<protocol::Transaction::ConstPtr> getTransactionsByShortIDs(
+        uint64_t _salt, std::span<const ShortTxID> _shortIDs) override;
+    std::vector<protocol::Transaction::ConstPtr> matchShortTxIDs(
+        uint64_t _salt, std::span<const ShortTxID> _shortIDs) override;
 
     // invoke when scheduler finished block executed and notify txpool new block result
     void batchRemoveSealedTxs(bcos::protocol::BlockNumber _batchId,
@@ -81,6 +90,8 @@ public:
     bool batchVerifyAndSubmitTransaction(bcos::protocol::BlockHeader::ConstPtr _header,
         bcos::protocol::TransactionsPtr _txs) override;
     void batchImportTxs(bcos::protocol::TransactionsPtr _txs) override;
+    std::vector<bcos::protocol::TransactionStatus> batchVerifyAndSubmitTransactions(
+        std::span<const protocol::Transaction::Ptr> transactions, bool checkPoolLimit) override;
 
     // return true if all txs have been marked
     bool batchMarkTxs(crypto::HashListView _txsHashList, bcos::protocol::BlockNumber _batchId,
@@ -99,6 +110,11 @@ protected:
 
     bcos::protocol::TransactionStatus enforceSubmitTransaction(
         bcos::protocol::Transaction::Ptr _tx);
+    // run all the checks of verifyAndSubmitTransaction that do not modify the txpool
+    bcos::protocol::TransactionStatus verifyTransaction(
+        const bcos::protocol::Transaction::Ptr& transaction,
+        protocol::TxSubmitCallback& txSubmitCallback, bool checkPoolLimit);
+    bcos::protocol::TransactionStatus reserveNonce(const bcos::protocol::Transaction& transaction);
     bcos::protocol::TransactionStatus txpoolStorageCheck(
         const bcos::protocol::Transaction& transaction,
         protocol::TxSubmitCallback& txSubmitCallback);
@@ -111,6 +127,23 @@ protected:
     void removeInvalidTxs(std::span<bcos::protocol::Transaction::Ptr> txs);
     virtual void cleanUpExpiredTransactions();
 
+    // Add txs that entered unsealTransactions to the sealing index, must be called without
+    // holding any bucket lock of unsealTransactions
+    void indexUnsealedTxs(::ranges::input_range auto&& txs)
+    {
+        std::unique_lock lock(m_unsealedIndexMutex);
+        for (const bcos::protocol::Transaction::Ptr& tx : txs)
+        {
+            m_unsealedIndex.insert_or_assign(UnsealedIndexKey{tx->importTime(), tx->hash()}, tx);
+        }
+    }
+    void compactUnsealedIndex();
+
+    // the sealed txs by their short id under _salt, a short id matching more than one tx maps to
+    // nullptr
+    using ShortIDIndex = std::unordered_map<ShortTxID, bcos::protocol::Transaction::Ptr>;
+    std::shared_ptr<const ShortIDIndex> shortIDIndex(uint64_t _salt);
+
     void printPendingTxs() override;
 
     TxPoolConfig::Ptr m_config;
@@ -135,6 +168,17 @@ protected:
     std::shared_ptr<Timer> m_cleanUpTimer;
     // timer to notify txs size
     std::shared_ptr<Timer> m_txsSizeNotifierTimer;
-    bcos::crypto::HashType m_knownLatestSealedTxHash;
+
+    // Unsealed txs ordered by import time, sealing pops from the front and entries whose tx
+    // has been sealed or removed in the meantime are dropped lazily when reached
+    using UnsealedIndexKey = std::tuple<int64_t, bcos::crypto::HashType>;
+    std::map<UnsealedIndexKey, bcos::protocol::Transaction::Ptr> m_unsealedIndex;
+    std::mutex m_unsealedIndexMutex;
+
+    // the short id indexes of the latest proposals, most recently used first, the followers
+    // missing txs of the same proposal share one index
+    constexpr static size_t MAX_SHORT_ID_INDEXES = 4;
+    std::list<std::pair<uint64_t, std::shared_ptr<const ShortIDIndex>>> m_shortIDIndexes;
+    std::mutex m_shortIDIndexesMutex;
 };
 }  // namespace bcos::txpool
\ No newline at end of file
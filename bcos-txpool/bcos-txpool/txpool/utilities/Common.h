@@ -34,6 +34,9 @@ static constexpr const uint64_t TX_DEFAULT_EXPIRATION_TIME = uint64_t(60 * 10 *
 // The limit set here is to minimize the impact of the cleanup operation on txpool performance
 static constexpr const uint64_t MAX_TRAVERSE_TXS_COUNT = 10000;
 static constexpr const size_t MAX_RETRY_NOTIFY_TIME = 3;
+// The sealing index is only rebuilt by m_cleanUpTimer once its size drifts from the number of
+// unsealed txs by more than this count plus a quarter of the unsealed txs
+static constexpr const size_t MIN_UNSEALED_INDEX_DRIFT = 1024;
 static constexpr const size_t DEFAULT_POOL_LIMIT = 15000;
 static constexpr const int64_t DEFAULT_BLOCK_LIMIT = 600;
 static constexpr const uint64_t DEFAULT_WEB3_NONCE_CHECK_LIMIT = DEFAULT_BLOCK_LIMIT * 1000;
@@ -8,6 +8,7 @@
 #include "bcos-crypto/signature/secp256k1/Secp256k1Crypto.h"
 #include "bcos-framework/ledger/LedgerInterface.h"
 #include "bcos-framework/txpool/Constant.h"
+#include "bcos-framework/txpool/ShortTxID.h"
 #include "bcos-protocol/TransactionSubmitResultFactoryImpl.h"
 #include "bcos-protocol/TransactionSubmitResultImpl.h"
 #include "bcos-tars-protocol/protocol/BlockFactoryImpl.h"
@@ -42,6 +43,55 @@ using namespace bcos::txpool;
 using namespace bcos::protocol;
 using namespace bcos::crypto;
 
+// Thread-safe validator for the paths verifying txs in parallel, fakeit mocks record every
+// invocation without locking
+class RejectNonceValidator : public bcos::txpool::TxValidatorInterface
+{
+public:
+    explicit RejectNonceValidator(std::string rejectNonce) : m_rejectNonce(std::move(rejectNonce))
+    {}
+
+    TransactionStatus verify(Transaction& /*_tx*/) override { return TransactionStatus::None; }
+    TransactionStatus checkTransaction(const Transaction& /*_tx*/, bool /*_onlyLedger*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkLedgerNonceAndBlockLimit(const Transaction& /*_tx*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkTxpoolNonce(const Transaction& /*_tx*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkWeb3Nonce(const Transaction& /*_tx*/, bool /*_onlyLedger*/) override
+    {
+        return TransactionStatus::None;
+    }
+    LedgerNonceChecker::Ptr ledgerNonceChecker() override { return nullptr; }
+    Web3NonceChecker::Ptr web3NonceChecker() override { return m_web3NonceChecker; }
+    void setLedgerNonceChecker(LedgerNonceChecker::Ptr /*_ledgerNonceChecker*/) override {}
+    TransactionStatus validateTransaction(const Transaction& _tx) override
+    {
+        return _tx.nonce() == m_rejectNonce ? TransactionStatus::OverFlowValue :
+                                              TransactionStatus::None;
+    }
+    task::Task<TransactionStatus> validateBalance(const Transaction& /*_tx*/,
+        std::shared_ptr<bcos::ledger::LedgerInterface> /*_ledger*/) override
+    {
+        co_return TransactionStatus::None;
+    }
+    task::Task<TransactionStatus> validateChainId(const Transaction& /*_tx*/,
+        std::shared_ptr<bcos::ledger::LedgerInterface> /*_ledger*/) override
+    {
+        co_return TransactionStatus::None;
+    }
+
+private:
+    std::string m_rejectNonce;
+    Web3NonceChecker::Ptr m_web3NonceChecker = std::make_shared<Web3NonceChecker>(nullptr);
+};
+
 struct MemoryStorageFixture
 {
     MemoryStorageFixture()
@@ -171,6 +221,85 @@ BOOST_AUTO_TEST_CASE(FilterUnknownAndBatchExists)
     BOOST_CHECK_EQUAL(storage.batchExists(allHave), true);
 }
 
+BOOST_AUTO_TEST_CASE(GetTransactionsByShortIDs)
+{
+    auto tx1 = makeTx("c1", false);
+    auto tx2 = makeTx("c2", true);
+    storage.insert(tx1);
+    storage.insert(tx2);
+
+    HashType missing{};  // all zeros, non-existent
+    HashList requested{tx1->hash(), missing, tx2->hash()};
+    uint64_t salt = 0x5a5a5a5a12345678ULL;
+    auto encoded = encodeShortTxIDs(salt, requested);
+    BOOST_CHECK_EQUAL(encoded.size(), SHORT_TXID_SALT_SIZE + 3 * SHORT_TXID_SIZE);
+
+    bytesConstRef data(encoded.data(), encoded.size());
+    uint64_t decodedSalt = 0;
+    std::vector<ShortTxID> shortIDs;
+    BOOST_REQUIRE(decodeShortTxIDs(data, decodedSalt, shortIDs));
+    BOOST_CHECK_EQUAL(decodedSalt, salt);
+    BOOST_CHECK_EQUAL(shortIDs.size(), 3U);
+    BOOST_CHECK_EQUAL(shortIDs[0], shortTxID(salt, tx1->hash()));
+    // the ids change with the salt
+    BOOST_CHECK_NE(shortIDs[0], shortTxID(salt + 1, tx1->hash()));
+    // truncated short id
+    BOOST_CHECK(
+        !decodeShortTxIDs(data.getCroppedData(0, data.size() - 1), decodedSalt, shortIDs));
+
+    // only the sealed txs are matched, the missing one is left out
+    BOOST_REQUIRE(decodeShortTxIDs(data, decodedSalt, shortIDs));
+    auto txs = storage.getTransactionsByShortIDs(decodedSalt, shortIDs);
+    BOOST_REQUIRE_EQUAL(txs.size(), 1U);
+    BOOST_CHECK_EQUAL(txs[0]->hash(), tx2->hash());
+    // a repeated short id is answered once
+    std::vector<ShortTxID> repeated{shortIDs[2], shortIDs[2]};
+    BOOST_CHECK_EQUAL(storage.getTransactionsByShortIDs(salt, repeated).size(), 1U);
+
+    // the salt of a proposal is its hash
+    BOOST_CHECK_EQUAL(shortTxIDSalt(tx1->hash()), shortTxIDSalt(tx1->hash()));
+    BOOST_CHECK_NE(shortTxIDSalt(tx1->hash()), shortTxIDSalt(tx2->hash()));
+
+    // the index of a salt is built from the txs sealed when it is first requested
+    HashType batchHash{};
+    HashList toSeal{tx1->hash()};
+    BOOST_REQUIRE(storage.batchMarkTxs(toSeal, 1, batchHash, true));
+    BOOST_CHECK_EQUAL(storage.getTransactionsByShortIDs(salt, shortIDs).size(), 1U);
+    auto newSalt = salt + 1;
+    std::vector<ShortTxID> newShortIDs{
+        shortTxID(newSalt, tx1->hash()), shortTxID(newSalt, tx2->hash())};
+    BOOST_CHECK_EQUAL(storage.getTransactionsByShortIDs(newSalt, newShortIDs).size(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE(MatchShortTxIDs)
+{
+    auto tx1 = makeTx("p1", false);
+    auto tx2 = makeTx("p2", true);
+    storage.insert(tx1);
+    storage.insert(tx2);
+
+    HashType missing{};  // all zeros, non-existent
+    uint64_t salt = 0x1234567812345678ULL;
+    std::vector<ShortTxID> shortIDs{
+        shortTxID(salt, tx2->hash()), shortTxID(salt, missing), shortTxID(salt, tx1->hash())};
+    // the sealed and the unsealed txs are matched in the order of the proposal
+    auto txs = storage.matchShortTxIDs(salt, shortIDs);
+    BOOST_REQUIRE_EQUAL(txs.size(), 3U);
+    BOOST_REQUIRE(txs[0]);
+    BOOST_CHECK_EQUAL(txs[0]->hash(), tx2->hash());
+    BOOST_CHECK(!txs[1]);
+    BOOST_REQUIRE(txs[2]);
+    BOOST_CHECK_EQUAL(txs[2]->hash(), tx1->hash());
+
+    // a short id listed twice is left unmatched at both positions
+    std::vector<ShortTxID> repeated{shortIDs[0], shortIDs[2], shortIDs[0]};
+    txs = storage.matchShortTxIDs(salt, repeated);
+    BOOST_REQUIRE_EQUAL(txs.size(), 3U);
+    BOOST_CHECK(!txs[0]);
+    BOOST_CHECK(txs[1]);
+    BOOST_CHECK(!txs[2]);
+}
+
 BOOST_AUTO_TEST_CASE(BatchMarkSealAndUnseal)
 {
     // Insert 3 unsealed transactions first
@@ -973,10 +1102,10 @@ BOOST_AUTO_TEST_CASE(FIB50_NonceNotInsertedOnValidationFailure)
 
 BOOST_AUTO_TEST_CASE(FIB65_SealAtIndex0UpdatesKnownHash)
 {
-    // FIB-65: batchMarkTxs must update m_knownLatestSealedTxHash even when the sealed
-    // transaction is at index 0 of the hash list. The old code used `> 0` which skipped
-    // index 0, leaving m_knownLatestSealedTxHash stale and causing batchSealTransactions
-    // to start from the wrong position on subsequent calls.
+    // FIB-65: sealing the tx at index 0 of the hash list through batchMarkTxs must not make
+    // batchSealTransactions miss the txs imported after it. The position sealing resumes from
+    // used to be a hash recorded by batchMarkTxs, it is now the unsealed index ordered by import
+    // time, which batchMarkTxs keeps up to date.
 
     // Provide a real BlockFactory so batchSealTransactions can create TransactionMetaData
     auto hashImpl = std::make_shared<Keccak256>();
@@ -1007,13 +1136,13 @@ BOOST_AUTO_TEST_CASE(FIB65_SealAtIndex0UpdatesKnownHash)
     storage.insert(tx2);
     BOOST_CHECK(!tx2->sealed());
 
-    // Step 3: batchSealTransactions must find tx2 regardless of m_knownLatestSealedTxHash
+    // Step 3: batchSealTransactions must find tx2 at the front of the unsealed index
     std::vector<protocol::TransactionMetaData::Ptr> txsList;
     std::vector<protocol::TransactionMetaData::Ptr> sysTxsList;
     bool result = storage.batchSealTransactions(txsList, sysTxsList, /*limit*/ 100);
     BOOST_CHECK(result);
 
-    // tx2 must be in the output (the fix ensures rangeByKey starts from the correct position)
+    // tx2 must be in the output, tx1 is skipped as a stale entry of the unsealed index
     bool foundTx2 = false;
     for (auto& meta : txsList)
     {
@@ -1174,4 +1303,100 @@ BOOST_AUTO_TEST_CASE(TimeoutCleanupNotifiesResultWithEmptyReceipt)
     BOOST_CHECK(receipt->output().empty());
 }
 
+BOOST_AUTO_TEST_CASE(SealInImportOrderWithLimit)
+{
+    // batchSealTransactions pops exactly _txsLimit txs from the import-time ordered index,
+    // skipping the entries whose tx was removed or sealed by another path in the meantime
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto blockHeaderFactory =
+        std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite);
+    auto txFactory = std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite);
+    auto receiptFactory =
+        std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite);
+    auto blockFactory = std::make_shared<bcostars::protocol::BlockFactoryImpl>(
+        cryptoSuite, blockHeaderFactory, txFactory, receiptFactory);
+    config->setBlockFactory(blockFactory);
+
+    constexpr static size_t TX_COUNT = 20;
+    auto now = static_cast<int64_t>(utcTime());
+    std::vector<bcostars::protocol::TransactionImpl::Ptr> txs;
+    for (size_t i = 0; i < TX_COUNT; ++i)
+    {
+        auto tx = makeTx("seal_order_" + std::to_string(i), false);
+        tx->setImportTime(now + static_cast<int64_t>(i));
+        txs.emplace_back(std::move(tx));
+    }
+    // insert in reverse order, sealing must follow the import time instead
+    for (auto it = txs.rbegin(); it != txs.rend(); ++it)
+    {
+        BOOST_CHECK(storage.insert(*it) == TransactionStatus::None);
+    }
+
+    storage.remove(txs[0]->hash());
+    HashList toSeal{txs[1]->hash()};
+    BOOST_CHECK(storage.batchMarkTxs(toSeal, 1, HashType::generateRandomFixedBytes(), true));
+
+    std::vector<protocol::TransactionMetaData::Ptr> txsList;
+    std::vector<protocol::TransactionMetaData::Ptr> sysTxsList;
+    BOOST_CHECK(storage.batchSealTransactions(txsList, sysTxsList, 5));
+    BOOST_REQUIRE_EQUAL(txsList.size(), 5U);
+    for (size_t i = 0; i < txsList.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(txsList[i]->hash(), txs[i + 2]->hash());
+        BOOST_CHECK(txs[i + 2]->sealed());
+    }
+    BOOST_CHECK(!txs[7]->sealed());
+    BOOST_CHECK_EQUAL(storage.size(), TX_COUNT - 1);
+
+    // an unsealed tx goes back to the index at its import time position
+    HashList toUnseal{txs[3]->hash()};
+    BOOST_CHECK(storage.batchMarkTxs(toUnseal, -1, HashType(), false));
+    BOOST_CHECK(!txs[3]->sealed());
+
+    txsList.clear();
+    BOOST_CHECK(storage.batchSealTransactions(txsList, sysTxsList, 3));
+    BOOST_REQUIRE_EQUAL(txsList.size(), 3U);
+    BOOST_CHECK_EQUAL(txsList[0]->hash(), txs[3]->hash());
+    BOOST_CHECK_EQUAL(txsList[1]->hash(), txs[7]->hash());
+    BOOST_CHECK_EQUAL(txsList[2]->hash(), txs[8]->hash());
+    BOOST_CHECK(sysTxsList.empty());
+}
+
+BOOST_AUTO_TEST_CASE(BatchVerifyAndSubmitTransactions)
+{
+    auto nonceChecker = std::make_shared<TxPoolNonceChecker>();
+    auto cfg = std::make_shared<TxPoolConfig>(std::make_shared<RejectNonceValidator>("batch_bad"),
+        nullptr, nullptr, nullptr, nonceChecker, 1000, /*poolLimit*/ 3, /*checkSig=*/true);
+    auto stor = std::make_shared<MemoryStorage>(cfg);
+
+    auto existingTx = makeTx("batch_existing", false);
+    BOOST_CHECK(stor->insert(existingTx) == TransactionStatus::None);
+
+    auto goodTx1 = makeTx("batch_good1", false);
+    auto goodTx2 = makeTx("batch_good2", false);
+    auto goodTx3 = makeTx("batch_good3", false);
+    std::vector<Transaction::Ptr> txs{goodTx1, makeTx("batch_bad", false),
+        makeTx("batch_good1", false), existingTx, goodTx2, goodTx3};
+    auto results = stor->batchVerifyAndSubmitTransactions(txs, true);
+
+    BOOST_REQUIRE_EQUAL(results.size(), txs.size());
+    BOOST_CHECK_EQUAL(results[0], TransactionStatus::None);
+    BOOST_CHECK_EQUAL(results[1], TransactionStatus::OverFlowValue);
+    // the same nonce inside one batch is only accepted once
+    BOOST_CHECK_EQUAL(results[2], TransactionStatus::NonceCheckFail);
+    BOOST_CHECK_EQUAL(results[3], TransactionStatus::AlreadyInTxPool);
+    BOOST_CHECK_EQUAL(results[4], TransactionStatus::None);
+    // the pool is full after existingTx, goodTx1 and goodTx2
+    BOOST_CHECK_EQUAL(results[5], TransactionStatus::TxPoolIsFull);
+    BOOST_CHECK(!nonceChecker->exists("batch_good3"));
+
+    BOOST_CHECK_EQUAL(stor->size(), 3U);
+    BOOST_CHECK(stor->exists(goodTx1->hash()));
+    BOOST_CHECK(stor->exists(goodTx2->hash()));
+    BOOST_CHECK(!stor->exists(goodTx3->hash()));
+    BOOST_CHECK_GT(goodTx1->importTime(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
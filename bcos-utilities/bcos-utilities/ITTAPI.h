@@ -80,6 +80,7 @@ struct ITT_DOMAINS
     const __itt_domain* STORAGE2 = __itt_domain_create("storage2");
     __itt_string_handle* MERGE_BACKEND = __itt_string_handle_create("mergeBackend");
     __itt_string_handle* MERGE_CACHE = __itt_string_handle_create("mergeCache");
+    __itt_string_handle* COMPACT_LAYERS = __itt_string_handle_create("compactLayers");
 
     const __itt_domain* BASELINE_SCHEDULER = __itt_domain_create("baselineScheduler");
     __itt_string_handle* GET_TRANSACTIONS = __itt_string_handle_create("getTransactions");
@@ -116,6 +117,12 @@ struct ITT_DOMAINS
     __itt_string_handle* MERGE_CHUNK = __itt_string_handle_create("mergeChunk");
     __itt_string_handle* MERGE_LAST_CHUNK = __itt_string_handle_create("mergeLastChunk");
 
+    const __itt_domain* BLOCK_STM_SCHEDULER = __itt_domain_create("blockSTMScheduler");
+    __itt_string_handle* BLOCK_STM_EXECUTE = __itt_string_handle_create("blockSTMExecute");
+    __itt_string_handle* EXECUTE_INCARNATION = __itt_string_handle_create("executeIncarnation");
+    __itt_string_handle* VALIDATE_TRANSACTION = __itt_string_handle_create("validateTransaction");
+    __itt_string_handle* MERGE_WRITE_SETS = __itt_string_handle_create("mergeWriteSets");
+
     const __itt_domain* TRANSACTION = __itt_domain_create("transaction");
     __itt_string_handle* VERIFY_TRANSACTION = __itt_string_handle_create("verifyTransaction");
 };
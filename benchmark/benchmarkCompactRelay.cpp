@@ -0,0 +1,193 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-framework/txpool/ShortTxID.h"
+#include "bcos-protocol/TransactionSubmitResultFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-txpool/sync/utilities/Common.h"
+#include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include "bcos-txpool/txpool/validator/TxPoolNonceChecker.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <unordered_set>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+constexpr static int64_t PROPOSAL_SIZE = 1000;
+constexpr static int64_t POOL_NOISE_SIZE = 10000;
+
+// The leader seals a proposal of PROPOSAL_SIZE txs out of its pool, the follower's pool holds
+// overlap percent of them, and both pools hold POOL_NOISE_SIZE txs the other doesn't know
+struct RelayFixture
+{
+    explicit RelayFixture(int64_t overlap) : leader(createStorage()), follower(createStorage())
+    {
+        for (int64_t i = 0; i < PROPOSAL_SIZE; ++i)
+        {
+            auto tx = createTx(fmt::format("proposal-{}", i), true);
+            proposal.emplace_back(tx->hash());
+            leader->insert(tx);
+            if (i * 100 < overlap * PROPOSAL_SIZE)
+            {
+                follower->insert(createTx(fmt::format("proposal-{}", i), false));
+            }
+        }
+        for (int64_t i = 0; i < POOL_NOISE_SIZE; ++i)
+        {
+            leader->insert(createTx(fmt::format("leader-{}", i), false));
+            follower->insert(createTx(fmt::format("follower-{}", i), false));
+        }
+    }
+
+    static std::shared_ptr<MemoryStorage> createStorage()
+    {
+        auto config = std::make_shared<TxPoolConfig>(nullptr,
+            std::make_shared<TransactionSubmitResultFactoryImpl>(), nullptr, nullptr,
+            std::make_shared<TxPoolNonceChecker>(), 0, PROPOSAL_SIZE + POOL_NOISE_SIZE, false);
+        return std::make_shared<MemoryStorage>(config);
+    }
+
+    static Transaction::Ptr createTx(std::string nonce, bool sealed)
+    {
+        crypto::Keccak256 keccak;
+        auto tx = std::make_shared<bcostars::protocol::TransactionImpl>();
+        tx->setNonce(std::move(nonce));
+        tx->calculateHash(keccak);
+        tx->setSealed(sealed);
+        return tx;
+    }
+
+    std::shared_ptr<MemoryStorage> leader;
+    std::shared_ptr<MemoryStorage> follower;
+    crypto::HashList proposal;
+};
+
+// Before: the proposal carries the full hashes, the follower requests the missed ones by hash
+static void hashProposal(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0));
+    size_t wireBytes = 0;
+    for (auto const& it : state)
+    {
+        auto missedTxs = fixture.follower->filterUnknownTxs(fixture.proposal, nullptr);
+        auto fetchedTxs = fixture.leader->getTransactions(missedTxs);
+        benchmark::DoNotOptimize(fetchedTxs);
+        wireBytes = (fixture.proposal.size() + missedTxs.size()) * crypto::HashType::SIZE;
+    }
+    state.counters["wireBytes"] = benchmark::Counter(wireBytes);
+    state.SetItemsProcessed(state.iterations() * PROPOSAL_SIZE);
+}
+
+// The follower still receives the full hashes, but requests the missed txs by the short ids
+// salted with the proposal hash, and the unmatched ones by hash in a second exchange, below
+// MIN_COMPACT_REQUEST_TXS missed txs it requests them by hash. A cold cache makes the leader
+// index its sealed txs on every request, as for the first follower asking about a proposal
+static void compactRequest(benchmark::State& state, bool _coldCache)
+{
+    RelayFixture fixture(state.range(0));
+    auto salt = shortTxIDSalt(fixture.proposal.front());
+    size_t wireBytes = 0;
+    size_t exchanges = 0;
+    for (auto const& it : state)
+    {
+        auto missedTxs = fixture.follower->filterUnknownTxs(fixture.proposal, nullptr);
+        wireBytes = fixture.proposal.size() * crypto::HashType::SIZE;
+        exchanges = 0;
+        if (missedTxs.empty())
+        {
+            continue;
+        }
+        if (missedTxs.size() < sync::MIN_COMPACT_REQUEST_TXS)
+        {
+            auto fetchedTxs = fixture.leader->getTransactions(missedTxs);
+            benchmark::DoNotOptimize(fetchedTxs);
+            wireBytes += missedTxs.size() * crypto::HashType::SIZE;
+            exchanges = 1;
+            continue;
+        }
+        if (_coldCache)
+        {
+            ++salt;
+        }
+        auto request = encodeShortTxIDs(salt, missedTxs);
+        uint64_t decodedSalt = 0;
+        std::vector<ShortTxID> shortIDs;
+        decodeShortTxIDs(bytesConstRef(request.data(), request.size()), decodedSalt, shortIDs);
+        auto fetchedTxs = fixture.leader->getTransactionsByShortIDs(decodedSalt, shortIDs);
+        benchmark::DoNotOptimize(fetchedTxs);
+        wireBytes += request.size();
+        exchanges = 1;
+
+        std::unordered_set<crypto::HashType> fetched;
+        for (auto const& tx : fetchedTxs)
+        {
+            fetched.insert(tx->hash());
+        }
+        crypto::HashList unmatched;
+        for (auto const& hash : missedTxs)
+        {
+            if (!fetched.contains(hash))
+            {
+                unmatched.emplace_back(hash);
+            }
+        }
+        if (!unmatched.empty())
+        {
+            auto unmatchedTxs = fixture.leader->getTransactions(unmatched);
+            benchmark::DoNotOptimize(unmatchedTxs);
+            wireBytes += unmatched.size() * crypto::HashType::SIZE;
+            ++exchanges;
+        }
+    }
+    state.counters["wireBytes"] = benchmark::Counter(wireBytes);
+    state.counters["exchanges"] = benchmark::Counter(exchanges);
+    state.SetItemsProcessed(state.iterations() * PROPOSAL_SIZE);
+}
+
+// The proposal carries the salt and the short ids of its txs, the follower matches them against
+// its whole pool and fetches the unmatched ones by short id from the leader in one exchange
+static void compactProposal(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0));
+    auto salt = shortTxIDSalt(fixture.proposal.front());
+    size_t wireBytes = 0;
+    size_t exchanges = 0;
+    for (auto const& it : state)
+    {
+        auto relayed = encodeShortTxIDs(salt, fixture.proposal);
+        uint64_t decodedSalt = 0;
+        std::vector<ShortTxID> shortIDs;
+        decodeShortTxIDs(bytesConstRef(relayed.data(), relayed.size()), decodedSalt, shortIDs);
+        auto matchedTxs = fixture.follower->matchShortTxIDs(decodedSalt, shortIDs);
+        wireBytes = relayed.size();
+        exchanges = 0;
+
+        std::vector<ShortTxID> unmatched;
+        for (size_t i = 0; i < shortIDs.size(); ++i)
+        {
+            if (!matchedTxs[i])
+            {
+                unmatched.emplace_back(shortIDs[i]);
+            }
+        }
+        if (!unmatched.empty())
+        {
+            auto request = encodeShortTxIDs(decodedSalt, unmatched);
+            auto fetchedTxs = fixture.leader->getTransactionsByShortIDs(decodedSalt, unmatched);
+            benchmark::DoNotOptimize(fetchedTxs);
+            wireBytes += request.size();
+            exchanges = 1;
+        }
+        benchmark::DoNotOptimize(matchedTxs);
+    }
+    state.counters["wireBytes"] = benchmark::Counter(wireBytes);
+    state.counters["exchanges"] = benchmark::Counter(exchanges);
+    state.SetItemsProcessed(state.iterations() * PROPOSAL_SIZE);
+}
+
+BENCHMARK(hashProposal)->Arg(100)->Arg(99)->Arg(90)->Arg(50)->Arg(0);
+BENCHMARK_CAPTURE(compactRequest, cached, false)->Arg(100)->Arg(99)->Arg(90)->Arg(50)->Arg(0);
+BENCHMARK_CAPTURE(compactRequest, cold, true)->Arg(100)->Arg(99)->Arg(90)->Arg(50)->Arg(0);
+BENCHMARK(compactProposal)->Arg(100)->Arg(99)->Arg(90)->Arg(50)->Arg(0);
+
+BENCHMARK_MAIN();
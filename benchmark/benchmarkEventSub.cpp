@@ -0,0 +1,127 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-rpc/event/EventSubMatcher.h"
+#include "bcos-tars-protocol/protocol/BlockImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptImpl.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace bcos;
+using namespace bcos::event;
+
+constexpr static size_t BLOCK_TXS = 1000;
+constexpr static size_t CONTRACTS = 50;
+constexpr static size_t EVENTS = 4;
+
+static std::string contractAddress(size_t index)
+{
+    return fmt::format("{:0>40x}", index + 1);
+}
+
+static h256 eventTopic(size_t index)
+{
+    return h256(index + 1);
+}
+
+// A block of BLOCK_TXS txs calling CONTRACTS contracts, each receipt holds two logs, and the
+// subscribers each following one contract, one event of any contract or everything
+struct EventSubFixture
+{
+    explicit EventSubFixture(size_t subscribers)
+    {
+        crypto::Keccak256 keccak;
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        for (size_t i = 0; i < BLOCK_TXS; ++i)
+        {
+            auto tx = std::make_shared<bcostars::protocol::TransactionImpl>();
+            tx->setNonce(std::to_string(i));
+            tx->calculateHash(keccak);
+            block->appendTransaction(tx);
+
+            auto address = contractAddress(i % CONTRACTS);
+            std::vector<protocol::LogEntry> logs;
+            for (size_t j = 0; j < 2; ++j)
+            {
+                logs.emplace_back(bytes(address.begin(), address.end()),
+                    h256s{eventTopic((i + j) % EVENTS), h256(i)}, bytes(64, 'd'));
+            }
+            auto receipt = std::make_shared<bcostars::protocol::TransactionReceiptImpl>();
+            receipt->setLogEntries(logs);
+            block->appendReceipt(receipt);
+        }
+        block->encode(encodedBlock);
+
+        for (size_t i = 0; i < subscribers; ++i)
+        {
+            auto params = std::make_shared<EventSubParams>();
+            switch (i % 10)
+            {
+            case 0:
+                break;
+            case 1:
+            case 2:
+                params->addTopic(0, eventTopic(i % EVENTS).hex());
+                break;
+            default:
+                params->addAddress(contractAddress(i % CONTRACTS));
+                params->addTopic(0, eventTopic(i % EVENTS).hex());
+                break;
+            }
+            subscriptions.emplace_back(std::move(params));
+        }
+    }
+
+    protocol::Block::Ptr decodeBlock() const
+    {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->decode(ref(encodedBlock), false, false);
+        return block;
+    }
+
+    bytes encodedBlock;
+    std::vector<EventSubParams::ConstPtr> subscriptions;
+    EventSubMatcher matcher;
+};
+
+// Before: every subscription fetches the block on its own and matches all the logs of the block
+static void perSubscription(benchmark::State& state)
+{
+    EventSubFixture fixture(state.range(0));
+    for (auto const& it : state)
+    {
+        for (auto const& params : fixture.subscriptions)
+        {
+            auto block = fixture.decodeBlock();
+            Json::Value result(Json::arrayValue);
+            fixture.matcher.matches(params, block, result);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.counters["subscriptionsPerSecond"] = benchmark::Counter(
+        state.iterations() * fixture.subscriptions.size(), benchmark::Counter::kIsRate);
+}
+
+// The subscriptions following the block share one fetch and one pass over the logs
+static void sharedCursor(benchmark::State& state)
+{
+    EventSubFixture fixture(state.range(0));
+    for (auto const& it : state)
+    {
+        auto block = fixture.decodeBlock();
+        EventSubIndex index;
+        for (size_t i = 0; i < fixture.subscriptions.size(); ++i)
+        {
+            index.add(i, fixture.subscriptions[i]);
+        }
+        std::vector<Json::Value> results;
+        fixture.matcher.matches(index, block, results);
+        benchmark::DoNotOptimize(results);
+    }
+    state.counters["subscriptionsPerSecond"] = benchmark::Counter(
+        state.iterations() * fixture.subscriptions.size(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(perSubscription)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(sharedCursor)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+#include "bcos-framework/gateway/GatewayTypeDef.h"
+#include "bcos-gateway/libnetwork/FrameBatch.h"
+#include "bcos-gateway/libp2p/P2PMessageV2.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace bcos;
+using namespace bcos::gateway;
+
+constexpr static size_t QUEUED_MESSAGES = 64;
+
+// the consensus and txs sync messages queued for one peer while the previous write is in flight
+static std::vector<P2PMessageV2::Ptr> makeMessages(size_t payloadSize)
+{
+    std::vector<P2PMessageV2::Ptr> messages;
+    for (size_t i = 0; i < QUEUED_MESSAGES; ++i)
+    {
+        bytes payload;
+        while (payload.size() < payloadSize)
+        {
+            auto line = fmt::format("view: {} index: {} hash: {:0>64}\n", i, i * 7919, i);
+            payload.insert(payload.end(), line.begin(), line.end());
+        }
+        payload.resize(payloadSize);
+
+        auto message = std::make_shared<P2PMessageV2>();
+        message->setVersion((uint16_t)(bcos::protocol::ProtocolVersion::V2));
+        message->setPacketType(GatewayMessageType::PeerToPeerMessage);
+        message->setSeq(i);
+        message->setSrcP2PNodeID(std::string(64, 'a'));
+        message->setDstP2PNodeID(std::string(64, 'b'));
+        message->setPayload(std::move(payload));
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+// Before: every message is sent as a frame of its own, compressed on its own when it is large
+// enough, and the receiver decodes the frames one by one
+static void plainFrames(benchmark::State& state)
+{
+    auto messages = makeMessages(state.range(0));
+    size_t wireBytes = 0;
+    for (auto const& it : state)
+    {
+        bytes buffer;
+        for (auto const& message : messages)
+        {
+            EncodedMessage encoded;
+            encoded.compress = true;
+            message->encode(encoded);
+            auto payload = encoded.payloadRef();
+            buffer.insert(buffer.end(), encoded.header.begin(), encoded.header.end());
+            buffer.insert(buffer.end(), payload.begin(), payload.end());
+        }
+        wireBytes = buffer.size();
+
+        auto data = ref(buffer);
+        while (!data.empty())
+        {
+            P2PMessageV2 message;
+            auto length = message.decode(data);
+            benchmark::DoNotOptimize(message);
+            data = data.getCroppedData(length);
+        }
+    }
+    state.counters["wireBytes"] = benchmark::Counter(wireBytes);
+    state.SetItemsProcessed(state.iterations() * QUEUED_MESSAGES);
+}
+
+// The queued messages are encoded uncompressed and coalesced into one frame batch compressed once
+static void frameBatch(benchmark::State& state)
+{
+    auto messages = makeMessages(state.range(0));
+    size_t wireBytes = 0;
+    for (auto const& it : state)
+    {
+        bytes frames;
+        for (auto const& message : messages)
+        {
+            EncodedMessage encoded;
+            encoded.compress = false;
+            message->encode(encoded);
+            auto payload = encoded.payloadRef();
+            frames.insert(frames.end(), encoded.header.begin(), encoded.header.end());
+            frames.insert(frames.end(), payload.begin(), payload.end());
+        }
+        auto batch = encodeFrameBatch(std::move(frames), true);
+        bytes buffer = std::move(batch.header);
+        buffer.insert(buffer.end(), batch.payload.begin(), batch.payload.end());
+        wireBytes = buffer.size();
+
+        bytes decoded;
+        std::vector<bytesConstRef> frameRefs;
+        decodeFrameBatch(ref(buffer), decoded, frameRefs);
+        for (auto frame : frameRefs)
+        {
+            P2PMessageV2 message;
+            message.decode(frame);
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.counters["wireBytes"] = benchmark::Counter(wireBytes);
+    state.SetItemsProcessed(state.iterations() * QUEUED_MESSAGES);
+}
+
+BENCHMARK(plainFrames)->Arg(128)->Arg(512)->Arg(1024)->Arg(4096);
+BENCHMARK(frameBatch)->Arg(128)->Arg(512)->Arg(1024)->Arg(4096);
+
+BENCHMARK_MAIN();
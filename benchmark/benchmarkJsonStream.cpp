@@ -0,0 +1,142 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h"
+#include "bcos-rpc/jsonrpc/JsonStreamWriter.h"
+#include "bcos-tars-protocol/protocol/BlockImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+// count the bytes allocated on the heap to report the peak memory of a response
+static std::atomic<size_t> g_allocatedBytes = 0;
+static std::atomic<size_t> g_peakBytes = 0;
+constexpr static size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    auto* memory = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER));
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(memory) = size;
+    auto allocated = g_allocatedBytes.fetch_add(size) + size;
+    auto peak = g_peakBytes.load();
+    while (allocated > peak && !g_peakBytes.compare_exchange_weak(peak, allocated))
+    {
+    }
+    return memory + ALLOCATION_HEADER;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    auto* memory = static_cast<char*>(pointer) - ALLOCATION_HEADER;
+    g_allocatedBytes.fetch_sub(*reinterpret_cast<size_t*>(memory));
+    std::free(memory);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+// a block of range(0) txs, as getBlockByNumber returns it with the full txs
+static protocol::Block::Ptr makeBlock(size_t txCount)
+{
+    crypto::Keccak256 keccak;
+    auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+    auto header = block->blockHeader();
+    header->setNumber(1);
+    header->setSealerList(std::vector<bytes>(4, bytes(64, 's')));
+    header->setConsensusWeights(std::vector<uint64_t>(4, 1));
+    for (size_t i = 0; i < txCount; ++i)
+    {
+        bcostars::Transaction inner;
+        inner.data.version = 1;
+        inner.data.chainID = "chain0";
+        inner.data.groupID = "group0";
+        inner.data.blockLimit = 500;
+        inner.data.nonce = fmt::format("{:0>64}", i);
+        inner.data.to = fmt::format("0x{:0>40x}", i % 100);
+        inner.data.input.assign(164, 'i');
+        inner.data.value = "0";
+        inner.data.gasPrice = "0";
+        inner.data.maxFeePerGas = "0";
+        inner.data.maxPriorityFeePerGas = "0";
+        inner.signature.assign(65, 's');
+        inner.sender.assign(20, 'f');
+        inner.importTime = 1700000000000 + i;
+        auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>();
+        transaction->setInner(std::move(inner));
+        transaction->calculateHash(keccak);
+        block->appendTransaction(std::move(transaction));
+    }
+    return block;
+}
+
+// Before: the Json::Value tree of the block is built, then serialized by jsoncpp
+static void jsonValue(benchmark::State& state)
+{
+    auto block = makeBlock(state.range(0));
+    size_t responseSize = 0;
+    size_t peakBytes = 0;
+    for (auto const& it : state)
+    {
+        auto base = g_allocatedBytes.load();
+        g_peakBytes = base;
+        JsonResponse response{};
+        response.jsonrpc = "2.0";
+        toJsonResp(response.result, *block, false);
+        auto buffer = toStringResponse(std::move(response));
+        responseSize = buffer.size();
+        peakBytes = g_peakBytes.load() - base;
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.counters["responseBytes"] = benchmark::Counter(responseSize);
+    state.counters["peakBytes"] = benchmark::Counter(peakBytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The block is written straight into the response buffer
+static void jsonStream(benchmark::State& state)
+{
+    auto block = makeBlock(state.range(0));
+    size_t responseSize = 0;
+    size_t peakBytes = 0;
+    for (auto const& it : state)
+    {
+        auto base = g_allocatedBytes.load();
+        g_peakBytes = base;
+        bcos::bytes buffer;
+        JsonStreamWriter writer(buffer);
+        writer.beginObject();
+        writer.key("id");
+        writer.value(int64_t(0));
+        writer.key("jsonrpc");
+        writer.value("2.0");
+        writer.key("result");
+        toJsonResp(writer, *block, false);
+        writer.endObject();
+        responseSize = buffer.size();
+        peakBytes = g_peakBytes.load() - base;
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.counters["responseBytes"] = benchmark::Counter(responseSize);
+    state.counters["peakBytes"] = benchmark::Counter(peakBytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(jsonValue)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(jsonStream)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-ledger/LogIndex.h"
+#include "bcos-table/src/StateStorage.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+constexpr static protocol::BlockNumber BLOCK_COUNT = 1000 * 1000;
+constexpr static size_t ADDRESS_COUNT = 1000;
+// one block in LOGGED_BLOCK_INTERVAL has a log
+constexpr static protocol::BlockNumber LOGGED_BLOCK_INTERVAL = 64;
+
+static std::string address(size_t index)
+{
+    return fmt::format("{:0>40x}", index);
+}
+
+static std::shared_ptr<storage::StateStorage> buildLedger(bool withSections)
+{
+    auto storage = std::make_shared<storage::StateStorage>(nullptr, false);
+    auto setRow = [&storage](std::string key, std::string value) {
+        storage::Entry entry;
+        entry.set(std::move(value));
+        storage->asyncSetRow(SYS_LOG_INDEX, key, std::move(entry), [](Error::UniquePtr) {});
+    };
+
+    std::vector<Bloom> blooms;
+    for (protocol::BlockNumber number = 0; number < BLOCK_COUNT; ++number)
+    {
+        Bloom bloom{};
+        if (number % LOGGED_BLOCK_INTERVAL == 0)
+        {
+            auto logAddress = address(number / LOGGED_BLOCK_INTERVAL % ADDRESS_COUNT);
+            bytesToBloom(bytesConstRef((const byte*)logAddress.data(), logAddress.size()), bloom);
+        }
+        setRow(log_index::blockKey(number), log_index::encodeBloom(bloom));
+        blooms.push_back(bloom);
+
+        if (withSections && blooms.size() == log_index::LOG_INDEX_SECTION_SIZE)
+        {
+            auto section = number / log_index::LOG_INDEX_SECTION_SIZE;
+            for (auto& [key, value] : log_index::buildSectionRows(section, blooms))
+            {
+                setRow(std::move(key), std::move(value));
+            }
+            blooms.clear();
+        }
+    }
+    return storage;
+}
+
+// Query one address over the last range(0) blocks of a synthetic 1M blocks ledger
+static void queryLogIndex(benchmark::State& state, bool withSections)
+{
+    static auto blockIndexedLedger = buildLedger(false);
+    static auto sectionIndexedLedger = buildLedger(true);
+    auto& storage = withSections ? *sectionIndexedLedger : *blockIndexedLedger;
+    auto query = log_index::makeQuery({address(7)}, {});
+
+    auto range = state.range(0);
+    size_t blocks = 0;
+    for (auto const& it : state)
+    {
+        auto candidates =
+            log_index::queryBlocks(storage, BLOCK_COUNT - range, BLOCK_COUNT - 1, *query);
+        blocks = candidates.size();
+        benchmark::DoNotOptimize(candidates);
+    }
+    state.counters["candidates"] = (double)blocks;
+    state.SetItemsProcessed(state.iterations() * range);
+}
+
+static void blockBloomQuery(benchmark::State& state)
+{
+    queryLogIndex(state, false);
+}
+
+static void sectionBitmapQuery(benchmark::State& state)
+{
+    queryLogIndex(state, true);
+}
+
+BENCHMARK(blockBloomQuery)->Arg(10 * 1000)->Arg(100 * 1000)->Arg(1000 * 1000);
+BENCHMARK(sectionBitmapQuery)->Arg(10 * 1000)->Arg(100 * 1000)->Arg(1000 * 1000);
+
+BENCHMARK_MAIN();
@@ -8,6 +8,7 @@
 #include <tbb/concurrent_map.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <boost/container_hash/hash_fwd.hpp>
+#include <random>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/zip.hpp>
 #include <variant>
@@ -45,12 +46,7 @@ struct Fixture
 
 void setCapacityForMRU(auto& storage)
 {
-    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(storage)>,
-                      MemoryStorage<Key, storage::Entry,
-                          memory_storage::Attribute(ORDERED | CONCURRENT | LRU)>> ||
-                  std::is_same_v<std::remove_cvref_t<decltype(storage)>,
-                      MemoryStorage<Key, storage::Entry,
-                          memory_storage::Attribute(CONCURRENT | LRU)>>)
+    if constexpr (std::remove_cvref_t<decltype(storage)>::withCapacity)
     {
         storage.setMaxCapacity(1000 * 1000 * 1000);
     }
@@ -61,7 +57,8 @@ std::variant<MemoryStorage<Key, storage::Entry, ORDERED>,
     MemoryStorage<Key, storage::Entry, ORDERED | CONCURRENT>,
     MemoryStorage<Key, storage::Entry, ORDERED | CONCURRENT | LRU>,
     MemoryStorage<Key, storage::Entry>, MemoryStorage<Key, storage::Entry, CONCURRENT>,
-    MemoryStorage<Key, storage::Entry, CONCURRENT | LRU>>
+    MemoryStorage<Key, storage::Entry, CONCURRENT | LRU>,
+    MemoryStorage<Key, storage::Entry, CONCURRENT | CLOCK>>
     allStorage;
 
 template <class Storage>
@@ -132,6 +129,58 @@ static void write(benchmark::State& state)
     }(state));
 }
 
+// A read-through cache holding a tenth of the keys: 90% of the reads go to a hot twentieth of
+// the keys, and after every HOT_READS reads a one-off scan reads a fifth of the keys, as blocks
+// that touch a few hot contracts and many accounts once
+template <class Storage>
+static void hitRatio(benchmark::State& state)
+{
+    constexpr static size_t HOT_READS = 20000;
+    auto count = state.range(0);
+    fixture.prepareData(count);
+    Storage storage;
+    storage.setMaxCapacity(
+        (Storage::getSize(fixture.allKeys[0]) + Storage::getSize(fixture.allValues[0])) * count /
+        10);
+
+    std::mt19937 random(0);
+    auto hotCount = std::max(count / 20, (int64_t)1);
+    std::vector<size_t> reads;
+    size_t scanCursor = 0;
+    while (reads.size() < 1000 * 1000)
+    {
+        for (size_t i = 0; i < HOT_READS; ++i)
+        {
+            reads.push_back(
+                random() % 10 == 0 ? random() % count : random() % hotCount);
+        }
+        for (auto i = 0; i < count / 5; ++i)
+        {
+            reads.push_back(scanCursor++ % count);
+        }
+    }
+
+    int64_t hits = 0;
+    size_t i = 0;
+    task::syncWait([&]() -> task::Task<void> {
+        for (auto const& it : state)
+        {
+            auto index = reads[i++ % reads.size()];
+            if (co_await storage2::readOne(storage, fixture.allKeys[index]))
+            {
+                ++hits;
+            }
+            else
+            {
+                co_await storage2::writeOne(
+                    storage, fixture.allKeys[index], fixture.allValues[index]);
+            }
+        }
+    }());
+    state.counters["hitRatio"] = (double)hits / (double)state.iterations();
+    state.SetItemsProcessed(state.iterations());
+}
+
 struct StateKeyHash
 {
     static size_t hash(const StateKey& key) { return std::hash<StateKey>{}(key); }
@@ -243,5 +292,16 @@ BENCHMARK(read<MemoryStorage<Key, storage::Entry, CONCURRENT | LRU>>)
     ->Arg(1000000)
     ->Threads(1)
     ->Threads(8);
+BENCHMARK(read<MemoryStorage<Key, storage::Entry, CONCURRENT | CLOCK>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+// every thread reads the same 100 hot keys
+BENCHMARK(read<MemoryStorage<Key, storage::Entry, CONCURRENT | LRU>>)->Arg(100)->Threads(8);
+BENCHMARK(read<MemoryStorage<Key, storage::Entry, CONCURRENT | CLOCK>>)->Arg(100)->Threads(8);
+
+BENCHMARK(hitRatio<MemoryStorage<Key, storage::Entry, CONCURRENT | LRU>>)->Arg(100000);
+BENCHMARK(hitRatio<MemoryStorage<Key, storage::Entry, CONCURRENT | CLOCK>>)->Arg(100000);
 
 BENCHMARK_MAIN();
\ No newline at end of file
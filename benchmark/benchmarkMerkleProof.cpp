@@ -0,0 +1,113 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-ledger/BlockMerkle.h"
+#include "bcos-table/src/StateStorage.h"
+#include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include <bcos-crypto/merkle/Merkle.h>
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <range/v3/view/transform.hpp>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+// A committed block with range(0) transactions, nothing of it is in the proof caches
+struct ColdBlock
+{
+    explicit ColdBlock(size_t txCount)
+      : cryptoSuite(std::make_shared<crypto::CryptoSuite>(
+            std::make_shared<crypto::Keccak256>(), nullptr, nullptr)),
+        txFactory(std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite)),
+        storage(std::make_shared<storage::StateStorage>(nullptr, false))
+    {
+        crypto::Keccak256 keccak;
+        std::vector<crypto::HashType> leaves;
+        for (size_t i = 0; i < txCount; ++i)
+        {
+            auto tx = std::make_shared<bcostars::protocol::TransactionImpl>();
+            tx->setNonce(fmt::format("proof-benchmark-{}", i));
+            tx->calculateHash(keccak);
+
+            bytes buffer;
+            tx->encode(buffer);
+            storage::Entry entry;
+            entry.importFields({std::move(buffer)});
+            auto hash = tx->hash();
+            txHashes.emplace_back((const char*)hash.data(), hash.size());
+            storage->asyncSetRow(
+                SYS_HASH_2_TX, txHashes.back(), std::move(entry), [](Error::UniquePtr) {});
+            leaves.push_back(hash);
+        }
+        target = leaves[txCount / 2];
+
+        storage::Entry merkleEntry;
+        merkleEntry.set(block_merkle::encodeMerkle(cryptoSuite->hashImpl()->hasher(), leaves));
+        storage->asyncSetRow(
+            SYS_NUMBER_2_TX_MERKLE, "1", std::move(merkleEntry), [](Error::UniquePtr) {});
+    }
+
+    crypto::CryptoSuite::Ptr cryptoSuite;
+    protocol::TransactionFactory::Ptr txFactory;
+    std::shared_ptr<storage::StateStorage> storage;
+    std::vector<std::string> txHashes;
+    crypto::HashType target;
+};
+
+// Load and decode every transaction of the block, then rebuild the merkle tree
+static void rebuildTxProof(benchmark::State& state)
+{
+    ColdBlock block(state.range(0));
+    for (auto const& it : state)
+    {
+        std::promise<std::vector<std::optional<storage::Entry>>> promise;
+        block.storage->asyncGetRows(SYS_HASH_2_TX, block.txHashes,
+            [&promise](Error::UniquePtr, std::vector<std::optional<storage::Entry>> entries) {
+                promise.set_value(std::move(entries));
+            });
+        auto entries = promise.get_future().get();
+        std::vector<protocol::Transaction::Ptr> transactions;
+        transactions.reserve(entries.size());
+        for (auto& entry : entries)
+        {
+            auto field = entry->getField(0);
+            transactions.push_back(block.txFactory->createTransaction(
+                bytesConstRef((const byte*)field.data(), field.size()), false, false, false));
+        }
+
+        crypto::merkle::Merkle merkle(block.cryptoSuite->hashImpl()->hasher());
+        auto hashes = transactions | ::ranges::views::transform([](auto const& transaction) {
+            return transaction->hash();
+        });
+        std::vector<crypto::HashType> merkleTree;
+        merkle.generateMerkle(hashes, merkleTree);
+        MerkleProof proof;
+        merkle.generateMerkleProof(hashes, merkleTree, block.target, proof);
+        benchmark::DoNotOptimize(proof);
+    }
+}
+
+// Read the merkle tree stored with the block
+static void storedTxProof(benchmark::State& state)
+{
+    ColdBlock block(state.range(0));
+    for (auto const& it : state)
+    {
+        std::promise<std::optional<storage::Entry>> promise;
+        block.storage->asyncGetRow(SYS_NUMBER_2_TX_MERKLE, "1",
+            [&promise](Error::UniquePtr, std::optional<storage::Entry> entry) {
+                promise.set_value(std::move(entry));
+            });
+        auto entry = promise.get_future().get();
+        auto proof = block_merkle::getMerkleProof(
+            block.cryptoSuite->hashImpl()->hasher(), entry->get(), block.target);
+        benchmark::DoNotOptimize(proof);
+    }
+}
+
+BENCHMARK(rebuildTxProof)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(storedTxProof)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-ledger/Ledger.h"
+#include "bcos-ledger/NonceIndex.h"
+#include "bcos-table/src/StateStorage.h"
+#include "bcos-tars-protocol/protocol/BlockFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+constexpr static size_t BLOCK_LIMIT = 1000;
+constexpr static size_t TXS_PER_BLOCK = 10000;
+
+// A ledger of BLOCK_LIMIT blocks of TXS_PER_BLOCK nonces, the window the nonce checker of the
+// txpool loads at startup
+struct NonceWindow
+{
+    explicit NonceWindow(bool nonceIndex)
+    {
+        auto cryptoSuite = std::make_shared<crypto::CryptoSuite>(
+            std::make_shared<crypto::Keccak256>(), nullptr, nullptr);
+        blockFactory = std::make_shared<bcostars::protocol::BlockFactoryImpl>(cryptoSuite,
+            std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite),
+            std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite),
+            std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite));
+        auto storage = std::make_shared<storage::StateStorage>(nullptr, false);
+        for (size_t number = 1; number <= BLOCK_LIMIT; ++number)
+        {
+            protocol::NonceList nonces;
+            nonces.reserve(TXS_PER_BLOCK);
+            for (size_t i = 0; i < TXS_PER_BLOCK; ++i)
+            {
+                nonces.emplace_back(fmt::format("{:0>32x}", number * TXS_PER_BLOCK + i));
+            }
+
+            storage::Entry entry;
+            if (nonceIndex)
+            {
+                entry.importFields({nonce_index::encodeNonces(nonces)});
+            }
+            else
+            {
+                // Before: the nonces were stored as a tars Block with only the nonce list
+                auto block = blockFactory->createBlock();
+                block->setNonceList(nonces);
+                bytes buffer;
+                block->encode(buffer);
+                entry.importFields({std::move(buffer)});
+            }
+            storage->asyncSetRow(SYS_BLOCK_NUMBER_2_NONCES, std::to_string(number),
+                std::move(entry), [](Error::UniquePtr) {});
+        }
+        ledger = std::make_shared<Ledger>(blockFactory, storage, BLOCK_LIMIT);
+    }
+
+    protocol::BlockFactory::Ptr blockFactory;
+    std::shared_ptr<Ledger> ledger;
+};
+
+static void loadNonceWindow(benchmark::State& state, bool nonceIndex)
+{
+    NonceWindow window(nonceIndex);
+    for (auto const& it : state)
+    {
+        std::promise<std::shared_ptr<std::map<protocol::BlockNumber, protocol::NonceListPtr>>>
+            promise;
+        window.ledger->asyncGetNonceList(
+            1, BLOCK_LIMIT - 1, [&promise](Error::Ptr, auto nonces) { promise.set_value(nonces); });
+        auto nonces = promise.get_future().get();
+        benchmark::DoNotOptimize(nonces);
+    }
+    state.SetItemsProcessed(state.iterations() * BLOCK_LIMIT * TXS_PER_BLOCK);
+}
+
+static void tarsBlockRows(benchmark::State& state)
+{
+    loadNonceWindow(state, false);
+}
+
+static void nonceIndexRows(benchmark::State& state)
+{
+    loadNonceWindow(state, true);
+}
+
+BENCHMARK(tarsBlockRows)->Unit(benchmark::kMillisecond)->Iterations(5);
+BENCHMARK(nonceIndexRows)->Unit(benchmark::kMillisecond)->Iterations(5);
+
+BENCHMARK_MAIN();
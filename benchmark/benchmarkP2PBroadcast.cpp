@@ -0,0 +1,70 @@
+#include "bcos-framework/gateway/GatewayTypeDef.h"
+#include "bcos-gateway/libp2p/P2PMessageV2.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace bcos;
+using namespace bcos::gateway;
+
+constexpr static size_t PAYLOAD_SIZE = 1024 * 1024;
+
+static P2PMessageV2::Ptr makeBroadcastMessage(bool sharePayload)
+{
+    bytes payload;
+    payload.reserve(PAYLOAD_SIZE);
+    for (size_t i = 0; payload.size() < PAYLOAD_SIZE; ++i)
+    {
+        auto line = fmt::format("transaction: {} nonce: {}\n", i, i * 7919);
+        payload.insert(payload.end(), line.begin(), line.end());
+    }
+
+    auto message = std::make_shared<P2PMessageV2>();
+    message->setVersion((uint16_t)(bcos::protocol::ProtocolVersion::V2));
+    message->setPacketType(GatewayMessageType::PeerToPeerMessage);
+    message->setSrcP2PNodeID(std::string(64, 'a'));
+    message->setPayload(std::move(payload));
+    message->setSharePayload(sharePayload);
+    return message;
+}
+
+// Encode one broadcast for every peer, each peer gets its own header with a different dst
+static void encodeBroadcast(benchmark::State& state, bool sharePayload)
+{
+    auto peerCount = state.range(0);
+    std::vector<std::string> peers;
+    for (auto i = 0; i < peerCount; ++i)
+    {
+        peers.emplace_back(fmt::format("{:0>64}", i));
+    }
+
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        auto message = makeBroadcastMessage(sharePayload);
+        std::vector<EncodedMessage> encodedMessages(peerCount);
+        state.ResumeTiming();
+
+        for (auto i = 0; i < peerCount; ++i)
+        {
+            message->setDstP2PNodeID(peers[i]);
+            message->encode(encodedMessages[i]);
+        }
+        benchmark::DoNotOptimize(encodedMessages);
+    }
+    state.SetItemsProcessed(state.iterations() * peerCount);
+}
+
+static void copyPayloadBroadcast(benchmark::State& state)
+{
+    encodeBroadcast(state, false);
+}
+
+static void sharedPayloadBroadcast(benchmark::State& state)
+{
+    encodeBroadcast(state, true);
+}
+
+BENCHMARK(copyPayloadBroadcast)->Arg(4)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(sharedPayloadBroadcast)->Arg(4)->Arg(16)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN();
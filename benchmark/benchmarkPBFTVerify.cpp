@@ -0,0 +1,172 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-crypto/signature/secp256k1/Secp256k1Crypto.h"
+#include "bcos-pbft/pbft/config/PBFTConfig.h"
+#include "bcos-pbft/pbft/engine/PBFTMessageVerifier.h"
+#include "bcos-pbft/pbft/protocol/PB/PBFTMessage.h"
+#include "bcos-pbft/pbft/protocol/PB/PBFTProposal.h"
+#include <benchmark/benchmark.h>
+#include <oneapi/tbb/concurrent_queue.h>
+
+using namespace bcos;
+using namespace bcos::consensus;
+using namespace bcos::crypto;
+
+constexpr static size_t VERIFY_THREAD_COUNT = 4;
+
+// One consensus round of nodeCount nodes, every node has sent its prepare, with the proposal it
+// signed, and its commit to the node that verifies them
+struct Round
+{
+    explicit Round(size_t nodeCount)
+      : cryptoSuite(std::make_shared<CryptoSuite>(
+            std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr))
+    {
+        ConsensusNodeList nodes;
+        std::vector<KeyPairInterface::Ptr> keyPairs;
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            keyPairs.emplace_back(cryptoSuite->signatureImpl()->generateKeyPair());
+            nodes.emplace_back(ConsensusNode{keyPairs.back()->publicKey(),
+                consensus::Type::consensus_sealer, 1, 0, 0});
+        }
+        config = std::make_shared<PBFTConfig>(cryptoSuite, keyPairs.front(), nullptr, nullptr,
+            nullptr, nullptr, nullptr, nullptr, nullptr);
+        config->setConsensusNodeList(nodes);
+
+        auto proposalHash = cryptoSuite->hashImpl()->hash(std::string_view("benchmark proposal"));
+        for (auto const& keyPair : keyPairs)
+        {
+            auto index = config->getNodeIndexByNodeID(keyPair->publicKey());
+            prepares.emplace_back(
+                signedMessage(keyPair, index, proposalHash, PacketType::PreparePacket));
+            commits.emplace_back(
+                signedMessage(keyPair, index, proposalHash, PacketType::CommitPacket));
+        }
+    }
+
+    PBFTBaseMessageInterface::Ptr signedMessage(KeyPairInterface::Ptr const& keyPair,
+        IndexType index, HashType const& proposalHash, PacketType packetType)
+    {
+        auto proposal = std::make_shared<PBFTProposal>();
+        proposal->setIndex(1);
+        proposal->setHash(proposalHash);
+        proposal->setSignature(*cryptoSuite->signatureImpl()->sign(*keyPair, proposalHash, false));
+
+        auto message = std::make_shared<PBFTMessage>();
+        message->setPacketType(packetType);
+        message->setIndex(1);
+        message->setGeneratedFrom(index);
+        message->setHash(proposalHash);
+        message->setConsensusProposal(proposal);
+        auto encoded = message->encode(cryptoSuite, keyPair);
+        return std::make_shared<PBFTMessage>(cryptoSuite, ref(*encoded));
+    }
+
+    CryptoSuite::Ptr cryptoSuite;
+    PBFTConfig::Ptr config;
+    std::vector<PBFTBaseMessageInterface::Ptr> prepares;
+    std::vector<PBFTBaseMessageInterface::Ptr> commits;
+};
+
+// The checks the engine runs on the worker when it handles a message
+static bool engineCheck(Round& round, PBFTBaseMessageInterface::Ptr const& message,
+    PBFTMessageVerifier* verifier)
+{
+    auto publicKey = round.config->getConsensusNodeByIndex(message->generatedFrom())->nodeID;
+    auto verify = [&]() { return message->verifySignature(round.cryptoSuite, publicKey); };
+    auto valid = verifier ? verifier->verify(publicKey, message->signatureDataHash(),
+                                message->signatureData(), verify) :
+                            verify();
+    if (message->packetType() == PacketType::PreparePacket)
+    {
+        auto proposal = std::dynamic_pointer_cast<PBFTMessage>(message)->consensusProposal();
+        auto verifyProposal = [&]() {
+            return round.cryptoSuite->signatureImpl()->verify(
+                publicKey, proposal->hash(), proposal->signature());
+        };
+        valid = valid && (verifier ? verifier->verify(publicKey, proposal->hash(),
+                                         proposal->signature(), verifyProposal) :
+                                     verifyProposal());
+    }
+    return valid;
+}
+
+// Before: every signature of the phase is verified in turn on the consensus worker
+static void serialPhase(benchmark::State& state, bool commit)
+{
+    Round round(state.range(0));
+    auto const& messages = commit ? round.commits : round.prepares;
+    for (auto const& it : state)
+    {
+        for (auto const& message : messages)
+        {
+            benchmark::DoNotOptimize(engineCheck(round, message, nullptr));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * messages.size());
+}
+
+// After: the verifier stage verifies the phase in parallel and the worker hits its cache
+static void stagedPhase(benchmark::State& state, bool commit)
+{
+    Round round(state.range(0));
+    auto const& messages = commit ? round.commits : round.prepares;
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        auto verifier = std::make_shared<PBFTMessageVerifier>(
+            round.config, VERIFY_THREAD_COUNT, messages.size() * 2);
+        tbb::concurrent_queue<PBFTBaseMessageInterface::Ptr> msgQueue;
+        state.ResumeTiming();
+
+        for (auto const& message : messages)
+        {
+            verifier->asyncVerify(message, [&msgQueue, message](bool valid) {
+                if (valid)
+                {
+                    msgQueue.push(message);
+                }
+            });
+        }
+        size_t handled = 0;
+        PBFTBaseMessageInterface::Ptr message;
+        while (handled < messages.size())
+        {
+            if (msgQueue.try_pop(message))
+            {
+                benchmark::DoNotOptimize(engineCheck(round, message, verifier.get()));
+                ++handled;
+            }
+        }
+
+        state.PauseTiming();
+        verifier->stop();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * messages.size());
+}
+
+static void serialPrepare(benchmark::State& state)
+{
+    serialPhase(state, false);
+}
+static void stagedPrepare(benchmark::State& state)
+{
+    stagedPhase(state, false);
+}
+static void serialCommit(benchmark::State& state)
+{
+    serialPhase(state, true);
+}
+static void stagedCommit(benchmark::State& state)
+{
+    stagedPhase(state, true);
+}
+
+BENCHMARK(serialPrepare)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(stagedPrepare)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(serialCommit)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(stagedCommit)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,203 @@
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "libinitializer/StorageInitializer.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <rocksdb/statistics.h>
+#include <boost/filesystem.hpp>
+#include <boost/throw_exception.hpp>
+#include <future>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::initializer;
+
+constexpr static size_t BLOCK_COUNT = 400;
+constexpr static size_t TX_PER_BLOCK = 500;
+constexpr static size_t ACCOUNT_COUNT = 200 * 1000;
+constexpr static size_t ACCOUNT_UPDATES_PER_BLOCK = 2000;
+constexpr static std::string_view ACCOUNT_TABLE = "/apps/benchmark_accounts";
+
+static std::string randomBytes(std::mt19937_64& random, size_t size)
+{
+    std::string bytes;
+    while (bytes.size() < size)
+    {
+        auto value = random();
+        bytes.append((const char*)&value, std::min(sizeof(value), size - bytes.size()));
+    }
+    return bytes;
+}
+
+static std::string accountKey(size_t index)
+{
+    return fmt::format("{:0>40x}", index);
+}
+
+// A node that committed BLOCK_COUNT blocks, every block has TX_PER_BLOCK transactions with their
+// receipts and indices and updates ACCOUNT_UPDATES_PER_BLOCK accounts of the state
+struct Ledger
+{
+    explicit Ledger(bool split)
+      : path(fmt::format("benchmark-rocksdb-{}", split ? "column-families" : "default"))
+    {
+        boost::filesystem::remove_all(path);
+        // the same total block cache for both layouts
+        RocksDBOption option;
+        option.enableColumnFamilies = split;
+        option.blockCacheSize = split ? 32 << 20 : 64 << 20;
+        option.blockDataCacheSize = 16 << 20;
+        option.indexCacheSize = 16 << 20;
+        auto rocksDB = StorageInitializer::createRocksDB(path, option, true);
+        rocksDBStorage = std::dynamic_pointer_cast<storage::RocksDBStorage>(
+            StorageInitializer::build(std::move(rocksDB), nullptr));
+
+        std::mt19937_64 random(1);
+        auto setRows = [this](std::string_view table, std::vector<std::string> const& keys,
+                           std::vector<std::string> const& values) {
+            auto toView = [](std::string const& value) { return std::string_view(value); };
+            auto error = rocksDBStorage->setRows(table, keys | ::ranges::views::transform(toView),
+                values | ::ranges::views::transform(toView));
+            if (error)
+            {
+                BOOST_THROW_EXCEPTION(*error);
+            }
+        };
+
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (size_t i = 0; i < ACCOUNT_COUNT; ++i)
+        {
+            keys.push_back(accountKey(i));
+            values.push_back(randomBytes(random, 64));
+        }
+        setRows(ACCOUNT_TABLE, keys, values);
+
+        for (size_t number = 0; number < BLOCK_COUNT; ++number)
+        {
+            std::vector<std::string> hashes;
+            std::vector<std::string> transactions;
+            std::vector<std::string> receipts;
+            for (size_t i = 0; i < TX_PER_BLOCK; ++i)
+            {
+                hashes.push_back(randomBytes(random, 32));
+                transactions.push_back(fmt::format("{:>400}",
+                    fmt::format("chain:group:{}:{}:{}", number, i, randomBytes(random, 96))));
+                receipts.push_back(fmt::format(
+                    "{:>300}", fmt::format("status:0:gas:21000:{}", randomBytes(random, 64))));
+            }
+            std::string blockHashes;
+            for (auto const& hash : hashes)
+            {
+                blockHashes.append(hash);
+            }
+            txHashes.insert(txHashes.end(), hashes.begin(), hashes.end());
+            setRows(ledger::SYS_HASH_2_TX, hashes, transactions);
+            setRows(ledger::SYS_HASH_2_RECEIPT, hashes, receipts);
+            setRows(ledger::SYS_HASH_2_NUMBER, hashes,
+                std::vector<std::string>(TX_PER_BLOCK, std::to_string(number)));
+            setRows(ledger::SYS_NUMBER_2_TXS, {std::to_string(number)}, {blockHashes});
+            setRows(ledger::SYS_NUMBER_2_BLOCK_HEADER, {std::to_string(number)},
+                {randomBytes(random, 512)});
+            setRows(ledger::SYS_BLOCK_NUMBER_2_NONCES, {std::to_string(number)},
+                {randomBytes(random, TX_PER_BLOCK * 16)});
+
+            keys.clear();
+            values.clear();
+            for (size_t i = 0; i < ACCOUNT_UPDATES_PER_BLOCK; ++i)
+            {
+                keys.push_back(accountKey(random() % ACCOUNT_COUNT));
+                values.push_back(randomBytes(random, 64));
+            }
+            setRows(ACCOUNT_TABLE, keys, values);
+        }
+
+        auto statistics = rocksDBStorage->rocksDB().GetDBOptions().statistics;
+        compactWriteBytes = statistics->getTickerCount(::rocksdb::COMPACT_WRITE_BYTES);
+        stallMicros = statistics->getTickerCount(::rocksdb::STALL_MICROS);
+    }
+    Ledger(const Ledger&) = delete;
+    Ledger(Ledger&&) = delete;
+    Ledger& operator=(const Ledger&) = delete;
+    Ledger& operator=(Ledger&&) = delete;
+    ~Ledger()
+    {
+        rocksDBStorage.reset();
+        boost::filesystem::remove_all(path);
+    }
+
+    std::string path;
+    std::shared_ptr<storage::RocksDBStorage> rocksDBStorage;
+    std::vector<std::string> txHashes;
+    uint64_t compactWriteBytes = 0;
+    uint64_t stallMicros = 0;
+};
+
+static Ledger& committedLedger(bool split)
+{
+    if (split)
+    {
+        static Ledger splitLedger(true);
+        return splitLedger;
+    }
+    static Ledger defaultLedger(false);
+    return defaultLedger;
+}
+
+static void readRows(benchmark::State& state, bool split, std::string_view table, auto&& keyOf)
+{
+    auto& node = committedLedger(split);
+    std::mt19937_64 random(2);
+    for (auto const& it : state)
+    {
+        std::promise<std::optional<storage::Entry>> promise;
+        node.rocksDBStorage->asyncGetRow(table, keyOf(node, random),
+            [&promise](Error::UniquePtr, std::optional<storage::Entry> entry) {
+                promise.set_value(std::move(entry));
+            });
+        benchmark::DoNotOptimize(promise.get_future().get());
+    }
+    state.counters["compactWriteMB"] = (double)node.compactWriteBytes / (1 << 20);
+    state.counters["stallMs"] = (double)node.stallMicros / 1000;
+}
+
+// point reads of the hot state while the block data grows beside it
+static void stateRead(benchmark::State& state, bool split)
+{
+    readRows(state, split, ACCOUNT_TABLE,
+        [](Ledger&, std::mt19937_64& random) { return accountKey(random() % ACCOUNT_COUNT); });
+}
+
+// point reads of the cold transactions, as getTransactionByHash does
+static void transactionRead(benchmark::State& state, bool split)
+{
+    readRows(state, split, ledger::SYS_HASH_2_TX, [](Ledger& node, std::mt19937_64& random) {
+        return node.txHashes[random() % node.txHashes.size()];
+    });
+}
+
+static void defaultStateRead(benchmark::State& state)
+{
+    stateRead(state, false);
+}
+
+static void columnFamilyStateRead(benchmark::State& state)
+{
+    stateRead(state, true);
+}
+
+static void defaultTransactionRead(benchmark::State& state)
+{
+    transactionRead(state, false);
+}
+
+static void columnFamilyTransactionRead(benchmark::State& state)
+{
+    transactionRead(state, true);
+}
+
+BENCHMARK(defaultStateRead);
+BENCHMARK(columnFamilyStateRead);
+BENCHMARK(defaultTransactionRead);
+BENCHMARK(columnFamilyTransactionRead);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-table/src/StateStorage.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptImpl.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+constexpr static size_t STORED_RECEIPTS = 10000;
+
+// The receipts of the committed blocks, a batch of getTransactionReceipt requests looks up
+// range(0) of them
+struct StoredReceipts
+{
+    StoredReceipts()
+      : cryptoSuite(std::make_shared<crypto::CryptoSuite>(
+            std::make_shared<crypto::Keccak256>(), nullptr, nullptr)),
+        receiptFactory(
+            std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite)),
+        storage(std::make_shared<storage::StateStorage>(nullptr, false))
+    {
+        bytes output(64, 'o');
+        for (size_t i = 0; i < STORED_RECEIPTS; ++i)
+        {
+            auto receipt = receiptFactory->createReceipt(
+                i * 21000, fmt::format("{:0>40x}", i + 1), {}, 0, ref(output), i / 100);
+            bytes buffer;
+            receipt->encode(buffer);
+            storage::Entry entry;
+            entry.importFields({std::move(buffer)});
+            crypto::HashType hash(i + 1);
+            txHashes.emplace_back((const char*)hash.data(), hash.size());
+            storage->asyncSetRow(
+                SYS_HASH_2_RECEIPT, txHashes.back(), std::move(entry), [](Error::UniquePtr) {});
+        }
+    }
+
+    std::vector<std::string> batch(size_t size) const
+    {
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < size; ++i)
+        {
+            keys.push_back(txHashes[(i * 7919) % txHashes.size()]);
+        }
+        return keys;
+    }
+
+    protocol::TransactionReceipt::Ptr decode(const storage::Entry& entry) const
+    {
+        auto field = entry.getField(0);
+        return receiptFactory->createReceipt(
+            bytesConstRef((const byte*)field.data(), field.size()));
+    }
+
+    crypto::CryptoSuite::Ptr cryptoSuite;
+    protocol::TransactionReceiptFactory::Ptr receiptFactory;
+    std::shared_ptr<storage::StateStorage> storage;
+    std::vector<std::string> txHashes;
+};
+
+// Before: every request of the batch reads the ledger on its own
+static void perRequestRead(benchmark::State& state)
+{
+    StoredReceipts receipts;
+    auto keys = receipts.batch(state.range(0));
+    for (auto const& it : state)
+    {
+        for (const auto& key : keys)
+        {
+            std::promise<std::optional<storage::Entry>> promise;
+            receipts.storage->asyncGetRow(SYS_HASH_2_RECEIPT, key,
+                [&promise](Error::UniquePtr, std::optional<storage::Entry> entry) {
+                    promise.set_value(std::move(entry));
+                });
+            auto entry = promise.get_future().get();
+            benchmark::DoNotOptimize(receipts.decode(*entry));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// The lookups of the batch sharing the group and node are served with one read of the ledger
+static void sharedRead(benchmark::State& state)
+{
+    StoredReceipts receipts;
+    auto keys = receipts.batch(state.range(0));
+    for (auto const& it : state)
+    {
+        std::promise<std::vector<std::optional<storage::Entry>>> promise;
+        receipts.storage->asyncGetRows(SYS_HASH_2_RECEIPT, keys,
+            [&promise](Error::UniquePtr, std::vector<std::optional<storage::Entry>> entries) {
+                promise.set_value(std::move(entries));
+            });
+        auto entries = promise.get_future().get();
+        for (const auto& entry : entries)
+        {
+            benchmark::DoNotOptimize(receipts.decode(*entry));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK(perRequestRead)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(sharedRead)->Arg(1)->Arg(10)->Arg(100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,161 @@
+#include "bcos-framework/storage2/MemoryStorage.h"
+#include "bcos-framework/transaction-executor/StateKey.h"
+#include "bcos-task/Wait.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::storage2::memory_storage;
+using namespace bcos::executor_v1;
+
+constexpr static size_t CONTRACT_COUNT = 100;
+constexpr static size_t SLOT_COUNT = 1000;
+constexpr static size_t TRANSACTION_COUNT = 10000;
+constexpr static size_t ACCESSES_PER_TRANSACTION = 10;
+
+// The former StateKey, "<table>:<key>" in one string
+struct StringStateKey
+{
+    std::string m_tableAndKey;
+    size_t m_split;
+
+    StringStateKey(std::string_view table, std::string_view key) : m_split(table.size())
+    {
+        m_tableAndKey.reserve(table.size() + 1 + key.size());
+        m_tableAndKey.append(table);
+        m_tableAndKey.push_back(':');
+        m_tableAndKey.append(key);
+    }
+
+    StateKeyView view() const
+    {
+        return {std::string_view(m_tableAndKey).substr(0, m_split),
+            std::string_view(m_tableAndKey).substr(m_split + 1)};
+    }
+};
+
+static auto operator<=>(StringStateKey const& lhs, StringStateKey const& rhs)
+{
+    return lhs.view() <=> rhs.view();
+}
+static bool operator==(StringStateKey const& lhs, StringStateKey const& rhs)
+{
+    return lhs.view() == rhs.view();
+}
+static auto operator<=>(StringStateKey const& lhs, StateKeyView const& rhs)
+{
+    return lhs.view() <=> rhs;
+}
+static bool operator==(StringStateKey const& lhs, StateKeyView const& rhs)
+{
+    return lhs.view() == rhs;
+}
+
+struct StringStateKeyHash
+{
+    using is_transparent = void;
+    size_t operator()(StringStateKey const& key) const { return key.view().hash(); }
+    size_t operator()(StateKeyView const& view) const { return view.hash(); }
+};
+
+using CompactMutableStorage =
+    MemoryStorage<StateKey, StateValue, Attribute(SORT_ON_FREEZE | LOGICAL_DELETION)>;
+using StringMutableStorage = MemoryStorage<StringStateKey, StateValue,
+    Attribute(SORT_ON_FREEZE | LOGICAL_DELETION), StringStateKeyHash>;
+
+// Transactions each calling one contract and touching ACCESSES_PER_TRANSACTION of its 32 bytes
+// slots, as SLOAD and SSTORE do
+struct Workload
+{
+    Workload()
+    {
+        std::mt19937_64 random(0);
+        for (size_t i = 0; i < CONTRACT_COUNT; ++i)
+        {
+            tables.emplace_back(fmt::format("/apps/{:0>40x}", random()));
+        }
+        for (size_t i = 0; i < SLOT_COUNT; ++i)
+        {
+            std::string slot(32, '\0');
+            for (auto& byte : slot)
+            {
+                byte = static_cast<char>(random());
+            }
+            slots.emplace_back(std::move(slot));
+        }
+        for (size_t i = 0; i < TRANSACTION_COUNT; ++i)
+        {
+            auto contract = random() % CONTRACT_COUNT;
+            for (size_t j = 0; j < ACCESSES_PER_TRANSACTION; ++j)
+            {
+                accesses.emplace_back(contract, random() % SLOT_COUNT);
+            }
+        }
+    }
+
+    std::vector<std::string> tables;
+    std::vector<std::string> slots;
+    std::vector<std::tuple<size_t, size_t>> accesses;
+};
+static Workload workload;
+
+// SSTORE: every access builds a key and writes it into the block's mutable storage, which is
+// frozen at the end of the block
+template <class Storage>
+static void sstore(benchmark::State& state)
+{
+    storage::Entry entry;
+    entry.set(std::string(32, '1'));
+    for (auto const& it : state)
+    {
+        Storage storage;
+        task::syncWait([&]() -> task::Task<void> {
+            for (auto [contract, slot] : workload.accesses)
+            {
+                co_await storage2::writeOne(storage,
+                    typename Storage::Key(workload.tables[contract], workload.slots[slot]), entry);
+            }
+        }());
+        storage.freeze();
+        benchmark::DoNotOptimize(storage);
+    }
+    state.SetItemsProcessed(state.iterations() * workload.accesses.size());
+}
+
+// SLOAD: every access looks up a view of the table and the slot
+template <class Storage>
+static void sload(benchmark::State& state)
+{
+    Storage storage;
+    storage::Entry entry;
+    entry.set(std::string(32, '1'));
+    task::syncWait([&]() -> task::Task<void> {
+        for (auto const& table : workload.tables)
+        {
+            for (auto const& slot : workload.slots)
+            {
+                co_await storage2::writeOne(storage, typename Storage::Key(table, slot), entry);
+            }
+        }
+    }());
+
+    for (auto const& it : state)
+    {
+        task::syncWait([&]() -> task::Task<void> {
+            for (auto [contract, slot] : workload.accesses)
+            {
+                benchmark::DoNotOptimize(co_await storage2::readOne(
+                    storage, StateKeyView(workload.tables[contract], workload.slots[slot])));
+            }
+        }());
+    }
+    state.SetItemsProcessed(state.iterations() * workload.accesses.size());
+}
+
+BENCHMARK(sstore<StringMutableStorage>);
+BENCHMARK(sstore<CompactMutableStorage>);
+BENCHMARK(sload<StringMutableStorage>);
+BENCHMARK(sload<CompactMutableStorage>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,216 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-crypto/signature/secp256k1/Secp256k1Crypto.h"
+#include "bcos-protocol/TransactionSubmitResultFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/BlockFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
+#include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include "bcos-txpool/txpool/validator/TxPoolNonceChecker.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/transform.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+// Recover the signatures but accept every transaction, so the benchmark only measures the txpool
+// storage and the signature verification
+class AcceptAllValidator : public TxValidatorInterface
+{
+public:
+    explicit AcceptAllValidator(crypto::CryptoSuite::Ptr cryptoSuite)
+      : m_cryptoSuite(std::move(cryptoSuite))
+    {}
+
+    TransactionStatus verify(Transaction& _tx) override
+    {
+        _tx.clearSenderAndHash();
+        _tx.verify(*m_cryptoSuite->hashImpl(), *m_cryptoSuite->signatureImpl());
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkTransaction(
+        const Transaction& /*_tx*/, bool /*onlyCheckLedgerNonce*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkLedgerNonceAndBlockLimit(const Transaction& /*_tx*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkTxpoolNonce(const Transaction& /*_tx*/) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkWeb3Nonce(
+        const Transaction& /*_tx*/, bool /*onlyCheckLedgerNonce*/) override
+    {
+        return TransactionStatus::None;
+    }
+    LedgerNonceChecker::Ptr ledgerNonceChecker() override { return nullptr; }
+    Web3NonceChecker::Ptr web3NonceChecker() override { return m_web3NonceChecker; }
+    void setLedgerNonceChecker(LedgerNonceChecker::Ptr /*_ledgerNonceChecker*/) override {}
+    TransactionStatus validateTransaction(const Transaction& /*_tx*/) override
+    {
+        return TransactionStatus::None;
+    }
+    task::Task<TransactionStatus> validateBalance(const Transaction& /*_tx*/,
+        std::shared_ptr<bcos::ledger::LedgerInterface> /*_ledger*/) override
+    {
+        co_return TransactionStatus::None;
+    }
+    task::Task<TransactionStatus> validateChainId(const Transaction& /*_tx*/,
+        std::shared_ptr<bcos::ledger::LedgerInterface> /*_ledger*/) override
+    {
+        co_return TransactionStatus::None;
+    }
+
+private:
+    crypto::CryptoSuite::Ptr m_cryptoSuite;
+    Web3NonceChecker::Ptr m_web3NonceChecker = std::make_shared<Web3NonceChecker>(nullptr);
+};
+
+struct TxPoolFixture
+{
+    TxPoolFixture(size_t poolLimit, bool checkSignature)
+      : cryptoSuite(std::make_shared<crypto::CryptoSuite>(std::make_shared<crypto::Keccak256>(),
+            std::make_shared<crypto::Secp256k1Crypto>(), nullptr)),
+        txFactory(std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite)),
+        nonceChecker(std::make_shared<TxPoolNonceChecker>())
+    {
+        auto blockFactory = std::make_shared<bcostars::protocol::BlockFactoryImpl>(cryptoSuite,
+            std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite), txFactory,
+            std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite));
+        auto config =
+            std::make_shared<TxPoolConfig>(std::make_shared<AcceptAllValidator>(cryptoSuite),
+                std::make_shared<TransactionSubmitResultFactoryImpl>(), blockFactory, nullptr,
+                nonceChecker, 0, poolLimit, checkSignature);
+        storage = std::make_shared<MemoryStorage>(config);
+    }
+
+    void fillPool(int64_t poolSize)
+    {
+        crypto::Keccak256 keccak;
+        auto importTime = static_cast<int64_t>(utcTime());
+        for (auto i = 0; i < poolSize; ++i)
+        {
+            auto tx = std::make_shared<bcostars::protocol::TransactionImpl>();
+            tx->setNonce(fmt::format("seal-benchmark-{}", i));
+            tx->setImportTime(importTime + i);
+            tx->calculateHash(keccak);
+            storage->insert(std::move(tx));
+        }
+    }
+
+    std::vector<Transaction::Ptr> signedTransactions(int64_t count)
+    {
+        auto keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+        bcos::bytes input(100, 1);
+        std::vector<Transaction::Ptr> transactions;
+        for (auto i = 0; i < count; ++i)
+        {
+            transactions.emplace_back(txFactory->createTransaction(0, "", input,
+                fmt::format("submit-benchmark-{}", i), 100, "chain0", "group0", 0, *keyPair));
+        }
+        return transactions;
+    }
+
+    // remove the submitted txs and their nonces, so the same txs can be submitted again
+    void reset(const std::vector<Transaction::Ptr>& transactions)
+    {
+        storage->clear();
+        nonceChecker->batchRemove(
+            transactions |
+            ::ranges::views::transform([](auto& tx) { return std::string(tx->nonce()); }) |
+            ::ranges::to<NonceList>());
+    }
+
+    crypto::CryptoSuite::Ptr cryptoSuite;
+    std::shared_ptr<bcostars::protocol::TransactionFactoryImpl> txFactory;
+    std::shared_ptr<TxPoolNonceChecker> nonceChecker;
+    std::shared_ptr<MemoryStorage> storage;
+};
+
+// Seal txsLimit transactions from a pool of poolSize, then put them back to keep the pool size
+static void sealTransactions(benchmark::State& state)
+{
+    auto poolSize = state.range(0);
+    auto txsLimit = state.range(1);
+    TxPoolFixture fixture(poolSize, false);
+    fixture.fillPool(poolSize);
+
+    std::vector<TransactionMetaData::Ptr> txsList;
+    std::vector<TransactionMetaData::Ptr> sysTxsList;
+    for (auto const& it : state)
+    {
+        txsList.clear();
+        sysTxsList.clear();
+        fixture.storage->batchSealTransactions(txsList, sysTxsList, txsLimit);
+
+        state.PauseTiming();
+        auto hashes = txsList |
+                      ::ranges::views::transform([](auto& metaData) { return metaData->hash(); }) |
+                      ::ranges::to<crypto::HashList>();
+        fixture.storage->batchMarkTxs(hashes, -1, crypto::HashType(), false);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * txsLimit);
+}
+
+BENCHMARK(sealTransactions)
+    ->Args({10000, 1000})
+    ->Args({100000, 1000})
+    ->Args({500000, 1000})
+    ->Args({100000, 10000})
+    ->Args({500000, 10000})
+    ->Unit(benchmark::kMicrosecond);
+
+// Submit batchSize signed transactions one by one
+static void submitTransactions(benchmark::State& state)
+{
+    auto batchSize = state.range(0);
+    TxPoolFixture fixture(batchSize, true);
+    auto transactions = fixture.signedTransactions(batchSize);
+
+    for (auto const& it : state)
+    {
+        for (auto const& transaction : transactions)
+        {
+            benchmark::DoNotOptimize(
+                fixture.storage->verifyAndSubmitTransaction(transaction, nullptr, true, true));
+        }
+
+        state.PauseTiming();
+        fixture.reset(transactions);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+// Submit batchSize signed transactions in one batch, verifying the signatures in parallel
+static void batchSubmitTransactions(benchmark::State& state)
+{
+    auto batchSize = state.range(0);
+    TxPoolFixture fixture(batchSize, true);
+    auto transactions = fixture.signedTransactions(batchSize);
+
+    for (auto const& it : state)
+    {
+        benchmark::DoNotOptimize(
+            fixture.storage->batchVerifyAndSubmitTransactions(transactions, true));
+
+        state.PauseTiming();
+        fixture.reset(transactions);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+BENCHMARK(submitTransactions)->Arg(1)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(batchSubmitTransactions)->Arg(1)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -3,18 +3,23 @@
 #include "bcos-storage/RocksDBStorage2.h"
 #include "bcos-storage/StateKVResolver.h"
 #include "bcos-transaction-executor/TransactionExecutorImpl.h"
+#include "bcos-transaction-executor/vm/HostContext.h"
 #include "bcos-transaction-scheduler/BaselineScheduler.h"
+#include "bcos-transaction-scheduler/SchedulerBlockSTMImpl.h"
 #include "bcos-transaction-scheduler/SchedulerParallelImpl.h"
 #include "bcos-transaction-scheduler/SchedulerSerialImpl.h"
 #include "libinitializer/Common.h"
 #include <boost/throw_exception.hpp>
 
+// Hash indexed while the block executes, sorted once when the block's layer is pushed
 using MutableStorage = bcos::storage2::memory_storage::MemoryStorage<bcos::executor_v1::StateKey,
     bcos::executor_v1::StateValue,
-    bcos::storage2::memory_storage::ORDERED | bcos::storage2::memory_storage::LOGICAL_DELETION>;
+    bcos::storage2::memory_storage::SORT_ON_FREEZE |
+        bcos::storage2::memory_storage::LOGICAL_DELETION>;
+// CLOCK keeps the hits of hot accounts from parallel chunks on the shared reader lock
 using CacheStorage = bcos::storage2::memory_storage::MemoryStorage<bcos::executor_v1::StateKey,
     bcos::executor_v1::StateValue,
-    bcos::storage2::memory_storage::CONCURRENT | bcos::storage2::memory_storage::LRU>;
+    bcos::storage2::memory_storage::CONCURRENT | bcos::storage2::memory_storage::CLOCK>;
 
 std::tuple<std::function<std::shared_ptr<bcos::scheduler::SchedulerInterface>()>,
     std::function<void(std::function<void(bcos::protocol::BlockNumber)>)>>
@@ -36,17 +41,42 @@ bcos::scheduler_v1::BaselineSchedulerInitializer::build(::rocksdb::DB& rocksDB,
             m_multiLayerStorage;
         executor_v1::PrecompiledManager m_precompiledManager;
         executor_v1::TransactionExecutorImpl m_transactionExecutor;
+        std::string m_codeCachePath;
 
-        Data(::rocksdb::DB& rocksDB, protocol::BlockFactory& blockFactory)
+        Data(::rocksdb::DB& rocksDB, protocol::BlockFactory& blockFactory,
+            std::string codeCachePath)
           : m_rocksDBStorage(rocksDB, storage2::rocksdb::StateKeyResolver{},
                 storage2::rocksdb::StateValueResolver{}),
             m_multiLayerStorage(m_rocksDBStorage, m_cacheStorage),
             m_precompiledManager(blockFactory.cryptoSuite()->hashImpl()),
             m_transactionExecutor(*blockFactory.receiptFactory(),
-                blockFactory.cryptoSuite()->hashImpl(), m_precompiledManager)
-        {}
+                blockFactory.cryptoSuite()->hashImpl(), m_precompiledManager),
+            m_codeCachePath(std::move(codeCachePath))
+        {
+            if (!m_codeCachePath.empty())
+            {
+                auto codeHashes = executor_v1::hostcontext::loadCodeHashes(m_codeCachePath);
+                auto count = task::syncWait(executor_v1::hostcontext::warmupExecutables(
+                    m_rocksDBStorage, codeHashes, EVMC_CANCUN));
+                INITIALIZER_LOG(INFO) << "Warm up executables" << LOG_KV("path", m_codeCachePath)
+                                      << LOG_KV("codeHashes", codeHashes.size())
+                                      << LOG_KV("analysed", count);
+            }
+        }
+        Data(const Data&) = delete;
+        Data(Data&&) = delete;
+        Data& operator=(const Data&) = delete;
+        Data& operator=(Data&&) = delete;
+        ~Data()
+        {
+            if (!m_codeCachePath.empty())
+            {
+                executor_v1::hostcontext::saveCodeHashes(
+                    m_codeCachePath, executor_v1::hostcontext::cachedCodeHashes());
+            }
+        }
     };
-    auto data = std::make_shared<Data>(rocksDB, *blockFactory);
+    auto data = std::make_shared<Data>(rocksDB, *blockFactory, config.codeCachePath);
 
     auto buildBaselineHolder = [&](auto scheduler) {
         auto baselineScheduler =
@@ -55,6 +85,7 @@ bcos::scheduler_v1::BaselineSchedulerInitializer::build(::rocksdb::DB& rocksDB,
                 ledger::LedgerInterface>>(data->m_multiLayerStorage, *scheduler,
                 data->m_transactionExecutor, *blockFactory, *ledger, *txpool,
                 *transactionSubmitResultFactory, *blockFactory->cryptoSuite()->hashImpl());
+        baselineScheduler->setMaxLayerDepth(config.maxLayerDepth);
         baselineScheduler->registerTransactionNotifier(
             [txpool](bcos::protocol::BlockNumber blockNumber,
                 bcos::protocol::TransactionSubmitResultsPtr result,
@@ -75,9 +106,18 @@ bcos::scheduler_v1::BaselineSchedulerInitializer::build(::rocksdb::DB& rocksDB,
     };
 
     INITIALIZER_LOG(INFO) << "Initialize baseline scheduler, parallel: " << config.parallel
+                          << ", blockSTM: " << config.blockSTM
                           << ", grainSize: " << config.grainSize
-                          << ", maxThread: " << config.maxThread;
+                          << ", maxThread: " << config.maxThread
+                          << ", maxLayerDepth: " << config.maxLayerDepth
+                          << ", codeCachePath: " << config.codeCachePath;
 
+    if (config.parallel && config.blockSTM)
+    {
+        auto scheduler = std::make_shared<SchedulerBlockSTMImpl<MutableStorage>>();
+        scheduler->m_maxConcurrency = config.maxThread;
+        return buildBaselineHolder(std::move(scheduler));
+    }
     if (config.parallel)
     {
         auto scheduler = std::make_shared<SchedulerParallelImpl<MutableStorage>>();
@@ -150,6 +150,9 @@ RocksDBOption getRocksDBOption(
     option.blockCacheSize = nodeConfig->blockCacheSize();
     option.optimizeLevelStyleCompaction = optimizeLevelStyleCompaction;
     option.enable_blob_files = nodeConfig->enableRocksDBBlob();
+    option.enableColumnFamilies = nodeConfig->enableColumnFamilies();
+    option.blockDataCacheSize = nodeConfig->blockDataCacheSize();
+    option.indexCacheSize = nodeConfig->indexCacheSize();
     return option;
 }
 
@@ -234,6 +237,11 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         m_protocolInitializer->blockFactory(), m_storage, m_nodeConfig, m_blockStorage);
     ledger->setKeyPageSize(m_nodeConfig->keyPageSize());
     m_ledger = ledger;
+    if (m_nodeConfig->enableLogIndexBackfill())
+    {
+        // index the logs of the blocks committed before the log index was introduced
+        ledger->asyncBuildLogIndex(0, getCurrentBlockNumber());
+    }
 
     bcos::protocol::ExecutionMessageFactory::Ptr executionMessageFactory = nullptr;
     // Note: since tikv-storage store txs with transaction, batch writing is more efficient than
@@ -709,7 +717,10 @@ void Initializer::prune()
             bcos::ledger::SYS_BLOCK_NUMBER_2_NONCES, std::to_string(blockLimit + 1)));
         auto endKey = rocksdb::Slice(bcos::storage::toDBKey(
             bcos::ledger::SYS_BLOCK_NUMBER_2_NONCES, std::to_string(endBlockNumber)));
-        auto status = rocksDB.CompactRange(rocksdb::CompactRangeOptions(), &startKey, &endKey);
+        // the nonces are kept in the index column family of a split DB
+        auto status = rocksDB.CompactRange(rocksdb::CompactRangeOptions(),
+            storage::columnFamilyOfTable(rocksDB, bcos::ledger::SYS_BLOCK_NUMBER_2_NONCES),
+            &startKey, &endKey);
         if (!status.ok())
         {
             std::cerr << LOG_DESC("rocksDB compact range failed") << LOG_DESC(status.ToString());
@@ -722,14 +733,16 @@ std::unique_ptr<rocksdb::DB> createReadOnlyRocksDB(const std::string& path)
 {
     rocksdb::Options options;
     options.create_if_missing = false;
-    rocksdb::DB* db = nullptr;
-    rocksdb::Status status = rocksdb::DB::OpenForReadOnly(options, path, &db);
-    if (!status.ok())
+    try
+    {
+        return storage::ColumnFamilyDB::openForRead(options, path);
+    }
+    catch (std::exception const& e)
     {
-        std::cout << "open read only rocksDB failed: " << status.ToString() << std::endl;
+        std::cout << "open read only rocksDB failed: " << boost::diagnostic_information(e)
+                  << std::endl;
         return nullptr;
     }
-    return std::unique_ptr<rocksdb::DB>(db);
 }
 
 fs::path getSstFileName(const std::string& path, size_t index)
@@ -1026,15 +1039,47 @@ bcos::Error::Ptr bcos::initializer::traverseRocksDB(const std::string& rockDBPat
     std::cout << "Traverse RocksDB: " << rockDBPath << std::endl;
     ReadOptions readOptions;
     readOptions.snapshot = db->GetSnapshot();
-    std::unique_ptr<Iterator> it(db->NewIterator(readOptions));
-    for (it->SeekToFirst(); it->Valid(); it->Next())
+    std::vector<ColumnFamilyHandle*> columnFamilies{db->DefaultColumnFamily()};
+    if (auto* columnFamilyDB = storage::asColumnFamilyDB(*db))
+    {
+        columnFamilies = columnFamilyDB->columnFamilies();
+    }
+    std::vector<Iterator*> iterators;
+    auto status = db->NewIterators(readOptions, columnFamilies, &iterators);
+    std::vector<std::unique_ptr<Iterator>> its(iterators.begin(), iterators.end());
+    if (!status.ok())
     {
+        db->ReleaseSnapshot(readOptions.snapshot);
+        return BCOS_ERROR_PTR(-1, "create rocksDB iterators failed, " + status.ToString());
+    }
+    for (auto& it : its)
+    {
+        it->SeekToFirst();
+    }
+    // merge the column families so the keys are processed in the order of a DB that is not
+    // split, the sst files require the keys to be sorted
+    while (true)
+    {
+        Iterator* it = nullptr;
+        for (auto& columnFamilyIt : its)
+        {
+            if (columnFamilyIt->Valid() &&
+                (it == nullptr || columnFamilyIt->key().compare(it->key()) < 0))
+            {
+                it = columnFamilyIt.get();
+            }
+        }
+        if (it == nullptr)
+        {
+            break;
+        }
         auto err = processor(it->key(), it->value());
         if (err)
         {
             db->ReleaseSnapshot(readOptions.snapshot);
             return err;
         }
+        it->Next();
     }
     db->ReleaseSnapshot(readOptions.snapshot);
     return nullptr;
@@ -1086,12 +1131,25 @@ bcos::Error::Ptr ingestIntoRocksDB(
         std::cerr << "Error while adding file, " << status.ToString() << std::endl;
         return BCOS_ERROR_PTR(-1, "Error while adding file, " + status.ToString());
     }
+    std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies{rocksDB.DefaultColumnFamily()};
+    if (auto* columnFamilyDB = storage::asColumnFamilyDB(rocksDB))
+    {
+        // the sst files are ingested into the default column family, move the block and the index
+        // tables out of it
+        auto moved = columnFamilyDB->migrate();
+        std::cout << "move " << moved << " rows to the column families" << std::endl;
+        columnFamilies = columnFamilyDB->columnFamilies();
+    }
     // compaction
-    status = rocksDB.CompactRange(rocksdb::CompactRangeOptions(), nullptr, nullptr);
-    if (!status.ok())
+    for (auto* columnFamily : columnFamilies)
     {
-        std::cerr << "compaction failed, " << status.ToString() << std::endl;
-        return BCOS_ERROR_PTR(-1, "compaction failed, " + status.ToString());
+        status = rocksDB.CompactRange(
+            rocksdb::CompactRangeOptions(), columnFamily, nullptr, nullptr);
+        if (!status.ok())
+        {
+            std::cerr << "compaction failed, " << status.ToString() << std::endl;
+            return BCOS_ERROR_PTR(-1, "compaction failed, " + status.ToString());
+        }
     }
     return nullptr;
 }
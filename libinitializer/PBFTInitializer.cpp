@@ -465,6 +465,8 @@ void PBFTInitializer::createPBFT()
     pbftConfig->setPipelinePerPeerCapacity(m_nodeConfig->pipelinePerPeerCapacity());
     pbftConfig->setPipelineLruCapacity(m_nodeConfig->pipelineLruCapacity());
     pbftConfig->setPipelineMaxPeers(m_nodeConfig->pipelineMaxPeers());
+    pbftConfig->setVerifyThreadCount(m_nodeConfig->verifyThreadCount());
+    pbftConfig->setVerifyCacheCapacity(m_nodeConfig->verifyCacheCapacity());
 
     // FIB-146 follow-up: reset PBFTPipeline state when sealer set actually
     // changes. RPBFT installs the tools instance during config construction;
@@ -23,6 +23,7 @@
  * @date 2021-10-14
  */
 #pragma once
+#include "bcos-storage/RocksDBColumnFamily.h"
 #include "bcos-storage/RocksDBStorage.h"
 #include <rocksdb/statistics.h>
 #ifdef WITH_TIKV
@@ -46,6 +47,10 @@ struct RocksDBOption
     size_t blockCacheSize = 128 << 20;  // 128MB
     bool optimizeLevelStyleCompaction = false;
     bool enable_blob_files = false;
+    // keep the state, the block data and the ledger indices in separate column families
+    bool enableColumnFamilies = false;
+    size_t blockDataCacheSize = 32 << 20;  // 32MB
+    size_t indexCacheSize = 32 << 20;      // 32MB
 };
 
 class StorageInitializer
@@ -108,6 +113,21 @@ public:
             BCOS_LOG(INFO) << "available disk space is less than 1GB";
             throw std::runtime_error("available disk space is less than 1GB");
         }
+        auto closeDB = [](rocksdb::DB* rocksDB) {
+            CancelAllBackgroundWork(rocksDB, true);
+            rocksDB->Close();
+            delete rocksDB;
+        };
+
+        // a DB split before must be opened with its column families even if they are disabled
+        if (rocksDBOption.enableColumnFamilies ||
+            storage::ColumnFamilyDB::isSplit(options, _path))
+        {
+            auto columnFamilyDB = storage::ColumnFamilyDB::open(
+                options, _path, createColumnFamilyOptions(options, rocksDBOption));
+            return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(
+                columnFamilyDB.release(), closeDB);
+        }
 
         // open DB
         rocksdb::Status status = rocksdb::DB::Open(options, _path, &db);
@@ -117,12 +137,44 @@ public:
                            << LOG_KV("message", status.ToString());
             throw std::runtime_error("open rocksDB failed, msg:" + status.ToString());
         }
-        return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(
-            db, [](rocksdb::DB* rocksDB) {
-                CancelAllBackgroundWork(rocksDB, true);
-                rocksDB->Close();
-                delete rocksDB;
-            });
+        return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(db, closeDB);
+    }
+
+    static storage::ColumnFamilyClassOptions createColumnFamilyOptions(
+        rocksdb::Options const& options, RocksDBOption const& rocksDBOption)
+    {
+        auto tableFactory = [](size_t blockCacheSize, size_t blockSize, double bloomBitsPerKey) {
+            rocksdb::BlockBasedTableOptions table_options;
+            table_options.block_cache = rocksdb::NewLRUCache(blockCacheSize);
+            table_options.filter_policy.reset(
+                rocksdb::NewBloomFilterPolicy(bloomBitsPerKey, false));
+            table_options.optimize_filters_for_memory = true;
+            table_options.block_size = blockSize;
+            return std::shared_ptr<rocksdb::TableFactory>(
+                rocksdb::NewBlockBasedTableFactory(table_options));
+        };
+        storage::ColumnFamilyClassOptions columnFamilyOptions;
+        columnFamilyOptions.fill(rocksdb::ColumnFamilyOptions(options));
+
+        // the state is hot and read at random, small blocks and uncompressed upper levels keep
+        // the point lookups cheap
+        auto& state = columnFamilyOptions[(size_t)storage::ColumnFamilyClass::STATE];
+        state.table_factory = tableFactory(rocksDBOption.blockCacheSize, 16 * 1024, 10);
+        state.compression_per_level.assign(state.num_levels, rocksdb::kZSTD);
+        state.compression_per_level[0] = rocksdb::kNoCompression;
+        state.compression_per_level[1] = rocksdb::kNoCompression;
+
+        // the block data is written once and rarely read, compress it in large blocks, the
+        // largest family gets the smallest filters as they stay in memory
+        auto& block = columnFamilyOptions[(size_t)storage::ColumnFamilyClass::BLOCK];
+        block.table_factory = tableFactory(rocksDBOption.blockDataCacheSize, 64 * 1024, 6);
+
+        // the indices are hashes and numbers which barely compress, only the last level is, the
+        // lookups of unknown hashes miss often so their filters are the most precise
+        auto& index = columnFamilyOptions[(size_t)storage::ColumnFamilyClass::INDEX];
+        index.table_factory = tableFactory(rocksDBOption.indexCacheSize, 16 * 1024, 14);
+        index.compression = rocksdb::kNoCompression;
+        return columnFamilyOptions;
     }
     static bcos::storage::TransactionalStorageInterface::Ptr build(
         auto&& rocksDB, const bcos::security::StorageEncryptInterface::Ptr& _dataEncrypt)
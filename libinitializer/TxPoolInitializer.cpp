@@ -50,6 +50,7 @@ TxPoolInitializer::TxPoolInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
     m_txpool->setCheckBlockLimit(m_nodeConfig->checkBlockLimit());
     m_txpool->setPreStoreBackpressureEnabled(m_nodeConfig->preStoreBackpressureEnabled());
     m_txpool->setPreStoreMaxInflight(m_nodeConfig->preStoreMaxInflight());
+    m_txpool->transactionSync()->config()->setCompactTxsRelay(m_nodeConfig->compactTxsRelay());
     if (m_nodeConfig->enableSendTxByTree())
     {
         INITIALIZER_LOG(INFO) << LOG_DESC("enableSendTxByTree");
@@ -1362,6 +1362,9 @@ generate_config_ini() {
     ; enable_rip_protocol=false
     ; enable compression for p2p message, default: true
     ; enable_compression=false
+    ; coalesce the small p2p messages sent to a peer into one frame, all the gateways must
+    ; support it, default: false
+    ; enable_frame_coalescing=false
     ; enable p2p ssl verify, default is true
     enable_ssl_verify = ${p2p_enable_ssl}
 
@@ -1383,6 +1386,10 @@ generate_config_ini() {
     ${enable_ssl_content}
     ; return input params in sendTransaction() return, default: true
     ; return_input_params=false
+    ; the max number of requests in a batch request, default: 100
+    ; batch_request_size_limit=100
+    ; the methods writing the result straight into the response, empty to disable
+    ; stream_response_methods=getBlockByHash,getBlockByNumber
     ; tars_rpc_port=20021
 
 [web3_rpc]
@@ -1445,6 +1452,12 @@ generate_common_ini() {
     enable_dag=true
     baseline_scheduler=false
     baseline_scheduler_parallel=false
+    ; use the Block-STM scheduler when baseline_scheduler_parallel is enabled
+    baseline_scheduler_block_stm=false
+    ; compact pending layers in background beyond this depth, 0 disables compaction
+    baseline_scheduler_max_layer_depth=0
+    ; keep the code hashes of the hottest contracts in this file and analyse them again on start
+    ; baseline_scheduler_code_cache_path=data/code_cache
 
 [storage]
     data_path=data
@@ -1461,6 +1474,14 @@ generate_common_ini() {
     ; if modify enable_separate_block_state, should clear the data directory
     ;enable_separate_block_state=false
     ;sync_archived_blocks=false
+    ; build the eth_getLogs index of the blocks committed before the index was introduced
+    ;enable_log_index_backfill=false
+    ; keep the state, the block data and the ledger indices in separate rocksdb column families,
+    ; the existing data is migrated when the node starts, once split the data directory stays split
+    ;enable_column_families=false
+    ; block cache of the block data and the ledger indices column families, in bytes
+    ;block_data_cache_size=33554432
+    ;index_cache_size=33554432
 
 [txpool]
     ; size of the txpool, default is 15000
@@ -1473,6 +1494,8 @@ generate_common_ini() {
     txs_expiration_time = 600
     ; permit txs from free node or not, default is false
     enable_txs_from_free_node = false
+    ; request the txs missed by a proposal with short ids, all the nodes must support it
+    ;compact_relay = false
 
 [sync]
     ; send transaction by tree-topology
@@ -1594,6 +1617,9 @@ generate_sm_config_ini() {
     ; enable_rip_protocol=false
     ; enable compression for p2p message, default: true
     ; enable_compression=false
+    ; coalesce the small p2p messages sent to a peer into one frame, all the gateways must
+    ; support it, default: false
+    ; enable_frame_coalescing=false
     ; enable p2p ssl verify, default is true
     enable_ssl_verify = ${p2p_enable_ssl}
 
@@ -1615,6 +1641,10 @@ generate_sm_config_ini() {
     ${enable_ssl_content}
     ; return input params in sendTransaction() return, default: true
     ; return_input_params=false
+    ; the max number of requests in a batch request, default: 100
+    ; batch_request_size_limit=100
+    ; the methods writing the result straight into the response, empty to disable
+    ; stream_response_methods=getBlockByHash,getBlockByNumber
 
 [web3_rpc]
     enable=false
@@ -127,20 +127,16 @@ DB* createSecondaryRocksDB(const std::string& path, const std::string& secondary
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
-    DB* db_secondary = nullptr;
-    Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
-    if (!status.ok())
+    try
     {
-        std::cout << "open rocksDB failed: " << status.ToString() << std::endl;
-        exit(1);
+        // a DB split into column families must be opened with all of them
+        return bcos::storage::ColumnFamilyDB::openForRead(options, path, secondaryPath).release();
     }
-    status = db_secondary->TryCatchUpWithPrimary();
-    if (!status.ok())
+    catch (std::exception const& e)
     {
-        std::cout << "TryCatchUpWithPrimary failed: " << status.ToString() << std::endl;
+        std::cout << "open rocksDB failed: " << boost::diagnostic_information(e) << std::endl;
         exit(1);
     }
-    return db_secondary;
 }
 
 std::pair<TransactionalStorageInterface::Ptr, TransactionalStorageInterface::Ptr>
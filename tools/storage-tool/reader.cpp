@@ -29,6 +29,7 @@
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/security/StorageEncryptInterface.h>
 #include <bcos-security/bcos-security/BcosKmsDataEncryption.h>
+#include <bcos-storage/RocksDBColumnFamily.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <boost/algorithm/hex.hpp>
 #include <boost/algorithm/string.hpp>
@@ -102,12 +103,12 @@ int main(int argc, const char* argv[])
     cout << "tableName    : " << tableName << endl;
     // auto factory = make_shared<RocksDBAdapterFactory>(storagePath);
 
-    rocksdb::DB* db;
     rocksdb::Options options;
     options.IncreaseParallelism();
     options.OptimizeLevelStyleCompaction();
     options.create_if_missing = false;
-    rocksdb::Status s = rocksdb::DB::Open(options, storagePath, &db);
+    // the reader never writes, a split DB is opened with all of its column families
+    auto db = bcos::storage::ColumnFamilyDB::openForRead(options, storagePath);
 
     std::string configPath("./config.ini");
     if (params.count("config"))
@@ -145,7 +146,7 @@ int main(int argc, const char* argv[])
     dataEncryption = std::make_shared<bcos::security::BcosKmsDataEncryption>(nodeConfig);
 
     auto adapter =
-        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), dataEncryption);
+        std::make_shared<RocksDBStorage>(std::move(db), dataEncryption);
 
     if (iterate)
     {
@@ -181,27 +181,24 @@ DB* createSecondaryRocksDB(
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
-    DB* db_secondary = nullptr;
-    Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
-    if (!status.ok())
+    try
     {
-        std::cout << "open rocksDB failed: " << status.ToString() << std::endl;
-        exit(1);
+        // a DB split into column families must be opened with all of them
+        return bcos::storage::ColumnFamilyDB::openForRead(options, path, secondaryPath).release();
     }
-    status = db_secondary->TryCatchUpWithPrimary();
-    if (!status.ok())
+    catch (std::exception const& e)
     {
-        std::cout << "TryCatchUpWithPrimary failed: " << status.ToString() << std::endl;
+        std::cout << "open rocksDB failed: " << boost::diagnostic_information(e) << std::endl;
         exit(1);
     }
-    return db_secondary;
 }
 
 void getTableSize(DB* db, const string_view& table)
 {
     std::string tableName(table);
     double size = 0;
-    rocksdb::Iterator* it = db->NewIterator(rocksdb::ReadOptions());
+    rocksdb::Iterator* it = db->NewIterator(
+        rocksdb::ReadOptions(), bcos::storage::columnFamilyOfTable(*db, tableName));
     it->Seek(tableName);
     while (it->Valid())
     {
@@ -671,7 +668,8 @@ int main(int argc, const char* argv[])
             {
                 // rocksdb
                 auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                rocksdb::Iterator* it = rocksdb->NewIterator(rocksdb::ReadOptions());
+                rocksdb::Iterator* it = rocksdb->NewIterator(rocksdb::ReadOptions(),
+                    bcos::storage::columnFamilyOfTable(*rocksdb, tableName));
                 it->Seek(tableName);
                 while (it->Valid())
                 {
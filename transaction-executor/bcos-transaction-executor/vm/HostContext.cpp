@@ -3,6 +3,8 @@
 #include "bcos-crypto/ChecksumAddress.h"
 #include <fmt/compile.h>
 #include <fmt/format.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
 
 evmc_bytes32 bcos::executor_v1::hostcontext::evm_hash_fn(const uint8_t* data, size_t size)
 {
@@ -79,6 +81,73 @@ bcos::executor_v1::hostcontext::getCacheExecutables()
     return cachedExecutables.m_cachedExecutables;
 }
 
+bcos::executor_v1::hostcontext::CacheCodeHashes&
+bcos::executor_v1::hostcontext::getCacheCodeHashes()
+{
+    struct CacheCodeHashes
+    {
+        bcos::executor_v1::hostcontext::CacheCodeHashes m_cachedCodeHashes;
+
+        CacheCodeHashes()
+        {
+            constexpr static auto maxContracts = 10000;
+            m_cachedCodeHashes.setMaxCapacity(sizeof(crypto::HashType) * maxContracts);
+        }
+    } static cachedCodeHashes;
+
+    return cachedCodeHashes.m_cachedCodeHashes;
+}
+
+std::vector<bcos::crypto::HashType> bcos::executor_v1::hostcontext::cachedCodeHashes()
+{
+    return task::syncWait([]() -> task::Task<std::vector<crypto::HashType>> {
+        std::vector<crypto::HashType> codeHashes;
+        auto range = co_await storage2::range(getCacheExecutables());
+        while (auto item = co_await range.next())
+        {
+            codeHashes.emplace_back(std::get<0>(*item));
+        }
+        co_return codeHashes;
+    }());
+}
+
+void bcos::executor_v1::hostcontext::saveCodeHashes(
+    std::string const& path, std::vector<crypto::HashType> const& codeHashes)
+{
+    // Write aside and rename, a node killed while saving keeps the previous file
+    auto tempPath = path + ".tmp";
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        for (auto const& codeHash : codeHashes)
+        {
+            output.write(reinterpret_cast<const char*>(codeHash.data()), codeHash.size());
+        }
+        if (!output.flush())
+        {
+            HOST_CONTEXT_LOG(WARNING) << "Save code hashes failed" << LOG_KV("path", tempPath);
+            return;
+        }
+    }
+    boost::system::error_code errorCode;
+    boost::filesystem::rename(tempPath, path, errorCode);
+    HOST_CONTEXT_LOG(INFO) << "Save code hashes" << LOG_KV("path", path)
+                           << LOG_KV("count", codeHashes.size())
+                           << LOG_KV("error", errorCode.message());
+}
+
+std::vector<bcos::crypto::HashType> bcos::executor_v1::hostcontext::loadCodeHashes(
+    std::string const& path)
+{
+    std::vector<crypto::HashType> codeHashes;
+    std::ifstream input(path, std::ios::binary);
+    crypto::HashType codeHash;
+    while (input.read(reinterpret_cast<char*>(codeHash.data()), codeHash.size()))
+    {
+        codeHashes.emplace_back(codeHash);
+    }
+    return codeHashes;
+}
+
 bcos::executor_v1::hostcontext::Executable::Executable(storage::Entry code, evmc_revision revision)
   : m_code(std::make_optional(std::move(code))),
     m_vmInstance(VMFactory::create(VMKind::evmone,
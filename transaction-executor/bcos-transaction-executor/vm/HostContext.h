@@ -91,31 +91,90 @@ struct Executable
 template <class Storage>
 using Account = ledger::account::EVMAccount<Storage>;
 
+// Executables are keyed by the hash of their code, contracts deployed from the same code share
+// one analysis
 using CacheExecutables =
-    storage2::memory_storage::MemoryStorage<evmc_address, std::shared_ptr<Executable>,
+    storage2::memory_storage::MemoryStorage<crypto::HashType, std::shared_ptr<Executable>,
         storage2::memory_storage::Attribute(
-            storage2::memory_storage::LRU | storage2::memory_storage::CONCURRENT),
-        std::hash<evmc_address>>;
+            storage2::memory_storage::CLOCK | storage2::memory_storage::CONCURRENT),
+        std::hash<crypto::HashType>>;
 CacheExecutables& getCacheExecutables();
 
+// The code hashes of the contracts that keep their code in the account instead of
+// s_code_binary, such code is hashed once when it is first loaded
+using CacheCodeHashes = storage2::memory_storage::MemoryStorage<evmc_address, crypto::HashType,
+    storage2::memory_storage::Attribute(
+        storage2::memory_storage::CLOCK | storage2::memory_storage::CONCURRENT),
+    std::hash<evmc_address>>;
+CacheCodeHashes& getCacheCodeHashes();
+
+// The code hashes of the cached executables, a restarted node analyses them again before serving
+// blocks, see warmupExecutables
+std::vector<crypto::HashType> cachedCodeHashes();
+void saveCodeHashes(std::string const& path, std::vector<crypto::HashType> const& codeHashes);
+std::vector<crypto::HashType> loadCodeHashes(std::string const& path);
+
 task::Task<std::shared_ptr<Executable>> getExecutable(
     auto& storage, const evmc_address& address, const evmc_revision& revision, bool binaryAddress)
 {
-    if (auto executable = co_await storage2::readOne(getCacheExecutables(), address))
+    Account<std::decay_t<decltype(storage)>> account(storage, address, binaryAddress);
+    // The code hash is read through the storage so a rolled back deployment never resolves to
+    // the code of another block
+    auto codeHash = co_await account.codeHash();
+    if (codeHash == crypto::HashType{})
+    {
+        if (auto cachedCodeHash = co_await storage2::readOne(getCacheCodeHashes(), address))
+        {
+            codeHash = *cachedCodeHash;
+        }
+    }
+    if (codeHash != crypto::HashType{})
     {
-        co_return std::move(*executable);
+        if (auto executable = co_await storage2::readOne(getCacheExecutables(), codeHash))
+        {
+            co_return std::move(*executable);
+        }
     }
 
-    if (Account<std::decay_t<decltype(storage)>> account(storage, address, binaryAddress);
-        auto codeEntry = co_await account.code())
+    if (auto codeEntry = co_await account.code())
     {
+        if (codeHash == crypto::HashType{})
+        {
+            auto code = codeEntry->get();
+            codeHash = executor::GlobalHashImpl::g_hashImpl->hash(
+                bytesConstRef(reinterpret_cast<const bcos::byte*>(code.data()), code.size()));
+            co_await storage2::writeOne(getCacheCodeHashes(), address, codeHash);
+        }
         auto executable = std::make_shared<Executable>(std::move(*codeEntry), revision);
-        co_await storage2::writeOne(getCacheExecutables(), address, executable);
+        co_await storage2::writeOne(getCacheExecutables(), codeHash, executable);
         co_return executable;
     }
     co_return {};
 }
 
+// Analyse the code of codeHashes from s_code_binary into the executable cache, returns the
+// number of executables analysed
+task::Task<size_t> warmupExecutables(
+    auto& storage, std::vector<crypto::HashType> const& codeHashes, evmc_revision revision)
+{
+    size_t count = 0;
+    for (auto const& codeHash : codeHashes)
+    {
+        if (co_await storage2::existsOne(getCacheExecutables(), codeHash))
+        {
+            continue;
+        }
+        if (auto codeEntry = co_await storage2::readOne(storage,
+                StateKeyView{ledger::SYS_CODE_BINARY, concepts::bytebuffer::toView(codeHash)}))
+        {
+            co_await storage2::writeOne(getCacheExecutables(), codeHash,
+                std::make_shared<Executable>(std::move(*codeEntry), revision));
+            ++count;
+        }
+    }
+    co_return count;
+}
+
 template <class Storage, class TransientStorage>
 class HostContext : public evmc_host_context
 {
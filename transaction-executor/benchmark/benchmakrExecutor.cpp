@@ -1,4 +1,5 @@
 #include "../bcos-transaction-executor/TransactionExecutorImpl.h"
+#include "../bcos-transaction-executor/vm/HostContext.h"
 #include "../tests/TestBytecode.h"
 #include "../tests/TestMemoryStorage.h"
 #include "bcos-codec/bcos-codec/abi/ContractABICodec.h"
@@ -190,10 +191,93 @@ static void call_deployAndCall(benchmark::State& state)
     }(state));
 }
 
+// Contracts with distinct code, as a node restarted with its hottest contracts sees them
+struct StartFixture : public Fixture
+{
+    constexpr static size_t CONTRACT_COUNT = 50;
+    std::vector<evmc_address> m_addresses;
+    std::vector<crypto::HashType> m_codeHashes;
+
+    StartFixture()
+    {
+        task::syncWait([this]() -> task::Task<void> {
+            for (size_t i = 0; i < CONTRACT_COUNT; ++i)
+            {
+                // Trailing bytes after the code keep the contracts apart without changing them
+                auto code = m_helloworldBytecodeBinary;
+                code.insert(code.end(), (const bcos::byte*)&i, (const bcos::byte*)(&i + 1));
+                auto codeHash = m_cryptoSuite->hashImpl()->hash(code);
+
+                evmc_address address{};
+                std::copy_n(codeHash.data(), sizeof(address.bytes), address.bytes);
+                hostcontext::Account<MutableStorage> account(m_backendStorage, address, false);
+                co_await account.setCode(std::move(code), {}, codeHash);
+                m_addresses.emplace_back(address);
+                m_codeHashes.emplace_back(codeHash);
+            }
+        }());
+    }
+
+    void clearExecutables()
+    {
+        task::syncWait([this]() -> task::Task<void> {
+            for (auto const& codeHash : m_codeHashes)
+            {
+                co_await storage2::removeOne(hostcontext::getCacheExecutables(), codeHash);
+            }
+        }());
+    }
+
+    void loadExecutables()
+    {
+        task::syncWait([this]() -> task::Task<void> {
+            for (auto const& address : m_addresses)
+            {
+                benchmark::DoNotOptimize(co_await hostcontext::getExecutable(
+                    m_backendStorage, address, EVMC_CANCUN, false));
+            }
+        }());
+    }
+};
+
+// The first block after a restart analyses the code of every contract it calls
+static void coldStart(benchmark::State& state)
+{
+    StartFixture fixture;
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        fixture.clearExecutables();
+        state.ResumeTiming();
+
+        fixture.loadExecutables();
+    }
+    state.SetItemsProcessed(state.iterations() * StartFixture::CONTRACT_COUNT);
+}
+
+// The saved code hashes were analysed before the node served the first block
+static void warmStart(benchmark::State& state)
+{
+    StartFixture fixture;
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        fixture.clearExecutables();
+        task::syncWait(hostcontext::warmupExecutables(
+            fixture.m_backendStorage, fixture.m_codeHashes, EVMC_CANCUN));
+        state.ResumeTiming();
+
+        fixture.loadExecutables();
+    }
+    state.SetItemsProcessed(state.iterations() * StartFixture::CONTRACT_COUNT);
+}
+
 BENCHMARK(create);
 BENCHMARK(call_setInt);
 BENCHMARK(call_setString);
 BENCHMARK(call_delegateCall);
 BENCHMARK(call_deployAndCall);
+BENCHMARK(coldStart);
+BENCHMARK(warmStart);
 
 BENCHMARK_MAIN();
\ No newline at end of file
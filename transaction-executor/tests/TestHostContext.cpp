@@ -716,4 +716,41 @@ BOOST_AUTO_TEST_CASE(setStorageStatusLegacy)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(sharedExecutable)
+{
+    syncWait([this]() -> Task<void> {
+        bcos::bytes code;
+        boost::algorithm::unhex(helloworldBytecode, std::back_inserter(code));
+        auto codeHash = hashImpl->hash(code);
+
+        auto address1 = bcos::unhexAddress("0x0000000000000000000000000000000000010001");
+        auto address2 = bcos::unhexAddress("0x0000000000000000000000000000000000010002");
+        for (auto const& address : {address1, address2})
+        {
+            Account<decltype(rollbackableStorage)> account(rollbackableStorage, address, false);
+            co_await account.setCode(code, {}, codeHash);
+        }
+
+        // Contracts deployed from the same code share one analysis
+        auto executable1 =
+            co_await getExecutable(rollbackableStorage, address1, EVMC_CANCUN, false);
+        auto executable2 =
+            co_await getExecutable(rollbackableStorage, address2, EVMC_CANCUN, false);
+        BOOST_REQUIRE(executable1);
+        BOOST_CHECK_EQUAL(executable1.get(), executable2.get());
+        auto codeHashes = cachedCodeHashes();
+        BOOST_CHECK(std::find(codeHashes.begin(), codeHashes.end(), codeHash) != codeHashes.end());
+
+        // A restarted node analyses the saved code hashes again
+        std::string path = "sharedExecutable.codeHashes";
+        saveCodeHashes(path, codeHashes);
+        BOOST_CHECK(loadCodeHashes(path) == codeHashes);
+        std::remove(path.c_str());
+
+        co_await storage2::removeOne(getCacheExecutables(), codeHash);
+        BOOST_CHECK_EQUAL(co_await warmupExecutables(storage, {codeHash}, EVMC_CANCUN), 1);
+        BOOST_CHECK(co_await storage2::existsOne(getCacheExecutables(), codeHash));
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "bcos-framework/ledger/Ledger.h"
 #include "bcos-framework/ledger/LedgerConfig.h"
 #include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-framework/ledger/StateTree.h"
 #include "bcos-framework/protocol/Block.h"
 #include "bcos-framework/protocol/BlockFactory.h"
 #include "bcos-framework/protocol/BlockHeader.h"
@@ -38,6 +39,7 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
 #include <chrono>
+#include <coroutine>
 #include <exception>
 #include <memory>
 #include <range/v3/algorithm/any_of.hpp>
@@ -126,6 +128,69 @@ task::Task<h256> calculateStateRoot(auto& storage, uint32_t blockVersion,
     co_return totalHash;
 }
 
+/**
+ * Calculates the state root with the sparse Merkle state tree. Only the paths of the keys modified
+ * in this block are rewritten, and the updated tree nodes are written into the tree storage.
+ *
+ * NOTE: the tree only covers the keys written after feature_state_tree was enabled, it must be
+ * enabled from genesis for the proofs to cover the whole state.
+ *
+ * @param storage The storage holding the entries modified in this block.
+ * @param treeStorage The storage to read and write the tree nodes, usually a view over storage.
+ * @param hashImpl The hash implementation to use for the calculation.
+ * @return A task that will eventually resolve to the new state root.
+ */
+task::Task<h256> calculateStateTreeRoot(auto& storage, auto& treeStorage, uint32_t blockVersion,
+    crypto::Hash const& hashImpl, ledger::Features const& features)
+{
+    auto range = co_await storage2::range(storage);
+    const std::optional<ledger::Features> featuresOpt(features);
+
+    std::vector<ledger::state_tree::Update> updates;
+    using KeyValueType = task::AwaitableReturnType<decltype(range.next())>;
+    tbb::parallel_pipeline(tbb::this_task_arena::max_concurrency(),
+        tbb::make_filter<void, KeyValueType>(tbb::filter_mode::serial_in_order,
+            [&](tbb::flow_control& control) -> KeyValueType {
+                if (auto keyValue = task::tbb::syncWait(range.next()))
+                {
+                    return keyValue;
+                }
+                control.stop();
+                return {};
+            }) &
+            tbb::make_filter<KeyValueType, std::optional<ledger::state_tree::Update>>(
+                tbb::filter_mode::parallel,
+                [&](KeyValueType keyValue) -> std::optional<ledger::state_tree::Update> {
+                    auto& [key, value] = *keyValue;
+                    executor_v1::StateKeyView view(key);
+                    auto [tableName, keyName] = view.get();
+                    if (tableName == ledger::SYS_STATE_TREE)
+                    {
+                        return {};
+                    }
+
+                    ledger::state_tree::Update update{
+                        .path = ledger::state_tree::keyPath(tableName, keyName, hashImpl)};
+                    if (auto* entry = std::get_if<storage::Entry>(std::addressof(value)))
+                    {
+                        update.valueHash =
+                            entry->hash(tableName, keyName, hashImpl, blockVersion, featuresOpt);
+                    }
+                    return update;
+                }) &
+            tbb::make_filter<std::optional<ledger::state_tree::Update>, void>(
+                tbb::filter_mode::serial_out_of_order,
+                [&](std::optional<ledger::state_tree::Update> update) {
+                    if (update)
+                    {
+                        updates.emplace_back(std::move(*update));
+                    }
+                }));
+
+    ledger::state_tree::StateTreeUpdater updater(treeStorage, hashImpl);
+    co_return co_await updater.apply(std::move(updates));
+}
+
 h256 calculateReceiptRoot(
     ::ranges::range auto const& receipts, protocol::Block& block, crypto::Hash const& hashImpl)
 {
@@ -148,14 +213,14 @@ h256 calculateReceiptRoot(
 /**
  * @brief Finishes the execution of a transaction and updates the block header and block.
  *
- * @param storage The storage object used to store the transaction receipts.
+ * @param view The storage view of the block, its mutable storage holds the block's modifications.
  * @param receipts The range of transaction receipts to be stored.
  * @param blockHeader The original block header.
  * @param newBlockHeader The updated block header.
  * @param newBlock The updated block.
  * @param hashImpl The hash implementation used to calculate the block hash.
  */
-task::Task<void> finishExecute(auto& storage, ::ranges::range auto receipts,
+task::Task<void> finishExecute(auto& view, ::ranges::range auto receipts,
     protocol::BlockHeader& newBlockHeader, protocol::Block& block,
     ::ranges::input_range auto transactions, bool& sysBlock, crypto::Hash const& hashImpl,
     ledger::Features const& features)
@@ -167,10 +232,26 @@ task::Task<void> finishExecute(auto& storage, ::ranges::range auto receipts,
     h256 stateRoot;
     h256 receiptRoot;
 
+    // 区块的修改在此之后不再变化，计算状态根前排序一次，之后写入的key在压入视图时合并进来
+    // The modifications of the block are settled, sort them once before the state root is
+    // calculated, the keys written afterwards are merged in when the view is pushed
+    if constexpr (requires { mutableStorage(view).freeze(); })
+    {
+        mutableStorage(view).freeze();
+    }
     tbb::parallel_invoke([&]() { transactionRoot = calculateTransactionRoot(block, hashImpl); },
         [&]() {
-            stateRoot = task::tbb::syncWait(
-                calculateStateRoot(storage, block.blockHeader()->version(), hashImpl, features));
+            auto blockVersion = block.blockHeader()->version();
+            if (features.get(ledger::Features::Flag::feature_state_tree))
+            {
+                stateRoot = task::tbb::syncWait(calculateStateTreeRoot(
+                    mutableStorage(view), view, blockVersion, hashImpl, features));
+            }
+            else
+            {
+                stateRoot = task::tbb::syncWait(
+                    calculateStateRoot(mutableStorage(view), blockVersion, hashImpl, features));
+            }
         },
         [&]() { receiptRoot = calculateReceiptRoot(receipts, block, hashImpl); },
         [&]() {
@@ -209,12 +290,12 @@ task::Task<void> finishExecute(auto& storage, ::ranges::range auto receipts,
 
     storage::Entry hashEntry;
     hashEntry.importFields({blockHash.asBytes()});
-    co_await storage2::writeOne(storage,
+    co_await storage2::writeOne(mutableStorage(view),
         executor_v1::StateKey{ledger::SYS_NUMBER_2_HASH, blockNumberStr}, std::move(hashEntry));
 
     storage::Entry hash2NumberEntry;
     hash2NumberEntry.importFields({blockNumberStr});
-    co_await storage2::writeOne(storage,
+    co_await storage2::writeOne(mutableStorage(view),
         executor_v1::StateKey{
             ledger::SYS_HASH_2_NUMBER, bcos::concepts::bytebuffer::toView(blockHash)},
         hash2NumberEntry);
@@ -252,6 +333,9 @@ private:
     int64_t m_lastCommittedBlockNumber{-1};
     std::mutex m_commitMutex;
     tbb::task_group m_asyncGroup;
+    // 不可变层超过该深度时在后台合并，0表示不合并
+    // Compact the immutable layers in background beyond this depth, 0 disables compaction
+    size_t m_maxLayerDepth = 0;
 
     struct ExecuteResult
     {
@@ -264,6 +348,182 @@ private:
     std::deque<std::shared_ptr<ExecuteResult>> m_results;
     std::mutex m_resultsMutex;
 
+    struct BlockExecution
+    {
+        typename MultiLayerStorage::ViewType m_view;
+        std::vector<protocol::Transaction::ConstPtr> m_transactions;
+        std::vector<protocol::TransactionReceipt::Ptr> m_receipts;
+        protocol::BlockHeader::Ptr m_executedBlockHeader;
+        bool m_sysBlock{};
+        std::chrono::milliseconds::rep m_elapsed{};
+    };
+
+    // 共识期间在后台提前执行的提案，提案哈希与父状态都未变化时coExecuteBlock直接采用其结果
+    // A proposal executed in background during consensus, coExecuteBlock adopts its result when
+    // the proposal hash and the parent state are both unchanged
+    // 提前执行的结果，等待它的协程挂起而不占用TBB线程
+    // The result of a pre-execution, the coroutine waiting for it is suspended instead of
+    // blocking a TBB worker
+    class SpeculativeExecution
+    {
+    public:
+        void finish(std::shared_ptr<BlockExecution> execution)
+        {
+            std::coroutine_handle<> waiter;
+            {
+                std::unique_lock lock(m_mutex);
+                m_execution = std::move(execution);
+                m_finished = true;
+                waiter = std::exchange(m_waiter, {});
+            }
+            if (waiter)
+            {
+                waiter.resume();
+            }
+        }
+        bool finished()
+        {
+            std::unique_lock lock(m_mutex);
+            return m_finished;
+        }
+
+        constexpr static bool await_ready() noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::unique_lock lock(m_mutex);
+            if (m_finished)
+            {
+                return false;
+            }
+            m_waiter = handle;
+            return true;
+        }
+        std::shared_ptr<BlockExecution> await_resume() { return m_execution; }
+
+    private:
+        std::mutex m_mutex;
+        bool m_finished = false;
+        std::shared_ptr<BlockExecution> m_execution;
+        std::coroutine_handle<> m_waiter;
+    };
+
+    struct Speculation
+    {
+        protocol::BlockNumber m_number{};
+        crypto::HashType m_proposalHash;
+        uint64_t m_parentVersion{};
+        std::shared_ptr<SpeculativeExecution> m_execution;
+    };
+    std::optional<Speculation> m_speculation;
+    std::mutex m_speculationMutex;
+    // 已压入的执行结果视图数，由m_executeMutex保护，用于判断提前执行的父状态是否变化
+    // Number of execution views pushed, owned by m_executeMutex, tells whether the parent state
+    // of a speculation has changed
+    uint64_t m_executedVersion = 0;
+
+public:
+    struct SpeculativeStatistics
+    {
+        std::atomic_uint64_t hits{0};
+        std::atomic_uint64_t discards{0};
+        std::atomic_int64_t savedMilliseconds{0};
+    };
+
+private:
+    SpeculativeStatistics m_speculativeStatistics;
+
+    /**
+     * Executes the block on the view, the receipts are appended to the block.
+     *
+     * @param view A view forked from the latest executed state with a new mutable storage.
+     * @param block The block to execute.
+     * @return The execution, nullptr if some transactions of the block are not in the txpool.
+     */
+    task::Task<std::shared_ptr<BlockExecution>> executeOnView(
+        typename MultiLayerStorage::ViewType view, protocol::Block& block)
+    {
+        auto now = current();
+        auto blockHeader = block.blockHeader();
+        auto transactions = co_await getTransactions(m_txpool.get(), block);
+        if (::ranges::any_of(transactions, [](auto const& tx) { return tx == nullptr; }))
+        {
+            BASELINE_SCHEDULER_LOG(ERROR)
+                << "Not found transactions in txpool for block: " << blockHeader->number();
+            co_return nullptr;
+        }
+        auto ledgerConfig =
+            co_await ledger::getLedgerConfig(view, blockHeader->number(), m_blockFactory.get());
+        auto receipts = co_await m_schedulerImpl.get().executeBlock(view, m_executor.get(),
+            *blockHeader, ::ranges::views::indirect(transactions), *ledgerConfig);
+
+        auto executedBlockHeader =
+            m_blockFactory.get().blockHeaderFactory()->populateBlockHeader(blockHeader);
+        bool sysBlock = false;
+        co_await finishExecute(view, ::ranges::views::all(receipts), *executedBlockHeader, block,
+            ::ranges::views::all(transactions), sysBlock, m_hashImpl.get(),
+            ledgerConfig->features());
+
+        co_return std::make_shared<BlockExecution>(BlockExecution{.m_view = std::move(view),
+            .m_transactions = std::move(transactions),
+            .m_receipts = std::move(receipts),
+            .m_executedBlockHeader = std::move(executedBlockHeader),
+            .m_sysBlock = sysBlock,
+            .m_elapsed = current() - now});
+    }
+
+    /**
+     * Takes the pending speculation and returns its execution if it is for this block and was
+     * executed on the current parent state. Must be called with m_executeMutex held.
+     *
+     * The speculation is awaited even when it is discarded, so that two blocks never execute
+     * at the same time, the coroutine is resumed by the pre-execution once it finishes.
+     */
+    task::Task<std::shared_ptr<BlockExecution>> takeSpeculation(protocol::Block& block)
+    {
+        std::optional<Speculation> speculation;
+        {
+            std::unique_lock speculationLock(m_speculationMutex);
+            speculation.swap(m_speculation);
+        }
+        if (!speculation)
+        {
+            co_return nullptr;
+        }
+
+        auto waitStart = current();
+        auto execution = co_await *speculation->m_execution;
+        auto waited = current() - waitStart;
+        auto const& blockHeader = *block.blockHeader();
+        if (!execution || speculation->m_number != blockHeader.number() ||
+            speculation->m_proposalHash != blockHeader.hash() ||
+            speculation->m_parentVersion != m_executedVersion)
+        {
+            ++m_speculativeStatistics.discards;
+            BASELINE_SCHEDULER_LOG(INFO)
+                << "Discard pre-executed block: " << speculation->m_number
+                << " | executed: " << (execution != nullptr)
+                << " | parentChanged: " << (speculation->m_parentVersion != m_executedVersion);
+            co_return nullptr;
+        }
+
+        // 提前执行时收据写入的是提案的另一个副本
+        // The receipts were appended to another copy of the proposal during pre-execution
+        block.clearReceipts();
+        for (auto& receipt : execution->m_receipts)
+        {
+            block.appendReceipt(receipt);
+        }
+        auto hits = ++m_speculativeStatistics.hits;
+        auto saved = (m_speculativeStatistics.savedMilliseconds +=
+                      std::max<int64_t>(execution->m_elapsed - waited, 0));
+        BASELINE_SCHEDULER_LOG(INFO)
+            << "Adopt pre-executed block: " << blockHeader.number()
+            << " | executeElapsed: " << execution->m_elapsed << "ms | waited: " << waited
+            << "ms | hitRate: " << hits << "/" << (hits + m_speculativeStatistics.discards.load())
+            << " | totalSaved: " << saved << "ms";
+        co_return execution;
+    }
+
     /**
      * Executes a block and returns a tuple containing an error (if any), the block header, and
      * a boolean indicating success.
@@ -352,28 +612,22 @@ private:
             }
 
             auto now = current();
-            auto view = m_multiLayerStorage.get().fork();
-            view.newMutable();
-            auto transactions = co_await getTransactions(m_txpool.get(), *block);
-            if (::ranges::any_of(transactions, [](auto const& tx) { return tx == nullptr; }))
+            auto execution = co_await takeSpeculation(*block);
+            if (!execution)
+            {
+                auto view = m_multiLayerStorage.get().fork();
+                view.newMutable();
+                execution = co_await executeOnView(std::move(view), *block);
+            }
+            if (!execution)
             {
                 auto message = fmt::format(
                     "Not found transactions in txpool for block: {}", blockHeader->number());
-                BASELINE_SCHEDULER_LOG(ERROR) << message;
                 co_return {BCOS_ERROR_UNIQUE_PTR(scheduler::SchedulerError::InvalidBlocks, message),
                     nullptr, false};
             }
-            auto ledgerConfig =
-                co_await ledger::getLedgerConfig(view, blockHeader->number(), m_blockFactory.get());
-            auto receipts = co_await m_schedulerImpl.get().executeBlock(view, m_executor.get(),
-                *blockHeader, ::ranges::views::indirect(transactions), *ledgerConfig);
-
-            auto executedBlockHeader =
-                m_blockFactory.get().blockHeaderFactory()->populateBlockHeader(blockHeader);
-            bool sysBlock = false;
-            co_await finishExecute(mutableStorage(view), ::ranges::views::all(receipts),
-                *executedBlockHeader, *block, ::ranges::views::all(transactions), sysBlock,
-                m_hashImpl.get(), ledgerConfig->features());
+            auto executedBlockHeader = execution->m_executedBlockHeader;
+            auto sysBlock = execution->m_sysBlock;
 
             if (verify && (executedBlockHeader->hash() != blockHeader->hash()))
             {
@@ -403,8 +657,8 @@ private:
 
             auto executeResult = std::make_shared<ExecuteResult>(
                 ExecuteResult{.m_transactions = std::make_shared<protocol::ConstTransactions>(
-                                  std::move(transactions)),
-                    .m_receipts = std::move(receipts),
+                                  std::move(execution->m_transactions)),
+                    .m_receipts = std::move(execution->m_receipts),
                     .m_executedBlockHeader = executedBlockHeader,
                     .m_block = std::move(block),
                     .m_sysBlock = sysBlock});
@@ -421,7 +675,7 @@ private:
                 std::unique_lock resultsLock(m_resultsMutex);
                 assert(m_results.size() < MAX_PENDING_RESULTS);
 
-                m_multiLayerStorage.get().pushView(std::move(view));
+                m_multiLayerStorage.get().pushView(std::move(execution->m_view));
                 try
                 {
                     m_results.push_front(std::move(executeResult));
@@ -435,6 +689,8 @@ private:
             // FIB-102: Update m_lastExecutedBlockNumber only after the queue write
             // succeeds. Owned by m_executeMutex (still held via executeLock).
             m_lastExecutedBlockNumber = blockHeader->number();
+            ++m_executedVersion;
+            compactLayersInBackground();
 
             BASELINE_SCHEDULER_LOG(INFO)
                 << "Execute block finished: " << executedBlockHeader->number() << " | "
@@ -677,6 +933,26 @@ private:
         }
     }
 
+    void compactLayersInBackground()
+    {
+        if (m_maxLayerDepth == 0 || m_multiLayerStorage.get().layerDepth() <= m_maxLayerDepth)
+        {
+            return;
+        }
+        m_asyncGroup.run([this]() {
+            auto& multiLayerStorage = m_multiLayerStorage.get();
+            if (task::tbb::syncWait(multiLayerStorage.compactLayers(m_maxLayerDepth)))
+            {
+                auto const& statistics = multiLayerStorage.compactionStatistics();
+                BASELINE_SCHEDULER_LOG(DEBUG)
+                    << "Compact layers finished | depth: " << multiLayerStorage.layerDepth()
+                    << " | compactions: " << statistics.compactions.load()
+                    << " | aborted: " << statistics.abortedCompactions.load()
+                    << " | totalElapsed: " << statistics.compactionMicroseconds.load() << "us";
+            }
+        });
+    }
+
 public:
     BaselineScheduler(MultiLayerStorage& multiLayerStorage, SchedulerImpl& schedulerImpl,
         Executor& executor, protocol::BlockFactory& blockFactory, Ledger& ledger,
@@ -807,11 +1083,67 @@ public:
         co_return co_await account.storageEntry(key);
     }
 
-    void preExecuteBlock([[maybe_unused]] bcos::protocol::Block::Ptr block,
-        [[maybe_unused]] bool verify,
-        [[maybe_unused]] std::function<void(Error::Ptr)> callback) override
+    void preExecuteBlock(bcos::protocol::Block::Ptr block, [[maybe_unused]] bool verify,
+        std::function<void(Error::Ptr)> callback) override
     {
+        // 提案在后台执行，不阻塞共识
+        // The proposal is executed in background without blocking the consensus
         callback(nullptr);
+
+        // 只在最新执行状态上提前执行下一个区块，正在执行区块时父状态未定，直接跳过
+        // Only the next block is pre-executed on the latest executed state, the parent state is
+        // not settled while a block is executing so skip it then
+        std::unique_lock executeLock(m_executeMutex, std::try_to_lock);
+        auto blockHeader = block->blockHeader();
+        if (!executeLock.owns_lock() ||
+            (m_lastExecutedBlockNumber != -1 &&
+                blockHeader->number() - m_lastExecutedBlockNumber != 1))
+        {
+            BASELINE_SCHEDULER_LOG(DEBUG) << "Skip pre-execute block: " << blockHeader->number();
+            return;
+        }
+
+        std::unique_lock speculationLock(m_speculationMutex);
+        if (m_speculation)
+        {
+            if (m_speculation->m_proposalHash == blockHeader->hash() ||
+                !m_speculation->m_execution->finished())
+            {
+                return;
+            }
+            // 被新提案替换的结果不会再被采用
+            // A result replaced by a newer proposal will never be adopted
+            ++m_speculativeStatistics.discards;
+        }
+
+        using ViewType = typename MultiLayerStorage::ViewType;
+        auto view = std::make_shared<ViewType>(m_multiLayerStorage.get().fork());
+        view->newMutable();
+        auto execution = std::make_shared<SpeculativeExecution>();
+        m_speculation.emplace(Speculation{.m_number = blockHeader->number(),
+            .m_proposalHash = blockHeader->hash(),
+            .m_parentVersion = m_executedVersion,
+            .m_execution = execution});
+        speculationLock.unlock();
+        executeLock.unlock();
+
+        BASELINE_SCHEDULER_LOG(INFO) << "Pre-execute block: " << blockHeader->number();
+        m_asyncGroup.run([this, block = std::move(block), view, execution]() {
+            std::shared_ptr<BlockExecution> result;
+            try
+            {
+                result = task::tbb::syncWait(executeOnView(std::move(*view), *block));
+            }
+            catch (std::exception& e)
+            {
+                BASELINE_SCHEDULER_LOG(WARNING)
+                    << "Pre-execute block failed: " << block->blockHeader()->number() << " | "
+                    << boost::diagnostic_information(e);
+            }
+            // 等待中的coExecuteBlock在此恢复执行
+            // The coExecuteBlock waiting for it resumes here
+            execution->finish(std::move(result));
+        });
     }
 
     void stop() override {};
@@ -830,6 +1162,10 @@ public:
     }
 
     void setVersion(int version, ledger::LedgerConfig::Ptr ledgerConfig) override {}
+
+    void setMaxLayerDepth(size_t maxLayerDepth) { m_maxLayerDepth = maxLayerDepth; }
+
+    SpeculativeStatistics const& speculativeStatistics() const { return m_speculativeStatistics; }
 };
 
 }  // namespace bcos::scheduler_v1
@@ -0,0 +1,398 @@
+#pragma once
+#include "bcos-framework/storage2/Storage.h"
+#include "bcos-utilities/Exceptions.h"
+#include <oneapi/tbb/rw_mutex.h>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::scheduler_v1
+{
+
+// 读到了一个ESTIMATE版本，说明依赖的低序号交易正在重新执行
+// Read an ESTIMATE version, the lower transaction we depend on is being re-executed
+DERIVE_BCOS_EXCEPTION(ReadEstimateError);
+
+/**
+ * Multi-version memory of Block-STM: every key keeps one version per transaction index that
+ * wrote it, so a transaction always reads the write of the highest lower transaction. The read
+ * set of every transaction is recorded with the versions it observed, letting validation decide
+ * per transaction whether a re-execution is required.
+ */
+template <class KeyType, class ValueType>
+class MultiVersionMemory
+{
+public:
+    using Key = KeyType;
+    using Value = ValueType;
+    constexpr static int32_t STORAGE_VERSION = -1;
+
+    struct Version
+    {
+        int32_t transactionIndex = STORAGE_VERSION;
+        int32_t incarnation = 0;
+
+        friend bool operator==(Version const&, Version const&) = default;
+    };
+
+    enum class ReadStatus : uint8_t
+    {
+        NOT_FOUND,
+        OK,
+        ESTIMATE
+    };
+
+    struct ReadResult
+    {
+        ReadStatus status = ReadStatus::NOT_FOUND;
+        Version version;
+        storage2::StorageValueType<Value> value;
+    };
+
+    struct ReadRecord
+    {
+        Key key;
+        Version version;
+    };
+
+private:
+    struct VersionedValue
+    {
+        int32_t incarnation = 0;
+        bool estimate = false;
+        storage2::StorageValueType<Value> value;
+    };
+    // 按交易序号升序，读取时找到小于当前序号的最大版本
+    // Ascending by transaction index, a read picks the highest version below its own index
+    using Versions = std::map<int32_t, VersionedValue>;
+
+    struct Bucket
+    {
+        tbb::rw_mutex mutex;
+        std::unordered_map<Key, Versions, std::hash<Key>, std::equal_to<Key>> data;
+    };
+
+    struct TransactionSlot
+    {
+        std::mutex mutex;
+        std::shared_ptr<std::vector<ReadRecord> const> readSet;
+        std::vector<Key> writtenKeys;
+    };
+
+    std::vector<Bucket> m_buckets;
+    std::vector<TransactionSlot> m_slots;
+
+    Bucket& getBucket(Key const& key)
+    {
+        return m_buckets[std::hash<Key>{}(key) % m_buckets.size()];
+    }
+
+    void write(Key const& key, Version version, storage2::StorageValueType<Value> value)
+    {
+        auto& bucket = getBucket(key);
+        tbb::rw_mutex::scoped_lock lock(bucket.mutex, true);
+        auto& versioned = bucket.data[key][version.transactionIndex];
+        versioned.incarnation = version.incarnation;
+        versioned.estimate = false;
+        versioned.value = std::move(value);
+    }
+
+    void remove(Key const& key, int32_t transactionIndex)
+    {
+        auto& bucket = getBucket(key);
+        tbb::rw_mutex::scoped_lock lock(bucket.mutex, true);
+        if (auto it = bucket.data.find(key); it != bucket.data.end())
+        {
+            it->second.erase(transactionIndex);
+            if (it->second.empty())
+            {
+                bucket.data.erase(it);
+            }
+        }
+    }
+
+    template <bool withValue>
+    ReadResult readImpl(Key const& key, int32_t transactionIndex)
+    {
+        auto& bucket = getBucket(key);
+        tbb::rw_mutex::scoped_lock lock(bucket.mutex, false);
+
+        ReadResult result;
+        auto it = bucket.data.find(key);
+        if (it == bucket.data.end())
+        {
+            return result;
+        }
+        auto& versions = it->second;
+        auto versionIt = versions.lower_bound(transactionIndex);
+        if (versionIt == versions.begin())
+        {
+            return result;
+        }
+        --versionIt;
+
+        result.version = {.transactionIndex = versionIt->first,
+            .incarnation = versionIt->second.incarnation};
+        if (versionIt->second.estimate)
+        {
+            result.status = ReadStatus::ESTIMATE;
+            return result;
+        }
+        result.status = ReadStatus::OK;
+        if constexpr (withValue)
+        {
+            result.value = versionIt->second.value;
+        }
+        return result;
+    }
+
+public:
+    explicit MultiVersionMemory(size_t transactionCount, unsigned buckets = 0)
+      : m_buckets(buckets == 0 ? std::thread::hardware_concurrency() * 2 + 1 : buckets),
+        m_slots(transactionCount)
+    {}
+    MultiVersionMemory(const MultiVersionMemory&) = delete;
+    MultiVersionMemory(MultiVersionMemory&&) = delete;
+    MultiVersionMemory& operator=(const MultiVersionMemory&) = delete;
+    MultiVersionMemory& operator=(MultiVersionMemory&&) = delete;
+    ~MultiVersionMemory() noexcept = default;
+
+    ReadResult read(Key const& key, int32_t transactionIndex)
+    {
+        return readImpl<true>(key, transactionIndex);
+    }
+
+    /**
+     * Publishes the write set and read set of one incarnation.
+     *
+     * @param writeSet Range of (key, value) written by the incarnation, value may be DELETED.
+     * @return true if the incarnation wrote a key that the previous incarnation did not write,
+     * in which case higher transactions must be validated again.
+     */
+    bool record(int32_t transactionIndex, int32_t incarnation, ::ranges::input_range auto writeSet,
+        std::vector<ReadRecord> readSet)
+    {
+        auto& slot = m_slots[transactionIndex];
+        std::vector<Key> newKeys;
+        for (auto&& [key, value] : writeSet)
+        {
+            write(key,
+                Version{.transactionIndex = transactionIndex, .incarnation = incarnation},
+                std::forward<decltype(value)>(value));
+            newKeys.emplace_back(std::forward<decltype(key)>(key));
+        }
+        std::sort(newKeys.begin(), newKeys.end());
+
+        auto& oldKeys = slot.writtenKeys;
+        std::vector<Key> removedKeys;
+        std::set_difference(oldKeys.begin(), oldKeys.end(), newKeys.begin(), newKeys.end(),
+            std::back_inserter(removedKeys));
+        for (auto const& key : removedKeys)
+        {
+            remove(key, transactionIndex);
+        }
+        bool wroteNewKey = !std::includes(
+            oldKeys.begin(), oldKeys.end(), newKeys.begin(), newKeys.end());
+        oldKeys.swap(newKeys);
+
+        auto readSetPtr = std::make_shared<std::vector<ReadRecord> const>(std::move(readSet));
+        std::unique_lock lock(slot.mutex);
+        slot.readSet = std::move(readSetPtr);
+        return wroteNewKey;
+    }
+
+    /**
+     * Checks whether every version observed by the last incarnation of the transaction is still
+     * the version it would read now.
+     */
+    bool validateReadSet(int32_t transactionIndex)
+    {
+        auto& slot = m_slots[transactionIndex];
+        std::shared_ptr<std::vector<ReadRecord> const> readSet;
+        {
+            std::unique_lock lock(slot.mutex);
+            readSet = slot.readSet;
+        }
+        if (!readSet)
+        {
+            return true;
+        }
+
+        return std::all_of(readSet->begin(), readSet->end(), [&](ReadRecord const& record) {
+            auto result = readImpl<false>(record.key, transactionIndex);
+            switch (result.status)
+            {
+            case ReadStatus::ESTIMATE:
+                return false;
+            case ReadStatus::NOT_FOUND:
+                return record.version.transactionIndex == STORAGE_VERSION;
+            case ReadStatus::OK:
+            default:
+                return result.version == record.version;
+            }
+        });
+    }
+
+    // 交易被中止后，将其写入标记为ESTIMATE，使依赖它的交易等待而不是读到过期值
+    // Once aborted, mark its writes as ESTIMATE so dependents wait instead of reading stale values
+    void convertWritesToEstimates(int32_t transactionIndex)
+    {
+        for (auto const& key : m_slots[transactionIndex].writtenKeys)
+        {
+            auto& bucket = getBucket(key);
+            tbb::rw_mutex::scoped_lock lock(bucket.mutex, true);
+            if (auto it = bucket.data.find(key); it != bucket.data.end())
+            {
+                if (auto versionIt = it->second.find(transactionIndex);
+                    versionIt != it->second.end())
+                {
+                    versionIt->second.estimate = true;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Storage handed to the executor for one incarnation of one transaction. Writes are buffered
+ * in a private mutable storage, reads go to the own writes first, then to the multi-version
+ * memory of lower transactions, then to the block's base view, and each of them is recorded
+ * for validation.
+ */
+template <class StorageType, class MutableStorageType>
+class MultiVersionTransactionStorage
+{
+public:
+    using Key = typename MutableStorageType::Key;
+    using Value = typename MutableStorageType::Value;
+    using MutableStorage = MutableStorageType;
+    using Memory = MultiVersionMemory<Key, Value>;
+
+private:
+    std::reference_wrapper<Memory> m_memory;
+    std::reference_wrapper<std::remove_reference_t<StorageType>> m_storage;
+    int32_t m_transactionIndex;
+    MutableStorage m_writeSet;
+    std::vector<typename Memory::ReadRecord> m_readSet;
+    std::optional<int32_t> m_blockingTransactionIndex;
+
+public:
+    MultiVersionTransactionStorage(Memory& memory, StorageType& storage, int32_t transactionIndex)
+      : m_memory(memory), m_storage(storage), m_transactionIndex(transactionIndex)
+    {}
+
+    auto readOneRaw(const auto& key) -> task::Task<storage2::StorageValueType<Value>>
+    {
+        if (auto value = co_await m_writeSet.readOneRaw(key);
+            !std::holds_alternative<storage2::NOT_EXISTS_TYPE>(value))
+        {
+            co_return value;
+        }
+
+        Key stateKey{key};
+        auto result = m_memory.get().read(stateKey, m_transactionIndex);
+        switch (result.status)
+        {
+        case Memory::ReadStatus::ESTIMATE:
+            m_blockingTransactionIndex = result.version.transactionIndex;
+            BOOST_THROW_EXCEPTION(ReadEstimateError{});
+        case Memory::ReadStatus::OK:
+            m_readSet.emplace_back(std::move(stateKey), result.version);
+            co_return std::move(result.value);
+        case Memory::ReadStatus::NOT_FOUND:
+        default:
+            m_readSet.emplace_back(std::move(stateKey), typename Memory::Version{});
+            co_return co_await m_storage.get().readOneRaw(key);
+        }
+    }
+
+    // DIRECT reads are Rollbackable's pre-image snapshots of this incarnation's own writes,
+    // they are not transaction-visible and never leave the private write set.
+    auto readOneRaw(const auto& key, storage2::DIRECT_TYPE /*unused*/)
+        -> task::Task<storage2::StorageValueType<Value>>
+    {
+        co_return co_await m_writeSet.readOneRaw(key);
+    }
+
+    auto readSomeRaw(::ranges::input_range auto keys)
+        -> task::Task<std::vector<storage2::StorageValueType<Value>>>
+    {
+        std::vector<storage2::StorageValueType<Value>> values;
+        for (auto&& key : keys)
+        {
+            values.emplace_back(co_await readOneRaw(key));
+        }
+        co_return values;
+    }
+
+    auto readSomeRaw(::ranges::input_range auto keys, storage2::DIRECT_TYPE /*unused*/)
+        -> task::Task<std::vector<storage2::StorageValueType<Value>>>
+    {
+        co_return co_await m_writeSet.readSomeRaw(std::move(keys));
+    }
+
+    auto readOne(const auto& key) -> task::Task<std::optional<Value>>
+    {
+        co_return MutableStorage::toOptional(co_await readOneRaw(key));
+    }
+
+    auto readSome(::ranges::input_range auto keys) -> task::Task<std::vector<std::optional<Value>>>
+    {
+        std::vector<std::optional<Value>> values;
+        for (auto&& key : keys)
+        {
+            values.emplace_back(MutableStorage::toOptional(co_await readOneRaw(key)));
+        }
+        co_return values;
+    }
+
+    auto existsOne(const auto& key) -> task::Task<bool>
+    {
+        co_return MutableStorage::toOptional(co_await readOneRaw(key)).has_value();
+    }
+
+    task::Task<void> writeOne(auto key, auto value)
+    {
+        co_await storage2::writeOne(m_writeSet, std::move(key), std::move(value));
+    }
+
+    task::Task<void> writeSome(::ranges::input_range auto keyValues)
+    {
+        co_await storage2::writeSome(m_writeSet, std::move(keyValues));
+    }
+
+    task::Task<void> removeOne(auto key, auto&&... args)
+    {
+        co_await storage2::removeOne(
+            m_writeSet, std::move(key), std::forward<decltype(args)>(args)...);
+    }
+
+    task::Task<void> removeSome(::ranges::input_range auto keys, auto&&... args)
+    {
+        co_await storage2::removeSome(
+            m_writeSet, std::move(keys), std::forward<decltype(args)>(args)...);
+    }
+
+    // NOTE: same limitation as ReadWriteSetStorage::range(), the lazy iterator is not tracked
+    // and is not used during transaction execution.
+    auto range(auto&&... args) -> task::Task<storage2::ReturnType<
+        std::invoke_result_t<storage2::Range, StorageType&, decltype(args)...>>>
+    {
+        co_return co_await storage2::range(m_storage.get(), std::forward<decltype(args)>(args)...);
+    }
+
+    std::optional<int32_t> blockingTransactionIndex() const { return m_blockingTransactionIndex; }
+    std::vector<typename Memory::ReadRecord>& readSet() & { return m_readSet; }
+    MutableStorage& writeSet() & { return m_writeSet; }
+};
+
+}  // namespace bcos::scheduler_v1
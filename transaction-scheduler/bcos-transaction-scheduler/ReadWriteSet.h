@@ -0,0 +1,242 @@
+#pragma once
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bcos::scheduler_v1
+{
+
+struct ReadWriteFlag
+{
+    bool read = false;
+    bool write = false;
+};
+
+// 开放寻址的扁平读写集：条目按插入顺序连续存放，索引表只保存下标；clear()保留已分配的内存以便复用
+// Flat open-addressing read/write set: entries are stored contiguously in insertion order and the
+// probe table only holds indexes into them; clear() keeps the allocated memory for reuse.
+// exactKey=false keeps only the 64-bit hash of each key, exactKey=true keeps the key itself so a
+// hash collision can never be reported as a conflict.
+template <class KeyType, bool exactKey = false, class Hasher = std::hash<KeyType>>
+class FlatReadWriteSet
+{
+public:
+    using LookupKey = std::conditional_t<exactKey, KeyType, size_t>;
+    using value_type = std::pair<LookupKey, ReadWriteFlag>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = const_iterator;
+
+private:
+    constexpr static size_t MIN_SLOTS = 16;
+    constexpr static size_t SUMMARY_BITS = 1024;
+    constexpr static uint32_t EMPTY_SLOT = 0;
+
+    std::vector<value_type> m_entries;
+    std::vector<size_t> m_hashes;
+    std::vector<uint32_t> m_slots;
+    std::bitset<SUMMARY_BITS> m_summary;
+
+    static size_t mix(size_t hash) { return hash * 0x9E3779B97F4A7C15ULL; }
+    static size_t summaryBit(size_t hash) { return (mix(hash) >> 32) % SUMMARY_BITS; }
+
+    size_t entryHash(size_t index) const
+    {
+        if constexpr (exactKey)
+        {
+            return m_hashes[index];
+        }
+        else
+        {
+            return m_entries[index].first;
+        }
+    }
+
+    bool matches(size_t index, size_t hash, LookupKey const& key) const
+    {
+        if constexpr (exactKey)
+        {
+            return m_hashes[index] == hash && m_entries[index].first == key;
+        }
+        else
+        {
+            return m_entries[index].first == hash;
+        }
+    }
+
+    // 返回槽位下标，槽位为空表示未找到
+    // Returns the slot position, an empty slot means the key is absent
+    size_t probe(size_t hash, LookupKey const& key) const
+    {
+        auto mask = m_slots.size() - 1;
+        for (auto pos = mix(hash) & mask;; pos = (pos + 1) & mask)
+        {
+            auto slot = m_slots[pos];
+            if (slot == EMPTY_SLOT || matches(slot - 1, hash, key))
+            {
+                return pos;
+            }
+        }
+    }
+
+    void rehash(size_t slotCount)
+    {
+        m_slots.assign(slotCount, EMPTY_SLOT);
+        auto mask = slotCount - 1;
+        for (size_t index = 0; index < m_entries.size(); ++index)
+        {
+            auto pos = mix(entryHash(index)) & mask;
+            while (m_slots[pos] != EMPTY_SLOT)
+            {
+                pos = (pos + 1) & mask;
+            }
+            m_slots[pos] = static_cast<uint32_t>(index + 1);
+        }
+    }
+
+    void insert(size_t hash, LookupKey const& key, ReadWriteFlag flag)
+    {
+        // 负载因子保持在1/2以下
+        // Keep the load factor below 1/2
+        if ((m_entries.size() + 1) * 2 > m_slots.size())
+        {
+            rehash(std::max(MIN_SLOTS, m_slots.size() * 2));
+        }
+
+        auto pos = probe(hash, key);
+        if (auto slot = m_slots[pos]; slot != EMPTY_SLOT)
+        {
+            auto& existsFlag = m_entries[slot - 1].second;
+            existsFlag.read |= flag.read;
+            existsFlag.write |= flag.write;
+            return;
+        }
+
+        m_entries.emplace_back(key, flag);
+        if constexpr (exactKey)
+        {
+            m_hashes.emplace_back(hash);
+        }
+        m_slots[pos] = static_cast<uint32_t>(m_entries.size());
+        m_summary.set(summaryBit(hash));
+    }
+
+    const_iterator findHash(size_t hash, LookupKey const& key) const
+    {
+        if (m_entries.empty() || !m_summary.test(summaryBit(hash)))
+        {
+            return m_entries.end();
+        }
+        auto slot = m_slots[probe(hash, key)];
+        return slot == EMPTY_SLOT ? m_entries.end() : m_entries.begin() + (slot - 1);
+    }
+
+    static size_t hashOf(LookupKey const& key)
+    {
+        if constexpr (exactKey)
+        {
+            return Hasher{}(key);
+        }
+        else
+        {
+            return key;
+        }
+    }
+
+public:
+    void put(bool write, auto const& key)
+    {
+        auto hash = Hasher{}(key);
+        if constexpr (exactKey)
+        {
+            insert(hash, LookupKey(key), ReadWriteFlag{.read = !write, .write = write});
+        }
+        else
+        {
+            insert(hash, hash, ReadWriteFlag{.read = !write, .write = write});
+        }
+    }
+
+    // 合并另一读写集中的写集，不需要重新计算哈希
+    // Merge the writes of another set without rehashing its keys
+    void mergeWrites(FlatReadWriteSet const& from)
+    {
+        for (size_t index = 0; index < from.m_entries.size(); ++index)
+        {
+            auto const& [key, flag] = from.m_entries[index];
+            if (flag.write)
+            {
+                insert(from.entryHash(index), key, ReadWriteFlag{.write = true});
+            }
+        }
+    }
+
+    // 遍历较小的集合并在较大的集合中探测，位图摘要不相交时直接返回
+    // Walks the smaller set and probes the larger one, returning early when the bitmap summaries
+    // are disjoint
+    bool intersects(FlatReadWriteSet const& other) const
+    {
+        if (empty() || other.empty() || (m_summary & other.m_summary).none())
+        {
+            return false;
+        }
+
+        auto const& smaller = size() <= other.size() ? *this : other;
+        auto const& larger = size() <= other.size() ? other : *this;
+        for (size_t index = 0; index < smaller.m_entries.size(); ++index)
+        {
+            if (larger.findHash(smaller.entryHash(index), smaller.m_entries[index].first) !=
+                larger.m_entries.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const_iterator find(LookupKey const& key) const { return findHash(hashOf(key), key); }
+    bool contains(LookupKey const& key) const { return find(key) != end(); }
+    ReadWriteFlag const& at(LookupKey const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            BOOST_THROW_EXCEPTION(std::out_of_range("Key not found in read write set"));
+        }
+        return it->second;
+    }
+
+    void reserve(size_t count)
+    {
+        m_entries.reserve(count);
+        if constexpr (exactKey)
+        {
+            m_hashes.reserve(count);
+        }
+        if (count * 2 > m_slots.size())
+        {
+            rehash(std::bit_ceil(std::max(MIN_SLOTS, count * 2)));
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_hashes.clear();
+        std::fill(m_slots.begin(), m_slots.end(), EMPTY_SLOT);
+        m_summary.reset();
+    }
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+};
+
+}  // namespace bcos::scheduler_v1
@@ -1,4 +1,5 @@
 #pragma once
+#include "ReadWriteSet.h"
 #include "bcos-framework/storage2/Storage.h"
 #include <bcos-task/Trait.h>
 #include <type_traits>
@@ -7,7 +8,9 @@
 namespace bcos::scheduler_v1
 {
 
-template <class StorageType>
+// exactKey: 保存完整的key而非64位哈希，避免哈希碰撞造成的误判冲突
+// exactKey: track full keys instead of 64-bit hashes so a collision never forces a false RAW retry
+template <class StorageType, bool exactKey = false>
 class ReadWriteSetStorage
 {
 private:
@@ -18,32 +21,16 @@ public:
     using Value = std::decay_t<StorageType>::Value;
     ReadWriteSetStorage(StorageType& storage) : m_storage(std::ref(storage)) {}
 
-private:
-    struct ReadWriteFlag
-    {
-        bool read = false;
-        bool write = false;
-    };
+    // 预留读写集容量，避免执行过程中反复扩容
+    // Pre-size the tracked set so a chunk does not regrow it while executing
+    void reserve(size_t count) { m_readWriteSet.reserve(count); }
 
-    std::unordered_map<size_t, ReadWriteFlag> m_readWriteSet;
+private:
+    FlatReadWriteSet<Key, exactKey> m_readWriteSet;
 
     using Storage = StorageType;
 
-    void putSet(bool write, size_t hash)
-    {
-        auto [it, inserted] =
-            m_readWriteSet.try_emplace(hash, ReadWriteFlag{.read = !write, .write = write});
-        if (!inserted)
-        {
-            it->second.write |= write;
-            it->second.read |= (!write);
-        }
-    }
-    void putSet(bool write, auto const& key)
-    {
-        auto hash = std::hash<Key>{}(key);
-        putSet(write, hash);
-    }
+    void putSet(bool write, auto const& key) { m_readWriteSet.put(write, key); }
 
 public:
     auto readSomeRaw(::ranges::input_range auto keys, auto&&... args)
@@ -170,14 +157,7 @@ public:
 
     friend void mergeWriteSet(ReadWriteSetStorage& storage, auto& inputWriteSet)
     {
-        auto& writeMap = readWriteSet(inputWriteSet);
-        for (auto& [key, flag] : writeMap)
-        {
-            if (flag.write)
-            {
-                storage.putSet(true, key);
-            }
-        }
+        storage.m_readWriteSet.mergeWrites(readWriteSet(inputWriteSet));
     }
 
     // Conflict detection between a prior-chunks aggregated write set (lhs) and
@@ -188,25 +168,11 @@ public:
     //     semantics make writes implicitly read-dependent on the pre-image,
     //     so WAW must serialize to keep Rollbackable from snapshotting a
     //     stale value.
+    //   Every tracked entry is either a read or a write, so this reduces to a
+    //   plain intersection of the two key sets.
     friend bool hasRAWIntersection(ReadWriteSetStorage const& lhs, const auto& rhs)
     {
-        auto const& lhsSet = readWriteSet(lhs);
-        auto const& rhsSet = readWriteSet(rhs);
-
-        if (::ranges::empty(lhsSet) || ::ranges::empty(rhsSet))
-        {
-            return false;
-        }
-
-        for (auto const& [key, flag] : rhsSet)
-        {
-            if ((flag.read || flag.write) && lhsSet.contains(key))
-            {
-                return true;
-            }
-        }
-
-        return false;
+        return readWriteSet(lhs).intersects(readWriteSet(rhs));
     }
 };
 
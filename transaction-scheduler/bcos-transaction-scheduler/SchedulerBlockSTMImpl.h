@@ -0,0 +1,434 @@
+#pragma once
+
+#include "GC.h"
+#include "MultiVersionStorage.h"
+#include "bcos-framework/ledger/LedgerConfig.h"
+#include "bcos-framework/protocol/BlockHeader.h"
+#include "bcos-framework/protocol/TransactionReceipt.h"
+#include "bcos-framework/storage2/Storage.h"
+#include "bcos-framework/transaction-executor/TransactionExecutor.h"
+#include "bcos-task/TBBWait.h"
+#include "bcos-utilities/BoostLog.h"
+#include "bcos-utilities/ITTAPI.h"
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_group.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <range/v3/view/transform.hpp>
+
+namespace bcos::scheduler_v1
+{
+
+#define BLOCK_STM_SCHEDULER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("BLOCK_STM_SCHEDULER")
+
+/**
+ * The collaborative task scheduler of Block-STM. Execution and validation tasks are handed out in
+ * transaction order through two shared indexes; an aborted transaction only lowers the indexes
+ * back to itself, so the work redone is the invalidated transaction and whatever later
+ * transaction fails validation because of it, instead of the whole suffix of the block.
+ */
+class BlockSTMTaskScheduler
+{
+public:
+    enum class TaskKind : uint8_t
+    {
+        EXECUTION,
+        VALIDATION
+    };
+
+    struct SchedulerTask
+    {
+        int32_t transactionIndex;
+        int32_t incarnation;
+        TaskKind kind;
+    };
+
+private:
+    enum class Status : uint8_t
+    {
+        READY_TO_EXECUTE,
+        EXECUTING,
+        EXECUTED,
+        ABORTING
+    };
+
+    struct TransactionStatus
+    {
+        std::mutex mutex;
+        int32_t incarnation = 0;
+        Status status = Status::READY_TO_EXECUTE;
+        std::vector<int32_t> dependencies;
+    };
+
+    int32_t m_count;
+    std::vector<TransactionStatus> m_status;
+    std::atomic_int32_t m_executionIndex{0};
+    std::atomic_int32_t m_validationIndex{0};
+    std::atomic_int32_t m_activeTasks{0};
+    std::atomic_int64_t m_decreaseCount{0};
+    std::atomic_bool m_done{false};
+
+    void decreaseIndex(std::atomic_int32_t& index, int32_t target)
+    {
+        auto current = index.load();
+        while (current > target && !index.compare_exchange_weak(current, target))
+        {
+        }
+        ++m_decreaseCount;
+    }
+
+    void checkDone()
+    {
+        auto observedCount = m_decreaseCount.load();
+        if (std::min(m_executionIndex.load(), m_validationIndex.load()) >= m_count &&
+            m_activeTasks.load() == 0 && observedCount == m_decreaseCount.load())
+        {
+            m_done = true;
+        }
+    }
+
+    std::optional<SchedulerTask> tryIncarnate(int32_t index)
+    {
+        if (index < m_count)
+        {
+            auto& item = m_status[index];
+            std::unique_lock lock(item.mutex);
+            if (item.status == Status::READY_TO_EXECUTE)
+            {
+                item.status = Status::EXECUTING;
+                return SchedulerTask{.transactionIndex = index,
+                    .incarnation = item.incarnation,
+                    .kind = TaskKind::EXECUTION};
+            }
+        }
+        return {};
+    }
+
+    std::optional<SchedulerTask> nextVersionToExecute()
+    {
+        if (m_executionIndex.load() >= m_count)
+        {
+            checkDone();
+            return {};
+        }
+        ++m_activeTasks;
+        if (auto task = tryIncarnate(m_executionIndex.fetch_add(1)))
+        {
+            return task;
+        }
+        --m_activeTasks;
+        return {};
+    }
+
+    std::optional<SchedulerTask> nextVersionToValidate()
+    {
+        if (m_validationIndex.load() >= m_count)
+        {
+            checkDone();
+            return {};
+        }
+        ++m_activeTasks;
+        auto index = m_validationIndex.fetch_add(1);
+        if (index < m_count)
+        {
+            auto& item = m_status[index];
+            std::unique_lock lock(item.mutex);
+            if (item.status == Status::EXECUTED)
+            {
+                return SchedulerTask{.transactionIndex = index,
+                    .incarnation = item.incarnation,
+                    .kind = TaskKind::VALIDATION};
+            }
+        }
+        --m_activeTasks;
+        return {};
+    }
+
+    void setReadyStatus(int32_t index)
+    {
+        auto& item = m_status[index];
+        std::unique_lock lock(item.mutex);
+        ++item.incarnation;
+        item.status = Status::READY_TO_EXECUTE;
+    }
+
+public:
+    explicit BlockSTMTaskScheduler(int32_t count) : m_count(count), m_status(count) {}
+
+    bool done() const { return m_done.load(); }
+
+    std::optional<SchedulerTask> nextTask()
+    {
+        if (m_validationIndex.load() < m_executionIndex.load())
+        {
+            return nextVersionToValidate();
+        }
+        return nextVersionToExecute();
+    }
+
+    /**
+     * Suspends the transaction until blockingIndex finishes its next incarnation.
+     *
+     * @return false if blockingIndex has already been executed and the caller should retry.
+     */
+    bool addDependency(int32_t index, int32_t blockingIndex)
+    {
+        // blockingIndex is always lower than index, so the nested locks are taken in order
+        auto& blocking = m_status[blockingIndex];
+        std::unique_lock blockingLock(blocking.mutex);
+        if (blocking.status == Status::EXECUTED)
+        {
+            return false;
+        }
+        {
+            auto& item = m_status[index];
+            std::unique_lock lock(item.mutex);
+            item.status = Status::ABORTING;
+        }
+        blocking.dependencies.emplace_back(index);
+        blockingLock.unlock();
+
+        --m_activeTasks;
+        return true;
+    }
+
+    std::optional<SchedulerTask> finishExecution(
+        int32_t index, int32_t incarnation, bool wroteNewKey)
+    {
+        std::vector<int32_t> dependencies;
+        {
+            auto& item = m_status[index];
+            std::unique_lock lock(item.mutex);
+            item.status = Status::EXECUTED;
+            dependencies.swap(item.dependencies);
+        }
+        if (!dependencies.empty())
+        {
+            for (auto dependency : dependencies)
+            {
+                setReadyStatus(dependency);
+            }
+            decreaseIndex(
+                m_executionIndex, *std::min_element(dependencies.begin(), dependencies.end()));
+        }
+
+        if (m_validationIndex.load() > index)
+        {
+            if (!wroteNewKey)
+            {
+                return SchedulerTask{.transactionIndex = index,
+                    .incarnation = incarnation,
+                    .kind = TaskKind::VALIDATION};
+            }
+            decreaseIndex(m_validationIndex, index);
+        }
+        --m_activeTasks;
+        return {};
+    }
+
+    bool tryValidationAbort(int32_t index, int32_t incarnation)
+    {
+        auto& item = m_status[index];
+        std::unique_lock lock(item.mutex);
+        if (item.incarnation == incarnation && item.status == Status::EXECUTED)
+        {
+            item.status = Status::ABORTING;
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<SchedulerTask> finishValidation(int32_t index, bool aborted)
+    {
+        if (aborted)
+        {
+            setReadyStatus(index);
+            decreaseIndex(m_validationIndex, index + 1);
+            if (m_executionIndex.load() > index)
+            {
+                if (auto task = tryIncarnate(index))
+                {
+                    return task;
+                }
+            }
+        }
+        --m_activeTasks;
+        return {};
+    }
+};
+
+template <class MutableStorageType>
+class SchedulerBlockSTMImpl
+{
+public:
+    using MutableStorage = MutableStorageType;
+    constexpr static auto DEFAULT_MAX_CONCURRENCY = 8UL;
+
+    size_t m_maxConcurrency = DEFAULT_MAX_CONCURRENCY;
+
+    template <class Storage, executor_v1::TransactionExecutor<Storage> TransactionExecutor>
+    task::Task<std::vector<protocol::TransactionReceipt::Ptr>> executeBlock(Storage& storage,
+        TransactionExecutor& executor, protocol::BlockHeader const& blockHeader,
+        ::ranges::random_access_range auto const& transactions,
+        ledger::LedgerConfig const& ledgerConfig)
+    {
+        ittapi::Report report(ittapi::ITT_DOMAINS::instance().BLOCK_STM_SCHEDULER,
+            ittapi::ITT_DOMAINS::instance().BLOCK_STM_EXECUTE);
+
+        using TransactionStorage = MultiVersionTransactionStorage<Storage, MutableStorage>;
+        using Memory = typename TransactionStorage::Memory;
+
+        struct TransactionResult
+        {
+            std::unique_ptr<TransactionStorage> storage;
+            protocol::TransactionReceipt::Ptr receipt;
+            std::exception_ptr exception;
+        };
+        struct ExecuteResult
+        {
+            std::optional<int32_t> blockingIndex;
+            bool wroteNewKey = false;
+        };
+
+        auto count = static_cast<int32_t>(::ranges::size(transactions));
+        Memory memory(count);
+        BlockSTMTaskScheduler scheduler(count);
+        std::vector<TransactionResult> results(count);
+        std::atomic_size_t incarnations = 0;
+
+        auto executeIncarnation = [&](int32_t index,
+                                      int32_t incarnation) -> task::Task<ExecuteResult> {
+            ittapi::Report report(ittapi::ITT_DOMAINS::instance().BLOCK_STM_SCHEDULER,
+                ittapi::ITT_DOMAINS::instance().EXECUTE_INCARNATION);
+            ++incarnations;
+            auto transactionStorage = std::make_unique<TransactionStorage>(memory, storage, index);
+            TransactionResult result;
+            try
+            {
+                auto context = co_await executor.createExecuteContext(*transactionStorage,
+                    blockHeader, transactions[index], index, ledgerConfig, false);
+                co_await context.template executeStep<0>();
+                co_await context.template executeStep<1>();
+                result.receipt = co_await context.template executeStep<2>();
+            }
+            catch (...)
+            {
+                // 可能是读到不一致快照导致的，由校验决定是否为真正的错误
+                // May be caused by an inconsistent snapshot, validation decides whether it is real
+                result.exception = std::current_exception();
+            }
+
+            if (auto blockingIndex = transactionStorage->blockingTransactionIndex())
+            {
+                co_return ExecuteResult{.blockingIndex = blockingIndex};
+            }
+
+            auto writeSet = co_await storage2::range(transactionStorage->writeSet());
+            std::vector<std::tuple<typename MutableStorage::Key,
+                storage2::StorageValueType<typename MutableStorage::Value>>>
+                keyValues;
+            while (auto keyValue = co_await writeSet.next())
+            {
+                auto&& [key, value] = *keyValue;
+                keyValues.emplace_back(key, value);
+            }
+            auto wroteNewKey = memory.record(index, incarnation, std::move(keyValues),
+                std::move(transactionStorage->readSet()));
+
+            result.storage = std::move(transactionStorage);
+            GC::collect(std::exchange(results[index], std::move(result)));
+            co_return ExecuteResult{.wroteNewKey = wroteNewKey};
+        };
+
+        auto tryExecute = [&](BlockSTMTaskScheduler::SchedulerTask task)
+            -> std::optional<BlockSTMTaskScheduler::SchedulerTask> {
+            while (true)
+            {
+                auto result = task::tbb::syncWait(
+                    executeIncarnation(task.transactionIndex, task.incarnation));
+                if (!result.blockingIndex)
+                {
+                    return scheduler.finishExecution(
+                        task.transactionIndex, task.incarnation, result.wroteNewKey);
+                }
+                if (scheduler.addDependency(task.transactionIndex, *result.blockingIndex))
+                {
+                    return {};
+                }
+            }
+        };
+
+        auto needsReexecution = [&](BlockSTMTaskScheduler::SchedulerTask task)
+            -> std::optional<BlockSTMTaskScheduler::SchedulerTask> {
+            ittapi::Report report(ittapi::ITT_DOMAINS::instance().BLOCK_STM_SCHEDULER,
+                ittapi::ITT_DOMAINS::instance().VALIDATE_TRANSACTION);
+            auto aborted = !memory.validateReadSet(task.transactionIndex) &&
+                           scheduler.tryValidationAbort(task.transactionIndex, task.incarnation);
+            if (aborted)
+            {
+                memory.convertWritesToEstimates(task.transactionIndex);
+            }
+            return scheduler.finishValidation(task.transactionIndex, aborted);
+        };
+
+        tbb::task_arena arena(
+            static_cast<int>(m_maxConcurrency), 1, tbb::task_arena::priority::high);
+        arena.execute([&]() {
+            tbb::task_group group;
+            for (size_t i = 0; i < m_maxConcurrency; ++i)
+            {
+                group.run([&]() {
+                    std::optional<BlockSTMTaskScheduler::SchedulerTask> task;
+                    while (!scheduler.done())
+                    {
+                        if (task && task->kind == BlockSTMTaskScheduler::TaskKind::EXECUTION)
+                        {
+                            task = tryExecute(*task);
+                        }
+                        if (task && task->kind == BlockSTMTaskScheduler::TaskKind::VALIDATION)
+                        {
+                            task = needsReexecution(*task);
+                        }
+                        if (!task)
+                        {
+                            task = scheduler.nextTask();
+                            if (!task)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+                });
+            }
+            group.wait();
+        });
+        BLOCK_STM_SCHEDULER_LOG(DEBUG) << "Block-STM execute block finished, transactions: "
+                                       << count << ", incarnations: " << incarnations;
+
+        ittapi::Report mergeReport(ittapi::ITT_DOMAINS::instance().BLOCK_STM_SCHEDULER,
+            ittapi::ITT_DOMAINS::instance().MERGE_WRITE_SETS);
+        std::vector<protocol::TransactionReceipt::Ptr> receipts;
+        receipts.reserve(count);
+        for (auto& result : results)
+        {
+            // 校验通过后仍然存在的异常与串行执行的结果一致，直接抛出
+            // An exception surviving validation is what serial execution would throw
+            if (result.exception)
+            {
+                std::rethrow_exception(result.exception);
+            }
+            co_await storage2::merge(storage, result.storage->writeSet());
+            receipts.emplace_back(std::move(result.receipt));
+        }
+        GC::collect(std::move(results));
+
+        co_return receipts;
+    }
+};
+
+}  // namespace bcos::scheduler_v1
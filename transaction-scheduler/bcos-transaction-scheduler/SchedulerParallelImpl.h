@@ -46,6 +46,8 @@ template <class MutableStorage, class Storage,
 class ChunkStatus
 {
 private:
+    constexpr static size_t EXPECT_KEYS_PER_TRANSACTION = 8;
+
     int64_t m_chunkIndex = 0;
     std::reference_wrapper<boost::atomic_flag const> m_hasRAW;
     Contexts m_contexts;
@@ -67,6 +69,7 @@ public:
         m_readWriteSetStorage(m_storageView)
     {
         m_storageView.newMutable();
+        m_readWriteSetStorage.reserve(::ranges::size(m_contexts) * EXPECT_KEYS_PER_TRANSACTION);
     }
 
     int64_t chunkIndex() const { return m_chunkIndex; }
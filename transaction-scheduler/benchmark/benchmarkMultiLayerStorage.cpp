@@ -4,6 +4,7 @@
 #include <bcos-task/Wait.h>
 #include <benchmark/benchmark.h>
 #include <fmt/format.h>
+#include <random>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
@@ -49,6 +50,31 @@ struct Fixture
         }
     }
 
+    // 把count个key平均写入layer个层，模拟多个已执行未提交的区块
+    // Spread count keys evenly over layer layers, like several executed but uncommitted blocks
+    void prepareLayers(int64_t count, int64_t layer)
+    {
+        allKeys = ::ranges::views::iota(0, count) | ::ranges::views::transform([](int num) {
+            auto key = fmt::format("key: {}", num);
+            return executor_v1::StateKey{"test_table"sv, std::string_view(key)};
+        }) | ::ranges::to<decltype(allKeys)>();
+
+        task::syncWait([this](int64_t count, int64_t layer) -> task::Task<void> {
+            for (auto i = 0; i < layer; ++i)
+            {
+                auto view = multiLayerStorage.fork();
+                view.newMutable();
+                for (auto num = i; num < count; num += layer)
+                {
+                    storage::Entry entry;
+                    entry.set(fmt::format("value: {}", num));
+                    co_await storage2::writeOne(view, allKeys[num], std::move(entry));
+                }
+                multiLayerStorage.pushView(std::move(view));
+            }
+        }(count, layer));
+    }
+
     using MutableStorage = MemoryStorage<executor_v1::StateKey, executor_v1::StateValue,
         Attribute(ORDERED | LOGICAL_DELETION)>;
     using BackendStorage = MemoryStorage<executor_v1::StateKey, executor_v1::StateValue,
@@ -99,6 +125,33 @@ static void read10(benchmark::State& state)
     }(state));
 }
 
+static void readLayers(benchmark::State& state)
+{
+    auto dataCount = state.range(0);
+    auto layerCount = state.range(1);
+    Fixture fixture;
+    fixture.prepareLayers(dataCount, layerCount);
+
+    int i = 0;
+    task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+        auto view = fixture.multiLayerStorage.fork();
+        for (auto const& it : state)
+        {
+            [[maybe_unused]] auto data =
+                co_await storage2::readOne(view, fixture.allKeys[(i + dataCount) % dataCount]);
+            ++i;
+        }
+
+        co_return;
+    }(state));
+
+    auto const& statistics = fixture.multiLayerStorage.readStatistics();
+    auto reads = static_cast<double>(std::max<uint64_t>(statistics.reads, 1));
+    state.counters["probes/read"] = static_cast<double>(statistics.layerProbes) / reads;
+    state.counters["skips/read"] = static_cast<double>(statistics.filterSkips) / reads;
+    state.counters["falsePositives/read"] = static_cast<double>(statistics.falsePositives) / reads;
+}
+
 static void write1(benchmark::State& state)
 {
     Fixture fixture;
@@ -121,9 +174,54 @@ static void write1(benchmark::State& state)
     }(state));
 }
 
+// 写密集的区块：随机写入count次（部分key被重复写），然后把该层推入为不可变层
+// A write heavy block: count writes to random keys, some of them written twice, then the layer
+// is pushed as an immutable layer
+template <class MutableStorage>
+static void writeBlock(benchmark::State& state)
+{
+    auto count = state.range(0);
+    std::mt19937 random(0);
+    auto keys = ::ranges::views::iota(0, count) | ::ranges::views::transform([&](int) {
+        auto key = fmt::format("key: {}", random() % count);
+        return executor_v1::StateKey{"test_table"sv, std::string_view(key)};
+    }) | ::ranges::to<std::vector>();
+
+    Fixture::BackendStorage backendStorage;
+    storage2::MultiLayerStorage<MutableStorage, void, Fixture::BackendStorage> multiLayerStorage(
+        backendStorage);
+    for (auto const& it : state)
+    {
+        task::syncWait([&]() -> task::Task<void> {
+            auto view = multiLayerStorage.fork();
+            view.newMutable();
+            for (auto const& key : keys)
+            {
+                storage::Entry entry;
+                entry.set("value"sv);
+                co_await storage2::writeOne(view, key, std::move(entry));
+            }
+            multiLayerStorage.pushView(std::move(view));
+        }());
+        multiLayerStorage.popFrontStorage();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+using SortOnFreezeStorage = MemoryStorage<executor_v1::StateKey, executor_v1::StateValue,
+    Attribute(SORT_ON_FREEZE | LOGICAL_DELETION)>;
 
 BENCHMARK(read1)->Arg(10000)->Arg(100000)->Arg(1000000);
 BENCHMARK(read10)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(readLayers)
+    ->Args({100000, 1})
+    ->Args({100000, 4})
+    ->Args({100000, 16})
+    ->Args({1000000, 1})
+    ->Args({1000000, 4})
+    ->Args({1000000, 16});
 BENCHMARK(write1);
+BENCHMARK(writeBlock<Fixture::MutableStorage>)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(writeBlock<SortOnFreezeStorage>)->Arg(10000)->Arg(100000)->Arg(1000000);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "bcos-task/Wait.h"
 #include "bcos-transaction-executor/TransactionExecutorImpl.h"
 #include "bcos-transaction-executor/precompiled/PrecompiledManager.h"
+#include "bcos-transaction-scheduler/SchedulerBlockSTMImpl.h"
 #include "bcos-transaction-scheduler/SchedulerParallelImpl.h"
 #include "bcos-transaction-scheduler/SchedulerSerialImpl.h"
 #include "transaction-executor/tests/TestBytecode.h"
@@ -37,7 +38,14 @@ using BackendStorage = MemoryStorage<StateKey, StateValue, ORDERED | LRU | CONCU
 using MultiLayerStorageType = MultiLayerStorage<MutableStorage, void, BackendStorage>;
 using ReceiptFactory = bcostars::protocol::TransactionReceiptFactoryImpl;
 
-template <bool parallel>
+enum class SchedulerType
+{
+    SERIAL,
+    PARALLEL,
+    BLOCK_STM,
+};
+
+template <SchedulerType schedulerType>
 struct Fixture
 {
     bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
@@ -52,7 +60,8 @@ struct Fixture
 
     PrecompiledManager m_precompiledManager;
     TransactionExecutorImpl m_executor;
-    std::variant<std::monostate, SchedulerSerialImpl, SchedulerParallelImpl<MutableStorage>>
+    std::variant<std::monostate, SchedulerSerialImpl, SchedulerParallelImpl<MutableStorage>,
+        SchedulerBlockSTMImpl<MutableStorage>>
         m_scheduler;
 
     std::string m_contractAddress;
@@ -86,10 +95,14 @@ struct Fixture
         bcos::executor::GlobalHashImpl::g_hashImpl = std::make_shared<bcos::crypto::Keccak256>();
         boost::algorithm::unhex(helloworldBytecode, std::back_inserter(m_helloworldBytecodeBinary));
 
-        if constexpr (parallel)
+        if constexpr (schedulerType == SchedulerType::PARALLEL)
         {
             m_scheduler.emplace<SchedulerParallelImpl<MutableStorage>>();
         }
+        else if constexpr (schedulerType == SchedulerType::BLOCK_STM)
+        {
+            m_scheduler.emplace<SchedulerBlockSTMImpl<MutableStorage>>();
+        }
         else
         {
             m_scheduler.emplace<SchedulerSerialImpl>();
@@ -253,6 +266,34 @@ struct Fixture
             ::ranges::to<decltype(m_transactions)>();
     }
 
+    // conflictPercent% of the transfers pay into account 0, the rest pick random accounts
+    void prepareHotKeyTransfer(size_t conflictPercent)
+    {
+        bcos::codec::abi::ContractABICodec abiCodec(*bcos::executor::GlobalHashImpl::g_hashImpl);
+        auto count = m_addresses.size();
+        std::mt19937_64 rng(std::random_device{}());
+        m_transfers.resize(count);
+        m_transactions =
+            ::ranges::views::transform(::ranges::views::iota(0LU, count),
+                [&, this](size_t index) {
+                    auto transaction = std::make_unique<bcostars::protocol::TransactionImpl>();
+                    auto& inner = transaction->mutableInner();
+                    inner.data.to = m_contractAddress;
+                    auto& transfer = m_transfers[index];
+                    transfer.from = rng() % count;
+                    transfer.to = (rng() % 100 < conflictPercent) ? 0 : rng() % count;
+                    auto& fromAddress = m_addresses[transfer.from];
+                    auto& toAddress = m_addresses[transfer.to];
+
+                    auto input = abiCodec.abiIn(
+                        std::string(transferMethod), fromAddress, toAddress, singleTransfer);
+                    inner.data.input.assign(input.begin(), input.end());
+                    transaction->calculateHash(*m_cryptoSuite->hashImpl());
+                    return transaction;
+                }) |
+            ::ranges::to<decltype(m_transactions)>();
+    }
+
     task::Task<std::vector<s256>> balances()
     {
         co_return co_await std::visit(
@@ -330,12 +371,21 @@ static void initParallelScheduler(benchmark::State& state, auto& fixture)
             scheduler.m_maxConcurrency = maxParallel;
         }
     }
+    else if (std::holds_alternative<SchedulerBlockSTMImpl<MutableStorage>>(fixture.m_scheduler))
+    {
+        auto maxParallel = state.range(2);
+        auto& scheduler = std::get<SchedulerBlockSTMImpl<MutableStorage>>(fixture.m_scheduler);
+        if (maxParallel > 0)
+        {
+            scheduler.m_maxConcurrency = maxParallel;
+        }
+    }
 }
 
-template <bool parallel>
+template <SchedulerType schedulerType>
 static void noConflictTransfer(benchmark::State& state)
 {
-    Fixture<parallel> fixture;
+    Fixture<schedulerType> fixture;
     fixture.deployContract();
     initParallelScheduler(state, fixture);
 
@@ -409,10 +459,10 @@ static void noConflictTransfer(benchmark::State& state)
         fixture.m_scheduler);
 }
 
-template <bool parallel>
+template <SchedulerType schedulerType>
 static void randomTransfer(benchmark::State& state)
 {
-    Fixture<parallel> fixture;
+    Fixture<schedulerType> fixture;
     fixture.deployContract();
 
     auto count = state.range(0);
@@ -483,10 +533,10 @@ static void randomTransfer(benchmark::State& state)
         fixture.m_scheduler);
 }
 
-template <bool parallel>
+template <SchedulerType schedulerType>
 static void conflictTransfer(benchmark::State& state)
 {
-    Fixture<parallel> fixture;
+    Fixture<schedulerType> fixture;
     fixture.deployContract();
 
     auto count = state.range(0) * 2;
@@ -575,8 +625,83 @@ static void conflictTransfer(benchmark::State& state)
         fixture.m_scheduler);
 }
 
-constexpr static bool SERIAL = false;
-constexpr static bool PARALLEL = true;
+template <SchedulerType schedulerType>
+static void hotKeyTransfer(benchmark::State& state)
+{
+    Fixture<schedulerType> fixture;
+    fixture.deployContract();
+
+    auto count = state.range(0);
+    fixture.prepareAddresses(count);
+    fixture.prepareIssue(count);
+
+    initParallelScheduler(state, fixture);
+    std::visit(
+        [&](auto& scheduler) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(scheduler)>, std::monostate>)
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error("invalid scheduler"));
+            }
+            else
+            {
+                int i = 0;
+                task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+                    // First issue
+                    bcostars::protocol::BlockHeaderImpl blockHeader;
+                    blockHeader.setNumber(0);
+                    blockHeader.setVersion((uint32_t)bcos::protocol::BlockVersion::MAX_VERSION);
+
+                    auto view = fixture.m_multiLayerStorage.fork();
+                    view.newMutable();
+
+                    [[maybe_unused]] auto receipts = co_await scheduler.executeBlock(view,
+                        fixture.m_executor, blockHeader,
+                        ::ranges::views::indirect(fixture.m_transactions), fixture.m_ledgerConfig);
+                    fixture.m_transactions.clear();
+
+                    fixture.prepareHotKeyTransfer(state.range(3));
+                    // Start transfer
+                    for (auto const& it : state)
+                    {
+                        bcostars::protocol::BlockHeaderImpl blockHeader;
+                        blockHeader.setNumber((i++) + 1);
+                        blockHeader.setVersion((uint32_t)bcos::protocol::BlockVersion::MAX_VERSION);
+
+                        [[maybe_unused]] auto receipts =
+                            co_await scheduler.executeBlock(view, fixture.m_executor, blockHeader,
+                                ::ranges::views::indirect(fixture.m_transactions),
+                                fixture.m_ledgerConfig);
+                    }
+
+                    // Check
+                    fixture.m_multiLayerStorage.pushView(std::move(view));
+                    auto balances = co_await fixture.balances();
+
+                    std::vector<s256> expectbalances(count, singleIssue);
+                    for (auto& transfer : fixture.m_transfers)
+                    {
+                        expectbalances[transfer.from] -= singleTransfer * i;
+                        expectbalances[transfer.to] += singleTransfer * i;
+                    }
+                    for (auto&& [expect, got] : ::ranges::views::zip(expectbalances, balances))
+                    {
+                        if (expect != got)
+                        {
+                            BOOST_THROW_EXCEPTION(std::runtime_error(
+                                fmt::format("From balance not equal to expected! {} {}",
+                                    expect.str(), got.str())));
+                        }
+                    }
+                    co_await fixture.m_multiLayerStorage.mergeBackStorage();
+                }(state));
+            }
+        },
+        fixture.m_scheduler);
+}
+
+constexpr static auto SERIAL = SchedulerType::SERIAL;
+constexpr static auto PARALLEL = SchedulerType::PARALLEL;
+constexpr static auto BLOCK_STM = SchedulerType::BLOCK_STM;
 
 BENCHMARK(noConflictTransfer<SERIAL>)->Arg(1000)->Arg(10000)->Arg(100000);
 BENCHMARK(noConflictTransfer<PARALLEL>)
@@ -693,4 +818,59 @@ BENCHMARK(conflictTransfer<PARALLEL>)
     ->Args({100000, 256, 4})
     ->Args({100000, 256, 6})
     ->Args({100000, 256, 8})
-    ->Args({100000, 256, 16});
\ No newline at end of file
+    ->Args({100000, 256, 16});
+
+BENCHMARK(noConflictTransfer<BLOCK_STM>)
+    ->Args({1000, 0, 4})
+    ->Args({1000, 0, 8})
+    ->Args({1000, 0, 16})
+    ->Args({10000, 0, 4})
+    ->Args({10000, 0, 8})
+    ->Args({10000, 0, 16})
+    ->Args({100000, 0, 4})
+    ->Args({100000, 0, 8})
+    ->Args({100000, 0, 16});
+
+BENCHMARK(randomTransfer<BLOCK_STM>)
+    ->Args({1000, 0, 4})
+    ->Args({1000, 0, 8})
+    ->Args({1000, 0, 16})
+    ->Args({10000, 0, 4})
+    ->Args({10000, 0, 8})
+    ->Args({10000, 0, 16})
+    ->Args({100000, 0, 4})
+    ->Args({100000, 0, 8})
+    ->Args({100000, 0, 16});
+
+BENCHMARK(conflictTransfer<BLOCK_STM>)
+    ->Args({1000, 0, 4})
+    ->Args({1000, 0, 8})
+    ->Args({1000, 0, 16})
+    ->Args({10000, 0, 4})
+    ->Args({10000, 0, 8})
+    ->Args({10000, 0, 16});
+
+// Args: transaction count, grain size, max concurrency, percent of transfers into one hot account
+BENCHMARK(hotKeyTransfer<SERIAL>)
+    ->Args({10000, 0, 0, 0})
+    ->Args({10000, 0, 0, 1})
+    ->Args({10000, 0, 0, 10})
+    ->Args({10000, 0, 0, 50});
+BENCHMARK(hotKeyTransfer<PARALLEL>)
+    ->Args({10000, 16, 8, 0})
+    ->Args({10000, 16, 8, 1})
+    ->Args({10000, 16, 8, 10})
+    ->Args({10000, 16, 8, 50})
+    ->Args({10000, 64, 8, 0})
+    ->Args({10000, 64, 8, 1})
+    ->Args({10000, 64, 8, 10})
+    ->Args({10000, 64, 8, 50});
+BENCHMARK(hotKeyTransfer<BLOCK_STM>)
+    ->Args({10000, 0, 8, 0})
+    ->Args({10000, 0, 8, 1})
+    ->Args({10000, 0, 8, 10})
+    ->Args({10000, 0, 8, 50})
+    ->Args({10000, 0, 16, 0})
+    ->Args({10000, 0, 16, 1})
+    ->Args({10000, 0, 16, 10})
+    ->Args({10000, 0, 16, 50});
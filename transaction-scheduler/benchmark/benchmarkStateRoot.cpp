@@ -0,0 +1,98 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-framework/ledger/Features.h"
+#include "bcos-framework/protocol/Protocol.h"
+#include "bcos-framework/transaction-executor/StateKey.h"
+#include "bcos-transaction-scheduler/BaselineScheduler.h"
+#include <bcos-framework/storage2/MemoryStorage.h>
+#include <bcos-task/Wait.h>
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace bcos;
+using namespace bcos::storage2::memory_storage;
+using namespace std::string_view_literals;
+
+constexpr static auto BENCHMARK_BLOCK_VERSION =
+    static_cast<uint32_t>(protocol::BlockVersion::V3_1_VERSION);
+
+struct StateRootFixture
+{
+    using DirtyStorage = MemoryStorage<executor_v1::StateKey, executor_v1::StateValue,
+        Attribute(ORDERED | LOGICAL_DELETION)>;
+    using TreeStorage = MemoryStorage<executor_v1::StateKey, executor_v1::StateValue, ORDERED>;
+
+    StateRootFixture() { features.set(ledger::Features::Flag::feature_state_tree); }
+
+    // 每轮写入不同的value，模拟一个区块修改了dirtyCount个已存在的key
+    // Each round writes new values, as a block modifying dirtyCount existing keys
+    DirtyStorage makeBlock(int64_t dirtyCount, int64_t totalCount, int64_t round)
+    {
+        DirtyStorage dirty;
+        task::syncWait([&]() -> task::Task<void> {
+            for (auto i = 0; i < dirtyCount; ++i)
+            {
+                auto keyIndex = (round * dirtyCount + i) % totalCount;
+                storage::Entry entry;
+                entry.set(fmt::format("value: {} {}", keyIndex, round));
+                co_await storage2::writeOne(dirty,
+                    executor_v1::StateKey{"test_table"sv, fmt::format("key: {}", keyIndex)},
+                    std::move(entry));
+            }
+        }());
+        return dirty;
+    }
+
+    h256 treeRoot(DirtyStorage& dirty)
+    {
+        return task::syncWait(scheduler_v1::calculateStateTreeRoot(
+            dirty, treeStorage, BENCHMARK_BLOCK_VERSION, hashImpl, features));
+    }
+
+    crypto::Keccak256 hashImpl;
+    ledger::Features features;
+    TreeStorage treeStorage;
+};
+
+static void xorStateRoot(benchmark::State& state)
+{
+    StateRootFixture fixture;
+    auto dirtyCount = state.range(0);
+    auto dirty = fixture.makeBlock(dirtyCount, dirtyCount, 0);
+
+    for (auto const& it : state)
+    {
+        benchmark::DoNotOptimize(task::syncWait(scheduler_v1::calculateStateRoot(
+            dirty, BENCHMARK_BLOCK_VERSION, fixture.hashImpl, fixture.features)));
+    }
+    state.SetItemsProcessed(state.iterations() * dirtyCount);
+}
+
+static void treeStateRoot(benchmark::State& state)
+{
+    StateRootFixture fixture;
+    auto dirtyCount = state.range(0);
+    auto totalCount = state.range(1);
+    auto genesis = fixture.makeBlock(totalCount, totalCount, 0);
+    fixture.treeRoot(genesis);
+
+    int64_t round = 1;
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        auto dirty = fixture.makeBlock(dirtyCount, totalCount, round++);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(fixture.treeRoot(dirty));
+    }
+    state.SetItemsProcessed(state.iterations() * dirtyCount);
+}
+
+BENCHMARK(xorStateRoot)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(treeStateRoot)
+    ->Args({1000, 1000})
+    ->Args({10000, 10000})
+    ->Args({100000, 100000})
+    ->Args({1000, 100000})
+    ->Args({10000, 100000});
+
+BENCHMARK_MAIN();
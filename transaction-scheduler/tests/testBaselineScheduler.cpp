@@ -448,4 +448,111 @@ BOOST_AUTO_TEST_CASE(call)
     end.get_future().get();
 }
 
+BOOST_AUTO_TEST_CASE(preExecuteBlock)
+{
+    // the consensus decodes its own copy of the proposal for pre-execution and execution
+    auto makeProposal = [this](protocol::BlockNumber number, int64_t timestamp) {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        auto blockHeader = block->blockHeader();
+        blockHeader->setNumber(number);
+        blockHeader->setVersion(200);
+        blockHeader->setTimestamp(timestamp);
+        blockHeader->calculateHash(*hashImpl);
+        bcos::bytes input;
+        block->appendTransaction(transactionFactory->createTransaction(
+            0, "to", input, "12345", 100, "chain", "group", 0));
+        block->appendTransaction(transactionFactory->createTransaction(
+            0, "to", input, "12346", 100, "chain", "group", 0));
+        return block;
+    };
+    auto execute = [this](protocol::Block::Ptr block) {
+        std::promise<protocol::BlockHeader::Ptr> end;
+        baselineScheduler.executeBlock(block, false,
+            [&](bcos::Error::Ptr error, bcos::protocol::BlockHeader::Ptr blockHeader, bool) {
+                BOOST_CHECK(!error);
+                end.set_value(std::move(blockHeader));
+            });
+        return end.get_future().get();
+    };
+    auto preExecute = [this](protocol::Block::Ptr block) {
+        std::promise<bcos::Error::Ptr> end;
+        baselineScheduler.preExecuteBlock(
+            block, false, [&](bcos::Error::Ptr error) { end.set_value(std::move(error)); });
+        BOOST_CHECK(!end.get_future().get());
+    };
+    writeBlock(500, 1000);
+
+    // the same proposal is adopted
+    preExecute(makeProposal(500, 1000));
+    auto block = makeProposal(500, 1000);
+    auto executedHeader = execute(block);
+    BOOST_REQUIRE(executedHeader);
+    BOOST_CHECK_EQUAL(executedHeader->gasUsed(), 200);
+    BOOST_CHECK_EQUAL(block->receiptsSize(), 2);
+    auto const& statistics = baselineScheduler.speculativeStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits.load(), 1);
+    BOOST_CHECK_EQUAL(statistics.discards.load(), 0);
+
+    // a different proposal of the same height is discarded and executed again
+    preExecute(makeProposal(501, 1000));
+    auto otherBlock = makeProposal(501, 2000);
+    auto otherHeader = execute(otherBlock);
+    BOOST_REQUIRE(otherHeader);
+    BOOST_CHECK_EQUAL(otherHeader->timestamp(), 2000);
+    BOOST_CHECK_EQUAL(otherBlock->receiptsSize(), 2);
+    BOOST_CHECK_EQUAL(statistics.hits.load(), 1);
+    BOOST_CHECK_EQUAL(statistics.discards.load(), 1);
+
+    // a proposal not following the latest executed block is not pre-executed
+    preExecute(makeProposal(600, 1000));
+    BOOST_CHECK(execute(makeProposal(502, 1000)));
+    BOOST_CHECK_EQUAL(statistics.hits.load(), 1);
+    BOOST_CHECK_EQUAL(statistics.discards.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(finishExecuteSortsOnce)
+{
+    using SortedStorage =
+        memory_storage::MemoryStorage<StateKey, StateValue,
+            memory_storage::Attribute(
+                memory_storage::SORT_ON_FREEZE | memory_storage::LOGICAL_DELETION)>;
+    using SortedMultiLayerStorage = MultiLayerStorage<SortedStorage, void, BackendStorage>;
+    for (auto stateTree : {false, true})
+    {
+        SortedMultiLayerStorage sortedStorage(backendStorage);
+        auto view = sortedStorage.fork();
+        view.newMutable();
+        auto& storage = mutableStorage(view);
+        for (auto i = 0; i < 100; ++i)
+        {
+            storage::Entry entry;
+            entry.set(std::to_string(i));
+            task::syncWait(
+                storage2::writeOne(view, StateKey{"t_test", std::to_string(i)}, std::move(entry)));
+        }
+
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->blockHeader()->setNumber(1);
+        block->blockHeader()->setVersion(200);
+        auto executedBlockHeader = blockHeaderFactory->populateBlockHeader(block->blockHeader());
+        ledger::Features features;
+        if (stateTree)
+        {
+            features.set(ledger::Features::Flag::feature_state_tree);
+        }
+        std::vector<protocol::TransactionReceipt::Ptr> receipts;
+        std::vector<protocol::Transaction::ConstPtr> transactions;
+        bool sysBlock = false;
+        task::syncWait(scheduler_v1::finishExecute(view, ::ranges::views::all(receipts),
+            *executedBlockHeader, *block, ::ranges::views::all(transactions), sysBlock, *hashImpl,
+            features));
+        sortedStorage.pushView(std::move(view));
+
+        // the state root, the bloom filter of the layer and its ranges share one sort, the block
+        // hash entries and the tree nodes written after the root are merged in
+        BOOST_CHECK(storage.frozen());
+        BOOST_CHECK_EQUAL(storage.sortCount(), 1U);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
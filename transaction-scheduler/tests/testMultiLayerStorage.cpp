@@ -225,4 +225,121 @@ BOOST_AUTO_TEST_CASE(deletedEntry)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(layerFilter)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        constexpr static int LAYER_COUNT = 8;
+        constexpr static int KEYS_PER_LAYER = 100;
+        auto toKey = [](int layer, int num) {
+            return StateKey{"test_table"sv, fmt::format("key: {} {}", layer, num)};
+        };
+
+        for (auto layer : ::ranges::views::iota(0, LAYER_COUNT))
+        {
+            auto view = multiLayerStorage.fork();
+            view.newMutable();
+            for (auto num : ::ranges::views::iota(0, KEYS_PER_LAYER))
+            {
+                storage::Entry entry;
+                entry.set(fmt::format("value: {} {}", layer, num));
+                co_await storage2::writeOne(view, toKey(layer, num), std::move(entry));
+            }
+            // 删除标记也要能遮盖更旧的层 | Deletions must still shadow the older layers
+            if (layer > 0)
+            {
+                co_await storage2::removeOne(view, toKey(layer - 1, 0));
+            }
+            multiLayerStorage.pushView(std::move(view));
+        }
+
+        auto view = multiLayerStorage.fork();
+        for (auto layer : ::ranges::views::iota(0, LAYER_COUNT))
+        {
+            auto value = co_await storage2::readOne(view, toKey(layer, 1));
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(value->get(), fmt::format("value: {} {}", layer, 1));
+            BOOST_CHECK_EQUAL(co_await storage2::readOne(view, toKey(layer, 0)).has_value(),
+                layer == LAYER_COUNT - 1);
+        }
+        BOOST_CHECK(!co_await storage2::readOne(view, toKey(LAYER_COUNT, 0)));
+
+        auto const& statistics = multiLayerStorage.readStatistics();
+        BOOST_CHECK_EQUAL(statistics.reads.load(), LAYER_COUNT * 2 + 1);
+        BOOST_CHECK_GT(statistics.filterSkips.load(), statistics.layerProbes.load());
+        BOOST_CHECK_LT(statistics.falsePositives.load(), LAYER_COUNT);
+
+        auto keys = ::ranges::views::iota(0, LAYER_COUNT) |
+                    ::ranges::views::transform([&](int layer) { return toKey(layer, 2); });
+        auto values = co_await storage2::readSome(view, keys);
+        for (auto&& [layer, value] : ::ranges::views::enumerate(values))
+        {
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(value->get(), fmt::format("value: {} {}", layer, 2));
+        }
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(compactLayers)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        constexpr static int LAYER_COUNT = 6;
+        StateKey commonKey{"test_table"sv, "common"sv};
+        auto toKey = [](int num) { return StateKey{"test_table"sv, fmt::format("key: {}", num)}; };
+        auto readValue = [&](StateKey const& key) -> task::Task<std::optional<std::string>> {
+            auto view = multiLayerStorage.fork();
+            if (auto entry = co_await storage2::readOne(view, key))
+            {
+                co_return std::string(entry->get());
+            }
+            co_return std::nullopt;
+        };
+
+        for (auto layer : ::ranges::views::iota(0, LAYER_COUNT))
+        {
+            auto view = multiLayerStorage.fork();
+            view.newMutable();
+            storage::Entry entry;
+            entry.set(fmt::format("value: {}", layer));
+            co_await storage2::writeOne(view, commonKey, entry);
+            co_await storage2::writeOne(view, toKey(layer), entry);
+            if (layer == 3)
+            {
+                co_await storage2::removeOne(view, toKey(1));
+            }
+            multiLayerStorage.pushView(std::move(view));
+        }
+
+        BOOST_CHECK(!co_await multiLayerStorage.compactLayers(LAYER_COUNT));
+        BOOST_CHECK(co_await multiLayerStorage.compactLayers(2));
+        BOOST_CHECK_EQUAL(multiLayerStorage.layerDepth(), 2);
+        BOOST_CHECK_EQUAL(multiLayerStorage.compactionStatistics().compactions.load(), 1);
+        BOOST_CHECK_EQUAL(multiLayerStorage.compactionStatistics().compactedLayers.load(), 5);
+
+        BOOST_CHECK_EQUAL((co_await readValue(commonKey)).value_or(""), "value: 5");
+        BOOST_CHECK(!co_await readValue(toKey(1)));
+        for (auto layer : {0, 2, 3, 4, 5})
+        {
+            BOOST_CHECK_EQUAL(
+                (co_await readValue(toKey(layer))).value_or(""), fmt::format("value: {}", layer));
+        }
+
+        // 提交最旧的区块后合并层仍然保留 | The compacted layer survives committing its oldest block
+        co_await multiLayerStorage.mergeBackStorage();
+        BOOST_CHECK_EQUAL(multiLayerStorage.layerDepth(), 2);
+        BOOST_CHECK_EQUAL((co_await readValue(toKey(0))).value_or(""), "value: 0");
+
+        // 回滚到合并层内部时拆回每个区块的层 | Rolling back into the compacted layer splits it
+        multiLayerStorage.popFrontStorage();
+        BOOST_CHECK_EQUAL(multiLayerStorage.layerDepth(), 1);
+        BOOST_CHECK_EQUAL((co_await readValue(commonKey)).value_or(""), "value: 4");
+
+        multiLayerStorage.popFrontStorage();
+        BOOST_CHECK_EQUAL(multiLayerStorage.layerDepth(), 3);
+        BOOST_CHECK_EQUAL((co_await readValue(commonKey)).value_or(""), "value: 3");
+        BOOST_CHECK(!co_await readValue(toKey(4)));
+        BOOST_CHECK(!co_await readValue(toKey(1)));
+        BOOST_CHECK_EQUAL((co_await readValue(toKey(2))).value_or(""), "value: 2");
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -110,4 +110,60 @@ BOOST_AUTO_TEST_CASE(directFlag)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(exactKey)
+{
+    task::syncWait([]() -> task::Task<void> {
+        Storage lhsStorage;
+        ReadWriteSetStorage<decltype(lhsStorage), true> firstStorage(lhsStorage);
+
+        Storage rhsStorage;
+        ReadWriteSetStorage<decltype(rhsStorage), true> secondStorage(rhsStorage);
+
+        co_await storage2::writeOne(firstStorage, 100, 1);
+        co_await storage2::writeOne(firstStorage, 200, 1);
+        co_await storage2::readOne(secondStorage, 400);
+        BOOST_CHECK(!hasRAWIntersection(firstStorage, secondStorage));
+
+        co_await storage2::readOne(secondStorage, 200);
+        BOOST_CHECK(hasRAWIntersection(firstStorage, secondStorage));
+        BOOST_CHECK(readWriteSet(secondStorage).at(200).read);
+
+        Storage mergedStorage;
+        ReadWriteSetStorage<decltype(mergedStorage), true> merged(mergedStorage);
+        mergeWriteSet(merged, secondStorage);
+        BOOST_CHECK(::ranges::empty(readWriteSet(merged)));
+        mergeWriteSet(merged, firstStorage);
+        BOOST_CHECK_EQUAL(readWriteSet(merged).size(), 2);
+    }());
+}
+
+struct CollideHasher
+{
+    size_t operator()(int /*key*/) const { return 0; }
+};
+
+BOOST_AUTO_TEST_CASE(hashCollision)
+{
+    FlatReadWriteSet<int, false, CollideHasher> lhsHashed;
+    FlatReadWriteSet<int, false, CollideHasher> rhsHashed;
+    lhsHashed.put(true, 1);
+    rhsHashed.put(false, 2);
+    // 只保存哈希时碰撞会被误判为冲突
+    // With hashes only, a collision is reported as a conflict
+    BOOST_CHECK(lhsHashed.intersects(rhsHashed));
+
+    FlatReadWriteSet<int, true, CollideHasher> lhsExact;
+    FlatReadWriteSet<int, true, CollideHasher> rhsExact;
+    lhsExact.put(true, 1);
+    rhsExact.put(false, 2);
+    BOOST_CHECK(!lhsExact.intersects(rhsExact));
+    rhsExact.put(false, 1);
+    BOOST_CHECK(lhsExact.intersects(rhsExact));
+    BOOST_CHECK_EQUAL(rhsExact.size(), 2);
+
+    lhsExact.clear();
+    BOOST_CHECK(lhsExact.empty());
+    BOOST_CHECK(!lhsExact.intersects(rhsExact));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "bcos-framework/ledger/LedgerConfig.h"
+#include "bcos-framework/storage2/MemoryStorage.h"
+#include "bcos-framework/storage2/MultiLayerStorage.h"
+#include "bcos-framework/storage2/Storage.h"
+#include "bcos-framework/transaction-executor/StateKey.h"
+#include "bcos-tars-protocol/protocol/BlockHeaderImpl.h"
+#include <bcos-tars-protocol/protocol/TransactionImpl.h>
+#include <bcos-task/Wait.h>
+#include <bcos-transaction-scheduler/SchedulerBlockSTMImpl.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::storage2;
+using namespace bcos::executor_v1;
+using namespace bcos::scheduler_v1;
+using namespace std::string_view_literals;
+
+constexpr static int BLOCK_STM_INITIAL_VALUE = 100000;
+constexpr static size_t BLOCK_STM_USER_COUNT = 1000;
+
+// input is "<from>,<to>", transfer 1 from the first key to the second key
+struct MockBlockSTMExecutor
+{
+    template <class Storage>
+    struct ExecuteContext
+    {
+        protocol::Transaction const* transaction;
+        Storage* storage;
+
+        template <int step>
+        task::Task<protocol::TransactionReceipt::Ptr> executeStep()
+        {
+            if constexpr (step == 1)
+            {
+                auto input = transaction->input();
+                std::string_view inputView((const char*)input.data(), input.size());
+                auto split = inputView.find(',');
+
+                StateKey fromKey{"t_test"sv, inputView.substr(0, split)};
+                auto fromEntry = co_await storage2::readOne(*storage, fromKey);
+                fromEntry->set(boost::lexical_cast<std::string>(
+                    boost::lexical_cast<int>(fromEntry->get()) - 1));
+                co_await storage2::writeOne(*storage, fromKey, *fromEntry);
+
+                StateKey toKey{"t_test"sv, inputView.substr(split + 1)};
+                auto toEntry = co_await storage2::readOne(*storage, toKey);
+                toEntry->set(
+                    boost::lexical_cast<std::string>(boost::lexical_cast<int>(toEntry->get()) + 1));
+                co_await storage2::writeOne(*storage, toKey, *toEntry);
+            }
+            else if constexpr (step == 2)
+            {
+                co_return std::shared_ptr<bcos::protocol::TransactionReceipt>(
+                    (bcos::protocol::TransactionReceipt*)0x10086, [](auto* p) {});
+            }
+            co_return {};
+        }
+    };
+
+    auto createExecuteContext(auto& storage, protocol::BlockHeader const& blockHeader,
+        protocol::Transaction const& transaction, int32_t contextID,
+        ledger::LedgerConfig const& ledgerConfig, bool call)
+        -> task::Task<ExecuteContext<std::decay_t<decltype(storage)>>>
+    {
+        co_return ExecuteContext<std::decay_t<decltype(storage)>>{
+            .transaction = std::addressof(transaction), .storage = std::addressof(storage)};
+    }
+
+    task::Task<protocol::TransactionReceipt::Ptr> executeTransaction(auto& storage,
+        protocol::BlockHeader const& blockHeader, protocol::Transaction const& transaction,
+        int contextID, ledger::LedgerConfig const& /*unused*/, bool /*unused*/)
+    {
+        co_return {};
+    }
+};
+
+class TestSchedulerBlockSTMFixture
+{
+public:
+    using MutableStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::LOGICAL_DELETION)>;
+    using BackendStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::CONCURRENT),
+        std::hash<StateKey>>;
+
+    TestSchedulerBlockSTMFixture() : multiLayerStorage(backendStorage) {}
+
+    task::Task<void> initAccounts()
+    {
+        auto view = multiLayerStorage.fork();
+        view.newMutable();
+        for (auto i : ::ranges::views::iota(0LU, BLOCK_STM_USER_COUNT))
+        {
+            storage::Entry entry;
+            entry.set(boost::lexical_cast<std::string>(BLOCK_STM_INITIAL_VALUE));
+            co_await storage2::writeOne(view,
+                StateKey{"t_test"sv, boost::lexical_cast<std::string>(i)}, std::move(entry));
+        }
+        multiLayerStorage.pushView(std::move(view));
+    }
+
+    task::Task<std::vector<protocol::TransactionReceipt::Ptr>> executeTransfers(
+        std::vector<std::pair<size_t, size_t>> const& transfers)
+    {
+        auto transactions =
+            transfers | ::ranges::views::transform([](auto const& transfer) {
+                auto transaction = std::make_unique<bcostars::protocol::TransactionImpl>();
+                auto input = fmt::format("{},{}", transfer.first, transfer.second);
+                transaction->mutableInner().data.input.assign(input.begin(), input.end());
+                return transaction;
+            }) |
+            ::ranges::to<std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>>>();
+
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        MockBlockSTMExecutor executor;
+        SchedulerBlockSTMImpl<MutableStorage> scheduler;
+        ledger::LedgerConfig ledgerConfig;
+
+        auto view = multiLayerStorage.fork();
+        view.newMutable();
+        auto receipts = co_await scheduler.executeBlock(view, executor, blockHeader,
+            transactions | ::ranges::views::transform([](auto& ptr) -> auto& { return *ptr; }),
+            ledgerConfig);
+        multiLayerStorage.pushView(std::move(view));
+        co_return receipts;
+    }
+
+    task::Task<int> balance(size_t index)
+    {
+        auto view = multiLayerStorage.fork();
+        auto entry = co_await storage2::readOne(
+            view, StateKey{"t_test"sv, boost::lexical_cast<std::string>(index)});
+        co_return boost::lexical_cast<int>(entry->get());
+    }
+
+    BackendStorage backendStorage;
+    MultiLayerStorage<MutableStorage, void, BackendStorage> multiLayerStorage;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSchedulerBlockSTM, TestSchedulerBlockSTMFixture)
+
+BOOST_AUTO_TEST_CASE(noConflict)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        co_await initAccounts();
+
+        auto transfers = ::ranges::views::iota(0LU, BLOCK_STM_USER_COUNT / 2) |
+                         ::ranges::views::transform([](size_t index) {
+                             return std::make_pair(index * 2, index * 2 + 1);
+                         }) |
+                         ::ranges::to<std::vector>();
+        auto receipts = co_await executeTransfers(transfers);
+        BOOST_CHECK_EQUAL(receipts.size(), transfers.size());
+        for (auto const& receipt : receipts)
+        {
+            BOOST_CHECK_EQUAL(receipt.get(), (bcos::protocol::TransactionReceipt*)0x10086);
+        }
+
+        for (auto i : ::ranges::views::iota(0LU, BLOCK_STM_USER_COUNT))
+        {
+            BOOST_CHECK_EQUAL(co_await balance(i),
+                i % 2 == 0 ? BLOCK_STM_INITIAL_VALUE - 1 : BLOCK_STM_INITIAL_VALUE + 1);
+        }
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(hotKey)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        co_await initAccounts();
+
+        // Every transaction pays into account 0, forming a chain of read-after-write conflicts
+        constexpr static size_t TRANSACTION_COUNT = 500;
+        auto transfers =
+            ::ranges::views::iota(0LU, TRANSACTION_COUNT) |
+            ::ranges::views::transform([](size_t index) {
+                return std::make_pair(index % (BLOCK_STM_USER_COUNT - 1) + 1, size_t{0});
+            }) |
+            ::ranges::to<std::vector>();
+        auto receipts = co_await executeTransfers(transfers);
+        BOOST_CHECK_EQUAL(receipts.size(), transfers.size());
+
+        BOOST_CHECK_EQUAL(co_await balance(0), BLOCK_STM_INITIAL_VALUE + TRANSACTION_COUNT);
+        for (auto i : ::ranges::views::iota(1LU, TRANSACTION_COUNT + 1))
+        {
+            BOOST_CHECK_EQUAL(co_await balance(i), BLOCK_STM_INITIAL_VALUE - 1);
+        }
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(mixedConflict)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        co_await initAccounts();
+
+        // Same layout as the parallel scheduler conflict test: every account pays once and is
+        // paid once, so all balances must end where they started
+        auto transfers = ::ranges::views::iota(0LU, BLOCK_STM_USER_COUNT) |
+                         ::ranges::views::transform([](size_t index) {
+                             return std::make_pair(index % BLOCK_STM_USER_COUNT,
+                                 (index + (BLOCK_STM_USER_COUNT / 2)) % BLOCK_STM_USER_COUNT);
+                         }) |
+                         ::ranges::to<std::vector>();
+        auto receipts = co_await executeTransfers(transfers);
+        BOOST_CHECK_EQUAL(receipts.size(), transfers.size());
+
+        for (auto i : ::ranges::views::iota(0LU, BLOCK_STM_USER_COUNT))
+        {
+            BOOST_CHECK_EQUAL(co_await balance(i), BLOCK_STM_INITIAL_VALUE);
+        }
+    }());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-framework/ledger/Features.h"
+#include "bcos-framework/ledger/StateTree.h"
+#include "bcos-framework/protocol/Protocol.h"
+#include "bcos-framework/storage/Entry.h"
+#include "bcos-framework/storage2/MemoryStorage.h"
+#include "bcos-framework/transaction-executor/StateKey.h"
+#include "bcos-task/Wait.h"
+#include "bcos-transaction-scheduler/BaselineScheduler.h"
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::storage2;
+using namespace bcos::executor_v1;
+using namespace bcos::ledger::state_tree;
+using namespace std::string_view_literals;
+
+constexpr static auto STATE_TREE_TEST_VERSION =
+    static_cast<uint32_t>(protocol::BlockVersion::V3_1_VERSION);
+
+class TestStateTreeFixture
+{
+public:
+    using DirtyStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::LOGICAL_DELETION)>;
+    using TreeStorage =
+        memory_storage::MemoryStorage<StateKey, StateValue, memory_storage::ORDERED>;
+
+    TestStateTreeFixture() { features.set(ledger::Features::Flag::feature_state_tree); }
+
+    static storage::Entry valueEntry(std::string_view value)
+    {
+        storage::Entry entry;
+        entry.set(std::string(value));
+        return entry;
+    }
+
+    h256 applyBlock(DirtyStorage& dirty, TreeStorage& tree)
+    {
+        return task::syncWait(scheduler_v1::calculateStateTreeRoot(
+            dirty, tree, STATE_TREE_TEST_VERSION, hashImpl, features));
+    }
+
+    static size_t countNodes(TreeStorage& tree)
+    {
+        return task::syncWait([&]() -> task::Task<size_t> {
+            size_t count = 0;
+            auto range = co_await storage2::range(tree);
+            while (auto keyValue = co_await range.next())
+            {
+                ++count;
+            }
+            co_return count;
+        }());
+    }
+
+    crypto::Keccak256 hashImpl;
+    ledger::Features features;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestStateTree, TestStateTreeFixture)
+
+BOOST_AUTO_TEST_CASE(incrementalMatchesRebuild)
+{
+    constexpr static size_t KEY_COUNT = 300;
+    TreeStorage tree;
+    std::map<std::string, std::string> state;
+
+    DirtyStorage block1;
+    for (auto i : ::ranges::views::iota(0LU, KEY_COUNT))
+    {
+        auto key = boost::lexical_cast<std::string>(i);
+        state[key] = "v1-" + key;
+        task::syncWait(
+            storage2::writeOne(block1, StateKey{"t_test"sv, key}, valueEntry(state[key])));
+    }
+    auto root1 = applyBlock(block1, tree);
+    BOOST_CHECK_NE(root1, h256{});
+
+    // The tree root must not collide with the XOR root of the same modifications
+    BOOST_CHECK_NE(root1, task::syncWait(scheduler_v1::calculateStateRoot(
+                              block1, STATE_TREE_TEST_VERSION, hashImpl, features)));
+
+    // Modify, delete and insert keys in the next block
+    DirtyStorage block2;
+    for (auto i : ::ranges::views::iota(0LU, KEY_COUNT + 50))
+    {
+        auto key = boost::lexical_cast<std::string>(i);
+        StateKey stateKey{"t_test"sv, key};
+        if (i % 3 == 0)
+        {
+            state.erase(key);
+            task::syncWait(storage2::removeOne(block2, stateKey));
+        }
+        else if (i % 3 == 1)
+        {
+            state[key] = "v2-" + key;
+            task::syncWait(storage2::writeOne(block2, stateKey, valueEntry(state[key])));
+        }
+    }
+    auto root2 = applyBlock(block2, tree);
+    BOOST_CHECK_NE(root2, root1);
+
+    TreeStorage rebuiltTree;
+    DirtyStorage rebuild;
+    for (auto const& [key, value] : state)
+    {
+        task::syncWait(storage2::writeOne(rebuild, StateKey{"t_test"sv, key}, valueEntry(value)));
+    }
+    BOOST_CHECK_EQUAL(applyBlock(rebuild, rebuiltTree), root2);
+
+    // No stale node is left behind by the incremental update
+    BOOST_CHECK_EQUAL(countNodes(tree), countNodes(rebuiltTree));
+}
+
+BOOST_AUTO_TEST_CASE(removeAllKeys)
+{
+    TreeStorage tree;
+    DirtyStorage block1;
+    DirtyStorage block2;
+    for (auto i : ::ranges::views::iota(0, 100))
+    {
+        StateKey stateKey{"t_test"sv, boost::lexical_cast<std::string>(i)};
+        task::syncWait(storage2::writeOne(block1, stateKey, valueEntry("value")));
+        task::syncWait(storage2::removeOne(block2, stateKey));
+    }
+    BOOST_CHECK_NE(applyBlock(block1, tree), h256{});
+    BOOST_CHECK_EQUAL(applyBlock(block2, tree), h256{});
+    BOOST_CHECK_EQUAL(countNodes(tree), 0);
+}
+
+BOOST_AUTO_TEST_CASE(proof)
+{
+    TreeStorage tree;
+    DirtyStorage block;
+    for (auto i : ::ranges::views::iota(0, 100))
+    {
+        task::syncWait(storage2::writeOne(block,
+            StateKey{"t_test"sv, boost::lexical_cast<std::string>(i)}, valueEntry("value")));
+    }
+    auto root = applyBlock(block, tree);
+
+    const std::optional<ledger::Features> featuresOpt(features);
+    auto valueHash =
+        valueEntry("value").hash("t_test", "42", hashImpl, STATE_TREE_TEST_VERSION, featuresOpt);
+    auto path = keyPath("t_test", "42", hashImpl);
+    auto stateProof = task::syncWait(getStateProof(tree, path));
+    BOOST_CHECK(verifyStateProof(root, path, valueHash, stateProof, hashImpl));
+    BOOST_CHECK(!verifyStateProof(root, path, std::nullopt, stateProof, hashImpl));
+    BOOST_CHECK(!verifyStateProof(root, path, h256(1), stateProof, hashImpl));
+
+    auto absentPath = keyPath("t_test", "absent", hashImpl);
+    auto absentProof = task::syncWait(getStateProof(tree, absentPath));
+    BOOST_CHECK(verifyStateProof(root, absentPath, std::nullopt, absentProof, hashImpl));
+    BOOST_CHECK(!verifyStateProof(root, absentPath, valueHash, absentProof, hashImpl));
+}
+
+BOOST_AUTO_TEST_SUITE_END()